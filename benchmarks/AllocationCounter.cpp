@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+
+namespace
+{
+std::atomic<size_t> num_heap_allocations = 0;
+} // namespace
+
+size_t get_num_heap_allocations()
+{
+    return num_heap_allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(const std::size_t size)
+{
+    num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto *ptr = std::malloc(std::max<std::size_t>(size, 1)))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// std::pmr::new_delete_resource allocates through the aligned forms
+void *operator new(const std::size_t size, const std::align_val_t align)
+{
+    num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto alignment = static_cast<std::size_t>(align);
+    const auto aligned_size = (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment;
+#ifdef _WIN32
+    if (auto *ptr = _aligned_malloc(aligned_size, alignment))
+        return ptr;
+#else
+    if (auto *ptr = std::aligned_alloc(alignment, aligned_size))
+        return ptr;
+#endif
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr, const std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void operator delete(void *ptr, const std::size_t, const std::align_val_t align) noexcept
+{
+    operator delete(ptr, align);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+
+// rota_bench replaces the global operator new to count heap allocations. The
+// count covers every thread of the process, take the difference around the
+// code under test.
+size_t get_num_heap_allocations();
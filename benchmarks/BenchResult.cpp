@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "BenchResult.h"
+
+namespace
+{
+constexpr auto SCHEMA = "gw2rotahelper-bench/1";
+} // namespace
+
+double get_elapsed_ns(const std::chrono::steady_clock::time_point &t0)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+}
+
+BenchResult get_bench_result(const std::string &name, std::vector<double> samples_ns, const size_t items)
+{
+    auto result = BenchResult{.name = name, .iterations = samples_ns.size(), .items = items, .counters = {}};
+    if (samples_ns.empty())
+        return result;
+
+    std::sort(samples_ns.begin(), samples_ns.end());
+
+    // Nearest rank, the p99 of few samples is their maximum
+    const auto get_percentile = [&samples_ns](const double percentile) {
+        const auto rank = static_cast<size_t>(percentile * static_cast<double>(samples_ns.size() - 1) + 0.5);
+        return samples_ns[std::min(rank, samples_ns.size() - 1)];
+    };
+
+    auto sum = 0.0;
+    for (const auto sample : samples_ns)
+        sum += sample;
+
+    result.min_ns = samples_ns.front();
+    result.median_ns = get_percentile(0.5);
+    result.p99_ns = get_percentile(0.99);
+    result.max_ns = samples_ns.back();
+    result.mean_ns = sum / static_cast<double>(samples_ns.size());
+
+    return result;
+}
+
+void print_bench_result(const BenchResult &result)
+{
+    std::fprintf(stderr,
+                 "%-64s %8zu x  median %12.0f ns  p99 %12.0f ns\n",
+                 result.name.c_str(),
+                 result.iterations,
+                 result.median_ns,
+                 result.p99_ns);
+}
+
+bool write_bench_results(const std::vector<BenchResult> &results, const std::filesystem::path &output_path)
+{
+    auto benchmarks = nlohmann::ordered_json::array();
+    for (const auto &result : results)
+    {
+        auto entry = nlohmann::ordered_json{
+            {"name", result.name},
+            {"iterations", result.iterations},
+            {"items", result.items},
+            {"min_ns", result.min_ns},
+            {"median_ns", result.median_ns},
+            {"p99_ns", result.p99_ns},
+            {"max_ns", result.max_ns},
+            {"mean_ns", result.mean_ns},
+        };
+
+        if (!result.counters.empty())
+        {
+            auto counters = nlohmann::ordered_json::object();
+            for (const auto &[counter_name, value] : result.counters)
+                counters[counter_name] = value;
+            entry["counters"] = counters;
+        }
+
+        benchmarks.push_back(entry);
+    }
+
+    const auto output =
+        nlohmann::ordered_json{{"schema", SCHEMA}, {"benchmarks", benchmarks}}.dump(2) + "\n";
+
+    if (output_path.empty())
+        return std::fputs(output.c_str(), stdout) >= 0;
+
+    auto file = std::ofstream{output_path, std::ios::binary | std::ios::trunc};
+    file << output;
+
+    return file.good();
+}
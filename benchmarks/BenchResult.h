@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Results shared by rota_bench and rota_render_harness. Both write the same
+// JSON layout, one entry per benchmark with the keys in a fixed order, so the
+// outputs of two commits can be diffed or compared by a script. All times
+// are nanoseconds.
+
+struct BenchResult
+{
+    std::string name;
+    size_t iterations = 0;
+    size_t items = 0;
+    double min_ns = 0.0;
+    double median_ns = 0.0;
+    double p99_ns = 0.0;
+    double max_ns = 0.0;
+    double mean_ns = 0.0;
+
+    // Extra per-iteration means of the benchmark, e.g. vertices per frame
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+double get_elapsed_ns(const std::chrono::steady_clock::time_point &t0);
+
+// items is the number of elements one sample handles
+BenchResult get_bench_result(const std::string &name, std::vector<double> samples_ns, const size_t items);
+
+// Prints the summary line of the result to stderr
+void print_bench_result(const BenchResult &result);
+
+// Writes to stdout if the path is empty
+bool write_bench_results(const std::vector<BenchResult> &results, const std::filesystem::path &output_path);
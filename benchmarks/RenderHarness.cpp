@@ -0,0 +1,360 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "imgui.h"
+
+#include "BenchResult.h"
+#include "IconCache.h"
+#include "LogData.h"
+#include "RenderUtils.h"
+#include "Settings.h"
+#include "SyntheticLibrary.h"
+#include "Types.h"
+#include "TypesUtils.h"
+#include "UiHost.h"
+#include "UiShared.h"
+
+// Frame cost of the rotation and options windows without the game or a GPU:
+//
+//   rota_render_harness [--data <data folder>] [--build <bench file>] [--frames <n>] [--output <file>]
+//
+// ImGui runs without a platform or renderer backend, only the font atlas is
+// built so text can be laid out. The build is loaded without textures, so the
+// icons take the placeholder path like before their download finished. Each
+// frame is NewFrame, the window, Render. The draw data is counted instead of
+// drawn. render/selection keeps the bench popup of the options window open
+// over a synthetic library of 5k builds, see SyntheticLibrary.h. The results
+// are written as JSON, see BenchResult.h. The windows come from rota_ui and
+// reach the game through HarnessUiHostType below instead of Nexus and Mumble,
+// so the harness builds on every platform. Their log messages go through
+// Logger.h and are dropped.
+
+namespace
+{
+constexpr auto TRAINING_AREA_MAP_ID = 1154u;
+constexpr auto FRAMES_PER_ROTATION_STEP = 20u;
+// Builds in the bench popup of render/selection
+constexpr auto NUM_SELECTION_FILES = size_t{5000};
+
+struct HarnessConfig
+{
+    std::filesystem::path data_path = "data";
+    std::filesystem::path build_path;
+    std::filesystem::path output_path;
+    uint32_t num_frames = 600;
+};
+
+// The training area with the player of the loaded build, no icon textures and no shell
+class HarnessUiHostType : public UiHostType
+{
+public:
+    bool is_valid_map() const override
+    {
+        return true;
+    }
+
+    bool is_in_combat() const override
+    {
+        return false;
+    }
+
+    unsigned int get_map_id() const override
+    {
+        return TRAINING_AREA_MAP_ID;
+    }
+
+    ProfessionID get_profession() const override
+    {
+        return Globals::RotationRun.meta_data.profession_id;
+    }
+
+    EliteSpecID get_elite_spec() const override
+    {
+        return Globals::RotationRun.meta_data.elite_spec_id;
+    }
+
+    std::string get_profession_name() const override
+    {
+        return profession_to_string(get_profession());
+    }
+
+    SkillIconView get_skill_icon(const int) const override
+    {
+        return SkillIconView{};
+    }
+
+    void begin_icon_draws(ImDrawList *) const override
+    {
+    }
+
+    void end_icon_draws(ImDrawList *) const override
+    {
+    }
+
+    void release_build_icons() override
+    {
+    }
+
+    void acquire_build_icons() override
+    {
+    }
+
+    void start_icon_downloads() override
+    {
+    }
+
+    std::optional<IconCacheStats> get_icon_cache_stats() const override
+    {
+        return std::nullopt;
+    }
+
+    void restart_rotation(const bool) override
+    {
+        Globals::RotationRun.restart_rotation();
+    }
+
+    void download_bench_data() override
+    {
+    }
+
+    void select_keybinds_file() override
+    {
+    }
+
+    void open_in_shell(const std::string &) override
+    {
+    }
+};
+
+struct FrameCounts
+{
+    size_t vertices = 0;
+    size_t indices = 0;
+    size_t draw_calls = 0;
+};
+
+FrameCounts get_frame_counts(const ImDrawData *draw_data)
+{
+    auto counts = FrameCounts{};
+    if (!draw_data)
+        return counts;
+
+    for (auto idx = 0; idx < draw_data->CmdListsCount; ++idx)
+    {
+        const auto *cmd_list = draw_data->CmdLists[idx];
+        counts.vertices += static_cast<size_t>(cmd_list->VtxBuffer.Size);
+        counts.indices += static_cast<size_t>(cmd_list->IdxBuffer.Size);
+        counts.draw_calls += static_cast<size_t>(cmd_list->CmdBuffer.Size);
+    }
+
+    return counts;
+}
+
+void create_headless_context()
+{
+    ImGui::CreateContext();
+
+    auto &io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    // Builds the font atlas, the pixels are never uploaded
+    io.Fonts->AddFontDefault();
+    unsigned char *pixels = nullptr;
+    auto width = 0;
+    auto height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+// Runs the frames and advances the rotation every few frames, so the rotation
+// window scrolls like during a golem run
+BenchResult run_frames(const std::string &name, const uint32_t num_frames, const std::function<void()> &render)
+{
+    auto samples = std::vector<double>{};
+    samples.reserve(num_frames);
+
+    auto total_counts = FrameCounts{};
+
+    for (auto frame_idx = uint32_t{0}; frame_idx < num_frames; ++frame_idx)
+    {
+        if (frame_idx % FRAMES_PER_ROTATION_STEP == FRAMES_PER_ROTATION_STEP - 1)
+        {
+            Globals::RotationRun.pop_bench_rotation_queue();
+            if (Globals::RotationRun.is_current_run_done())
+                Globals::RotationRun.restart_rotation();
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        ImGui::NewFrame();
+        render();
+        ImGui::Render();
+        samples.push_back(get_elapsed_ns(t0));
+
+        const auto counts = get_frame_counts(ImGui::GetDrawData());
+        total_counts.vertices += counts.vertices;
+        total_counts.indices += counts.indices;
+        total_counts.draw_calls += counts.draw_calls;
+    }
+
+    auto result = get_bench_result(name, std::move(samples), 1);
+
+    const auto frames = static_cast<double>(std::max(num_frames, uint32_t{1}));
+    result.counters = {
+        {"vertices", static_cast<double>(total_counts.vertices) / frames},
+        {"indices", static_cast<double>(total_counts.indices) / frames},
+        {"draw_calls", static_cast<double>(total_counts.draw_calls) / frames},
+    };
+
+    return result;
+}
+
+std::filesystem::path get_default_build_path(const std::vector<BenchFileInfo> &benches_files)
+{
+    auto build_paths = std::vector<std::filesystem::path>{};
+    for (const auto &file_info : benches_files)
+    {
+        if (!file_info.is_directory_header)
+            build_paths.push_back(file_info.full_path);
+    }
+
+    if (build_paths.empty())
+        return {};
+
+    return *std::min_element(build_paths.begin(), build_paths.end());
+}
+
+// Sets up the globals the windows read the way the addon does after a build was selected
+bool load_harness_data(const HarnessConfig &config)
+{
+    // No update banner, there is no addon directory to download into
+    Settings::SkipBenchFileUpdate = true;
+    Settings::ShowWindow = true;
+
+    auto &render_data = Globals::RenderData;
+    render_data.data_path = config.data_path;
+    render_data.img_path = config.data_path / "img";
+    render_data.bench_path = config.data_path / "bench";
+    render_data.builds.initialize_build_categories();
+    render_data.benches_files = get_bench_files(render_data.bench_path, render_data.builds);
+
+    render_data.selected_file_path =
+        config.build_path.empty() ? get_default_build_path(render_data.benches_files) : config.build_path;
+    if (render_data.selected_file_path.empty())
+        return false;
+
+    auto &rotation_run = Globals::RotationRun;
+    rotation_run.load_data(render_data.selected_file_path);
+    if (rotation_run.all_rotation_steps.empty())
+        return false;
+
+    render_data.current_build_key = rotation_run.meta_data.name;
+    render_data.show_rotation_window = true;
+    render_data.show_rotation_keybinds = true;
+    render_data.show_rotation_icons_overview = true;
+
+    rotation_run.get_rotation_text(render_data.keybinds,
+                                   rotation_run.meta_data.profession_id,
+                                   rotation_run.meta_data.elite_spec_id);
+    GetRotationSkills(rotation_run, *Globals::UiHost);
+    GetRotationIcons(rotation_run, *Globals::UiHost);
+
+    return true;
+}
+
+// The options window with the bench popup open over a library of 5k builds,
+// the build list of the popup follows the profession of the loaded build
+BenchResult run_selection_frames(const uint32_t num_frames)
+{
+    auto &render_data = Globals::RenderData;
+    auto &options_render = Globals::OptionsRender;
+
+    auto benches_files = get_synthetic_library(render_data.benches_files, render_data.bench_path, NUM_SELECTION_FILES);
+    std::swap(render_data.benches_files, benches_files);
+    Settings::FilterBuffer[0] = '\0';
+    options_render.open_combo_next_frame = true;
+
+    auto result = run_frames("render/selection", num_frames, [&options_render]() { options_render.render(); });
+    result.counters.emplace_back("listed", static_cast<double>(options_render.filtered_files.size()));
+
+    std::swap(render_data.benches_files, benches_files);
+    options_render.filtered_files.clear();
+
+    return result;
+}
+
+bool parse_args(const int argc, char **argv, HarnessConfig &config)
+{
+    for (auto idx = 1; idx < argc; ++idx)
+    {
+        const auto arg = std::string_view{argv[idx]};
+        const auto has_value = idx + 1 < argc;
+
+        if (arg == "--data" && has_value)
+            config.data_path = argv[++idx];
+        else if (arg == "--build" && has_value)
+            config.build_path = argv[++idx];
+        else if (arg == "--output" && has_value)
+            config.output_path = argv[++idx];
+        else if (arg == "--frames" && has_value)
+            config.num_frames = static_cast<uint32_t>(std::max(1, std::atoi(argv[++idx])));
+        else
+            return false;
+    }
+
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    auto config = HarnessConfig{};
+    if (!parse_args(argc, argv, config))
+    {
+        std::fprintf(stderr,
+                     "Usage: rota_render_harness [--data <data folder>] [--build <bench file>] [--frames <n>] "
+                     "[--output <file>]\n");
+        return 1;
+    }
+
+    create_headless_context();
+
+    auto ui_host = HarnessUiHostType{};
+    Globals::UiHost = &ui_host;
+
+    if (!load_harness_data(config))
+    {
+        std::fprintf(stderr, "No build could be loaded from %s\n", config.data_path.string().c_str());
+        Globals::UiHost = nullptr;
+        ImGui::DestroyContext();
+        return 1;
+    }
+
+    auto results = std::vector<BenchResult>{};
+
+    results.push_back(run_frames("render/rotation", config.num_frames, []() { Globals::RotationRender.render(); }));
+    results.push_back(run_frames("render/options", config.num_frames, []() { Globals::OptionsRender.render(); }));
+    results.push_back(run_frames("render/both", config.num_frames, []() {
+        Globals::OptionsRender.render();
+        Globals::RotationRender.render();
+    }));
+    results.push_back(run_selection_frames(config.num_frames));
+
+    for (const auto &result : results)
+        print_bench_result(result);
+
+    Globals::UiHost = nullptr;
+    ImGui::DestroyContext();
+
+    return write_bench_results(results, config.output_path) ? 0 : 1;
+}
@@ -0,0 +1,1591 @@
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "AllocationCounter.h"
+#include "AtlasBuilder.h"
+#include "BenchCatalog.h"
+#include "BenchResult.h"
+#include "Builds.h"
+#include "Clock.h"
+#include "DataSync.h"
+#include "Downloader.h"
+#include "FileUtils.h"
+#include "Frozen.h"
+#include "IconArchive.h"
+#include "Inflate.h"
+#include "ImageResample.h"
+#include "LogData.h"
+#include "LoopbackHttp.h"
+#include "PngDecoder.h"
+#include "Rotation.h"
+#include "RotationTable.h"
+#include "RuleMatcher.h"
+#include "Sha256.h"
+#include "SkillData.h"
+#include "StringInterner.h"
+#include "SyntheticLibrary.h"
+#include "TextureLoader.h"
+#include "Types.h"
+#include "ZipArchive.h"
+#include "ZipWriter.h"
+
+// Benchmarks of the hot paths of the core, run without the game:
+//
+//   rota_bench [--data <data folder>] [--iterations <n>] [--filter <substring>] [--output <file>]
+//
+// The results are written as JSON, see BenchResult.h. The frame cost of the
+// rotation and options windows is measured by rota_render_harness.
+
+namespace
+{
+constexpr auto CAST_INTERVAL = std::chrono::milliseconds(500);
+// A build loads up to a few hundred icons of about 4 KB
+constexpr auto NUM_DOWNLOAD_FILES = size_t{256};
+constexpr auto DOWNLOAD_FILE_SIZE = size_t{4 * 1024};
+constexpr std::array<size_t, 3> NUM_DOWNLOAD_WORKERS = {1, 4, 8};
+
+// A build loads a few hundred icons, the shipped icons show the worst case
+constexpr std::array<size_t, 2> NUM_ATLAS_ICONS = {200, SIZE_MAX};
+
+// Decode threads of the icon batch, beyond the cores of the machine the timings stay flat
+constexpr std::array<size_t, 4> NUM_DECODE_WORKERS = {1, 2, 4, 8};
+
+// Icon sizes and a full atlas page
+constexpr std::array<uint32_t, 3> RESAMPLE_SIZES = {64, 256, 2048};
+
+// Every n-th file of the bench data changes between two releases in the delta sync
+constexpr auto SYNC_DELTA_INTERVAL = size_t{10};
+
+// Builds in the bench popup of the options window
+constexpr auto NUM_SELECTION_FILES = size_t{5000};
+
+// A full InputBinds file of the game holds about 250 actions, 20k actions show the scaling
+constexpr std::array<size_t, 2> NUM_XML_ACTIONS = {250, 20000};
+
+struct BenchConfig
+{
+    std::filesystem::path data_path = "data";
+    std::filesystem::path output_path;
+    std::string filter;
+    uint32_t iterations = 3;
+};
+
+// Replays casts at a fixed interval, so the timers of the skill detection see
+// the same durations on every run no matter how fast the machine is
+class ReplayClockType final : public ClockType
+{
+public:
+    std::chrono::steady_clock::time_point now() const override
+    {
+        return time;
+    }
+
+    void advance(const std::chrono::steady_clock::duration duration)
+    {
+        time += duration;
+    }
+
+private:
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+};
+
+class BenchRunnerType
+{
+public:
+    explicit BenchRunnerType(const BenchConfig &config) : config(config)
+    {
+    }
+
+    bool is_enabled(std::string_view name) const
+    {
+        return config.filter.empty() || name.find(config.filter) != std::string_view::npos;
+    }
+
+    // Times each call of func, items is the number of elements one call handles
+    void run(const std::string &name, const uint32_t iterations, const size_t items, const std::function<void()> &func)
+    {
+        if (!is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        samples.reserve(iterations);
+
+        for (auto idx = uint32_t{0}; idx < iterations; ++idx)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            func();
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        add(get_bench_result(name, std::move(samples), items));
+    }
+
+    void add(BenchResult result)
+    {
+        print_bench_result(result);
+        results.push_back(std::move(result));
+    }
+
+    const std::vector<BenchResult> &get_results() const
+    {
+        return results;
+    }
+
+    const BenchConfig &config;
+
+private:
+    std::vector<BenchResult> results;
+};
+
+std::vector<std::filesystem::path> get_bench_file_paths(const std::filesystem::path &bench_path)
+{
+    auto paths = std::vector<std::filesystem::path>{};
+
+    auto ec = std::error_code{};
+    for (auto it = std::filesystem::recursive_directory_iterator{bench_path, ec};
+         it != std::filesystem::recursive_directory_iterator{};
+         it.increment(ec))
+    {
+        if (ec)
+            break;
+        if (it->is_regular_file() && it->path().extension() == ".json")
+            paths.push_back(it->path());
+    }
+
+    // Directory order differs between file systems, the results should not
+    std::sort(paths.begin(), paths.end());
+
+    return paths;
+}
+
+std::string get_bench_name(const std::filesystem::path &bench_path, const std::filesystem::path &file_path)
+{
+    return std::filesystem::relative(file_path, bench_path).replace_extension().generic_string();
+}
+
+void bench_build_loads(BenchRunnerType &runner, const std::vector<std::filesystem::path> &file_paths)
+{
+    const auto bench_path = runner.config.data_path / "bench";
+
+    auto rotation_run = RotationLogType{};
+
+    if (runner.is_enabled("load/all"))
+    {
+        auto total_samples = std::vector<double>{};
+
+        for (auto idx = uint32_t{0}; idx < runner.config.iterations; ++idx)
+        {
+            auto total_ns = 0.0;
+            for (const auto &file_path : file_paths)
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                rotation_run.load_data(file_path);
+                total_ns += get_elapsed_ns(t0);
+            }
+            total_samples.push_back(total_ns);
+        }
+
+        runner.add(get_bench_result("load/all", std::move(total_samples), file_paths.size()));
+    }
+
+    for (const auto &file_path : file_paths)
+    {
+        runner.run("load/" + get_bench_name(bench_path, file_path), runner.config.iterations, 1, [&]() {
+            rotation_run.load_data(file_path);
+        });
+    }
+}
+
+void bench_skill_data_map(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("skill_data_map"))
+        return;
+
+    auto skills_json = nlohmann::json{};
+    {
+        auto file = std::ifstream{runner.config.data_path / "skills" / "gw2_skills_en.json"};
+        if (!file)
+            return;
+        file >> skills_json;
+    }
+
+    runner.run("skill_data_map", runner.config.iterations * 5, skills_json.size(), [&]() {
+        auto arena = std::pmr::monotonic_buffer_resource{64 * 1024};
+        const auto skill_data_map = get_skill_data_map(skills_json, &arena);
+        (void)skill_data_map.size();
+    });
+}
+
+// Heap allocations of a build load, the arena of RotationLogType takes the maps
+// and the parse tree. The skill data map is built once into an arena and once
+// straight onto the heap.
+void bench_build_arena(BenchRunnerType &runner, const std::vector<std::filesystem::path> &file_paths)
+{
+    if (!runner.is_enabled("arena") || file_paths.empty())
+        return;
+
+    auto rotation_run = RotationLogType{};
+    const auto run_loads = [&](const std::string &name, const bool is_unload) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        auto num_allocations = size_t{0};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations; ++iteration)
+        {
+            auto total_ns = 0.0;
+            for (const auto &file_path : file_paths)
+            {
+                if (is_unload)
+                    rotation_run.load_data(file_path);
+
+                const auto allocations_before = get_num_heap_allocations();
+                const auto t0 = std::chrono::steady_clock::now();
+                if (is_unload)
+                    rotation_run.reset_rotation();
+                else
+                    rotation_run.load_data(file_path);
+                total_ns += get_elapsed_ns(t0);
+                num_allocations += get_num_heap_allocations() - allocations_before;
+            }
+            samples.push_back(total_ns);
+        }
+
+        auto result = get_bench_result(name, std::move(samples), file_paths.size());
+        result.counters = {{"allocations_per_build",
+                            static_cast<double>(num_allocations) / (runner.config.iterations * file_paths.size())}};
+        runner.add(std::move(result));
+    };
+
+    run_loads("arena/load", false);
+    run_loads("arena/unload", true);
+
+    auto skills_json = nlohmann::json{};
+    {
+        auto file = std::ifstream{runner.config.data_path / "skills" / "gw2_skills_en.json"};
+        if (!file)
+            return;
+        file >> skills_json;
+    }
+
+    const auto run_skill_data_map = [&](const std::string &name, const bool use_arena) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        auto num_allocations = size_t{0};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 5; ++iteration)
+        {
+            const auto allocations_before = get_num_heap_allocations();
+            const auto t0 = std::chrono::steady_clock::now();
+            {
+                auto arena = std::pmr::monotonic_buffer_resource{64 * 1024};
+                auto *resource = use_arena ? static_cast<std::pmr::memory_resource *>(&arena)
+                                           : std::pmr::new_delete_resource();
+                const auto skill_data_map = get_skill_data_map(skills_json, resource);
+                (void)skill_data_map.size();
+            }
+            samples.push_back(get_elapsed_ns(t0));
+            num_allocations += get_num_heap_allocations() - allocations_before;
+        }
+
+        auto result = get_bench_result(name, std::move(samples), skills_json.size());
+        result.counters = {{"allocations", static_cast<double>(num_allocations) / (runner.config.iterations * 5)}};
+        runner.add(std::move(result));
+    };
+
+    run_skill_data_map("arena/skill_data_map/arena", true);
+    run_skill_data_map("arena/skill_data_map/heap", false);
+}
+
+// Metadata reads of the catalog, once through the tail of the files and once
+// as a full parse of the whole file
+void bench_build_headers(BenchRunnerType &runner, const std::vector<std::filesystem::path> &file_paths)
+{
+    runner.run("catalog/build_header", runner.config.iterations * 10, file_paths.size(), [&]() {
+        for (const auto &file_path : file_paths)
+        {
+            auto j = nlohmann::json{};
+            (void)load_build_header_json(file_path, j);
+        }
+    });
+
+    runner.run("catalog/full_parse", runner.config.iterations * 10, file_paths.size(), [&]() {
+        for (const auto &file_path : file_paths)
+        {
+            auto j = nlohmann::json{};
+            (void)load_rotaion_json(file_path, j);
+        }
+    });
+}
+
+EvCombatDataPersistent get_cast_event(const SkillData &skill_data,
+                                      const ProfessionID profession_id,
+                                      const uint64_t event_id)
+{
+    return EvCombatDataPersistent{
+        .SrcName = {},
+        .SrcID = 0,
+        .SrcProfession = static_cast<uint32_t>(profession_id),
+        .SrcSpecialization = 0,
+        .SkillName = skill_data.name,
+        .SkillID = skill_data.skill_id,
+        .EventID = event_id,
+        .RepeatedSkill = false,
+    };
+}
+
+// Casts of a player following the rotation. Every noise_step-th cast is a
+// skill outside of the rotation and every skip_step-th step is never cast,
+// which drives the look ahead and the resynchronisation of the detection.
+std::vector<EvCombatDataPersistent> get_cast_stream(const RotationLogType &rotation_run,
+                                                    const SkillData &noise_skill,
+                                                    const size_t noise_step,
+                                                    const size_t skip_step)
+{
+    auto casts = std::vector<EvCombatDataPersistent>{};
+    casts.reserve(rotation_run.all_rotation_steps.size() * 2);
+
+    auto event_id = uint64_t{0};
+    for (auto idx = size_t{0}; idx < rotation_run.all_rotation_steps.size(); ++idx)
+    {
+        if (noise_step > 0 && idx % noise_step == noise_step - 1)
+            casts.push_back(get_cast_event(noise_skill, rotation_run.meta_data.profession_id, event_id++));
+
+        if (skip_step > 0 && idx % skip_step == skip_step - 1)
+            continue;
+
+        const auto &skill_data = rotation_run.all_rotation_steps[idx].skill_data;
+        casts.push_back(get_cast_event(skill_data, rotation_run.meta_data.profession_id, event_id++));
+    }
+
+    return casts;
+}
+
+void bench_skill_detection(BenchRunnerType &runner, const std::vector<std::filesystem::path> &file_paths)
+{
+    struct StreamKind
+    {
+        const char *name;
+        size_t noise_step;
+        size_t skip_step;
+    };
+    static constexpr StreamKind stream_kinds[] = {
+        {"in_order", 0, 0},
+        {"noise", 4, 0},
+        {"skips", 0, 5},
+    };
+
+    auto replay_clock = ReplayClockType{};
+    set_clock(&replay_clock);
+
+    auto rotation_run = RotationLogType{};
+    auto noise_skill = SkillData{};
+    noise_skill.skill_id = SkillID::UNKNOWN_SKILL;
+    noise_skill.name = "Bench Noise";
+
+    for (const auto &stream_kind : stream_kinds)
+    {
+        const auto name = std::string{"detection/"} + stream_kind.name;
+        if (!runner.is_enabled(name))
+            continue;
+
+        auto samples = std::vector<double>{};
+
+        for (const auto &file_path : file_paths)
+        {
+            rotation_run.load_data(file_path);
+            if (rotation_run.all_rotation_steps.empty())
+                continue;
+
+            const auto casts =
+                get_cast_stream(rotation_run, noise_skill, stream_kind.noise_step, stream_kind.skip_step);
+
+            for (auto idx = uint32_t{0}; idx < runner.config.iterations; ++idx)
+            {
+                rotation_run.restart_rotation();
+
+                auto num_skills_wo_match = uint32_t{0};
+                auto time_since_last_match = replay_clock.now();
+
+                for (const auto &cast : casts)
+                {
+                    replay_clock.advance(CAST_INTERVAL);
+
+                    const auto t0 = std::chrono::steady_clock::now();
+                    SkillDetectionLogic(num_skills_wo_match, time_since_last_match, rotation_run, cast);
+                    samples.push_back(get_elapsed_ns(t0));
+                }
+            }
+        }
+
+        const auto num_events = samples.size();
+        runner.add(get_bench_result(name, std::move(samples), num_events));
+    }
+
+    set_clock(nullptr);
+}
+
+// Catalog of num_files builds spread over directories of 20 files each, like
+// the bench folder after many releases
+std::vector<BenchFileInfo> get_synthetic_catalog(const std::vector<std::filesystem::path> &file_paths,
+                                                 const std::filesystem::path &bench_path,
+                                                 const size_t num_files)
+{
+    auto catalog = std::vector<BenchFileInfo>{};
+    if (file_paths.empty())
+        return catalog;
+
+    catalog.reserve(num_files + num_files / 20 + 1);
+
+    for (auto idx = size_t{0}; idx < num_files; ++idx)
+    {
+        const auto &file_path = file_paths[idx % file_paths.size()];
+        const auto directory = std::filesystem::path{"release_" + std::to_string(idx / 20)};
+
+        if (idx % 20 == 0)
+        {
+            auto &header = catalog.emplace_back(bench_path / directory, directory, true);
+            header.search_name = to_lowercase(header.display_name);
+            header.search_path = to_lowercase(header.relative_path.string());
+        }
+
+        const auto relative_path = directory / file_path.filename();
+        auto &file_info = catalog.emplace_back(bench_path / relative_path, relative_path);
+        file_info.search_name = to_lowercase(file_info.display_name);
+        file_info.search_path = to_lowercase(relative_path.string());
+    }
+
+    return catalog;
+}
+
+// The steps of every bench file as the previous array of RotationStep and as
+// columns over a shared skill table: heap size, building the table and a walk
+void bench_rotation_table(BenchRunnerType &runner, const std::vector<std::filesystem::path> &file_paths)
+{
+    if (!runner.is_enabled("rotation_table"))
+        return;
+
+    auto rotations = std::vector<RotationSteps>{};
+    auto rotation_run = RotationLogType{};
+    for (const auto &file_path : file_paths)
+    {
+        rotation_run.load_data(file_path);
+        auto &steps = rotations.emplace_back();
+        for (const auto step : rotation_run.all_rotation_steps)
+            steps.push_back(step);
+    }
+
+    auto tables = std::vector<RotationTableType>{};
+    auto num_steps = size_t{0};
+    auto aos_bytes = size_t{0};
+    auto soa_bytes = size_t{0};
+    for (const auto &steps : rotations)
+    {
+        const auto skill_table = std::make_shared<RotationSkillTableType>();
+        tables.emplace_back(steps, skill_table);
+        num_steps += steps.size();
+        aos_bytes += steps.size() * sizeof(RotationStep);
+        soa_bytes += steps.size() * (2 * sizeof(float) + sizeof(uint16_t) + sizeof(uint8_t)) +
+                     skill_table->size() * sizeof(SkillData);
+    }
+    if (num_steps == 0)
+        return;
+
+    runner.run("rotation_table/build", runner.config.iterations * 3, num_steps, [&]() {
+        for (const auto &steps : rotations)
+        {
+            const auto table = RotationTableType{steps, std::make_shared<RotationSkillTableType>()};
+            (void)table.size();
+        }
+    });
+
+    // What the rotation window reads of each step
+    constexpr auto NUM_WALKS = 200;
+    const auto run_walk = [&](const std::string &name, const auto &containers) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        auto checksum = 0.0;
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (auto walk = 0; walk < NUM_WALKS; ++walk)
+            {
+                for (const auto &container : containers)
+                {
+                    for (const RotationStepRef step : container)
+                        checksum += step.time_of_cast + step.duration_ms + step.skill_data.is_auto_attack;
+                }
+            }
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        const auto bytes = std::is_same_v<std::decay_t<decltype(containers)>, std::vector<RotationSteps>>
+                               ? aos_bytes
+                               : soa_bytes;
+        auto result = get_bench_result(name, std::move(samples), num_steps * NUM_WALKS);
+        result.counters = {{"kb", static_cast<double>(bytes) / 1024.0}, {"checksum", checksum}};
+        runner.add(std::move(result));
+    };
+
+    run_walk("rotation_table/walk/aos", rotations);
+    run_walk("rotation_table/walk/soa", tables);
+}
+
+// Skill names of every rotation step of the bench files
+std::vector<std::string> get_step_names(const std::vector<std::filesystem::path> &file_paths)
+{
+    auto names = std::vector<std::string>{};
+    auto rotation_run = RotationLogType{};
+    for (const auto &file_path : file_paths)
+    {
+        rotation_run.load_data(file_path);
+        const auto &steps = rotation_run.all_rotation_steps;
+        for (auto idx = size_t{0}; idx < steps.size(); ++idx)
+            names.push_back(steps.get_skill_data(idx).name.str());
+    }
+
+    return names;
+}
+
+// The name rules checked one std::string::find per pattern, as before the automaton
+uint32_t get_name_mask_by_find(const SkillRules &skill_rules, const std::string &name)
+{
+    const auto match_substrings = [&name](const FrozenSet<std::string_view> &patterns, const uint32_t mask) {
+        for (const auto pattern : patterns)
+        {
+            if (name.find(pattern) != std::string::npos)
+                return mask;
+        }
+        return uint32_t{0};
+    };
+    const auto match_exact = [&name](const FrozenSet<std::string_view> &patterns, const uint32_t mask) {
+        return patterns.find(name) != patterns.end() ? mask : uint32_t{0};
+    };
+
+    return match_substrings(skill_rules.skills_substr_to_drop_names, SkillRuleMask::DROP_NAME) |
+           match_exact(skill_rules.skills_match_to_drop_names, SkillRuleMask::DROP_NAME) |
+           match_substrings(skill_rules.skills_substr_weapon_swap_like, SkillRuleMask::WEAPON_SWAP_NAME) |
+           match_exact(skill_rules.skills_match_weapon_swap_like, SkillRuleMask::WEAPON_SWAP_NAME) |
+           (name.find("Unknown Skill") != std::string::npos ? SkillRuleMask::UNKNOWN_NAME : 0) |
+           match_substrings(skill_rules.special_substr_to_gray_out, SkillRuleMask::GRAY_OUT_NAME) |
+           match_exact(skill_rules.special_match_to_gray_out_names, SkillRuleMask::GRAY_OUT_NAME) |
+           match_substrings(skill_rules.special_substr_to_remove_duplicates_names, SkillRuleMask::DUPLICATE_NAME) |
+           match_substrings(skill_rules.easy_mode_names_drop_substr, SkillRuleMask::EASY_MODE_DROP_NAME);
+}
+
+// Name rules of every rotation step of the bench files
+void bench_rule_matching(BenchRunnerType &runner, const std::vector<std::filesystem::path> &file_paths)
+{
+    if (!runner.is_enabled("rules"))
+        return;
+
+    const auto names = get_step_names(file_paths);
+    if (names.empty())
+        return;
+
+    const auto &skill_rules = SkillRuleData::skill_rules;
+    const auto &matcher = SkillRuleData::skill_rule_matcher;
+
+    auto num_mismatches = size_t{0};
+    for (const auto &name : names)
+        num_mismatches += matcher.get_name_mask(name) != get_name_mask_by_find(skill_rules, name);
+
+    const auto run = [&](const std::string &name, const std::function<uint32_t(const std::string &)> &get_mask) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        auto checksum = uint32_t{0};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (const auto &step_name : names)
+                checksum += get_mask(step_name);
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        auto result = get_bench_result(name, std::move(samples), names.size());
+        result.counters = {{"mismatches", static_cast<double>(num_mismatches)}, {"checksum", checksum}};
+        runner.add(std::move(result));
+    };
+
+    run("rules/names/automaton", [&matcher](const std::string &name) { return matcher.get_name_mask(name); });
+    run("rules/names/find",
+        [&skill_rules](const std::string &name) { return get_name_mask_by_find(skill_rules, name); });
+}
+
+// Lookups of the skill tables, frozen arrays against the std containers they replaced
+void bench_frozen_tables(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("frozen"))
+        return;
+
+    const auto &cast_times = SkillRuleData::skill_cast_time_map;
+    const auto &not_tracked = SkillRuleData::skills_to_not_track;
+    const auto &gray_out = SkillRuleData::skill_rules.special_match_to_gray_out;
+
+    const auto std_cast_times = std::map<SkillID, float>{cast_times.begin(), cast_times.end()};
+    const auto std_not_tracked = std::set<SkillID>{not_tracked.begin(), not_tracked.end()};
+    const auto std_gray_out = std::set<SkillID>{gray_out.begin(), gray_out.end()};
+
+    // Every key of the tables and a miss next to each, shuffled
+    auto keys = std::vector<SkillID>{};
+    const auto add_key = [&keys](const SkillID skill_id) {
+        keys.push_back(skill_id);
+        keys.push_back(static_cast<SkillID>(static_cast<int>(skill_id) + 1));
+    };
+    for (const auto &[skill_id, cast_time] : cast_times)
+        add_key(skill_id);
+    for (const auto skill_id : not_tracked)
+        add_key(skill_id);
+    for (const auto skill_id : gray_out)
+        add_key(skill_id);
+
+    auto seed = uint32_t{1};
+    for (auto idx = keys.size(); idx > 1; --idx)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        std::swap(keys[idx - 1], keys[(seed >> 8) % idx]);
+    }
+
+    constexpr auto NUM_ROUNDS = 1000;
+    const auto run = [&](const std::string &name, const auto &get_num_hits) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        auto num_hits = size_t{0};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (auto round = 0; round < NUM_ROUNDS; ++round)
+            {
+                for (const auto skill_id : keys)
+                    num_hits += get_num_hits(skill_id);
+            }
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        auto result = get_bench_result(name, std::move(samples), keys.size() * NUM_ROUNDS);
+        result.counters = {{"hits", static_cast<double>(num_hits / (runner.config.iterations * 3 * NUM_ROUNDS))}};
+        runner.add(std::move(result));
+    };
+
+    run("frozen/lookup/frozen", [&](const SkillID skill_id) -> size_t {
+        return (cast_times.find(skill_id) != cast_times.end()) + not_tracked.contains(skill_id) +
+               gray_out.contains(skill_id);
+    });
+    run("frozen/lookup/std", [&](const SkillID skill_id) -> size_t {
+        return (std_cast_times.find(skill_id) != std_cast_times.end()) + std_not_tracked.contains(skill_id) +
+               std_gray_out.contains(skill_id);
+    });
+}
+
+// Skill names of the bench steps held as std::string and as interned handles:
+// allocations to store them and the name compares of the keybind lookup
+void bench_string_interner(BenchRunnerType &runner, const std::vector<std::filesystem::path> &file_paths)
+{
+    if (!runner.is_enabled("interner"))
+        return;
+
+    const auto names = get_step_names(file_paths);
+    if (names.empty())
+        return;
+
+    const auto run_store = [&](const std::string &name, const auto &make_names) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        auto num_allocations = size_t{0};
+        auto bytes = size_t{0};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            const auto allocations_before = get_num_heap_allocations();
+            const auto t0 = std::chrono::steady_clock::now();
+            const auto stored = make_names();
+            samples.push_back(get_elapsed_ns(t0));
+            num_allocations = get_num_heap_allocations() - allocations_before;
+            bytes = stored.size() * sizeof(stored[0]);
+        }
+
+        auto result = get_bench_result(name, std::move(samples), names.size());
+        result.counters = {{"allocations", static_cast<double>(num_allocations)},
+                           {"kb_objects", static_cast<double>(bytes) / 1024.0}};
+        runner.add(std::move(result));
+    };
+
+    run_store("interner/store/string", [&names]() {
+        auto stored = std::vector<std::string>{};
+        stored.reserve(names.size());
+        for (const auto &name : names)
+            stored.emplace_back(name);
+        return stored;
+    });
+    // The names are interned once before, as they are after the first build load
+    run_store("interner/store/interned", [&names]() {
+        auto stored = std::vector<InternedString>{};
+        stored.reserve(names.size());
+        for (const auto &name : names)
+            stored.emplace_back(name);
+        return stored;
+    });
+
+    // Three compares per step, as the slot check of get_keybind_str
+    constexpr auto NUM_ROUNDS = 50;
+    const auto run_compare = [&](const std::string &name, const auto &stored, const auto &targets) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        auto num_matches = size_t{0};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (auto round = 0; round < NUM_ROUNDS; ++round)
+            {
+                for (const auto &step_name : stored)
+                    num_matches += (step_name == targets[0]) + (step_name == targets[1]) + (step_name == targets[2]);
+            }
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        auto result = get_bench_result(name, std::move(samples), stored.size() * NUM_ROUNDS);
+        result.counters = {{"matches", static_cast<double>(num_matches / (runner.config.iterations * 3 * NUM_ROUNDS))}};
+        runner.add(std::move(result));
+    };
+
+    const auto string_names = names;
+    const auto interned_names = std::vector<InternedString>{names.begin(), names.end()};
+    const auto string_targets = std::array<std::string, 3>{names[0], names[names.size() / 2], "Weapon Swap"};
+    const auto interned_targets = std::array<InternedString, 3>{
+        InternedString{string_targets[0]}, InternedString{string_targets[1]}, InternedString{string_targets[2]}};
+
+    run_compare("interner/compare/string", string_names, string_targets);
+    run_compare("interner/compare/interned", interned_names, interned_targets);
+}
+
+void bench_file_filter(BenchRunnerType &runner, const std::vector<std::filesystem::path> &file_paths)
+{
+    const auto bench_path = runner.config.data_path / "bench";
+
+    for (const auto num_files : {size_t{1000}, size_t{10000}})
+    {
+        auto catalog = get_synthetic_catalog(file_paths, bench_path, num_files);
+        const auto suffix = "/" + std::to_string(num_files);
+
+        runner.run("filter/profession" + suffix, runner.config.iterations * 10, catalog.size(), [&]() {
+            char filter_string[50] = "";
+            const auto result = get_file_data_pairs(catalog, filter_string, "Engineer");
+            (void)result.first.size();
+        });
+
+        runner.run("filter/text" + suffix, runner.config.iterations * 10, catalog.size(), [&]() {
+            char filter_string[50] = "power";
+            const auto result = get_file_data_pairs(catalog, filter_string, "Engineer");
+            (void)result.first.size();
+        });
+    }
+}
+
+// The category lookup before the trie: a scan over the ordered cache for the
+// first build name starting with the name of the file
+BuildCategory get_build_category_by_scan(const BuildsType &builds, const std::string &display_name)
+{
+    const auto build_name = display_name.length() > 4 ? display_name.substr(4) : display_name;
+
+    if (build_name.contains("antiquary") || build_name.contains("bladesworn") || build_name.contains("mirage"))
+        return BuildCategory::RED_CROSSED;
+    if (build_name.contains("daredevil") || build_name.contains("deadeye"))
+        return BuildCategory::ORANGE_CROSSED;
+
+    for (const auto &[name, category] : builds.build_category_cache)
+    {
+        if (name.starts_with(build_name))
+            return category;
+    }
+
+    return BuildCategory::UNTESTED;
+}
+
+// The work of the bench popup besides ImGui over a library of 5k builds: the
+// category lookups and a frame of the popup without a profession from Mumble,
+// which lists every build. The labels are resolved per item like before or
+// read from the fields get_bench_files resolved. The ImGui part of the frame
+// is measured by rota_render_harness.
+void bench_selection(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("selection"))
+        return;
+
+    const auto bench_path = runner.config.data_path / "bench";
+
+    auto builds = BuildsType{};
+    builds.initialize_build_categories();
+    auto library = get_synthetic_library(get_bench_files(bench_path, builds), bench_path, NUM_SELECTION_FILES);
+
+    auto num_mismatches = size_t{0};
+    for (const auto &file_info : library)
+    {
+        if (!file_info.is_directory_header &&
+            builds.get_build_category(file_info.display_name) !=
+                get_build_category_by_scan(builds, file_info.display_name))
+            ++num_mismatches;
+    }
+
+    const auto run_categorize = [&](const std::string &name, const auto &get_category) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        auto num_untested = size_t{0};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 10; ++iteration)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            for (const auto &file_info : library)
+            {
+                if (!file_info.is_directory_header)
+                    num_untested += get_category(file_info.display_name) == BuildCategory::UNTESTED;
+            }
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        auto result = get_bench_result(name, std::move(samples), NUM_SELECTION_FILES);
+        result.counters = {{"mismatches", static_cast<double>(num_mismatches)},
+                           {"untested", static_cast<double>(num_untested)}};
+        runner.add(std::move(result));
+    };
+
+    run_categorize("selection/categorize/trie",
+                   [&builds](const std::string &display_name) { return builds.get_build_category(display_name); });
+    run_categorize("selection/categorize/scan", [&builds](const std::string &display_name) {
+        return get_build_category_by_scan(builds, display_name);
+    });
+
+    const auto run_frame = [&](const std::string &name, const auto &get_label_size) {
+        runner.run(name, runner.config.iterations * 10, library.size(), [&]() {
+            char filter_string[50] = "";
+            const auto [filtered_files, directories] = get_file_data_pairs(library, filter_string, "");
+
+            auto num_chars = size_t{0};
+            for (const auto &[original_index, file_info] : filtered_files)
+            {
+                if (!file_info->is_directory_header)
+                    num_chars += get_label_size(*file_info);
+            }
+            (void)num_chars;
+        });
+    };
+
+    run_frame("selection/frame/per_item", [&builds](const BenchFileInfo &file_info) {
+        const auto path_str = file_info.relative_path.string();
+        auto build_type_tags = std::string{};
+        if (path_str.find("dps") != std::string::npos)
+            build_type_tags = "[DPS] ";
+        else if (path_str.find("quick") != std::string::npos)
+            build_type_tags = "[Quick] ";
+        else if (path_str.find("alac") != std::string::npos)
+            build_type_tags = "[Alac] ";
+
+        if (path_str.find("power") != std::string::npos)
+            build_type_tags += "[Power] ";
+        else if (path_str.find("condition") != std::string::npos)
+            build_type_tags += "[Condi] ";
+
+        const auto category = get_build_category_by_scan(builds, file_info.display_name);
+        const auto label = format_build_name(file_info.display_name) + "##" + build_type_tags;
+        return category == BuildCategory::RED_CROSSED ? size_t{0} : label.size();
+    });
+    run_frame("selection/frame/precomputed", [](const BenchFileInfo &file_info) {
+        return file_info.category == BuildCategory::RED_CROSSED
+                   ? size_t{0}
+                   : file_info.formatted_name.size() + file_info.build_type_tags.size();
+    });
+}
+
+// Laid out like the InputBinds XML the game writes: one action per line,
+// names with spaces and entities and every other action with a secondary
+// binding
+std::string get_synthetic_keybinds_xml(const size_t num_actions)
+{
+    static constexpr const char *action_names[] = {
+        "Weapon Skill 1",
+        "Weapon Skill 2",
+        "Weapon Skill 3",
+        "Weapon Skill 4",
+        "Weapon Skill 5",
+        "Healing Skill",
+        "Utility Skill 1",
+        "Utility Skill 2",
+        "Utility Skill 3",
+        "Elite Skill",
+        "Profession Skill 1",
+        "Profession Skill 2",
+        "Profession Skill 3",
+        "Profession Skill 4",
+        "Profession Skill 5",
+        "Swap Weapons",
+        "Dodge &amp; Jump",
+    };
+
+    auto xml = std::string{"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<InputBindings>\n"};
+    for (auto idx = size_t{0}; idx < num_actions; ++idx)
+    {
+        const auto num_names = std::size(action_names);
+        const auto name = idx < num_names ? std::string{action_names[idx]} : "Action Name " + std::to_string(idx);
+
+        xml += "<action name=\"" + name + "\" device=\"Keyboard\" button=\"" + std::to_string(49 + idx % 40) +
+               "\" mod=\"" + std::to_string(idx % 3) + "\"";
+        if (idx % 2 == 0)
+            xml += " device2=\"Mouse\" button2=\"" + std::to_string(idx % 5) + "\" mod2=\"0\"";
+        xml += "/>\n";
+    }
+    xml += "</InputBindings>\n";
+
+    return xml;
+}
+
+void bench_xml_keybinds(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("keybinds"))
+        return;
+
+    for (const auto num_actions : NUM_XML_ACTIONS)
+    {
+        const auto xml = get_synthetic_keybinds_xml(num_actions);
+        const auto xml_path = std::filesystem::temp_directory_path() / "rota_bench_keybinds.xml";
+        {
+            auto file = std::ofstream{xml_path, std::ios::binary | std::ios::trunc};
+            file << xml;
+        }
+
+        const auto iterations = num_actions < 1000 ? runner.config.iterations * 100 : runner.config.iterations;
+        const auto suffix = "/" + std::to_string(num_actions);
+
+        runner.run("keybinds/parse_file" + suffix, iterations, num_actions, [&]() {
+            const auto keybinds = parse_xml_keybinds(xml_path);
+            (void)keybinds.size();
+        });
+
+        runner.run("keybinds/parse_buffer" + suffix, iterations, num_actions, [&]() {
+            const auto keybinds = parse_xml_keybinds_buffer(xml);
+            (void)keybinds.size();
+        });
+
+        auto ec = std::error_code{};
+        std::filesystem::remove(xml_path, ec);
+    }
+}
+
+// Downloads a batch of icon sized files from a loopback server, the cost of
+// the service and the transport without the network. Loopback only on POSIX.
+void bench_downloads(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("download"))
+        return;
+
+    auto server = LoopbackHttpServerType{};
+    if (!server.start())
+        return;
+
+    for (auto idx = size_t{0}; idx < NUM_DOWNLOAD_FILES; ++idx)
+    {
+        const auto body = std::string(DOWNLOAD_FILE_SIZE, static_cast<char>(idx));
+        server.set_file("/img/" + std::to_string(idx) + ".png", body);
+    }
+
+    const auto out_path = std::filesystem::temp_directory_path() / "rota_bench_downloads";
+    std::filesystem::create_directories(out_path);
+
+    for (const auto num_workers : NUM_DOWNLOAD_WORKERS)
+    {
+        const auto name = "download/loopback/" + std::to_string(num_workers);
+        if (!runner.is_enabled(name))
+            continue;
+
+        auto service = DownloadServiceType{make_loopback_transport, DownloadServiceConfig{num_workers}};
+        const auto stats_before = server.get_stats();
+
+        auto samples = std::vector<double>{};
+        auto num_failed = size_t{0};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            auto futures = std::vector<std::future<DownloadResult>>{};
+            futures.reserve(NUM_DOWNLOAD_FILES);
+
+            const auto t0 = std::chrono::steady_clock::now();
+            for (auto idx = size_t{0}; idx < NUM_DOWNLOAD_FILES; ++idx)
+            {
+                const auto file_name = std::to_string(idx) + ".png";
+                futures.push_back(service.submit(server.get_url("/img/" + file_name), out_path / file_name));
+            }
+            for (auto &future : futures)
+                num_failed += future.get().success ? 0 : 1;
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        const auto stats = server.get_stats();
+        auto result = get_bench_result(name, std::move(samples), NUM_DOWNLOAD_FILES);
+
+        const auto bytes = static_cast<double>(NUM_DOWNLOAD_FILES * DOWNLOAD_FILE_SIZE);
+        result.counters = {
+            {"mb_per_s", bytes / result.median_ns * 1e9 / (1024.0 * 1024.0)},
+            {"files_per_s", static_cast<double>(NUM_DOWNLOAD_FILES) / result.median_ns * 1e9},
+            {"threads", static_cast<double>(service.get_num_workers())},
+            {"connections", static_cast<double>(stats.num_connections - stats_before.num_connections)},
+            {"failed", static_cast<double>(num_failed)},
+        };
+        runner.add(std::move(result));
+    }
+
+    auto ec = std::error_code{};
+    std::filesystem::remove_all(out_path, ec);
+}
+
+// Evicts the file from the page cache so that the next read hits the disk,
+// only possible on POSIX
+bool evict_from_page_cache(const std::filesystem::path &path)
+{
+#ifndef _WIN32
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    const auto success = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    ::close(fd);
+    return success;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+// All icons of data/img once from their PNGs and once from the packed archive.
+// The warm runs read from the page cache, the cold runs evict the files first.
+void bench_data_sync(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("sync"))
+        return;
+
+    auto server = LoopbackHttpServerType{};
+    if (!server.start())
+        return;
+
+    // The bench data and skills served like the data folder of a release tag
+    auto manifest = DataManifest{};
+    manifest.base_url = server.get_url("/data/");
+    for (const auto *folder : {"bench", "skills"})
+    {
+        for (const auto &entry : std::filesystem::recursive_directory_iterator{runner.config.data_path / folder})
+        {
+            if (!entry.is_regular_file())
+                continue;
+
+            auto file = std::ifstream{entry.path(), std::ios::binary};
+            auto content = std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+            auto sha256 = Sha256Type{};
+            sha256.update(reinterpret_cast<const uint8_t *>(content.data()), content.size());
+
+            const auto path = std::filesystem::relative(entry.path(), runner.config.data_path).generic_string();
+            manifest.files.push_back(DataManifestFile{path, content.size(), sha256_to_hex(sha256.finalize())});
+            server.set_file(get_data_file_url("/data/", path), std::move(content));
+        }
+    }
+
+    const auto out_path = std::filesystem::temp_directory_path() / "rota_bench_sync";
+    const auto run = [&](const std::string &name, const std::function<void()> &prepare) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto service = DownloadServiceType{make_loopback_transport, DownloadServiceConfig{4}};
+        auto samples = std::vector<double>{};
+        auto stats = DataSyncStats{};
+        const auto stats_before = server.get_stats();
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations; ++iteration)
+        {
+            prepare();
+
+            // Hashing the local files is part of every sync
+            const auto t0 = std::chrono::steady_clock::now();
+            stats = sync_data_files(service, manifest, get_outdated_data_files(manifest, out_path), out_path);
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        const auto num_requests = server.get_stats().num_requests - stats_before.num_requests;
+        auto result = get_bench_result(name, std::move(samples), stats.num_files);
+        result.counters = {
+            {"mb_downloaded", static_cast<double>(stats.bytes_downloaded) / (1024.0 * 1024.0)},
+            {"files_downloaded", static_cast<double>(stats.num_updated)},
+            {"requests", static_cast<double>(num_requests) / runner.config.iterations},
+            {"failed", static_cast<double>(stats.num_failed)},
+        };
+        runner.add(std::move(result));
+    };
+
+    run("sync/loopback/full", [&]() {
+        auto ec = std::error_code{};
+        std::filesystem::remove_all(out_path, ec);
+    });
+    run("sync/loopback/delta", [&]() {
+        for (auto idx = size_t{0}; idx < manifest.files.size(); idx += SYNC_DELTA_INTERVAL)
+        {
+            const auto path = get_zip_entry_path(out_path, manifest.files[idx].path);
+            std::filesystem::create_directories(path.parent_path());
+            auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+            file << "outdated";
+        }
+    });
+
+    auto ec = std::error_code{};
+    std::filesystem::remove_all(out_path, ec);
+}
+
+// The shipped icons named by their icon id, sorted by id
+std::vector<ImageDecodeRequest> get_icon_requests(const std::filesystem::path &img_path)
+{
+    auto requests = std::vector<ImageDecodeRequest>{};
+    for (const auto &entry : std::filesystem::directory_iterator{img_path})
+    {
+        const auto stem = entry.path().stem().string();
+        if (entry.path().extension() == ".png" && !stem.empty() &&
+            std::all_of(stem.begin(), stem.end(), [](const char c) { return c >= '0' && c <= '9'; }))
+            requests.push_back(ImageDecodeRequest{std::stoi(stem), entry.path()});
+    }
+    std::sort(requests.begin(), requests.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.icon_id < rhs.icon_id;
+    });
+
+    return requests;
+}
+
+// Catalog scan of a bench folder of num_files copies of the shipped builds in
+// release directories of 20 files each. The warm runs read from the page cache, the
+// cold runs evict the files first, both start from an empty catalog.
+void bench_catalog_scan(BenchRunnerType &runner,
+                        const std::vector<std::filesystem::path> &file_paths,
+                        const size_t num_files)
+{
+    const auto prefix = "catalog/scan/" + std::to_string(num_files);
+    if (!runner.is_enabled(prefix + "/warm") && !runner.is_enabled(prefix + "/cold"))
+        return;
+
+    const auto bench_path = std::filesystem::temp_directory_path() / "rota_bench_catalog" / "bench";
+    auto ec = std::error_code{};
+    std::filesystem::remove_all(bench_path.parent_path(), ec);
+
+    auto copied_paths = std::vector<std::filesystem::path>{};
+    copied_paths.reserve(num_files);
+    auto bytes = uintmax_t{0};
+    for (auto idx = size_t{0}; idx < num_files; ++idx)
+    {
+        // The role and damage folders stay in the path, like in the release folders
+        const auto &file_path = file_paths[idx % file_paths.size()];
+        const auto relative_path = file_path.lexically_relative(runner.config.data_path / "bench");
+        auto &copied_path =
+            copied_paths.emplace_back(bench_path / ("release_" + std::to_string(idx / 20)) / relative_path);
+        std::filesystem::create_directories(copied_path.parent_path(), ec);
+        if (!std::filesystem::copy_file(file_path, copied_path, ec))
+            return;
+        bytes += std::filesystem::file_size(copied_path, ec);
+    }
+
+    const auto run = [&](const std::string &name, const bool is_cold) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations; ++iteration)
+        {
+            if (is_cold)
+            {
+                auto evicted = true;
+                for (const auto &copied_path : copied_paths)
+                    evicted = evict_from_page_cache(copied_path) && evicted;
+                if (!evicted)
+                    return;
+            }
+
+            auto catalog = BenchCatalogType{};
+            const auto t0 = std::chrono::steady_clock::now();
+            (void)catalog.refresh(bench_path);
+            samples.push_back(get_elapsed_ns(t0));
+
+            if (catalog.files.size() != num_files)
+                return;
+        }
+
+        auto result = get_bench_result(name, std::move(samples), num_files);
+        result.counters = {
+            {"threads", static_cast<double>(std::thread::hardware_concurrency())},
+            {"mb_on_disk", static_cast<double>(bytes) / (1024.0 * 1024.0)},
+        };
+        runner.add(std::move(result));
+    };
+
+    run(prefix + "/warm", false);
+    run(prefix + "/cold", true);
+
+    std::filesystem::remove_all(bench_path.parent_path(), ec);
+}
+
+void bench_icon_loading(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("icons"))
+        return;
+
+    const auto img_path = runner.config.data_path / "img";
+    auto requests = std::vector<ImageDecodeRequest>{};
+    auto png_bytes = uintmax_t{0};
+    for (const auto &entry : std::filesystem::directory_iterator{img_path})
+    {
+        const auto stem = entry.path().stem().string();
+        if (entry.path().extension() != ".png" || stem.empty() ||
+            !std::all_of(stem.begin(), stem.end(), [](const char c) { return c >= '0' && c <= '9'; }))
+            continue;
+
+        requests.push_back(ImageDecodeRequest{std::stoi(stem), entry.path()});
+        png_bytes += entry.file_size();
+    }
+    if (requests.empty())
+        return;
+
+    const auto archive_path = std::filesystem::temp_directory_path() / "rota_bench_icons.pack";
+    const auto png_factory = make_png_decoder_factory(nullptr);
+    const auto num_workers = static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()));
+
+    runner.run("icons/archive/build", runner.config.iterations, requests.size(), [&]() {
+        (void)write_icon_archive(img_path, archive_path, png_factory, num_workers);
+    });
+    if (!std::filesystem::exists(archive_path))
+        (void)write_icon_archive(img_path, archive_path, png_factory, num_workers);
+
+    const auto archive_bytes = std::filesystem::file_size(archive_path);
+
+    const auto decode_pngs = [&]() {
+        const auto icons = decode_image_batch(requests, png_factory, 1);
+        (void)icons.size();
+    };
+    const auto decode_archive = [&]() {
+        auto archive = IconArchiveType{};
+        (void)open_current_icon_archive(archive, archive_path, img_path);
+        const auto icons = decode_image_batch(requests, make_archive_decoder_factory(archive, nullptr), 1);
+        (void)icons.size();
+    };
+
+    const auto run = [&](const std::string &name,
+                         const bool is_cold,
+                         const uintmax_t bytes,
+                         const std::function<void()> &func) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            if (is_cold)
+            {
+                auto evicted = evict_from_page_cache(archive_path);
+                for (const auto &request : requests)
+                    evicted = evict_from_page_cache(request.path) && evicted;
+                if (!evicted)
+                    return;
+            }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            func();
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        auto result = get_bench_result(name, std::move(samples), requests.size());
+        result.counters = {{"mb_read", static_cast<double>(bytes) / (1024.0 * 1024.0)}};
+        runner.add(std::move(result));
+    };
+
+    run("icons/png/warm", false, png_bytes, decode_pngs);
+    run("icons/archive/warm", false, archive_bytes, decode_archive);
+    run("icons/png/cold", true, png_bytes, decode_pngs);
+    run("icons/archive/cold", true, archive_bytes, decode_archive);
+
+    auto ec = std::error_code{};
+    std::filesystem::remove(archive_path, ec);
+}
+
+void bench_decode_batch(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("decode"))
+        return;
+
+    const auto requests = get_icon_requests(runner.config.data_path / "img");
+    if (requests.empty())
+        return;
+
+    // Warm page cache, so the timings show the decode work split across the workers
+    const auto png_factory = make_png_decoder_factory(nullptr);
+    (void)decode_image_batch(requests, png_factory, 1).size();
+
+    for (const auto num_workers : NUM_DECODE_WORKERS)
+    {
+        const auto name = "decode/batch/" + std::to_string(num_workers);
+        if (!runner.is_enabled(name))
+            continue;
+
+        auto samples = std::vector<double>{};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            const auto icons = decode_image_batch(requests, png_factory, num_workers);
+            samples.push_back(get_elapsed_ns(t0));
+            (void)icons.size();
+        }
+
+        auto result = get_bench_result(name, std::move(samples), requests.size());
+        result.counters = {{"workers", static_cast<double>(num_workers)},
+                           {"cores", static_cast<double>(std::thread::hardware_concurrency())}};
+        runner.add(std::move(result));
+    }
+}
+
+void bench_resample(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("resample"))
+        return;
+
+    for (const auto size : RESAMPLE_SIZES)
+    {
+        auto image = DecodedImage{};
+        image.width = size;
+        image.height = size;
+        image.pixels.resize(static_cast<size_t>(size) * size * 4);
+        auto seed = uint32_t{1};
+        for (auto &byte : image.pixels)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            byte = static_cast<uint8_t>(seed >> 24);
+        }
+
+        // Enough halvings of small images for a stable timing
+        const auto repeats = std::max(uint32_t{1}, (2048u / size) * (2048u / size) / 16);
+        const auto num_pixels = static_cast<size_t>(size) * size / 4 * repeats;
+        const auto suffix = std::to_string(size);
+
+        runner.run("resample/half/sse2/" + suffix, runner.config.iterations * 3, num_pixels, [&]() {
+            for (auto idx = uint32_t{0}; idx < repeats; ++idx)
+                (void)downscale_half(image).pixels.size();
+        });
+        runner.run("resample/half/scalar/" + suffix, runner.config.iterations * 3, num_pixels, [&]() {
+            for (auto idx = uint32_t{0}; idx < repeats; ++idx)
+                (void)downscale_half_scalar(image).pixels.size();
+        });
+    }
+}
+
+void bench_icon_atlas(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("atlas"))
+        return;
+
+    const auto requests = get_icon_requests(runner.config.data_path / "img");
+    auto icons = std::vector<DecodedIcon>{};
+    for (auto &icon : decode_image_batch(requests, make_png_decoder_factory(nullptr), 1))
+    {
+        if (icon.success)
+            icons.push_back(std::move(icon));
+    }
+
+    for (const auto max_icons : NUM_ATLAS_ICONS)
+    {
+        const auto num_icons = std::min(max_icons, icons.size());
+        const auto name = "atlas/build/" + std::to_string(num_icons);
+        if (num_icons == 0 || !runner.is_enabled(name))
+            continue;
+
+        // Packing and the page mips, as on the atlas thread. The icon copies are
+        // made outside of the timing, the atlas gets them from the texture loader.
+        auto samples = std::vector<double>{};
+        auto builder = AtlasBuilderType{};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations; ++iteration)
+        {
+            builder.clear();
+            for (auto idx = size_t{0}; idx < num_icons; ++idx)
+                builder.add(icons[idx].icon_id, icons[idx].image);
+
+            const auto t0 = std::chrono::steady_clock::now();
+            (void)builder.build();
+            builder.generate_page_mips();
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        auto page_bytes = size_t{0};
+        for (const auto &page : builder.get_pages())
+            page_bytes += get_image_bytes(page);
+
+        auto result = get_bench_result(name, std::move(samples), num_icons);
+        result.counters = {{"fill_ratio", builder.get_fill_ratio()},
+                           {"pages", static_cast<double>(builder.get_pages().size())},
+                           {"page_mb", static_cast<double>(page_bytes) / (1024.0 * 1024.0)}};
+        runner.add(std::move(result));
+    }
+}
+
+void bench_zip_extract(BenchRunnerType &runner)
+{
+    if (!runner.is_enabled("zip"))
+        return;
+
+    // The bench data as it ships in the release ZIP
+    auto entries = std::vector<ZipWriterEntry>{};
+    auto unpacked_bytes = uintmax_t{0};
+    for (const auto &entry : std::filesystem::recursive_directory_iterator{runner.config.data_path / "bench"})
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        auto file = std::ifstream{entry.path(), std::ios::binary};
+        auto content = std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+        unpacked_bytes += content.size();
+        const auto name = std::filesystem::relative(entry.path(), runner.config.data_path).generic_string();
+        entries.push_back(ZipWriterEntry{name, std::move(content), true});
+    }
+
+    const auto temp_path = std::filesystem::temp_directory_path() / "rota_bench_zip";
+    const auto zip_path = temp_path / "bench.zip";
+    std::filesystem::create_directories(temp_path);
+    if (entries.empty() || !write_zip(zip_path, entries))
+        return;
+
+    const auto to_mb_per_s = [unpacked_bytes](const BenchResult &result) {
+        return static_cast<double>(unpacked_bytes) / (1024.0 * 1024.0) / (result.median_ns * 1e-9);
+    };
+
+    const auto run = [&](const std::string &name, const std::function<void()> &func) {
+        if (!runner.is_enabled(name))
+            return;
+
+        auto samples = std::vector<double>{};
+        for (auto iteration = uint32_t{0}; iteration < runner.config.iterations * 3; ++iteration)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            func();
+            samples.push_back(get_elapsed_ns(t0));
+        }
+
+        auto result = get_bench_result(name, std::move(samples), entries.size());
+        result.counters = {{"mb_per_s", to_mb_per_s(result)},
+                           {"mb_unpacked", static_cast<double>(unpacked_bytes) / (1024.0 * 1024.0)}};
+        runner.add(std::move(result));
+    };
+
+    // Decoding alone, then the full extraction with CRC checks and atomic renames
+    auto compressed = std::vector<std::string>{};
+    for (const auto &entry : entries)
+        compressed.push_back(deflate_fixed(entry.content));
+
+    run("zip/inflate", [&]() {
+        for (const auto &data : compressed)
+            (void)inflate_raw(reinterpret_cast<const uint8_t *>(data.data()),
+                              data.size(),
+                              [](const uint8_t *, const size_t) { return true; });
+    });
+    run("zip/extract", [&]() {
+        auto archive = ZipArchiveType{};
+        if (archive.open(zip_path) == ZipStatus::OK)
+            (void)archive.extract_all(temp_path / "out");
+    });
+
+    auto ec = std::error_code{};
+    std::filesystem::remove_all(temp_path, ec);
+}
+
+bool parse_args(const int argc, char **argv, BenchConfig &config)
+{
+    for (auto idx = 1; idx < argc; ++idx)
+    {
+        const auto arg = std::string_view{argv[idx]};
+        const auto has_value = idx + 1 < argc;
+
+        if (arg == "--data" && has_value)
+            config.data_path = argv[++idx];
+        else if (arg == "--output" && has_value)
+            config.output_path = argv[++idx];
+        else if (arg == "--filter" && has_value)
+            config.filter = argv[++idx];
+        else if (arg == "--iterations" && has_value)
+            config.iterations = static_cast<uint32_t>(std::max(1, std::atoi(argv[++idx])));
+        else
+            return false;
+    }
+
+    return true;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    auto config = BenchConfig{};
+    if (!parse_args(argc, argv, config))
+    {
+        std::fprintf(stderr,
+                     "Usage: rota_bench [--data <data folder>] [--iterations <n>] [--filter <substring>] "
+                     "[--output <file>]\n");
+        return 1;
+    }
+
+    const auto file_paths = get_bench_file_paths(config.data_path / "bench");
+    if (file_paths.empty())
+    {
+        std::fprintf(stderr, "No bench files found in %s\n", (config.data_path / "bench").string().c_str());
+        return 1;
+    }
+
+    auto runner = BenchRunnerType{config};
+
+    bench_build_loads(runner, file_paths);
+    bench_skill_data_map(runner);
+    bench_build_arena(runner, file_paths);
+    bench_build_headers(runner, file_paths);
+    bench_skill_detection(runner, file_paths);
+    bench_rotation_table(runner, file_paths);
+    bench_rule_matching(runner, file_paths);
+    bench_frozen_tables(runner);
+    bench_string_interner(runner, file_paths);
+    bench_file_filter(runner, file_paths);
+    bench_selection(runner);
+    bench_xml_keybinds(runner);
+    bench_downloads(runner);
+    bench_data_sync(runner);
+    bench_catalog_scan(runner, file_paths, 5000);
+    bench_icon_loading(runner);
+    bench_icon_atlas(runner);
+    bench_decode_batch(runner);
+    bench_resample(runner);
+    bench_zip_extract(runner);
+
+    return write_bench_results(runner.get_results(), config.output_path) ? 0 : 1;
+}
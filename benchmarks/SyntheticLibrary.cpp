@@ -0,0 +1,48 @@
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "FileUtils.h"
+#include "Types.h"
+
+#include "SyntheticLibrary.h"
+
+std::vector<BenchFileInfo> get_synthetic_library(const std::vector<BenchFileInfo> &benches_files,
+                                                 const std::filesystem::path &bench_path,
+                                                 const size_t num_files)
+{
+    auto builds = std::vector<const BenchFileInfo *>{};
+    for (const auto &file_info : benches_files)
+    {
+        if (!file_info.is_directory_header)
+            builds.push_back(&file_info);
+    }
+
+    auto library = std::vector<BenchFileInfo>{};
+    if (builds.empty())
+        return library;
+
+    library.reserve(num_files + num_files / 20 + 1);
+
+    for (auto idx = size_t{0}; idx < num_files; ++idx)
+    {
+        const auto directory = std::filesystem::path{"release_" + std::to_string(idx / 20)};
+
+        if (idx % 20 == 0)
+        {
+            auto &header = library.emplace_back(bench_path / directory, directory, true);
+            header.search_name = to_lowercase(header.display_name);
+            header.search_path = to_lowercase(header.relative_path.string());
+        }
+
+        // The role and damage folders stay in the path, the filters and tags read them
+        const auto &build = *builds[idx % builds.size()];
+        auto &file_info = library.emplace_back(build);
+        file_info.relative_path = directory / build.relative_path;
+        file_info.full_path = bench_path / file_info.relative_path;
+        file_info.search_path = to_lowercase(file_info.relative_path.string());
+    }
+
+    return library;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+#include "Types.h"
+
+// Bench library of num_files builds in directories of 20 files each, like the
+// bench folder after many releases. The builds are copies of the resolved
+// entries of get_bench_files, so names, categories and build infos are real.
+std::vector<BenchFileInfo> get_synthetic_library(const std::vector<BenchFileInfo> &benches_files,
+                                                 const std::filesystem::path &bench_path,
+                                                 const size_t num_files);
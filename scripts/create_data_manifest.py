@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""
+Write the content-hash manifest of the bench data for delta updates.
+
+The manifest is published next to GW2RotaHelper.zip in the release. The addon
+compares it with the hashes of its local files and downloads only the files
+that changed, each from base_url + path.
+
+The addon fetches the manifest of the latest release, so base_url points at
+the data folder of that release tag and not at main. Otherwise a commit to
+main changes the files behind the hashes and every delta download fails. The
+POST_BUILD step of GW2RotaHelper writes bin/<config>/manifest.json for the
+tag of src/Version.h, which is uploaded together with the ZIP.
+
+Layout:
+    {
+        "version": 1,
+        "base_url": "https://.../data/",
+        "files": [{"path": "bench/...", "size": 123, "sha256": "<hex>"}, ...]
+    }
+"""
+
+import argparse
+import hashlib
+import json
+import sys
+from pathlib import Path
+
+from create_version_file import read_version_from_header
+
+
+MANIFEST_VERSION = 1
+BASE_URL_TEMPLATE = "https://raw.githubusercontent.com/franneck94/GW2_RotaHelper/{tag}/data/"
+DEFAULT_VERSION_HEADER = Path(__file__).resolve().parent.parent / "src" / "Version.h"
+DEFAULT_FOLDERS = ("bench", "img", "skills")
+EXCLUDED_SUFFIXES = (".log", ".pack")
+
+
+def hash_file(
+    path: Path,
+) -> str:
+    sha256 = hashlib.sha256()
+    with path.open("rb") as file:
+        for chunk in iter(lambda: file.read(1024 * 1024), b""):
+            sha256.update(chunk)
+    return sha256.hexdigest()
+
+
+def get_release_tag(
+    header_path: Path,
+) -> str:
+    """Release tags follow the changelog headings, MAJOR.MINOR.BUILD."""
+    version = read_version_from_header(header_path)
+    return ".".join(version.split(".")[:3])
+
+
+def collect_files(
+    data_dir: Path,
+    folders: list[str],
+) -> list[dict]:
+    files = []
+    for folder in folders:
+        folder_path = data_dir / folder
+        if not folder_path.is_dir():
+            print(f"Warning: Skipping missing folder: {folder_path}")
+            continue
+
+        for path in sorted(folder_path.rglob("*")):
+            if not path.is_file() or path.suffix in EXCLUDED_SUFFIXES:
+                continue
+
+            files.append(
+                {
+                    "path": path.relative_to(data_dir).as_posix(),
+                    "size": path.stat().st_size,
+                    "sha256": hash_file(path),
+                }
+            )
+
+    return files
+
+
+def main() -> int:
+    """Main function with CLI interface."""
+    parser = argparse.ArgumentParser(
+        description="Create the content-hash manifest of the bench data",
+    )
+    parser.add_argument(
+        "--data-dir",
+        type=Path,
+        default=Path("data"),
+        help="Folder laid out like the addon directory (default: data)",
+    )
+    parser.add_argument(
+        "--output",
+        "-o",
+        type=Path,
+        default=Path("manifest.json"),
+        help="Manifest to write (default: manifest.json)",
+    )
+    parser.add_argument(
+        "--tag",
+        help="Release tag the files are served from (default: MAJOR.MINOR.BUILD of --version-header)",
+    )
+    parser.add_argument(
+        "--version-header",
+        type=Path,
+        default=DEFAULT_VERSION_HEADER,
+        help="Version.h to take the release tag from (default: src/Version.h)",
+    )
+    parser.add_argument(
+        "--base-url",
+        help="URL the manifest paths are relative to, overrides --tag",
+    )
+    parser.add_argument(
+        "--folders",
+        nargs="+",
+        default=list(DEFAULT_FOLDERS),
+        help="Folders below the data folder to include (default: bench img skills)",
+    )
+
+    args = parser.parse_args()
+
+    if not args.data_dir.is_dir():
+        print(f"Error: Data folder does not exist: {args.data_dir}")
+        return 1
+
+    if args.base_url:
+        base_url = args.base_url
+    else:
+        tag = args.tag or get_release_tag(args.version_header)
+        base_url = BASE_URL_TEMPLATE.format(tag=tag)
+    base_url = base_url if base_url.endswith("/") else base_url + "/"
+    files = collect_files(args.data_dir, args.folders)
+
+    manifest = {
+        "version": MANIFEST_VERSION,
+        "base_url": base_url,
+        "files": files,
+    }
+    args.output.write_text(json.dumps(manifest, indent=2) + "\n", encoding="utf-8")
+
+    total_size = sum(entry["size"] for entry in files)
+    print(f"Wrote {len(files)} files ({total_size / (1024 * 1024):.1f} MiB) to {args.output}")
+    print(f"Files are served from {base_url}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,357 @@
+#!/usr/bin/env python3
+"""
+Pack the skill icon PNGs into a single pre-decoded icon archive.
+
+The archive holds an index sorted by icon id followed by RGBA8 pixel payloads,
+so the addon can memory-map it and upload icons without decoding PNGs.
+Icons missing from the archive are still loaded from the loose PNG files.
+The header stores count, total size and newest mtime of the <icon_id>.png
+files, the addon ignores and rebuilds an archive that no longer matches them.
+
+Layout (little endian):
+    header:  magic "GRHI", version u32, entry count u32, flags u32,
+             source file count u32, reserved u32, source total size u64,
+             source max mtime i64 (seconds since the Unix epoch)
+    entries: icon id i32, width u16, height u16, levels u16, reserved u16,
+             payload offset u64, payload size u32
+    payload: per entry the full size image followed by its downscaled
+             levels, every level tightly packed RGBA8, 16 byte aligned
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+ARCHIVE_MAGIC = b"GRHI"
+ARCHIVE_VERSION = 2
+HEADER_FORMAT = "<4sIIIIIQq"
+ENTRY_FORMAT = "<iHHHHQI"
+PAYLOAD_ALIGNMENT = 16
+
+CHANNELS_BY_COLOR_TYPE = {
+    0: 1,  # Grayscale
+    2: 3,  # RGB
+    3: 1,  # Palette
+    4: 2,  # Grayscale + alpha
+    6: 4,  # RGBA
+}
+
+
+class PngError(Exception):
+    """Raised for PNG files the packer cannot decode."""
+
+
+def paeth_predictor(left: int, up: int, up_left: int) -> int:
+    """Return the PNG Paeth predictor of the three neighbour bytes."""
+    estimate = left + up - up_left
+    dist_left = abs(estimate - left)
+    dist_up = abs(estimate - up)
+    dist_up_left = abs(estimate - up_left)
+
+    if dist_left <= dist_up and dist_left <= dist_up_left:
+        return left
+    if dist_up <= dist_up_left:
+        return up
+    return up_left
+
+
+def unfilter_scanlines(raw: bytes, width: int, height: int, bpp: int) -> bytearray:
+    """Undo the per scanline PNG filters.
+
+    Args:
+        raw: Inflated image data including the filter type bytes
+        width: Image width in pixels
+        height: Image height in pixels
+        bpp: Bytes per pixel
+
+    Returns:
+        The unfiltered pixel rows without filter bytes
+    """
+    stride = width * bpp
+    pixels = bytearray(stride * height)
+    previous = bytearray(stride)
+
+    pos = 0
+    for row in range(height):
+        filter_type = raw[pos]
+        line = bytearray(raw[pos + 1 : pos + 1 + stride])
+        pos += stride + 1
+
+        if filter_type == 1:
+            for i in range(bpp, stride):
+                line[i] = (line[i] + line[i - bpp]) & 0xFF
+        elif filter_type == 2:
+            for i in range(stride):
+                line[i] = (line[i] + previous[i]) & 0xFF
+        elif filter_type == 3:
+            for i in range(stride):
+                left = line[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + ((left + previous[i]) >> 1)) & 0xFF
+        elif filter_type == 4:
+            for i in range(stride):
+                left = line[i - bpp] if i >= bpp else 0
+                up_left = previous[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + paeth_predictor(left, previous[i], up_left)) & 0xFF
+        elif filter_type != 0:
+            msg = f"Unknown filter type {filter_type}"
+            raise PngError(msg)
+
+        pixels[row * stride : (row + 1) * stride] = line
+        previous = line
+
+    return pixels
+
+
+def get_color_key(color_type: int, transparency: bytes) -> bytes | None:
+    """Color of the tRNS chunk of gray and RGB images, 16 bit samples of which an 8 bit image uses the low byte."""
+    if color_type == 0 and len(transparency) >= 2 and transparency[0] == 0:
+        return transparency[1:2]
+    if color_type == 2 and len(transparency) >= 6 and transparency[0] == transparency[2] == transparency[4] == 0:
+        return bytes((transparency[1], transparency[3], transparency[5]))
+    return None
+
+
+def to_rgba(pixels: bytearray, color_type: int, palette: bytes, transparency: bytes) -> bytes:
+    """Expand 8 bit PNG pixels of any color type to RGBA8."""
+    if color_type == 6:
+        return bytes(pixels)
+
+    color_key = get_color_key(color_type, transparency)
+    rgba = bytearray()
+    if color_type == 2:
+        for i in range(0, len(pixels), 3):
+            rgb = pixels[i : i + 3]
+            rgba += rgb
+            rgba.append(0 if rgb == color_key else 0xFF)
+    elif color_type == 0:
+        for value in pixels:
+            alpha = 0 if color_key is not None and value == color_key[0] else 0xFF
+            rgba += bytes((value, value, value, alpha))
+    elif color_type == 4:
+        for i in range(0, len(pixels), 2):
+            value = pixels[i]
+            rgba += bytes((value, value, value, pixels[i + 1]))
+    elif color_type == 3:
+        for index in pixels:
+            alpha = transparency[index] if index < len(transparency) else 0xFF
+            rgba += palette[index * 3 : index * 3 + 3]
+            rgba.append(alpha)
+
+    return bytes(rgba)
+
+
+def decode_png(data: bytes) -> tuple[int, int, bytes]:
+    """Decode a non interlaced 8 bit PNG into RGBA8 pixels.
+
+    Args:
+        data: Content of the PNG file
+
+    Returns:
+        Width, height and the RGBA8 pixels
+    """
+    if not data.startswith(PNG_SIGNATURE):
+        msg = "Not a PNG file"
+        raise PngError(msg)
+
+    pos = len(PNG_SIGNATURE)
+    header = None
+    palette = b""
+    transparency = b""
+    compressed = bytearray()
+
+    while pos + 8 <= len(data):
+        length, chunk_type = struct.unpack(">I4s", data[pos : pos + 8])
+        chunk = data[pos + 8 : pos + 8 + length]
+        pos += 12 + length
+
+        if chunk_type == b"IHDR":
+            header = struct.unpack(">IIBBBBB", chunk)
+        elif chunk_type == b"PLTE":
+            palette = chunk
+        elif chunk_type == b"tRNS":
+            transparency = chunk
+        elif chunk_type == b"IDAT":
+            compressed += chunk
+        elif chunk_type == b"IEND":
+            break
+
+    if header is None:
+        msg = "Missing IHDR chunk"
+        raise PngError(msg)
+
+    width, height, bit_depth, color_type, _, _, interlace = header
+    if bit_depth != 8 or interlace != 0 or color_type not in CHANNELS_BY_COLOR_TYPE:
+        msg = f"Unsupported PNG format (depth {bit_depth}, color type {color_type}, interlace {interlace})"
+        raise PngError(msg)
+
+    bpp = CHANNELS_BY_COLOR_TYPE[color_type]
+    pixels = unfilter_scanlines(zlib.decompress(compressed), width, height, bpp)
+
+    return width, height, to_rgba(pixels, color_type, palette, transparency)
+
+
+def downscale_rgba(pixels: bytes, width: int, height: int) -> tuple[int, int, bytes]:
+    """Halve an RGBA8 image with a 2x2 box filter."""
+    new_width = max(1, width // 2)
+    new_height = max(1, height // 2)
+    result = bytearray(new_width * new_height * 4)
+
+    for y in range(new_height):
+        y0 = min(2 * y, height - 1)
+        y1 = min(2 * y + 1, height - 1)
+        for x in range(new_width):
+            x0 = min(2 * x, width - 1)
+            x1 = min(2 * x + 1, width - 1)
+            for channel in range(4):
+                total = (
+                    pixels[(y0 * width + x0) * 4 + channel]
+                    + pixels[(y0 * width + x1) * 4 + channel]
+                    + pixels[(y1 * width + x0) * 4 + channel]
+                    + pixels[(y1 * width + x1) * 4 + channel]
+                )
+                result[(y * new_width + x) * 4 + channel] = (total + 2) >> 2
+
+    return new_width, new_height, bytes(result)
+
+
+def build_levels(width: int, height: int, pixels: bytes, num_levels: int) -> tuple[int, bytes]:
+    """Return the number of levels and the concatenated level payload."""
+    payload = bytearray(pixels)
+    levels = 1
+
+    while levels < num_levels and (width > 1 or height > 1):
+        width, height, pixels = downscale_rgba(pixels, width, height)
+        payload += pixels
+        levels += 1
+
+    return levels, bytes(payload)
+
+
+def get_source_info(png_paths: list[Path]) -> tuple[int, int, int]:
+    """Return count, total size and newest mtime in seconds of the icon files."""
+    stats = [png_path.stat() for png_path in png_paths]
+    max_mtime = max((stat.st_mtime_ns // 1_000_000_000 for stat in stats), default=0)
+    return len(stats), sum(stat.st_size for stat in stats), max_mtime
+
+
+def pack_icons(img_dir: Path, output_path: Path, num_levels: int) -> bool:
+    """Decode all PNGs in img_dir and write them into one archive.
+
+    Args:
+        img_dir: Folder with the <icon_id>.png files
+        output_path: Path of the archive to write
+        num_levels: Number of levels per icon including the full size one
+
+    Returns:
+        True if the archive was written, False otherwise
+    """
+    entries = []
+    payloads = []
+    skipped = 0
+
+    png_paths = [png_path for png_path in sorted(img_dir.glob("*.png")) if png_path.stem.isdigit()]
+    num_files, total_size, max_mtime = get_source_info(png_paths)
+
+    for png_path in png_paths:
+        try:
+            width, height, pixels = decode_png(png_path.read_bytes())
+        except (PngError, zlib.error) as e:
+            print(f"Skipping {png_path.name}: {e}")
+            skipped += 1
+            continue
+
+        if width > 0xFFFF or height > 0xFFFF:
+            print(f"Skipping {png_path.name}: image too large")
+            skipped += 1
+            continue
+
+        levels, payload = build_levels(width, height, pixels, num_levels)
+        entries.append((int(png_path.stem), width, height, levels))
+        payloads.append(payload)
+
+    if not entries:
+        print(f"Error: No icons found in {img_dir}")
+        return False
+
+    order = sorted(range(len(entries)), key=lambda idx: entries[idx][0])
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    table_size = struct.calcsize(ENTRY_FORMAT) * len(entries)
+    offset = header_size + table_size
+
+    table = bytearray()
+    data = bytearray()
+    for idx in order:
+        icon_id, width, height, levels = entries[idx]
+        payload = payloads[idx]
+
+        padding = -(offset + len(data)) % PAYLOAD_ALIGNMENT
+        data += bytes(padding)
+
+        table += struct.pack(ENTRY_FORMAT, icon_id, width, height, levels, 0, offset + len(data), len(payload))
+        data += payload
+
+    header = struct.pack(
+        HEADER_FORMAT, ARCHIVE_MAGIC, ARCHIVE_VERSION, len(entries), 0, num_files, 0, total_size, max_mtime
+    )
+
+    try:
+        output_path.parent.mkdir(parents=True, exist_ok=True)
+        tmp_path = output_path.with_suffix(output_path.suffix + ".tmp")
+        tmp_path.write_bytes(header + table + data)
+        tmp_path.replace(output_path)
+    except OSError as e:
+        print(f"Error: Failed to write {output_path}: {e}")
+        return False
+
+    archive_size = len(header) + len(table) + len(data)
+    print(f"✅ Packed {len(entries)} icons into {output_path} ({archive_size / (1024 * 1024):.1f} MiB)")
+    if skipped:
+        print(f"   Skipped {skipped} files that are not decodable PNGs")
+    return True
+
+
+def main() -> int:
+    """Main function with CLI interface."""
+    parser = argparse.ArgumentParser(
+        description="Pack skill icon PNGs into a pre-decoded RGBA icon archive",
+    )
+    parser.add_argument(
+        "--img-dir",
+        type=Path,
+        default=Path("data/img"),
+        help="Folder with the <icon_id>.png files (default: data/img)",
+    )
+    parser.add_argument(
+        "--output",
+        "-o",
+        type=Path,
+        default=Path("data/icons.pack"),
+        help="Archive to write (default: data/icons.pack)",
+    )
+    parser.add_argument(
+        "--levels",
+        type=int,
+        default=1,
+        help="Number of levels per icon, each further level is half the size (default: 1)",
+    )
+
+    args = parser.parse_args()
+
+    if not args.img_dir.is_dir():
+        print(f"Error: Image folder does not exist: {args.img_dir}")
+        return 1
+
+    if args.levels < 1:
+        print("Error: --levels must be at least 1")
+        return 1
+
+    return 0 if pack_icons(args.img_dir, args.output, args.levels) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include <shlwapi.h>
+#include <urlmon.h>
+#include <windows.h>
+#include <wininet.h>
+
+#pragma comment(lib, "wininet.lib")
+#pragma comment(lib, "urlmon.lib")
+#pragma comment(lib, "shlwapi.lib")
+
+#include "AddonFiles.h"
+#include "BenchCatalog.h"
+#include "DataSync.h"
+#include "Downloader.h"
+#include "IconArchive.h"
+#include "PngDecoder.h"
+#include "Settings.h"
+#include "Shared.h"
+#include "Textures.h"
+#include "Types.h"
+#include "ZipArchive.h"
+
+bool DownloadFile(const std::string &url, const std::filesystem::path &outputPath)
+{
+    try
+    {
+        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Started ZIP Downloading");
+
+        const auto hr = URLDownloadToFileA(nullptr, url.c_str(), outputPath.string().c_str(), 0, nullptr);
+        return SUCCEEDED(hr);
+    }
+    catch (...)
+    {
+        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "ZIP downloading failed.");
+        return false;
+    }
+}
+
+bool ExtractZipFile(const std::filesystem::path &zipPath, const std::filesystem::path &extractPath)
+{
+    try
+    {
+        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Started ZIP Extracting");
+
+        auto archive = ZipArchiveType{};
+        auto status = archive.open(zipPath);
+        if (status == ZipStatus::OK)
+            status = archive.extract_all(extractPath);
+
+        if (status != ZipStatus::OK)
+        {
+            Globals::BenchDataDownloadState = DownloadState::FAILED;
+            auto errorMsg = "ZIP extraction failed: " + zip_status_to_string(status);
+            (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", errorMsg.c_str());
+            return false;
+        }
+
+        auto infoMsg = "Extracted " + std::to_string(archive.get_entries().size()) + " ZIP entries.";
+        (void)Globals::APIDefs->Log(LOGL_INFO, "GW2RotaHelper", infoMsg.c_str());
+        return true;
+    }
+    catch (...)
+    {
+        Globals::BenchDataDownloadState = DownloadState::FAILED;
+        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "ZIP extraction failed.");
+        return false;
+    }
+}
+
+void DropFiles(const std::filesystem::path &path)
+{
+    try
+    {
+        if (std::filesystem::exists(path) && std::filesystem::is_directory(path))
+        {
+            for (const auto &entry : std::filesystem::directory_iterator(path))
+            {
+                if (entry.is_regular_file())
+                    std::filesystem::remove(entry.path());
+            }
+
+            (void)Globals::APIDefs->Log(LOGL_INFO,
+                                        "GW2RotaHelper",
+                                        ("Removed old build files from " + path.string() + " directory").c_str());
+        }
+    }
+    catch (const std::filesystem::filesystem_error &e)
+    {
+        auto errorMsg = "Error removing old builds from " + path.string() + " directory: " + std::string(e.what());
+        (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", errorMsg.c_str());
+    }
+    catch (...)
+    {
+        (void)Globals::APIDefs->Log(
+            LOGL_WARNING,
+            "GW2RotaHelper",
+            ("Unknown error while removing old builds from " + path.string() + " directory").c_str());
+    }
+}
+
+void DropOldBuilds(const std::filesystem::path &addonPath)
+{
+    auto power_alac = addonPath / "bench" / "alac" / "power";
+    DropFiles(power_alac);
+    auto power_dps = addonPath / "bench" / "dps" / "power";
+    DropFiles(power_dps);
+    auto power_quick = addonPath / "bench" / "quick" / "power";
+    DropFiles(power_quick);
+
+    auto condition_alac = addonPath / "bench" / "alac" / "condition";
+    DropFiles(condition_alac);
+    auto condition_dps = addonPath / "bench" / "dps" / "condition";
+    DropFiles(condition_dps);
+    auto condition_quick = addonPath / "bench" / "quick" / "condition";
+    DropFiles(condition_quick);
+}
+
+bool SyncBenchDataFromManifest(const std::filesystem::path &addonPath)
+{
+    try
+    {
+        // The base_url of the manifest points at the data of the same release tag
+        const std::string manifest_url =
+            "https://github.com/franneck94/GW2_RotaHelper/releases/latest/download/manifest.json";
+
+        const auto manifest_path = addonPath / "manifest.json.download";
+        if (!DownloadFile(manifest_url, manifest_path))
+        {
+            (void)Globals::APIDefs->Log(LOGL_INFO, "GW2RotaHelper", "No bench data manifest available.");
+            return false;
+        }
+
+        auto content = std::string{};
+        {
+            auto file = std::ifstream{manifest_path, std::ios::binary};
+            content.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+        }
+        std::filesystem::remove(manifest_path);
+
+        auto manifest = DataManifest{};
+        if (!parse_data_manifest(content, manifest))
+        {
+            (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", "Invalid bench data manifest.");
+            return false;
+        }
+
+        const auto outdated_files = get_outdated_data_files(manifest, addonPath);
+
+        // Fresh installs and large updates are faster as one compressed ZIP download
+        auto outdated_bytes = uint64_t{0};
+        auto total_bytes = uint64_t{0};
+        for (const auto &file : outdated_files)
+            outdated_bytes += file.size;
+        for (const auto &file : manifest.files)
+            total_bytes += file.size;
+        if (outdated_bytes * 2 > total_bytes)
+        {
+            (void)Globals::APIDefs->Log(LOGL_INFO, "GW2RotaHelper", "Most bench data changed, using the ZIP file.");
+            return false;
+        }
+
+        auto download_service = DownloadServiceType{make_wininet_transport, DownloadServiceConfig{8}};
+        const auto stats = sync_data_files(download_service, manifest, outdated_files, addonPath);
+        download_service.shutdown();
+
+        const auto num_removed = stats.num_failed == 0 ? remove_unlisted_data_files(manifest, addonPath, "bench") : 0;
+
+        const auto stats_msg = "Bench data sync: " + std::to_string(stats.num_outdated) + " of " +
+                               std::to_string(stats.num_files) + " files outdated, " +
+                               std::to_string(stats.num_updated) + " updated, " + std::to_string(stats.num_failed) +
+                               " failed, " + std::to_string(num_removed) + " removed, " +
+                               std::to_string(stats.bytes_downloaded) + " bytes in " +
+                               std::to_string(stats.duration.count()) + " ms";
+        const auto log_level = stats.num_failed == 0 ? LOGL_INFO : LOGL_WARNING;
+        (void)Globals::APIDefs->Log(log_level, "GW2RotaHelper", stats_msg.c_str());
+
+        return stats.num_failed == 0;
+    }
+    catch (...)
+    {
+        (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", "Bench data sync failed.");
+        return false;
+    }
+}
+
+bool BuildIconArchiveIfStale(const std::filesystem::path &addonPath, const std::atomic<bool> *cancel)
+{
+    const auto img_path = addonPath / "img";
+    const auto archive_path = get_icon_archive_path(addonPath);
+
+    auto archive = IconArchiveType{};
+    if (open_current_icon_archive(archive, archive_path, img_path))
+        return true;
+    archive.close();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto num_workers = std::max(1u, std::thread::hardware_concurrency() / 2);
+    const auto decoder_factory = make_png_decoder_factory(make_wic_image_decoder);
+    if (!write_icon_archive(img_path, archive_path, decoder_factory, num_workers, cancel))
+    {
+        // On Windows the rename fails while this process still maps the old archive, the next start retries
+        (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", "Failed to pack the icon archive.");
+        return false;
+    }
+
+    const auto duration = std::chrono::steady_clock::now() - start;
+    const auto msg = "Packed the icon archive in " +
+                     std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()) + " ms";
+    (void)Globals::APIDefs->Log(LOGL_INFO, "GW2RotaHelper", msg.c_str());
+
+    return true;
+}
+
+void DownloadAndExtractDataAsync(const std::filesystem::path &addonPath)
+{
+    Globals::ExtractedBenchData = false;
+    Globals::BenchDataDownloadState = DownloadState::STARTED;
+
+    std::thread([addonPath]() {
+        try
+        {
+            const std::string data_url =
+                "https://github.com/franneck94/GW2_RotaHelper/releases/latest/download/GW2RotaHelper.zip";
+
+            auto temp_zip_path = addonPath / "temp_GW2RotaHelper.zip";
+            auto extract_path = addonPath.parent_path(); // Extract one level above
+            (void)Globals::APIDefs->Log(LOGL_INFO, "GW2RotaHelper", "Started Download Thread.");
+
+            std::filesystem::create_directories(addonPath);
+            if (SyncBenchDataFromManifest(addonPath))
+            {
+                std::filesystem::remove(get_bench_catalog_path(addonPath / "bench"));
+                Globals::BenchDataDownloadState = DownloadState::FINISHED;
+                Globals::ExtractedBenchData = true;
+                return;
+            }
+
+            if (DownloadFile(data_url, temp_zip_path))
+            {
+                std::filesystem::create_directories(addonPath);
+
+                if (ExtractZipFile(temp_zip_path, extract_path))
+                {
+                    std::filesystem::remove(temp_zip_path);
+                    std::filesystem::remove(get_bench_catalog_path(addonPath / "bench"));
+                    Globals::BenchDataDownloadState = DownloadState::FINISHED;
+                    Globals::ExtractedBenchData = true;
+                }
+                else
+                {
+                    std::filesystem::remove(temp_zip_path);
+                    Globals::BenchDataDownloadState = DownloadState::FAILED;
+                }
+            }
+            else
+            {
+                Globals::BenchDataDownloadState = DownloadState::FAILED;
+            }
+        }
+        catch (...)
+        {
+            Globals::BenchDataDownloadState = DownloadState::FAILED;
+            (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "DownloadAndExtractDataAsync failed.");
+        }
+    }).detach();
+}
+
+bool FileSelection()
+{
+    OPENFILENAME ofn;
+    CHAR szFile[260] = {0};
+
+    ZeroMemory(&ofn, sizeof(ofn));
+    ofn.lStructSize = sizeof(ofn);
+    ofn.lpstrFile = szFile;
+    ofn.nMaxFile = sizeof(szFile);
+    ofn.lpstrFilter = "XML Files\0*.xml\0All Files\0*.*\0";
+    ofn.nFilterIndex = 1;
+    ofn.lpstrFileTitle = NULL;
+    ofn.nMaxFileTitle = 0;
+    ofn.lpstrInitialDir = "C:/";
+    ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST;
+
+    if (GetOpenFileName(&ofn) == TRUE)
+    {
+        Settings::XmlSettingsPath = std::filesystem::path(szFile);
+        Settings::Save(Globals::SettingsPath);
+        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Loaded XML InputBinds File.");
+
+        // The options window reloads the keybinds on its next frame
+        Globals::RenderData.keybinds_fingerprint = FileFingerprint{};
+        Globals::RenderData.keybinds_last_check = {};
+        Globals::RenderData.keybinds_loaded = false;
+
+        return true;
+    }
+
+    return false;
+}
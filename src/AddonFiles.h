@@ -0,0 +1,27 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+
+// Bench data downloads and file dialogs of the addon, these need the Windows API
+
+bool DownloadFile(const std::string &url, const std::filesystem::path &outputPath);
+
+bool ExtractZipFile(const std::filesystem::path &zipPath, const std::filesystem::path &extractPath);
+
+// Downloads only the changed files listed in the release manifest, false if the ZIP file should be used instead
+bool SyncBenchDataFromManifest(const std::filesystem::path &addonPath);
+
+void DropOldBuilds(const std::filesystem::path &addonPath);
+
+// Runs on a detached thread. The icon archive is not packed here but on the
+// next load of the addon, whose unload can cancel and join the build.
+void DownloadAndExtractDataAsync(const std::filesystem::path &addonPath);
+
+// Packs addonPath/img into icons.pack unless the archive on disk still matches
+// the icons, so the next start skips the PNG decodes. Blocks, only run it
+// through Globals::IconArchiveBuild, which AddonUnload cancels and waits for.
+bool BuildIconArchiveIfStale(const std::filesystem::path &addonPath, const std::atomic<bool> *cancel = nullptr);
+
+bool FileSelection();
@@ -0,0 +1,121 @@
+#include <windows.h>
+
+#include <optional>
+#include <string>
+
+#include "imgui.h"
+
+#include "AddonFiles.h"
+#include "AddonHost.h"
+#include "Logger.h"
+#include "MumbleUtils.h"
+#include "Shared.h"
+#include "Textures.h"
+#include "Version.h"
+
+bool AddonHostType::is_valid_map() const
+{
+    return IsValidMap();
+}
+
+bool AddonHostType::is_in_combat() const
+{
+    return IsInfight();
+}
+
+unsigned int AddonHostType::get_map_id() const
+{
+    return Globals::Identity.MapID;
+}
+
+ProfessionID AddonHostType::get_profession() const
+{
+    return static_cast<ProfessionID>(Globals::Identity.Profession);
+}
+
+EliteSpecID AddonHostType::get_elite_spec() const
+{
+    return static_cast<EliteSpecID>(Globals::Identity.Specialization);
+}
+
+std::string AddonHostType::get_profession_name() const
+{
+    return get_current_profession_name();
+}
+
+SkillIconView AddonHostType::get_skill_icon(const int icon_id) const
+{
+    return GetSkillIconView(Globals::IconAtlas, Globals::TextureMap, icon_id);
+}
+
+void AddonHostType::begin_icon_draws(ImDrawList *draw_list) const
+{
+    Globals::IconSampler.begin(draw_list);
+}
+
+void AddonHostType::end_icon_draws(ImDrawList *draw_list) const
+{
+    Globals::IconSampler.end(draw_list);
+}
+
+void AddonHostType::release_build_icons()
+{
+    if (Globals::IconCache)
+        ReleaseTextureMap(Globals::TextureMap, *Globals::IconCache);
+    if (Globals::TextureLoader)
+        Globals::TextureLoader->clear();
+    Globals::IconAtlas.release();
+}
+
+void AddonHostType::acquire_build_icons()
+{
+    if (Globals::IconCache && Globals::TextureLoader)
+        AcquireAllSkillTextures(*Globals::IconCache,
+                                *Globals::TextureLoader,
+                                Globals::TextureMap,
+                                Globals::RotationRun.log_skill_info_map,
+                                Globals::RenderData.img_path);
+}
+
+void AddonHostType::start_icon_downloads()
+{
+    StartDownloadAllSkillIcons(Globals::DownloadService.get(), Globals::RotationRun, Globals::RenderData.img_path);
+}
+
+std::optional<IconCacheStats> AddonHostType::get_icon_cache_stats() const
+{
+    if (!Globals::IconCache)
+        return std::nullopt;
+
+    return Globals::IconCache->get_stats();
+}
+
+void AddonHostType::restart_rotation(const bool not_ooc_triggered)
+{
+    Globals::Render.restart_rotation(not_ooc_triggered);
+}
+
+void AddonHostType::download_bench_data()
+{
+    const auto AddonPath = Globals::APIDefs->Paths_GetAddonDirectory("GW2RotaHelper");
+
+    if (MAJOR == 0 && MINOR == 28 && BUILD == 0)
+    {
+        log_message(LogLevel::DEBUG, "Dropping old builds");
+        DropOldBuilds(AddonPath);
+    }
+
+    log_message(LogLevel::DEBUG, "Started downloading bench data");
+
+    DownloadAndExtractDataAsync(AddonPath);
+}
+
+void AddonHostType::select_keybinds_file()
+{
+    FileSelection();
+}
+
+void AddonHostType::open_in_shell(const std::string &target)
+{
+    ShellExecuteA(nullptr, "open", target.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "IconCache.h"
+#include "Types.h"
+#include "UiHost.h"
+
+// The addon windows inside the game, backed by Nexus, Mumble and the D3D11 icon textures
+class AddonHostType : public UiHostType
+{
+public:
+    bool is_valid_map() const override;
+    bool is_in_combat() const override;
+    unsigned int get_map_id() const override;
+    ProfessionID get_profession() const override;
+    EliteSpecID get_elite_spec() const override;
+    std::string get_profession_name() const override;
+
+    SkillIconView get_skill_icon(const int icon_id) const override;
+    void begin_icon_draws(ImDrawList *draw_list) const override;
+    void end_icon_draws(ImDrawList *draw_list) const override;
+
+    void release_build_icons() override;
+    void acquire_build_icons() override;
+    void start_icon_downloads() override;
+    std::optional<IconCacheStats> get_icon_cache_stats() const override;
+
+    void restart_rotation(const bool not_ooc_triggered) override;
+    void download_bench_data() override;
+    void select_keybinds_file() override;
+    void open_in_shell(const std::string &target) override;
+};
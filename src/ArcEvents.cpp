@@ -16,6 +16,7 @@
 #include "Defines.h"
 #include "FileUtils.h"
 #include "MumbleUtils.h"
+#include "Profiler.h"
 #include "Shared.h"
 #include "SkillData.h"
 #include "Types.h"
@@ -29,7 +30,7 @@ static auto is_first_cast_map = std::map<SkillID, bool>{};
 
 bool IsValidSelfData(const EvCombatData &combat_data)
 {
-    return combat_data.src->IsSelf && combat_data.src != nullptr && combat_data.skillname != nullptr &&
+    return combat_data.src != nullptr && combat_data.src->IsSelf && combat_data.skillname != nullptr &&
            combat_data.ev != nullptr && combat_data.src->Name != nullptr;
 }
 
@@ -57,7 +58,7 @@ bool IsNoCondiTick(const EvCombatDataPersistent &combat_data)
         "Poisened",
     };
 
-    const auto not_found = condi_names.find(combat_data.SkillName) == condi_names.end();
+    const auto not_found = condi_names.find(combat_data.SkillName.str()) == condi_names.end();
     return not_found;
 }
 
@@ -103,7 +104,9 @@ bool IsMultiHitSkill(const std::chrono::steady_clock::time_point &now, const EvC
 
     const auto is_reset_like_skill =
         SkillRuleData::reset_like_skill.find(combat_data.SkillID) != SkillRuleData::reset_like_skill.end();
-    const auto is_profession_reset_like_skill = SkillRuleData::IsProfessionResetLikeSKill(combat_data.SkillID);
+    const auto is_profession_reset_like_skill =
+        SkillRuleData::IsProfessionResetLikeSKill(combat_data.SkillID,
+                                                  static_cast<ProfessionID>(combat_data.SrcProfession));
 
     if (is_profession_reset_like_skill || is_reset_like_skill)
     {
@@ -190,6 +193,8 @@ bool OnCombat(const char *channel,
               uint64_t id,
               uint64_t revision)
 {
+    const auto profile_scope = ProfileScopeType{ProfileZone::ARC_COMBAT_EVENT};
+
 #ifdef GW2_NEXUS_ADDON
     if (Globals::APIDefs == nullptr)
         return false;
@@ -208,8 +213,8 @@ bool OnCombat(const char *channel,
         .SrcID = combat_data.src->ID,
         .SrcProfession = combat_data.src->Profession,
         .SrcSpecialization = combat_data.src->Specialization,
-        .SkillName = std::string(combat_data.skillname),
-        .SkillID = SafeConvertToSkillID(combat_data.ev->SkillID),
+        .SkillName = InternedString{combat_data.skillname},
+        .SkillID = SafeConvertToSkillID(combat_data.ev->SkillID, Globals::RotationRun.skill_data_map),
         .EventID = combat_data.id,
     };
 
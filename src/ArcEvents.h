@@ -8,8 +8,20 @@
 #ifndef ARCEVENTS_H
 #define ARCEVENTS_H
 
+#include <cstdint>
+
 #include "arcdps/ArcDPS.h"
 
+struct EvCombatData
+{
+    ArcDPS::CombatEvent *ev;
+    ArcDPS::AgentShort *src;
+    ArcDPS::AgentShort *dst;
+    char *skillname;
+    uint64_t id;
+    uint64_t revision;
+};
+
 ///----------------------------------------------------------------------------------------------------
 /// ArcEv Namespace
 ///----------------------------------------------------------------------------------------------------
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "AtlasBuilder.h"
+#include "ImageResample.h"
+#include "TextureLoader.h"
+
+namespace
+{
+uint32_t align_up(const uint32_t value, const uint32_t alignment)
+{
+    if (alignment <= 1)
+        return value;
+
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+struct Placement
+{
+    int icon_id = 0;
+    uint32_t page = 0;
+    AtlasRect slot; // Including padding
+};
+} // namespace
+
+void AtlasBuilderType::add(const int icon_id, DecodedImage image)
+{
+    if (image.width == 0 || image.height == 0 ||
+        image.pixels.size() < static_cast<size_t>(image.width) * image.height * 4)
+        return;
+
+    images[icon_id] = std::move(image);
+}
+
+void AtlasBuilderType::clear()
+{
+    images.clear();
+    pages.clear();
+    entries.clear();
+}
+
+bool AtlasBuilderType::build()
+{
+    pages.clear();
+    entries.clear();
+
+    auto order = std::vector<std::pair<int, const DecodedImage *>>{};
+    order.reserve(images.size());
+    for (const auto &[icon_id, image] : images)
+        order.emplace_back(icon_id, &image);
+
+    std::ranges::stable_sort(order, [](const auto &lhs, const auto &rhs) {
+        if (lhs.second->height != rhs.second->height)
+            return lhs.second->height > rhs.second->height;
+        return lhs.second->width > rhs.second->width;
+    });
+
+    auto placements = std::vector<Placement>{};
+    placements.reserve(order.size());
+
+    auto page_extents = std::vector<std::pair<uint32_t, uint32_t>>{};
+    auto shelf_x = uint32_t{0};
+    auto shelf_y = uint32_t{0};
+    auto shelf_height = uint32_t{0};
+    auto all_fit = true;
+
+    for (const auto &[icon_id, image] : order)
+    {
+        const auto slot_width = align_up(image->width + 2 * config.padding, config.alignment);
+        const auto slot_height = align_up(image->height + 2 * config.padding, config.alignment);
+        if (slot_width > config.page_size || slot_height > config.page_size)
+        {
+            all_fit = false;
+            continue;
+        }
+
+        if (page_extents.empty())
+            page_extents.emplace_back(0, 0);
+
+        if (shelf_x + slot_width > config.page_size)
+        {
+            shelf_y += shelf_height;
+            shelf_x = 0;
+            shelf_height = 0;
+        }
+
+        if (shelf_y + slot_height > config.page_size)
+        {
+            page_extents.emplace_back(0, 0);
+            shelf_x = 0;
+            shelf_y = 0;
+            shelf_height = 0;
+        }
+
+        const auto page = static_cast<uint32_t>(page_extents.size() - 1);
+        placements.push_back(Placement{icon_id, page, AtlasRect{shelf_x, shelf_y, slot_width, slot_height}});
+
+        shelf_x += slot_width;
+        shelf_height = std::max(shelf_height, slot_height);
+
+        auto &[extent_x, extent_y] = page_extents.back();
+        extent_x = std::max(extent_x, shelf_x);
+        extent_y = std::max(extent_y, shelf_y + shelf_height);
+    }
+
+    pages.resize(page_extents.size());
+    for (auto idx = size_t{0}; idx < pages.size(); ++idx)
+    {
+        pages[idx].width = page_extents[idx].first;
+        pages[idx].height = page_extents[idx].second;
+        pages[idx].pixels.assign(static_cast<size_t>(pages[idx].width) * pages[idx].height * 4, 0);
+    }
+
+    for (const auto &placement : placements)
+    {
+        const auto &image = images.at(placement.icon_id);
+        auto &page = pages[placement.page];
+
+        const auto rect = AtlasRect{placement.slot.x + config.padding,
+                                    placement.slot.y + config.padding,
+                                    image.width,
+                                    image.height};
+        blit(image, page, rect);
+
+        auto entry = AtlasEntry{};
+        entry.page = placement.page;
+        entry.rect = rect;
+        entry.u0 = static_cast<float>(rect.x) / static_cast<float>(page.width);
+        entry.v0 = static_cast<float>(rect.y) / static_cast<float>(page.height);
+        entry.u1 = static_cast<float>(rect.x + rect.width) / static_cast<float>(page.width);
+        entry.v1 = static_cast<float>(rect.y + rect.height) / static_cast<float>(page.height);
+        entries[placement.icon_id] = entry;
+    }
+
+    return all_fit;
+}
+
+void AtlasBuilderType::generate_page_mips()
+{
+    auto num_levels = uint32_t{0};
+    while ((config.padding >> (num_levels + 1)) > 0 && config.alignment % (uint32_t{2} << num_levels) == 0)
+        ++num_levels;
+
+    for (auto &page : pages)
+        generate_mips(page, 1, num_levels);
+}
+
+double AtlasBuilderType::get_fill_ratio() const
+{
+    auto page_area = uint64_t{0};
+    for (const auto &page : pages)
+        page_area += uint64_t{page.width} * page.height;
+
+    auto icon_area = uint64_t{0};
+    for (const auto &[icon_id, entry] : entries)
+        icon_area += uint64_t{entry.rect.width} * entry.rect.height;
+
+    return page_area == 0 ? 0.0 : static_cast<double>(icon_area) / static_cast<double>(page_area);
+}
+
+void AtlasBuilderType::blit(const DecodedImage &image, AtlasPage &page, const AtlasRect &rect) const
+{
+    const auto page_stride = static_cast<size_t>(page.width) * 4;
+    const auto image_stride = static_cast<size_t>(image.width) * 4;
+
+    const auto left = rect.x - config.padding;
+    const auto right = rect.x + rect.width;
+
+    for (auto row = uint32_t{0}; row < rect.height; ++row)
+    {
+        auto *dst = page.pixels.data() + (rect.y + row) * page_stride;
+        const auto *src = image.pixels.data() + row * image_stride;
+
+        std::memcpy(dst + static_cast<size_t>(rect.x) * 4, src, image_stride);
+
+        for (auto pad = uint32_t{0}; pad < config.padding; ++pad)
+        {
+            std::memcpy(dst + static_cast<size_t>(left + pad) * 4, src, 4);
+            std::memcpy(dst + static_cast<size_t>(right + pad) * 4, src + image_stride - 4, 4);
+        }
+    }
+
+    // The padded first and last rows are repeated into the top and bottom border
+    const auto padded_bytes = static_cast<size_t>(rect.width + 2 * config.padding) * 4;
+    auto *first_row = page.pixels.data() + rect.y * page_stride + static_cast<size_t>(left) * 4;
+    auto *last_row = first_row + (rect.height - 1) * page_stride;
+
+    for (auto pad = size_t{1}; pad <= config.padding; ++pad)
+    {
+        std::memcpy(first_row - pad * page_stride, first_row, padded_bytes);
+        std::memcpy(last_row + pad * page_stride, last_row, padded_bytes);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "TextureLoader.h"
+
+struct AtlasRect
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+struct AtlasEntry
+{
+    uint32_t page = 0;
+    AtlasRect rect; // Icon pixels without the padding
+    float u0 = 0.0f;
+    float v0 = 0.0f;
+    float u1 = 0.0f;
+    float v1 = 0.0f;
+};
+
+using AtlasPage = DecodedImage;
+
+struct AtlasConfig
+{
+    uint32_t page_size = 2048;
+    uint32_t padding = 2; // Border filled with the edge pixels against bleeding while filtering
+    uint32_t alignment = 4;
+};
+
+// Packs icons into as few RGBA pages as possible with a shelf packer. Icons
+// are sorted by height, so every shelf wastes at most the height difference
+// of its neighbours.
+class AtlasBuilderType
+{
+public:
+    explicit AtlasBuilderType(AtlasConfig config = {}) : config(config)
+    {
+    }
+
+    void add(const int icon_id, DecodedImage image);
+    void clear();
+
+    // Returns false if an icon does not fit into a page, it is left out then
+    bool build();
+
+    // Adds the page mip levels that keep every icon inside its own slot, a level
+    // needs at least one padding pixel and slots aligned to its scale
+    void generate_page_mips();
+
+    size_t get_num_images() const
+    {
+        return images.size();
+    }
+    const std::vector<AtlasPage> &get_pages() const
+    {
+        return pages;
+    }
+    const std::map<int, AtlasEntry> &get_entries() const
+    {
+        return entries;
+    }
+
+    // Share of the page area covered by icon pixels
+    double get_fill_ratio() const;
+
+private:
+    void blit(const DecodedImage &image, AtlasPage &page, const AtlasRect &rect) const;
+
+    AtlasConfig config;
+    std::map<int, DecodedImage> images;
+    std::vector<AtlasPage> pages;
+    std::map<int, AtlasEntry> entries;
+};
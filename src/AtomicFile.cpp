@@ -0,0 +1,231 @@
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#include "AtomicFile.h"
+
+#ifdef _WIN32
+
+namespace
+{
+bool write_all(HANDLE handle, std::string_view content)
+{
+    auto success = true;
+    while (success && !content.empty())
+    {
+        auto num_written = DWORD{0};
+        const auto chunk_size = static_cast<DWORD>(content.size() > MAXDWORD ? MAXDWORD : content.size());
+        success = WriteFile(handle, content.data(), chunk_size, &num_written, nullptr) && num_written > 0;
+        content.remove_prefix(num_written);
+    }
+
+    return success;
+}
+
+bool seek(HANDLE handle, const uint64_t offset)
+{
+    auto distance = LARGE_INTEGER{};
+    distance.QuadPart = static_cast<LONGLONG>(offset);
+    return SetFilePointerEx(handle, distance, nullptr, FILE_BEGIN) != FALSE;
+}
+
+bool replace_file(const std::filesystem::path &from, const std::filesystem::path &to)
+{
+    return MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+}
+} // namespace
+
+bool AtomicFileWriterType::open(const std::filesystem::path &path)
+{
+    discard();
+
+    target_path = path;
+    tmp_path = path;
+    tmp_path += ".tmp";
+
+    const auto handle =
+        CreateFileW(tmp_path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    file_handle = handle;
+    file_size = 0;
+    is_file_open = true;
+    return true;
+}
+
+bool AtomicFileWriterType::write(std::string_view content)
+{
+    if (!is_file_open || !write_all(static_cast<HANDLE>(file_handle), content))
+        return false;
+
+    file_size += content.size();
+    return true;
+}
+
+bool AtomicFileWriterType::write_at(const uint64_t offset, std::string_view content)
+{
+    if (!is_file_open || offset > file_size || content.size() > file_size - offset)
+        return false;
+
+    const auto handle = static_cast<HANDLE>(file_handle);
+    return seek(handle, offset) && write_all(handle, content) && seek(handle, file_size);
+}
+
+bool AtomicFileWriterType::close_file(const bool flush)
+{
+    // Without the flush the rename can reach the disk before the data does
+    const auto handle = static_cast<HANDLE>(file_handle);
+    auto success = !flush || FlushFileBuffers(handle);
+    success = CloseHandle(handle) && success;
+
+    file_handle = nullptr;
+    is_file_open = false;
+    return success;
+}
+
+#else
+
+namespace
+{
+bool write_all(const int fd, std::string_view content)
+{
+    auto success = true;
+    while (success && !content.empty())
+    {
+        const auto num_written = ::write(fd, content.data(), content.size());
+        success = num_written > 0;
+        if (success)
+            content.remove_prefix(static_cast<size_t>(num_written));
+    }
+
+    return success;
+}
+
+bool write_all_at(const int fd, std::string_view content, uint64_t offset)
+{
+    auto success = true;
+    while (success && !content.empty())
+    {
+        const auto num_written = ::pwrite(fd, content.data(), content.size(), static_cast<off_t>(offset));
+        success = num_written > 0;
+        if (success)
+        {
+            content.remove_prefix(static_cast<size_t>(num_written));
+            offset += static_cast<uint64_t>(num_written);
+        }
+    }
+
+    return success;
+}
+
+bool replace_file(const std::filesystem::path &from, const std::filesystem::path &to)
+{
+    if (std::rename(from.c_str(), to.c_str()) != 0)
+        return false;
+
+    // Persists the directory entry of the rename itself
+    const auto parent_path = to.has_parent_path() ? to.parent_path() : std::filesystem::path{"."};
+    const auto dir_fd = ::open(parent_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd >= 0)
+    {
+        (void)::fsync(dir_fd);
+        ::close(dir_fd);
+    }
+
+    return true;
+}
+} // namespace
+
+bool AtomicFileWriterType::open(const std::filesystem::path &path)
+{
+    discard();
+
+    target_path = path;
+    tmp_path = path;
+    tmp_path += ".tmp";
+
+    const auto fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return false;
+
+    file_descriptor = fd;
+    file_size = 0;
+    is_file_open = true;
+    return true;
+}
+
+bool AtomicFileWriterType::write(std::string_view content)
+{
+    if (!is_file_open || !write_all(file_descriptor, content))
+        return false;
+
+    file_size += content.size();
+    return true;
+}
+
+bool AtomicFileWriterType::write_at(const uint64_t offset, std::string_view content)
+{
+    if (!is_file_open || offset > file_size || content.size() > file_size - offset)
+        return false;
+
+    return write_all_at(file_descriptor, content, offset);
+}
+
+bool AtomicFileWriterType::close_file(const bool flush)
+{
+    // Without the flush the rename can reach the disk before the data does
+    auto success = !flush || ::fsync(file_descriptor) == 0;
+    success = ::close(file_descriptor) == 0 && success;
+
+    file_descriptor = -1;
+    is_file_open = false;
+    return success;
+}
+
+#endif
+
+AtomicFileWriterType::~AtomicFileWriterType()
+{
+    discard();
+}
+
+bool AtomicFileWriterType::commit()
+{
+    if (!is_file_open)
+        return false;
+
+    if (!close_file(true) || !replace_file(tmp_path, target_path))
+    {
+        auto ec = std::error_code{};
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+
+    return true;
+}
+
+void AtomicFileWriterType::discard()
+{
+    if (!is_file_open)
+        return;
+
+    (void)close_file(false);
+    auto ec = std::error_code{};
+    std::filesystem::remove(tmp_path, ec);
+}
+
+bool write_file_atomic(const std::filesystem::path &path, std::string_view content)
+{
+    auto writer = AtomicFileWriterType{};
+    return writer.open(path) && writer.write(content) && writer.commit();
+}
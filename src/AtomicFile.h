@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+// Replaces the file with the content so that a crash or power loss leaves
+// either the old or the new file, never a truncated one. The content is
+// written to <path>.tmp and flushed to disk before the temp file is renamed
+// over the target.
+bool write_file_atomic(const std::filesystem::path &path, std::string_view content);
+
+// write_file_atomic for content that is written in chunks, so the whole file
+// never has to be held in memory. Nothing replaces the target before commit(),
+// a writer destroyed without it removes the temp file.
+class AtomicFileWriterType
+{
+public:
+    AtomicFileWriterType() = default;
+    ~AtomicFileWriterType();
+
+    AtomicFileWriterType(const AtomicFileWriterType &) = delete;
+    AtomicFileWriterType &operator=(const AtomicFileWriterType &) = delete;
+
+    bool open(const std::filesystem::path &path);
+
+    // Appends to the end of the file
+    bool write(std::string_view content);
+
+    // Overwrites already written bytes, for headers that are only known at the end
+    bool write_at(const uint64_t offset, std::string_view content);
+
+    // Flushes the temp file to disk and renames it over the target
+    bool commit();
+
+    // Closes and removes the temp file, the target stays untouched
+    void discard();
+
+    bool is_open() const
+    {
+        return is_file_open;
+    }
+
+private:
+    bool close_file(const bool flush);
+
+    std::filesystem::path target_path;
+    std::filesystem::path tmp_path;
+    uint64_t file_size = 0;
+    bool is_file_open = false;
+
+#ifdef _WIN32
+    void *file_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+};
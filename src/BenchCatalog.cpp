@@ -0,0 +1,412 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "AtomicFile.h"
+#include "BenchCatalog.h"
+#include "FileUtils.h"
+#include "LogData.h"
+#include "Logger.h"
+#include "Types.h"
+
+namespace
+{
+constexpr auto BENCH_CATALOG_VERSION = 2;
+
+int64_t get_mtime(const std::filesystem::path &path)
+{
+    auto ec = std::error_code{};
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return 0;
+
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+std::string join_relative(const std::string &relative_dir, const std::string &name)
+{
+    if (relative_dir.empty())
+        return name;
+
+    return relative_dir + "/" + name;
+}
+
+std::filesystem::path to_native_path(const std::string &generic_path)
+{
+    auto path = std::filesystem::path{generic_path};
+    path.make_preferred();
+    return path;
+}
+
+std::string get_string_or_empty(const nlohmann::json &j, const char *key)
+{
+    if (j.contains(key) && j[key].is_string())
+        return j[key].get<std::string>();
+
+    return std::string{};
+}
+
+void from_json_build_info(const nlohmann::json &j, BenchBuildInfo &build_info)
+{
+    build_info.name = get_string_or_empty(j, "name");
+    build_info.profession = get_string_or_empty(j, "profession");
+    build_info.elite_spec = get_string_or_empty(j, "elite_spec");
+    build_info.build_type = get_string_or_empty(j, "build_type");
+    build_info.benchmark_type = get_string_or_empty(j, "benchmark_type");
+
+    if (j.contains("overall_dps") && j["overall_dps"].is_number())
+        build_info.overall_dps = j["overall_dps"].get<double>();
+
+    // Stored under the key of the bench files, so the same reader applies
+    build_info.skill_key_mapping = get_skill_key_mapping(j);
+}
+
+nlohmann::json to_json_build_info(const BenchBuildInfo &build_info)
+{
+    return nlohmann::json{
+        {"name", build_info.name},
+        {"profession", build_info.profession},
+        {"elite_spec", build_info.elite_spec},
+        {"build_type", build_info.build_type},
+        {"benchmark_type", build_info.benchmark_type},
+        {"overall_dps", build_info.overall_dps},
+        {"SkillKeyMapping",
+         {
+             {"slot_7", build_info.skill_key_mapping.skill_7},
+             {"slot_8", build_info.skill_key_mapping.skill_8},
+             {"slot_9", build_info.skill_key_mapping.skill_9},
+         }},
+    };
+}
+} // namespace
+
+std::filesystem::path get_bench_catalog_path(const std::filesystem::path &bench_path)
+{
+    return bench_path.parent_path() / "bench_catalog.json";
+}
+
+bool load_bench_build_info(const std::filesystem::path &json_path, BenchBuildInfo &build_info)
+{
+    auto j = nlohmann::json{};
+    if (!load_build_header_json(json_path, j))
+        return false;
+
+    const auto metadata = get_metadata(json_path, j);
+    build_info.overall_dps = metadata.overall_dps;
+    build_info.name = metadata.name;
+    build_info.profession = metadata.profession;
+    build_info.elite_spec = metadata.elite_spec;
+    build_info.build_type = metadata.build_type;
+    build_info.benchmark_type = metadata.benchmark_type;
+    build_info.skill_key_mapping = get_skill_key_mapping(j);
+
+    return true;
+}
+
+bool BenchCatalogType::load(const std::filesystem::path &catalog_path)
+{
+    directories.clear();
+    files.clear();
+
+    if (!std::filesystem::exists(catalog_path))
+        return false;
+
+    try
+    {
+        auto file = std::ifstream{catalog_path};
+        const auto j = nlohmann::json::parse(file);
+
+        if (!j.contains("version") || j.at("version") != BENCH_CATALOG_VERSION)
+            return false;
+
+        // at() throws on missing keys, so a truncated catalog is rebuilt below
+        for (const auto &[relative_dir, dir_json] : j.at("directories").items())
+        {
+            auto directory = BenchCatalogDirectory{};
+            directory.mtime = dir_json.at("mtime").get<int64_t>();
+            directory.subdirs = dir_json.at("subdirs").get<std::vector<std::string>>();
+            directory.files = dir_json.at("files").get<std::vector<std::string>>();
+            directories[relative_dir] = std::move(directory);
+        }
+
+        for (const auto &[relative_path, file_json] : j.at("files").items())
+        {
+            auto catalog_file = BenchCatalogFile{};
+            catalog_file.file_size = file_json.at("size").get<uintmax_t>();
+            catalog_file.mtime = file_json.at("mtime").get<int64_t>();
+            from_json_build_info(file_json.at("metadata"), catalog_file.build_info);
+            files[relative_path] = std::move(catalog_file);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        log_message(LogLevel::WARNING, "Bench catalog could not be parsed, rebuilding it.");
+        directories.clear();
+        files.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool BenchCatalogType::save(const std::filesystem::path &catalog_path) const
+{
+    auto j = nlohmann::json{{"version", BENCH_CATALOG_VERSION}};
+    j["directories"] = nlohmann::json::object();
+    j["files"] = nlohmann::json::object();
+
+    for (const auto &[relative_dir, directory] : directories)
+    {
+        j["directories"][relative_dir] = nlohmann::json{
+            {"mtime", directory.mtime},
+            {"subdirs", directory.subdirs},
+            {"files", directory.files},
+        };
+    }
+
+    for (const auto &[relative_path, catalog_file] : files)
+    {
+        j["files"][relative_path] = nlohmann::json{
+            {"size", catalog_file.file_size},
+            {"mtime", catalog_file.mtime},
+            {"metadata", to_json_build_info(catalog_file.build_info)},
+        };
+    }
+
+    auto content = std::string{};
+    try
+    {
+        content = j.dump(1, '\t');
+    }
+    catch (const std::exception &e)
+    {
+        log_message(LogLevel::WARNING, "Bench catalog could not be serialized.");
+        return false;
+    }
+
+    // A crash during the write keeps the previous catalog instead of a truncated one
+    if (!write_file_atomic(catalog_path, content))
+    {
+        log_message(LogLevel::WARNING, "Bench catalog could not be written.");
+        return false;
+    }
+
+    return true;
+}
+
+bool BenchCatalogType::refresh(const std::filesystem::path &bench_path)
+{
+    auto changed = false;
+
+    if (!std::filesystem::exists(bench_path))
+    {
+        changed = !directories.empty() || !files.empty();
+        directories.clear();
+        files.clear();
+        return changed;
+    }
+
+    auto seen_directories = std::set<std::string>{};
+    auto seen_files = std::set<std::string>{};
+    auto pending_files = PendingFiles{};
+    refresh_directory(bench_path, std::string{}, seen_directories, seen_files, pending_files, changed);
+
+    std::erase_if(directories, [&](const auto &entry) {
+        if (seen_directories.contains(entry.first))
+            return false;
+        changed = true;
+        return true;
+    });
+
+    std::erase_if(files, [&](const auto &entry) {
+        if (seen_files.contains(entry.first))
+            return false;
+        changed = true;
+        return true;
+    });
+
+    load_build_infos(pending_files);
+
+    return changed;
+}
+
+void BenchCatalogType::refresh_directory(const std::filesystem::path &bench_path,
+                                         const std::string &relative_dir,
+                                         std::set<std::string> &seen_directories,
+                                         std::set<std::string> &seen_files,
+                                         PendingFiles &pending_files,
+                                         bool &changed)
+{
+    const auto dir_path = relative_dir.empty() ? bench_path : bench_path / to_native_path(relative_dir);
+    const auto mtime = get_mtime(dir_path);
+
+    seen_directories.insert(relative_dir);
+
+    auto it = directories.find(relative_dir);
+    auto is_valid = it != directories.end() && it->second.mtime == mtime;
+    if (is_valid)
+    {
+        is_valid = std::ranges::all_of(it->second.files, [&](const auto &filename) {
+            return files.contains(join_relative(relative_dir, filename));
+        });
+    }
+
+    if (is_valid)
+    {
+        // Rewriting a file in place leaves the directory mtime untouched
+        for (const auto &filename : it->second.files)
+        {
+            if (refresh_file(dir_path / filename, join_relative(relative_dir, filename), pending_files))
+                changed = true;
+        }
+    }
+    else
+    {
+        auto &directory = directories[relative_dir];
+        directory.mtime = mtime;
+        if (rescan_directory(dir_path, relative_dir, directory, pending_files))
+            changed = true;
+        it = directories.find(relative_dir);
+    }
+
+    for (const auto &filename : it->second.files)
+        seen_files.insert(join_relative(relative_dir, filename));
+
+    const auto subdirs = it->second.subdirs;
+    for (const auto &subdir : subdirs)
+        refresh_directory(bench_path,
+                          join_relative(relative_dir, subdir),
+                          seen_directories,
+                          seen_files,
+                          pending_files,
+                          changed);
+}
+
+bool BenchCatalogType::rescan_directory(const std::filesystem::path &dir_path,
+                                        const std::string &relative_dir,
+                                        BenchCatalogDirectory &directory,
+                                        PendingFiles &pending_files)
+{
+    auto subdirs = std::vector<std::string>{};
+    auto filenames = std::vector<std::string>{};
+
+    try
+    {
+        for (const auto &entry : std::filesystem::directory_iterator(dir_path))
+        {
+            if (entry.is_directory())
+                subdirs.push_back(entry.path().filename().string());
+            else if (entry.is_regular_file() && entry.path().extension() == ".json")
+                filenames.push_back(entry.path().filename().string());
+        }
+    }
+    catch (const std::filesystem::filesystem_error &ex)
+    {
+        log_message(LogLevel::CRITICAL, "Error scanning bench files");
+    }
+
+    std::ranges::sort(subdirs);
+    std::ranges::sort(filenames);
+
+    auto changed = subdirs != directory.subdirs || filenames != directory.files;
+
+    for (const auto &filename : filenames)
+    {
+        if (refresh_file(dir_path / filename, join_relative(relative_dir, filename), pending_files))
+            changed = true;
+    }
+
+    directory.subdirs = std::move(subdirs);
+    directory.files = std::move(filenames);
+
+    return changed;
+}
+
+bool BenchCatalogType::refresh_file(const std::filesystem::path &file_path,
+                                    const std::string &relative_path,
+                                    PendingFiles &pending_files)
+{
+    auto ec = std::error_code{};
+    const auto file_size = std::filesystem::file_size(file_path, ec);
+    const auto mtime = get_mtime(file_path);
+
+    auto &catalog_file = files[relative_path];
+    if (!ec && catalog_file.file_size == file_size && catalog_file.mtime == mtime)
+        return false;
+
+    catalog_file.file_size = file_size;
+    catalog_file.mtime = mtime;
+    catalog_file.build_info = BenchBuildInfo{};
+    pending_files.emplace_back(file_path, &catalog_file);
+
+    return true;
+}
+
+void BenchCatalogType::load_build_infos(const PendingFiles &pending_files)
+{
+    if (pending_files.empty())
+        return;
+
+    // Catalog entries are map nodes, so workers can fill them in place while
+    // the map itself is left untouched
+    const auto num_workers =
+        std::clamp(static_cast<size_t>(std::thread::hardware_concurrency()), size_t{1}, pending_files.size());
+    auto next_index = std::atomic<size_t>{0};
+
+    auto worker = [&pending_files, &next_index]() {
+        for (auto idx = next_index.fetch_add(1); idx < pending_files.size(); idx = next_index.fetch_add(1))
+        {
+            const auto &[file_path, catalog_file] = pending_files[idx];
+            (void)load_bench_build_info(file_path, catalog_file->build_info);
+        }
+    };
+
+    auto workers = std::vector<std::thread>{};
+    workers.reserve(num_workers - 1);
+    for (auto i = size_t{1}; i < num_workers; ++i)
+        workers.emplace_back(worker);
+
+    worker();
+
+    for (auto &thread : workers)
+        thread.join();
+}
+
+std::vector<BenchFileInfo> BenchCatalogType::get_bench_files(const std::filesystem::path &bench_path) const
+{
+    auto bench_files = std::vector<BenchFileInfo>{};
+    bench_files.reserve(files.size() + directories.size());
+
+    for (const auto &[relative_dir, directory] : directories)
+    {
+        if (directory.files.empty())
+            continue;
+
+        const auto native_dir = to_native_path(relative_dir);
+
+        if (!relative_dir.empty())
+            bench_files.emplace_back(bench_path / native_dir, native_dir, true);
+
+        for (const auto &filename : directory.files)
+        {
+            const auto file_it = files.find(join_relative(relative_dir, filename));
+            if (file_it == files.end())
+                continue;
+
+            const auto relative_path = native_dir / filename;
+            auto &file_info = bench_files.emplace_back(bench_path / relative_path, relative_path, false);
+            file_info.build_info = file_it->second.build_info;
+        }
+    }
+
+    return bench_files;
+}
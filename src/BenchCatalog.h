@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Types.h"
+
+struct BenchCatalogFile
+{
+    uintmax_t file_size = 0;
+    int64_t mtime = 0;
+    BenchBuildInfo build_info;
+};
+
+struct BenchCatalogDirectory
+{
+    int64_t mtime = 0;
+    std::vector<std::string> subdirs;
+    std::vector<std::string> files;
+};
+
+// Persistent index of the bench directory. Paths are relative to the bench
+// directory in generic form, directories are only re-listed when their mtime
+// changed since the catalog was written and the metadata of a file is only
+// read again when its size or mtime changed.
+class BenchCatalogType
+{
+public:
+    bool load(const std::filesystem::path &catalog_path);
+    bool save(const std::filesystem::path &catalog_path) const;
+    bool refresh(const std::filesystem::path &bench_path);
+    std::vector<BenchFileInfo> get_bench_files(const std::filesystem::path &bench_path) const;
+
+    std::map<std::string, BenchCatalogDirectory> directories;
+    std::map<std::string, BenchCatalogFile> files;
+
+private:
+    using PendingFiles = std::vector<std::pair<std::filesystem::path, BenchCatalogFile *>>;
+
+    void refresh_directory(const std::filesystem::path &bench_path,
+                           const std::string &relative_dir,
+                           std::set<std::string> &seen_directories,
+                           std::set<std::string> &seen_files,
+                           PendingFiles &pending_files,
+                           bool &changed);
+    bool rescan_directory(const std::filesystem::path &dir_path,
+                          const std::string &relative_dir,
+                          BenchCatalogDirectory &directory,
+                          PendingFiles &pending_files);
+    // Queues the metadata of the file for a reload if its size or mtime changed
+    bool refresh_file(const std::filesystem::path &file_path,
+                      const std::string &relative_path,
+                      PendingFiles &pending_files);
+    static void load_build_infos(const PendingFiles &pending_files);
+};
+
+std::filesystem::path get_bench_catalog_path(const std::filesystem::path &bench_path);
+
+bool load_bench_build_info(const std::filesystem::path &json_path, BenchBuildInfo &build_info);
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <map>
 #include <set>
 #include <string>
@@ -178,6 +179,73 @@ static const std::set<std::string_view> green_tick_builds = {
 };
 } // namespace
 
+void BuildCategoryTrie::clear()
+{
+    nodes.clear();
+}
+
+void BuildCategoryTrie::insert(std::string_view key, BuildCategory category)
+{
+    if (nodes.empty())
+        nodes.emplace_back();
+
+    auto node_index = uint32_t{0};
+    for (const auto c : key)
+    {
+        if (!nodes[node_index].has_category)
+        {
+            nodes[node_index].first_category = category;
+            nodes[node_index].has_category = true;
+        }
+
+        auto &children = nodes[node_index].children;
+        const auto it = std::find_if(children.begin(), children.end(), [c](const auto &child) {
+            return child.first == c;
+        });
+
+        if (it != children.end())
+        {
+            node_index = it->second;
+        }
+        else
+        {
+            const auto child_index = static_cast<uint32_t>(nodes.size());
+            children.emplace_back(c, child_index);
+            nodes.emplace_back();
+            node_index = child_index;
+        }
+    }
+
+    if (!nodes[node_index].has_category)
+    {
+        nodes[node_index].first_category = category;
+        nodes[node_index].has_category = true;
+    }
+}
+
+BuildCategory BuildCategoryTrie::find_by_prefix(std::string_view prefix) const
+{
+    if (nodes.empty())
+        return BuildCategory::UNTESTED;
+
+    auto node_index = uint32_t{0};
+    for (const auto c : prefix)
+    {
+        const auto &children = nodes[node_index].children;
+        const auto it = std::find_if(children.begin(), children.end(), [c](const auto &child) {
+            return child.first == c;
+        });
+
+        if (it == children.end())
+            return BuildCategory::UNTESTED;
+
+        node_index = it->second;
+    }
+
+    const auto &node = nodes[node_index];
+    return node.has_category ? node.first_category : BuildCategory::UNTESTED;
+}
+
 void BuildsType::initialize_build_categories()
 {
     if (build_categories_initialized)
@@ -197,6 +265,12 @@ void BuildsType::initialize_build_categories()
     for (const auto &build : yellow_tick_builds)
         build_category_cache[std::string(build)] = BuildCategory::YELLOW_TICKED;
 
+    // The cache is ordered, so the first key reaching a trie node is the
+    // smallest build name starting with that prefix
+    build_category_trie.clear();
+    for (const auto &[name, category] : build_category_cache)
+        build_category_trie.insert(name, category);
+
     build_categories_initialized = true;
 }
 
@@ -215,11 +289,5 @@ BuildCategory BuildsType::get_build_category(const std::string &display_name) co
     if (build_name.contains("mirage"))
         return BuildCategory::RED_CROSSED;
 
-    for (const auto &[name, category] : build_category_cache)
-    {
-        if (name.starts_with(build_name))
-            return category;
-    }
-
-    return BuildCategory::UNTESTED;
+    return build_category_trie.find_by_prefix(build_name);
 }
@@ -1,10 +1,33 @@
 #pragma once
 
-#include <string>
+#include <cstdint>
 #include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "Types.h"
 
+class BuildCategoryTrie
+{
+public:
+    void clear();
+    void insert(std::string_view key, BuildCategory category);
+    BuildCategory find_by_prefix(std::string_view prefix) const;
+
+private:
+    struct Node
+    {
+        std::vector<std::pair<char, uint32_t>> children;
+        // Category of the lexicographically smallest key below this node
+        BuildCategory first_category = BuildCategory::UNTESTED;
+        bool has_category = false;
+    };
+
+    std::vector<Node> nodes;
+};
+
 class BuildsType
 {
 public:
@@ -13,4 +36,5 @@ public:
 
     bool build_categories_initialized = false;
     std::map<std::string, BuildCategory> build_category_cache;
+    BuildCategoryTrie build_category_trie;
 };
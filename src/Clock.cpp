@@ -0,0 +1,19 @@
+#include <atomic>
+
+#include "Clock.h"
+
+namespace
+{
+const auto steady_clock = SteadyClockType{};
+std::atomic<const ClockType *> current_clock = &steady_clock;
+} // namespace
+
+void set_clock(const ClockType *clock)
+{
+    current_clock.store(clock ? clock : &steady_clock, std::memory_order_release);
+}
+
+const ClockType &get_clock()
+{
+    return *current_clock.load(std::memory_order_acquire);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+
+// Time source of the skill detection. The steady clock is used unless a
+// benchmark or test replays a rotation with its own clock.
+class ClockType
+{
+public:
+    virtual ~ClockType() = default;
+
+    virtual std::chrono::steady_clock::time_point now() const = 0;
+};
+
+class SteadyClockType final : public ClockType
+{
+public:
+    std::chrono::steady_clock::time_point now() const override
+    {
+        return std::chrono::steady_clock::now();
+    }
+};
+
+// The clock has to outlive every caller of get_clock(), nullptr restores the steady clock
+void set_clock(const ClockType *clock);
+
+const ClockType &get_clock();
@@ -0,0 +1,198 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <set>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "DataSync.h"
+#include "Downloader.h"
+#include "Sha256.h"
+#include "ZipArchive.h"
+
+namespace
+{
+constexpr auto MANIFEST_VERSION = 1;
+
+bool is_unreserved_url_char(const char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_' ||
+           c == '.' || c == '~' || c == '/';
+}
+
+bool is_valid_download(const std::filesystem::path &path, const DataManifestFile &file)
+{
+    auto ec = std::error_code{};
+    const auto size = std::filesystem::file_size(path, ec);
+    return !ec && size == file.size && hash_file_sha256(path) == file.sha256;
+}
+} // namespace
+
+bool parse_data_manifest(const std::string &content, DataManifest &manifest)
+{
+    try
+    {
+        const auto json = nlohmann::json::parse(content);
+        if (json.at("version").get<int>() != MANIFEST_VERSION)
+            return false;
+
+        manifest.base_url = json.at("base_url").get<std::string>();
+        manifest.files.clear();
+        for (const auto &file_json : json.at("files"))
+        {
+            auto file = DataManifestFile{};
+            file.path = file_json.at("path").get<std::string>();
+            file.size = file_json.at("size").get<uint64_t>();
+            file.sha256 = file_json.at("sha256").get<std::string>();
+            manifest.files.push_back(std::move(file));
+        }
+
+        return !manifest.base_url.empty();
+    }
+    catch (const std::exception &e)
+    {
+        return false;
+    }
+}
+
+std::string get_data_file_url(const std::string &base_url, const std::string &path)
+{
+    auto url = base_url;
+    if (!url.empty() && url.back() != '/')
+        url.push_back('/');
+
+    for (const auto c : path)
+    {
+        if (is_unreserved_url_char(c))
+        {
+            url.push_back(c);
+            continue;
+        }
+
+        char encoded[4];
+        std::snprintf(encoded, sizeof(encoded), "%%%02X", static_cast<unsigned char>(c));
+        url += encoded;
+    }
+
+    return url;
+}
+
+std::vector<DataManifestFile> get_outdated_data_files(const DataManifest &manifest,
+                                                      const std::filesystem::path &data_path)
+{
+    auto outdated_files = std::vector<DataManifestFile>{};
+    for (const auto &file : manifest.files)
+    {
+        const auto local_path = get_zip_entry_path(data_path, file.path);
+        if (local_path.empty() || !is_valid_download(local_path, file))
+            outdated_files.push_back(file);
+    }
+
+    return outdated_files;
+}
+
+DataSyncStats sync_data_files(DownloadServiceType &download_service,
+                              const DataManifest &manifest,
+                              const std::vector<DataManifestFile> &outdated_files,
+                              const std::filesystem::path &data_path)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    auto stats = DataSyncStats{};
+    stats.num_files = manifest.files.size();
+    stats.num_outdated = outdated_files.size();
+
+    struct PendingFile
+    {
+        const DataManifestFile *file = nullptr;
+        std::filesystem::path target_path;
+        std::filesystem::path download_path;
+        std::future<DownloadResult> result;
+    };
+
+    auto pending_files = std::vector<PendingFile>{};
+    pending_files.reserve(outdated_files.size());
+    for (const auto &file : outdated_files)
+    {
+        stats.outdated_bytes += file.size;
+
+        auto target_path = get_zip_entry_path(data_path, file.path);
+        if (target_path.empty())
+        {
+            ++stats.num_failed;
+            continue;
+        }
+
+        auto ec = std::error_code{};
+        std::filesystem::create_directories(target_path.parent_path(), ec);
+
+        auto download_path = target_path;
+        download_path += ".download";
+
+        // Blocks while the download queue is full, earlier files keep completing meanwhile
+        auto result = download_service.submit(get_data_file_url(manifest.base_url, file.path), download_path);
+        pending_files.push_back(
+            PendingFile{&file, std::move(target_path), std::move(download_path), std::move(result)});
+    }
+
+    for (auto &pending : pending_files)
+    {
+        const auto result = pending.result.get();
+        stats.bytes_downloaded += result.bytes;
+
+        auto ec = std::error_code{};
+        if (result.success && is_valid_download(pending.download_path, *pending.file))
+        {
+            std::filesystem::rename(pending.download_path, pending.target_path, ec);
+            if (!ec)
+            {
+                ++stats.num_updated;
+                continue;
+            }
+        }
+
+        std::filesystem::remove(pending.download_path, ec);
+        ++stats.num_failed;
+    }
+
+    stats.duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    return stats;
+}
+
+size_t remove_unlisted_data_files(const DataManifest &manifest,
+                                  const std::filesystem::path &data_path,
+                                  const std::filesystem::path &folder)
+{
+    auto listed_paths = std::set<std::filesystem::path>{};
+    for (const auto &file : manifest.files)
+    {
+        const auto path = get_zip_entry_path(data_path, file.path);
+        if (!path.empty())
+            listed_paths.insert(path.lexically_normal());
+    }
+
+    auto num_removed = size_t{0};
+    auto ec = std::error_code{};
+    auto unlisted_paths = std::vector<std::filesystem::path>{};
+    for (auto it = std::filesystem::recursive_directory_iterator{data_path / folder, ec};
+         !ec && it != std::filesystem::recursive_directory_iterator{};
+         it.increment(ec))
+    {
+        if (it->is_regular_file(ec) && !listed_paths.contains(it->path().lexically_normal()))
+            unlisted_paths.push_back(it->path());
+    }
+
+    for (const auto &path : unlisted_paths)
+    {
+        if (std::filesystem::remove(path, ec))
+            ++num_removed;
+    }
+
+    return num_removed;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Downloader.h"
+
+struct DataManifestFile
+{
+    std::string path; // Relative to the addon directory, forward slashes
+    uint64_t size = 0;
+    std::string sha256;
+};
+
+// Written by scripts/create_data_manifest.py and published with the release
+struct DataManifest
+{
+    std::string base_url;
+    std::vector<DataManifestFile> files;
+};
+
+struct DataSyncStats
+{
+    size_t num_files = 0;
+    size_t num_outdated = 0;
+    size_t num_updated = 0;
+    size_t num_failed = 0;
+    uint64_t outdated_bytes = 0;
+    uintmax_t bytes_downloaded = 0;
+    std::chrono::milliseconds duration = std::chrono::milliseconds(0);
+};
+
+bool parse_data_manifest(const std::string &content, DataManifest &manifest);
+
+std::string get_data_file_url(const std::string &base_url, const std::string &path);
+
+// Files that are missing locally or whose size or hash differs from the manifest
+std::vector<DataManifestFile> get_outdated_data_files(const DataManifest &manifest,
+                                                      const std::filesystem::path &data_path);
+
+// Downloads the files in parallel next to their target and swaps each one in
+// only after its size and hash match the manifest
+DataSyncStats sync_data_files(DownloadServiceType &download_service,
+                              const DataManifest &manifest,
+                              const std::vector<DataManifestFile> &outdated_files,
+                              const std::filesystem::path &data_path);
+
+// Removes the files below data_path / folder that the manifest does not list,
+// returns the number of removed files
+size_t remove_unlisted_data_files(const DataManifest &manifest,
+                                  const std::filesystem::path &data_path,
+                                  const std::filesystem::path &folder);
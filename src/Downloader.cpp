@@ -0,0 +1,358 @@
+#ifdef _WIN32
+#include <windows.h>
+
+#include <wininet.h>
+#pragma comment(lib, "wininet.lib")
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "Downloader.h"
+#include "Logger.h"
+
+namespace
+{
+#ifdef _WIN32
+constexpr auto READ_BUFFER_SIZE = size_t{64 * 1024};
+
+class WinInetTransport final : public IHttpTransport
+{
+public:
+    WinInetTransport() : read_buffer(READ_BUFFER_SIZE)
+    {
+        session = InternetOpenA("GW2RotaHelper", INTERNET_OPEN_TYPE_PRECONFIG, nullptr, nullptr, 0);
+    }
+
+    ~WinInetTransport() override
+    {
+        for (const auto &[host, connection] : connections)
+            InternetCloseHandle(connection);
+
+        if (session != nullptr)
+            InternetCloseHandle(session);
+    }
+
+    HttpStatus get(const std::string &url, const DataSink &on_data) override
+    {
+        if (session == nullptr)
+            return HttpStatus::FAILED;
+
+        char host[256] = {0};
+        char path[2048] = {0};
+        char extra[1024] = {0};
+
+        auto components = URL_COMPONENTSA{};
+        components.dwStructSize = sizeof(components);
+        components.lpszHostName = host;
+        components.dwHostNameLength = sizeof(host);
+        components.lpszUrlPath = path;
+        components.dwUrlPathLength = sizeof(path);
+        components.lpszExtraInfo = extra;
+        components.dwExtraInfoLength = sizeof(extra);
+
+        if (!InternetCrackUrlA(url.c_str(), 0, 0, &components))
+            return HttpStatus::FAILED;
+
+        const auto is_secure = components.nScheme == INTERNET_SCHEME_HTTPS;
+        const auto connection_key = std::string{host} + ":" + std::to_string(components.nPort);
+
+        const auto connection = get_connection(connection_key, host, components.nPort);
+        if (connection == nullptr)
+            return HttpStatus::RETRY;
+
+        const auto object_name = std::string{path} + extra;
+        auto flags = DWORD{INTERNET_FLAG_KEEP_CONNECTION | INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE |
+                           INTERNET_FLAG_NO_UI};
+        if (is_secure)
+            flags |= INTERNET_FLAG_SECURE;
+
+        const auto request =
+            HttpOpenRequestA(connection, "GET", object_name.c_str(), nullptr, nullptr, nullptr, flags, 0);
+        if (request == nullptr)
+        {
+            drop_connection(connection_key);
+            return HttpStatus::RETRY;
+        }
+
+        if (!HttpSendRequestA(request, nullptr, 0, nullptr, 0))
+        {
+            InternetCloseHandle(request);
+            drop_connection(connection_key);
+            return HttpStatus::RETRY;
+        }
+
+        auto status_code = DWORD{0};
+        auto status_code_size = DWORD{sizeof(status_code)};
+        HttpQueryInfoA(request,
+                       HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER,
+                       &status_code,
+                       &status_code_size,
+                       nullptr);
+
+        if (status_code != 200)
+        {
+            InternetCloseHandle(request);
+            if (status_code == 408 || status_code == 429 || status_code >= 500)
+                return HttpStatus::RETRY;
+            return HttpStatus::FAILED;
+        }
+
+        auto status = HttpStatus::OK;
+        auto bytes_read = DWORD{0};
+        do
+        {
+            if (!InternetReadFile(request, read_buffer.data(), static_cast<DWORD>(read_buffer.size()), &bytes_read))
+            {
+                status = HttpStatus::RETRY;
+                break;
+            }
+
+            if (bytes_read > 0 && !on_data(read_buffer.data(), bytes_read))
+            {
+                status = HttpStatus::FAILED;
+                break;
+            }
+        } while (bytes_read > 0);
+
+        InternetCloseHandle(request);
+        return status;
+    }
+
+private:
+    HINTERNET get_connection(const std::string &connection_key, const char *host, const INTERNET_PORT port)
+    {
+        const auto it = connections.find(connection_key);
+        if (it != connections.end())
+            return it->second;
+
+        const auto connection =
+            InternetConnectA(session, host, port, nullptr, nullptr, INTERNET_SERVICE_HTTP, 0, 0);
+        if (connection != nullptr)
+            connections[connection_key] = connection;
+
+        return connection;
+    }
+
+    void drop_connection(const std::string &connection_key)
+    {
+        const auto it = connections.find(connection_key);
+        if (it == connections.end())
+            return;
+
+        InternetCloseHandle(it->second);
+        connections.erase(it);
+    }
+
+    HINTERNET session = nullptr;
+    std::map<std::string, HINTERNET> connections;
+    std::vector<char> read_buffer;
+};
+#endif
+} // namespace
+
+#ifdef _WIN32
+std::unique_ptr<IHttpTransport> make_wininet_transport()
+{
+    return std::make_unique<WinInetTransport>();
+}
+#endif
+
+DownloadServiceType::DownloadServiceType(HttpTransportFactory transport_factory, DownloadServiceConfig config)
+    : transport_factory(std::move(transport_factory)), config(config)
+{
+    const auto num_workers = std::max(size_t{1}, config.num_workers);
+    workers.reserve(num_workers);
+    for (auto i = size_t{0}; i < num_workers; ++i)
+        workers.emplace_back(&DownloadServiceType::worker_loop, this);
+}
+
+DownloadServiceType::~DownloadServiceType()
+{
+    shutdown();
+}
+
+std::future<DownloadResult> DownloadServiceType::submit(const std::string &url,
+                                                       const std::filesystem::path &out_path,
+                                                       DownloadCallback on_complete)
+{
+    return *enqueue(Job{url, out_path, std::promise<DownloadResult>{}, std::move(on_complete)}, true);
+}
+
+std::optional<std::future<DownloadResult>> DownloadServiceType::try_submit(const std::string &url,
+                                                                          const std::filesystem::path &out_path,
+                                                                          DownloadCallback on_complete)
+{
+    return enqueue(Job{url, out_path, std::promise<DownloadResult>{}, std::move(on_complete)}, false);
+}
+
+std::optional<std::future<DownloadResult>> DownloadServiceType::enqueue(Job job, const bool wait_for_space)
+{
+    auto future = job.promise.get_future();
+
+    auto lock = std::unique_lock<std::mutex>{mutex};
+    const auto max_queue_depth = std::max(size_t{1}, config.max_queue_depth);
+    if (wait_for_space)
+        queue_not_full.wait(lock, [this, max_queue_depth] { return stop || queue.size() < max_queue_depth; });
+
+    if (stop)
+    {
+        lock.unlock();
+        complete_job(job, DownloadResult{job.url, job.out_path, false, 0, 0});
+        return future;
+    }
+
+    if (queue.size() >= max_queue_depth)
+        return std::nullopt;
+
+    job.job_idx = num_jobs++;
+    queue.push_back(std::move(job));
+    lock.unlock();
+
+    queue_not_empty.notify_one();
+    return future;
+}
+
+void DownloadServiceType::shutdown()
+{
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        if (stop && workers.empty())
+            return;
+        stop = true;
+    }
+
+    queue_not_empty.notify_all();
+    queue_not_full.notify_all();
+    stop_cv.notify_all();
+
+    for (auto &worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+
+    // Jobs that never started are reported as failed
+    auto unstarted = std::deque<Job>{};
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        unstarted.swap(queue);
+    }
+
+    for (auto &job : unstarted)
+        complete_job(job, DownloadResult{job.url, job.out_path, false, 0, 0});
+}
+
+void DownloadServiceType::complete_job(Job &job, DownloadResult result)
+{
+    if (job.on_complete)
+        job.on_complete(result);
+
+    job.promise.set_value(std::move(result));
+}
+
+void DownloadServiceType::worker_loop()
+{
+    auto transport = transport_factory ? transport_factory() : nullptr;
+
+    while (true)
+    {
+        auto job = Job{};
+        {
+            auto lock = std::unique_lock<std::mutex>{mutex};
+            queue_not_empty.wait(lock, [this] { return stop || !queue.empty(); });
+            if (stop)
+                return;
+
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        queue_not_full.notify_one();
+
+        if (transport == nullptr)
+        {
+            complete_job(job, DownloadResult{job.url, job.out_path, false, 0, 0});
+            continue;
+        }
+
+        complete_job(job, run_job(*transport, job));
+    }
+}
+
+DownloadResult DownloadServiceType::run_job(IHttpTransport &transport, const Job &job)
+{
+    auto result = DownloadResult{job.url, job.out_path, false, 0, 0};
+
+    // Per job, two jobs for the same out_path must not write into one temp file
+    auto part_path = job.out_path;
+    part_path += "." + std::to_string(job.job_idx) + ".part";
+
+    for (auto attempt = uint32_t{1}; attempt <= std::max(uint32_t{1}, config.max_attempts); ++attempt)
+    {
+        result.attempts = attempt;
+        result.bytes = 0;
+
+        auto status = HttpStatus::FAILED;
+        auto write_ok = false;
+        {
+            auto file = std::ofstream{part_path, std::ios::binary | std::ios::trunc};
+            if (!file.is_open())
+            {
+                log_message(LogLevel::CRITICAL, "Failed to create output file");
+                break;
+            }
+
+            status = transport.get(job.url, [&file, &result](const char *data, size_t size) {
+                file.write(data, static_cast<std::streamsize>(size));
+                result.bytes += size;
+                return file.good();
+            });
+
+            file.flush();
+            write_ok = file.good();
+        }
+
+        if (status == HttpStatus::OK && write_ok)
+        {
+            auto ec = std::error_code{};
+            std::filesystem::rename(part_path, job.out_path, ec);
+            result.success = !ec;
+            break;
+        }
+
+        auto ec = std::error_code{};
+        std::filesystem::remove(part_path, ec);
+
+        if (status == HttpStatus::FAILED || !wait_for_backoff(attempt))
+            break;
+    }
+
+    if (result.success)
+        log_message(LogLevel::DEBUG, "Successfully downloaded file");
+    else
+        log_message(LogLevel::WARNING, "Failed to download file");
+
+    return result;
+}
+
+bool DownloadServiceType::wait_for_backoff(const uint32_t attempt)
+{
+    const auto delay = config.initial_backoff * (1 << std::min(attempt - 1, uint32_t{6}));
+
+    // Own condition variable, a submit must wake an idle worker and not this one
+    auto lock = std::unique_lock<std::mutex>{mutex};
+    return !stop_cv.wait_for(lock, delay, [this] { return stop; });
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class HttpStatus : uint8_t
+{
+    OK,
+    RETRY,
+    FAILED,
+};
+
+// Minimal blocking HTTP GET. Every download worker owns one transport, so
+// implementations may keep sessions and per-host connections without locking.
+class IHttpTransport
+{
+public:
+    using DataSink = std::function<bool(const char *data, size_t size)>;
+
+    virtual ~IHttpTransport() = default;
+
+    virtual HttpStatus get(const std::string &url, const DataSink &on_data) = 0;
+};
+
+using HttpTransportFactory = std::function<std::unique_ptr<IHttpTransport>()>;
+
+#ifdef _WIN32
+std::unique_ptr<IHttpTransport> make_wininet_transport();
+#endif
+
+struct DownloadResult
+{
+    std::string url;
+    std::filesystem::path out_path;
+    bool success = false;
+    uint32_t attempts = 0;
+    uintmax_t bytes = 0;
+};
+
+// Invoked on the worker thread once a job finished, before its future is ready
+using DownloadCallback = std::function<void(const DownloadResult &result)>;
+
+struct DownloadServiceConfig
+{
+    size_t num_workers = 4;
+    size_t max_queue_depth = 64;
+    uint32_t max_attempts = 3;
+    std::chrono::milliseconds initial_backoff = std::chrono::milliseconds(250);
+};
+
+class DownloadServiceType
+{
+public:
+    DownloadServiceType(HttpTransportFactory transport_factory, DownloadServiceConfig config = {});
+    ~DownloadServiceType();
+
+    DownloadServiceType(const DownloadServiceType &) = delete;
+    DownloadServiceType &operator=(const DownloadServiceType &) = delete;
+
+    // Blocks while the queue is full. The file is written to out_path only
+    // after the whole body arrived. Every job writes its own temp file, jobs
+    // for the same out_path do not clash, the last one to finish wins.
+    std::future<DownloadResult> submit(const std::string &url,
+                                       const std::filesystem::path &out_path,
+                                       DownloadCallback on_complete = {});
+
+    // Never blocks, for the render thread. Returns std::nullopt while the
+    // queue is full, the caller submits the job again on a later frame.
+    std::optional<std::future<DownloadResult>> try_submit(const std::string &url,
+                                                          const std::filesystem::path &out_path,
+                                                          DownloadCallback on_complete = {});
+    void shutdown();
+
+    size_t get_num_workers() const
+    {
+        return workers.size();
+    }
+
+private:
+    struct Job
+    {
+        std::string url;
+        std::filesystem::path out_path;
+        std::promise<DownloadResult> promise;
+        DownloadCallback on_complete;
+        uint64_t job_idx = 0;
+    };
+
+    // Returns std::nullopt if the queue is full and wait_for_space is false
+    std::optional<std::future<DownloadResult>> enqueue(Job job, const bool wait_for_space);
+    static void complete_job(Job &job, DownloadResult result);
+    void worker_loop();
+    DownloadResult run_job(IHttpTransport &transport, const Job &job);
+    bool wait_for_backoff(const uint32_t attempt);
+
+    HttpTransportFactory transport_factory;
+    DownloadServiceConfig config;
+
+    std::mutex mutex;
+    std::condition_variable queue_not_empty;
+    std::condition_variable queue_not_full;
+    std::condition_variable stop_cv;
+    std::deque<Job> queue;
+    uint64_t num_jobs = 0;
+    bool stop = false;
+
+    std::vector<std::thread> workers;
+};
@@ -1,151 +1,471 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <future>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <set>
 #include <sstream>
 #include <string>
-#include <thread>
+#include <string_view>
+#include <system_error>
+#include <utility>
 #include <vector>
 
-#include <shlwapi.h>
-#include <urlmon.h>
-#include <windows.h>
-#include <wininet.h>
-
-#pragma comment(lib, "wininet.lib")
-#pragma comment(lib, "urlmon.lib")
-#pragma comment(lib, "shlwapi.lib")
-
 #include "nlohmann/json.hpp"
 
+#include "BenchCatalog.h"
+#include "Builds.h"
 #include "FileUtils.h"
-#include "MumbleUtils.h"
+#include "Logger.h"
+#include "MappedFile.h"
 #include "Settings.h"
 #include "Types.h"
 #include "TypesUtils.h"
 
 namespace
 {
-void get_keybind_secondary_info(size_t button2_start, const std::string &line, KeybindInfo &keybind)
+// The SkillKeyMapping and buildMetadata objects closing the shipped bench files
+// take up less than 600 bytes
+constexpr auto BUILD_HEADER_TAIL_SIZE = size_t{4096};
+
+struct XmlActionAttributes
+{
+    std::string_view name;
+    std::string_view device;
+    std::string_view button;
+    std::string_view mod;
+    std::string_view device2;
+    std::string_view button2;
+    std::string_view mod2;
+    bool has_button2 = false;
+    bool has_device2 = false;
+    bool has_mod2 = false;
+};
+
+bool is_xml_space(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+template <typename T>
+T parse_keybind_value(std::string_view value, const T fallback)
+{
+    auto result = 0;
+    const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (ec != std::errc{})
+        return fallback;
+
+    return static_cast<T>(result);
+}
+
+Device parse_keybind_device(std::string_view value)
+{
+    if (value == "Keyboard")
+        return Device::KEYBOARD;
+    if (value == "Mouse")
+        return Device::MOUSE;
+
+    return parse_keybind_value(value, Device::KEYBOARD);
+}
+
+void set_xml_action_attribute(std::string_view attribute, std::string_view value, XmlActionAttributes &attributes)
 {
-    auto device2_start = line.find("device2=\"");
-    device2_start += std::string{"device2=\""}.size();
-    auto device2_end = line.find("\"", device2_start);
-    if (device2_end != std::string::npos)
+    if (attribute == "name")
     {
-        auto device2_str = line.substr(device2_start, device2_end - device2_start);
-        try
-        {
-            if (device2_str == "Keyboard")
-                device2_str = "0";
-            else if (device2_str == "Mouse")
-                device2_str = "1";
-            keybind.device = static_cast<Device>(std::stoi(device2_str));
-        }
-        catch (...)
-        {
-            keybind.device = Device::KEYBOARD;
-        }
+        attributes.name = value;
     }
+    else if (attribute == "device")
+    {
+        attributes.device = value;
+    }
+    else if (attribute == "button")
+    {
+        attributes.button = value;
+    }
+    else if (attribute == "mod")
+    {
+        attributes.mod = value;
+    }
+    else if (attribute == "device2")
+    {
+        attributes.device2 = value;
+        attributes.has_device2 = true;
+    }
+    else if (attribute == "button2")
+    {
+        attributes.button2 = value;
+        attributes.has_button2 = true;
+    }
+    else if (attribute == "mod2")
+    {
+        attributes.mod2 = value;
+        attributes.has_mod2 = true;
+    }
+}
 
-    button2_start += std::string{"button2=\""}.size();
-    auto button2_end = line.find("\"", button2_start);
-    if (button2_end != std::string::npos)
+// Reads the attributes of the tag starting at pos up to its closing '>'.
+// Returns the position after the tag.
+size_t read_xml_action_attributes(std::string_view xml, size_t pos, XmlActionAttributes &attributes)
+{
+    while (pos < xml.size())
     {
-        auto button2_str = line.substr(button2_start, button2_end - button2_start);
-        try
-        {
-            const auto button_val = std::stoi(button2_str);
-            keybind.button = static_cast<Keys>(button_val);
-        }
-        catch (...)
+        while (pos < xml.size() && is_xml_space(xml[pos]))
+            ++pos;
+
+        if (pos >= xml.size() || xml[pos] == '>')
+            return pos + 1;
+
+        if (xml[pos] == '/')
         {
-            keybind.button = Keys::NONE;
+            ++pos;
+            continue;
         }
+
+        const auto attribute_start = pos;
+        while (pos < xml.size() && !is_xml_space(xml[pos]) && xml[pos] != '=' && xml[pos] != '>' && xml[pos] != '/')
+            ++pos;
+        const auto attribute = xml.substr(attribute_start, pos - attribute_start);
+
+        while (pos < xml.size() && is_xml_space(xml[pos]))
+            ++pos;
+        if (pos >= xml.size() || xml[pos] != '=')
+            continue;
+
+        ++pos;
+        while (pos < xml.size() && is_xml_space(xml[pos]))
+            ++pos;
+        if (pos >= xml.size() || (xml[pos] != '"' && xml[pos] != '\''))
+            continue;
+
+        const auto quote = xml[pos];
+        const auto value_start = pos + 1;
+        const auto value_end = xml.find(quote, value_start);
+        if (value_end == std::string_view::npos)
+            return xml.size();
+
+        set_xml_action_attribute(attribute, xml.substr(value_start, value_end - value_start), attributes);
+        pos = value_end + 1;
     }
 
-    auto mod2_start = line.find("mod2=\"");
-    if (mod2_start != std::string::npos)
-    {
-        mod2_start += std::string{"mod2=\""}.size();
-        auto mod2_end = line.find("\"", mod2_start);
-        if (mod2_end != std::string::npos)
+    return pos;
+}
+
+// Resolves the predefined XML entities, unknown ones are kept verbatim
+std::string decode_xml_entities(std::string_view value)
+{
+    static constexpr std::pair<std::string_view, char> entities[] = {
+        {"&amp;", '&'},
+        {"&lt;", '<'},
+        {"&gt;", '>'},
+        {"&quot;", '"'},
+        {"&apos;", '\''},
+    };
+
+    auto decoded = std::string{};
+    decoded.reserve(value.size());
+
+    auto pos = size_t{0};
+    while (pos < value.size())
+    {
+        const auto amp_pos = value.find('&', pos);
+        decoded.append(value.substr(pos, amp_pos - pos));
+        if (amp_pos == std::string_view::npos)
+            break;
+
+        pos = amp_pos + 1;
+        auto is_decoded = false;
+        for (const auto &[entity, c] : entities)
         {
-            auto mod2_str = line.substr(mod2_start, mod2_end - mod2_start);
-            try
-            {
-                const auto mod_val = std::stoi(mod2_str);
-                keybind.modifier = static_cast<Modifiers>(mod_val);
-            }
-            catch (...)
+            if (value.substr(amp_pos, entity.size()) == entity)
             {
-                keybind.modifier = static_cast<Modifiers>(0);
+                decoded.push_back(c);
+                pos = amp_pos + entity.size();
+                is_decoded = true;
+                break;
             }
         }
+        if (!is_decoded)
+            decoded.push_back('&');
+    }
+
+    return decoded;
+}
+
+KeybindInfo get_keybind_info(const XmlActionAttributes &attributes)
+{
+    auto keybind = KeybindInfo{};
+    if (attributes.name.find('&') == std::string_view::npos)
+        keybind.action_name = std::string{attributes.name};
+    else
+        keybind.action_name = decode_xml_entities(attributes.name);
+
+    if (attributes.has_button2)
+    {
+        if (attributes.has_device2)
+            keybind.device = parse_keybind_device(attributes.device2);
+        keybind.button = parse_keybind_value(attributes.button2, Keys::NONE);
+        if (attributes.has_mod2)
+            keybind.modifier = parse_keybind_value(attributes.mod2, Modifiers::NONE);
+    }
+    else
+    {
+        keybind.device = parse_keybind_device(attributes.device);
+        keybind.button = parse_keybind_value(attributes.button, Keys::NONE);
+        keybind.modifier = parse_keybind_value(attributes.mod, Modifiers::NONE);
+    }
+
+    return keybind;
+}
+
+int64_t get_file_mtime(const std::filesystem::path &path)
+{
+    auto ec = std::error_code{};
+    const auto time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return 0;
+
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+size_t skip_json_whitespace(std::string_view text, size_t pos)
+{
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+        ++pos;
+
+    return pos;
+}
+
+size_t skip_json_string(std::string_view text, size_t pos)
+{
+    // pos points at the opening quote
+    for (++pos; pos < text.size(); ++pos)
+    {
+        if (text[pos] == '\\')
+            ++pos;
+        else if (text[pos] == '"')
+            return pos + 1;
     }
+
+    return std::string_view::npos;
 }
 
-void get_keybind_primary_info(const std::string &line, KeybindInfo &keybind)
+// Returns the position past the value starting at pos without building it
+size_t skip_json_value(std::string_view text, size_t pos)
 {
-    auto device_start = line.find("device=\"");
-    device_start += std::string{"device=\""}.size();
-    auto device_end = line.find("\"", device_start);
-    if (device_end != std::string::npos)
+    if (pos >= text.size())
+        return std::string_view::npos;
+
+    if (text[pos] == '"')
+        return skip_json_string(text, pos);
+
+    if (text[pos] != '{' && text[pos] != '[')
+    {
+        while (pos < text.size() && text[pos] != ',' && text[pos] != '}' && text[pos] != ']' && text[pos] != ' ' &&
+               text[pos] != '\t' && text[pos] != '\n' && text[pos] != '\r')
+            ++pos;
+
+        return pos;
+    }
+
+    auto depth = 0;
+    while (pos < text.size())
     {
-        auto device_str = line.substr(device_start, device_end - device_start);
-        try
+        const auto c = text[pos];
+        if (c == '"')
+        {
+            pos = skip_json_string(text, pos);
+            if (pos == std::string_view::npos)
+                return pos;
+            continue;
+        }
+
+        if (c == '{' || c == '[')
         {
-            if (device_str == "Keyboard")
-                device_str = "0";
-            else if (device_str == "Mouse")
-                device_str = "1";
-            keybind.device = static_cast<Device>(std::stoi(device_str));
+            ++depth;
         }
-        catch (...)
+        else if (c == '}' || c == ']')
         {
-            keybind.device = Device::KEYBOARD;
+            if (--depth == 0)
+                return pos + 1;
         }
+
+        ++pos;
     }
 
-    auto button_start = line.find("button=\"");
-    if (button_start != std::string::npos)
+    return std::string_view::npos;
+}
+
+// Value of a key of the top level object, the other values are skipped without building them
+std::string_view find_top_level_value(std::string_view text, std::string_view key)
+{
+    auto pos = skip_json_whitespace(text, 0);
+    if (pos >= text.size() || text[pos] != '{')
+        return {};
+
+    pos = skip_json_whitespace(text, pos + 1);
+    while (pos < text.size() && text[pos] == '"')
     {
-        button_start += std::string{"button=\""}.size();
-        const auto button_end = line.find("\"", button_start);
-        if (button_end != std::string::npos)
-        {
-            std::string button_str = line.substr(button_start, button_end - button_start);
-            try
-            {
-                int button_val = std::stoi(button_str);
-                keybind.button = static_cast<Keys>(button_val);
-            }
-            catch (...)
-            {
-                keybind.button = Keys::NONE;
-            }
-        }
+        const auto key_end = skip_json_string(text, pos);
+        if (key_end == std::string_view::npos)
+            return {};
+
+        const auto curr_key = text.substr(pos + 1, key_end - pos - 2);
+
+        pos = skip_json_whitespace(text, key_end);
+        if (pos >= text.size() || text[pos] != ':')
+            return {};
+
+        const auto value_start = skip_json_whitespace(text, pos + 1);
+        const auto value_end = skip_json_value(text, value_start);
+        if (value_end == std::string_view::npos)
+            return {};
+
+        if (curr_key == key)
+            return text.substr(value_start, value_end - value_start);
+
+        pos = skip_json_whitespace(text, value_end);
+        if (pos < text.size() && text[pos] == ',')
+            pos = skip_json_whitespace(text, pos + 1);
     }
 
-    auto mod_start = line.find("mod=\"");
-    if (mod_start != std::string::npos)
+    return {};
+}
+
+// Value of the object under key near the end of the top level object, which
+// has to be followed by next_key or, if next_key is empty, by the closing
+// brace. Empty if the text does not end like that.
+std::string_view find_trailing_object(std::string_view text, std::string_view key, std::string_view next_key)
+{
+    const auto key_pos = text.rfind(key);
+    if (key_pos == std::string_view::npos)
+        return {};
+
+    // A key of the top level object follows its opening brace or a comma
+    auto before = key_pos;
+    while (before > 0 && (text[before - 1] == ' ' || text[before - 1] == '\t' || text[before - 1] == '\n' ||
+                          text[before - 1] == '\r'))
+        --before;
+    if (before == 0 || (text[before - 1] != ',' && text[before - 1] != '{'))
+        return {};
+
+    auto pos = skip_json_whitespace(text, key_pos + key.size());
+    if (pos >= text.size() || text[pos] != ':')
+        return {};
+
+    const auto value_start = skip_json_whitespace(text, pos + 1);
+    if (value_start >= text.size() || text[value_start] != '{')
+        return {};
+
+    const auto value_end = skip_json_value(text, value_start);
+    if (value_end == std::string_view::npos)
+        return {};
+
+    pos = skip_json_whitespace(text, value_end);
+    if (next_key.empty())
     {
-        mod_start += std::string{"mod=\""}.size();
-        const auto mod_end = line.find("\"", mod_start);
-        if (mod_end != std::string::npos)
-        {
-            std::string mod_str = line.substr(mod_start, mod_end - mod_start);
-            try
-            {
-                int mod_val = std::stoi(mod_str);
-                keybind.modifier = static_cast<Modifiers>(mod_val);
-            }
-            catch (...)
-            {
-                keybind.modifier = static_cast<Modifiers>(0);
-            }
-        }
+        if (pos >= text.size() || text[pos] != '}' || skip_json_whitespace(text, pos + 1) != text.size())
+            return {};
+    }
+    else
+    {
+        if (pos >= text.size() || text[pos] != ',')
+            return {};
+        if (!text.substr(skip_json_whitespace(text, pos + 1)).starts_with(next_key))
+            return {};
+    }
+
+    return text.substr(value_start, value_end - value_start);
+}
+
+// The bench files end with the SkillKeyMapping and buildMetadata objects, so
+// both values can be found in the tail of the file
+std::string_view find_trailing_build_metadata(std::string_view text)
+{
+    return find_trailing_object(text, "\"buildMetadata\"", {});
+}
+
+std::string_view find_trailing_skill_key_mapping(std::string_view text)
+{
+    return find_trailing_object(text, "\"SkillKeyMapping\"", "\"buildMetadata\"");
+}
+
+// Reads at most max_bytes from the end of the file
+bool read_file_tail(const std::filesystem::path &path, const size_t max_bytes, std::string &text, bool &is_whole_file)
+{
+    auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+    if (!file)
+        return false;
+
+    const auto file_size = static_cast<size_t>(std::max(std::streamoff{0}, std::streamoff{file.tellg()}));
+    const auto num_bytes = std::min(file_size, max_bytes);
+
+    file.seekg(static_cast<std::streamoff>(file_size - num_bytes));
+    text.resize(num_bytes);
+    file.read(text.data(), static_cast<std::streamsize>(num_bytes));
+
+    is_whole_file = num_bytes == file_size;
+
+    return file.gcount() == static_cast<std::streamsize>(num_bytes);
+}
+
+std::string_view get_build_type_tags(const std::string &path_str)
+{
+    static constexpr std::string_view build_type_tags[4][3] = {
+        {"", "[Power] ", "[Condi] "},
+        {"[DPS] ", "[DPS] [Power] ", "[DPS] [Condi] "},
+        {"[Quick] ", "[Quick] [Power] ", "[Quick] [Condi] "},
+        {"[Alac] ", "[Alac] [Power] ", "[Alac] [Condi] "},
+    };
+
+    auto role_index = 0;
+    if (path_str.find("dps") != std::string::npos)
+        role_index = 1;
+    else if (path_str.find("quick") != std::string::npos)
+        role_index = 2;
+    else if (path_str.find("alac") != std::string::npos)
+        role_index = 3;
+
+    auto damage_index = 0;
+    if (path_str.find("power") != std::string::npos)
+        damage_index = 1;
+    else if (path_str.find("condition") != std::string::npos)
+        damage_index = 2;
+
+    return build_type_tags[role_index][damage_index];
+}
+
+void set_bench_display_data(BenchFileInfo &file_info, const BuildsType &builds)
+{
+    const auto path_str = file_info.relative_path.string();
+
+    file_info.search_name = to_lowercase(file_info.display_name);
+    file_info.search_path = to_lowercase(path_str);
+
+    if (file_info.is_directory_header)
+        return;
+
+    file_info.formatted_name = format_build_name(file_info.display_name).substr(4);
+    file_info.build_type_tags = get_build_type_tags(path_str);
+    file_info.category = builds.get_build_category(file_info.display_name);
+
+    const auto &build_info = file_info.build_info;
+    if (build_info.overall_dps > 0.0)
+    {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.1fk DPS", build_info.overall_dps / 1000.0);
+        file_info.build_info_text = buf;
+    }
+
+    if (!build_info.elite_spec.empty())
+    {
+        if (!file_info.build_info_text.empty())
+            file_info.build_info_text += " | ";
+        file_info.build_info_text += build_info.elite_spec;
     }
 }
 }; // namespace
@@ -188,12 +508,12 @@ std::string to_lowercase(const std::string &str)
 }
 
 void filter_by_profession(std::vector<BenchFileInfo> &benches_files,
+                          const std::string &profession_name,
                           std::vector<std::pair<int, const BenchFileInfo *>> &filtered_files,
                           std::set<std::string> &directories_with_matches)
 {
     // When filter is empty, filter by current character's profession
-    const auto profession = get_current_profession_name();
-    auto current_profession = to_lowercase(profession);
+    auto current_profession = to_lowercase(profession_name);
 
     if (current_profession.empty())
     {
@@ -214,8 +534,8 @@ void filter_by_profession(std::vector<BenchFileInfo> &benches_files,
 
             if (!file_info.is_directory_header)
             {
-                auto display_lower = to_lowercase(file_info.display_name);
-                auto path_lower = to_lowercase(file_info.relative_path.string());
+                const auto &display_lower = file_info.search_name;
+                const auto &path_lower = file_info.search_path;
 
                 bool matches = false;
 
@@ -263,8 +583,8 @@ void filter_by_profession(std::vector<BenchFileInfo> &benches_files,
             }
             else
             {
-                auto display_lower = to_lowercase(file_info.display_name);
-                auto path_lower = to_lowercase(file_info.relative_path.string());
+                const auto &display_lower = file_info.search_name;
+                const auto &path_lower = file_info.search_path;
 
                 bool matches = false;
 
@@ -307,7 +627,7 @@ void filter_by_text(std::vector<BenchFileInfo> &benches_files,
 
         if (!file_info.is_directory_header)
         {
-            auto display_lower = to_lowercase(file_info.display_name);
+            const auto &display_lower = file_info.search_name;
 
             if (display_lower.find(filter_string) != std::string::npos)
             {
@@ -333,7 +653,7 @@ void filter_by_text(std::vector<BenchFileInfo> &benches_files,
         }
         else
         {
-            auto display_lower = to_lowercase(file_info.display_name);
+            const auto &display_lower = file_info.search_name;
 
             if (display_lower.find(filter_string) != std::string::npos)
             {
@@ -345,13 +665,14 @@ void filter_by_text(std::vector<BenchFileInfo> &benches_files,
 
 std::pair<std::vector<std::pair<int, const BenchFileInfo *>>, std::set<std::string>> get_file_data_pairs(
     std::vector<BenchFileInfo> &benches_files,
-    char *filter_string)
+    char *filter_string,
+    const std::string &profession_name)
 {
     auto filtered_files = std::vector<std::pair<int, const BenchFileInfo *>>{};
     auto directories_with_matches = std::set<std::string>{};
 
     if (filter_string[0] == '\0' || filter_string == nullptr)
-        filter_by_profession(benches_files, filtered_files, directories_with_matches);
+        filter_by_profession(benches_files, profession_name, filtered_files, directories_with_matches);
     else
         filter_by_text(benches_files, filter_string, filtered_files, directories_with_matches);
 
@@ -367,12 +688,59 @@ bool load_rotaion_json(const std::filesystem::path &json_path, nlohmann::json &j
     }
     catch (const nlohmann::json::exception &e)
     {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Error parsing rotation data JSON");
+        log_message(LogLevel::CRITICAL, "Error parsing rotation data JSON");
         return false;
     }
     catch (const std::exception &e)
     {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Error loading rotation data");
+        log_message(LogLevel::CRITICAL, "Error loading rotation data");
+        return false;
+    }
+
+    return true;
+}
+
+bool load_build_header_json(const std::filesystem::path &json_path, nlohmann::json &j)
+{
+    auto text = std::string{};
+    auto is_whole_file = false;
+    if (!read_file_tail(json_path, BUILD_HEADER_TAIL_SIZE, text, is_whole_file))
+    {
+        log_message(LogLevel::CRITICAL, "Error loading rotation data");
+        return false;
+    }
+
+    auto metadata = find_trailing_build_metadata(text);
+    auto skill_key_mapping = find_trailing_skill_key_mapping(text);
+    if ((metadata.empty() || skill_key_mapping.empty()) && !is_whole_file)
+    {
+        // Not written by the converter, the objects may be anywhere in the file
+        if (!read_file_tail(json_path, std::numeric_limits<size_t>::max(), text, is_whole_file))
+        {
+            log_message(LogLevel::CRITICAL, "Error loading rotation data");
+            return false;
+        }
+        // The views pointed into the tail
+        metadata = {};
+        skill_key_mapping = {};
+    }
+    if (metadata.empty())
+        metadata = find_top_level_value(text, "buildMetadata");
+    if (skill_key_mapping.empty())
+        skill_key_mapping = find_top_level_value(text, "SkillKeyMapping");
+    if (metadata.empty())
+        return false;
+
+    try
+    {
+        j = nlohmann::json::object();
+        j["buildMetadata"] = nlohmann::json::parse(metadata);
+        if (!skill_key_mapping.empty())
+            j["SkillKeyMapping"] = nlohmann::json::parse(skill_key_mapping);
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+        log_message(LogLevel::CRITICAL, "Error parsing rotation data JSON");
         return false;
     }
 
@@ -391,12 +759,12 @@ bool load_skill_data_map(const std::filesystem::path &json_path, nlohmann::json
     }
     catch (const nlohmann::json::exception &e)
     {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Error parsing skill data JSON");
+        log_message(LogLevel::CRITICAL, "Error parsing skill data JSON");
         return false;
     }
     catch (const std::exception &e)
     {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Error loading skill data");
+        log_message(LogLevel::CRITICAL, "Error loading skill data");
         return false;
     }
 
@@ -438,302 +806,118 @@ std::string format_build_name(const std::string &raw_name)
     return "    " + result;
 }
 
-std::vector<BenchFileInfo> get_bench_files(const std::filesystem::path &bench_path)
+std::vector<BenchFileInfo> get_bench_files(const std::filesystem::path &bench_path, const BuildsType &builds)
 {
-    auto files = std::vector<BenchFileInfo>{};
-    auto directory_files = std::map<std::string, std::vector<std::filesystem::path>>{};
+    const auto catalog_path = get_bench_catalog_path(bench_path);
 
-    try
-    {
-        for (const auto &entry : std::filesystem::recursive_directory_iterator(bench_path))
-        {
-            if (entry.is_regular_file() && entry.path().extension() == ".json")
-            {
-                auto relative_path = std::filesystem::relative(entry.path(), bench_path);
-                auto parent_dir = relative_path.parent_path().string();
+    auto catalog = BenchCatalogType{};
+    (void)catalog.load(catalog_path);
 
-                if (parent_dir.empty())
-                    parent_dir = ".";
+    if (catalog.refresh(bench_path))
+        (void)catalog.save(catalog_path);
 
-                directory_files[parent_dir].push_back(entry.path());
-            }
-        }
+    auto files = catalog.get_bench_files(bench_path);
 
-        for (const auto &[dir_name, dir_files] : directory_files)
-        {
-            if (dir_name != ".")
-            {
-                auto header_path = bench_path / dir_name;
-                files.emplace_back(header_path, std::filesystem::path(dir_name), true);
-            }
-
-            for (const auto &file_path : dir_files)
-            {
-                auto relative_path = std::filesystem::relative(file_path, bench_path);
-                files.emplace_back(file_path, relative_path, false);
-            }
-        }
-    }
-    catch (const std::filesystem::filesystem_error &ex)
-    {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Error scanning bench files");
-    }
+    for (auto &file_info : files)
+        set_bench_display_data(file_info, builds);
 
     return files;
 }
 
-std::string get_keybind_action_name_from_xml_line(const std::string &line)
+std::map<std::string, KeybindInfo> parse_xml_keybinds_buffer(std::string_view xml)
 {
-    auto name_start = line.find("name=\"");
-    if (name_start != std::string::npos)
-    {
-        name_start += std::string{"name=\""}.size();
-        const auto name_end = line.find("\"", name_start);
-
-        if (name_end != std::string::npos)
-            return line.substr(name_start, name_end - name_start);
-    }
+    static constexpr auto action_tag = std::string_view{"<action"};
 
-    return std::string{};
-}
-
-std::map<std::string, KeybindInfo> parse_xml_keybinds(const std::filesystem::path &xml_path)
-{
     auto keybinds = std::map<std::string, KeybindInfo>{};
 
-    if (!std::filesystem::exists(xml_path))
-        return keybinds;
-
-    try
+    auto pos = xml.find(action_tag);
+    while (pos != std::string_view::npos)
     {
-        std::ifstream file(xml_path);
-        std::string line;
+        pos += action_tag.size();
 
-        while (std::getline(file, line))
+        // Skip tags that only share the prefix, like <actions>
+        if (pos < xml.size() && !is_xml_space(xml[pos]) && xml[pos] != '/' && xml[pos] != '>')
         {
-            if (line.find("<action") != std::string::npos)
-            {
-                auto keybind = KeybindInfo{};
-
-                keybind.action_name = get_keybind_action_name_from_xml_line(line);
-
-                auto button2_start = line.find("button2=\"");
-                bool has_button2 = button2_start != std::string::npos;
+            pos = xml.find(action_tag, pos);
+            continue;
+        }
 
-                if (has_button2)
-                    get_keybind_secondary_info(button2_start, line, keybind);
-                else
-                    get_keybind_primary_info(line, keybind);
+        auto attributes = XmlActionAttributes{};
+        pos = read_xml_action_attributes(xml, pos, attributes);
 
-                if (!keybind.action_name.empty() && keybind.button != Keys::NONE)
-                    keybinds[keybind.action_name] = keybind;
-            }
-        }
+        auto keybind = get_keybind_info(attributes);
+        if (!keybind.action_name.empty() && keybind.button != Keys::NONE)
+            keybinds[keybind.action_name] = std::move(keybind);
 
-        file.close();
-    }
-    catch (const std::exception &e)
-    {
-        (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", "Error parsing XML keybinds");
+        pos = xml.find(action_tag, pos);
     }
 
     return keybinds;
 }
 
-bool DownloadFile(const std::string &url, const std::filesystem::path &outputPath)
+std::map<std::string, KeybindInfo> parse_xml_keybinds(const std::filesystem::path &xml_path)
 {
-    try
+    auto mapped_file = MappedFileType{};
+    if (!mapped_file.open(xml_path))
     {
-        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Started ZIP Downloading");
-
-        const auto hr = URLDownloadToFileA(nullptr, url.c_str(), outputPath.string().c_str(), 0, nullptr);
-        return SUCCEEDED(hr);
-    }
-    catch (...)
-    {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "ZIP downloading failed.");
-        return false;
+        log_message(LogLevel::WARNING, "Error parsing XML keybinds");
+        return std::map<std::string, KeybindInfo>{};
     }
-}
-
-bool ExtractZipFile(const std::filesystem::path &zipPath, const std::filesystem::path &extractPath)
-{
-    try
-    {
-        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Started ZIP Extracting");
-
-        const auto psCommand = "powershell.exe -Command \"Expand-Archive -Path '" + zipPath.string() +
-                               "' -DestinationPath '" + extractPath.string() + "' -Force\"";
-
-        STARTUPINFOA si = {sizeof(si)};
-        PROCESS_INFORMATION pi = {};
-        si.dwFlags = STARTF_USESHOWWINDOW;
-        si.wShowWindow = SW_HIDE;
-
-        if (CreateProcessA(nullptr,
-                           const_cast<char *>(psCommand.c_str()),
-                           nullptr,
-                           nullptr,
-                           FALSE,
-                           0,
-                           nullptr,
-                           nullptr,
-                           &si,
-                           &pi))
-        {
-            (void)Globals::APIDefs->Log(LOGL_INFO, "GW2RotaHelper", "Started ZIP extraction process.");
-            WaitForSingleObject(pi.hProcess, 30000); // Wait max 30 seconds
-            DWORD exitCode;
-            GetExitCodeProcess(pi.hProcess, &exitCode);
-            CloseHandle(pi.hProcess);
-            CloseHandle(pi.hThread);
-
-            if (exitCode != 0)
-            {
-                Globals::BenchDataDownloadState = DownloadState::FAILED;
-                auto errorMsg = "ZIP extraction failed with exit code: " + std::to_string(exitCode);
-                (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", errorMsg.c_str());
-            }
 
-            return exitCode == 0;
-        }
-
-        DWORD createProcessError = GetLastError();
-        auto errorMsg = "Create Process Failed with error code: " + std::to_string(createProcessError);
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", errorMsg.c_str());
-        return false;
-    }
-    catch (...)
-    {
-        Globals::BenchDataDownloadState = DownloadState::FAILED;
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "ZIP extraction failed.");
-        return false;
-    }
+    return parse_xml_keybinds_buffer(mapped_file.view());
 }
 
-void DropFiles(const std::filesystem::path &path)
+uint64_t get_fnv1a_hash(std::string_view data)
 {
-    try
-    {
-        if (std::filesystem::exists(path) && std::filesystem::is_directory(path))
-        {
-            for (const auto &entry : std::filesystem::directory_iterator(path))
-            {
-                if (entry.is_regular_file())
-                    std::filesystem::remove(entry.path());
-            }
-
-            (void)Globals::APIDefs->Log(LOGL_INFO,
-                                        "GW2RotaHelper",
-                                        ("Removed old build files from " + path.string() + " directory").c_str());
-        }
-    }
-    catch (const std::filesystem::filesystem_error &e)
-    {
-        auto errorMsg = "Error removing old builds from " + path.string() + " directory: " + std::string(e.what());
-        (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", errorMsg.c_str());
-    }
-    catch (...)
+    auto hash = uint64_t{14695981039346656037ULL};
+    for (const auto c : data)
     {
-        (void)Globals::APIDefs->Log(
-            LOGL_WARNING,
-            "GW2RotaHelper",
-            ("Unknown error while removing old builds from " + path.string() + " directory").c_str());
+        hash ^= static_cast<uint8_t>(c);
+        hash *= uint64_t{1099511628211ULL};
     }
-}
 
-void DropOldBuilds(const std::filesystem::path &addonPath)
-{
-    auto power_alac = addonPath / "bench" / "alac" / "power";
-    DropFiles(power_alac);
-    auto power_dps = addonPath / "bench" / "dps" / "power";
-    DropFiles(power_dps);
-    auto power_quick = addonPath / "bench" / "quick" / "power";
-    DropFiles(power_quick);
-
-    auto condition_alac = addonPath / "bench" / "alac" / "condition";
-    DropFiles(condition_alac);
-    auto condition_dps = addonPath / "bench" / "dps" / "condition";
-    DropFiles(condition_dps);
-    auto condition_quick = addonPath / "bench" / "quick" / "condition";
-    DropFiles(condition_quick);
+    return hash;
 }
 
-void DownloadAndExtractDataAsync(const std::filesystem::path &addonPath)
+bool reload_xml_keybinds_if_changed(const std::filesystem::path &xml_path,
+                                    FileFingerprint &fingerprint,
+                                    std::map<std::string, KeybindInfo> &keybinds)
 {
-    Globals::ExtractedBenchData = false;
-    Globals::BenchDataDownloadState = DownloadState::STARTED;
-
-    std::thread([addonPath]() {
-        try
-        {
-            const std::string data_url =
-                "https://github.com/franneck94/GW2_RotaHelper/releases/latest/download/GW2RotaHelper.zip";
-
-            auto temp_zip_path = addonPath / "temp_GW2RotaHelper.zip";
-            auto extract_path = addonPath.parent_path(); // Extract one level above
-            (void)Globals::APIDefs->Log(LOGL_INFO, "GW2RotaHelper", "Started Download Thread.");
-
-            if (DownloadFile(data_url, temp_zip_path))
-            {
-                std::filesystem::create_directories(addonPath);
-
-                if (ExtractZipFile(temp_zip_path, extract_path))
-                {
-                    std::filesystem::remove(temp_zip_path);
-                    Globals::BenchDataDownloadState = DownloadState::FINISHED;
-                    Globals::ExtractedBenchData = true;
-                }
-                else
-                {
-                    std::filesystem::remove(temp_zip_path);
-                    Globals::BenchDataDownloadState = DownloadState::FAILED;
-                }
-            }
-            else
-            {
-                Globals::BenchDataDownloadState = DownloadState::FAILED;
-            }
-        }
-        catch (...)
-        {
-            Globals::BenchDataDownloadState = DownloadState::FAILED;
-            (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "DownloadAndExtractDataAsync failed.");
-        }
-    }).detach();
-}
-
-bool FileSelection()
-{
-    OPENFILENAME ofn;
-    CHAR szFile[260] = {0};
-
-    ZeroMemory(&ofn, sizeof(ofn));
-    ofn.lStructSize = sizeof(ofn);
-    ofn.lpstrFile = szFile;
-    ofn.nMaxFile = sizeof(szFile);
-    ofn.lpstrFilter = "XML Files\0*.xml\0All Files\0*.*\0";
-    ofn.nFilterIndex = 1;
-    ofn.lpstrFileTitle = NULL;
-    ofn.nMaxFileTitle = 0;
-    ofn.lpstrInitialDir = "C:/";
-    ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST;
+    // A deleted or unreadable file must not leave the keybinds of the old file behind
+    const auto clear_keybinds = [&]() {
+        const auto had_keybinds = fingerprint.is_valid || !keybinds.empty();
+        keybinds.clear();
+        fingerprint = FileFingerprint{};
+        return had_keybinds;
+    };
+
+    auto ec = std::error_code{};
+    const auto file_size = std::filesystem::file_size(xml_path, ec);
+    if (ec)
+        return clear_keybinds();
+
+    const auto mtime = get_file_mtime(xml_path);
+    if (fingerprint.is_valid && fingerprint.mtime == mtime && fingerprint.size == file_size)
+        return false;
 
-    if (GetOpenFileName(&ofn) == TRUE)
+    auto mapped_file = MappedFileType{};
+    if (!mapped_file.open(xml_path))
     {
-        Settings::XmlSettingsPath = std::filesystem::path(szFile);
-        Settings::Save(Globals::SettingsPath);
-        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Loaded XML InputBinds File.");
+        log_message(LogLevel::WARNING, "Error parsing XML keybinds");
+        return clear_keybinds();
+    }
 
-        if (std::filesystem::exists(Settings::XmlSettingsPath))
-        {
-            Globals::RenderData.keybinds = parse_xml_keybinds(Settings::XmlSettingsPath);
-            Globals::RenderData.keybinds_loaded = true;
-            (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "parsed XML InputBinds File.");
-        }
+    const auto hash = get_fnv1a_hash(mapped_file.view());
+    const auto is_same_content = fingerprint.is_valid && fingerprint.hash == hash;
 
-        return true;
-    }
+    fingerprint.mtime = mtime;
+    fingerprint.size = file_size;
+    fingerprint.hash = hash;
+    fingerprint.is_valid = true;
+
+    if (is_same_content)
+        return false;
 
-    return false;
+    keybinds = parse_xml_keybinds_buffer(mapped_file.view());
+    return true;
 }
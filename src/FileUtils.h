@@ -1,39 +1,47 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "nlohmann/json.hpp"
 
 #include "Types.h"
 
+class BuildsType;
+
 void to_lowercase(char *str);
 
 std::string to_lowercase(const std::string &str);
 
 std::pair<std::vector<std::pair<int, const BenchFileInfo *>>, std::set<std::string>> get_file_data_pairs(
     std::vector<BenchFileInfo> &benches_files,
-    char *filter_string);
+    char *filter_string,
+    const std::string &profession_name);
 
 bool load_rotaion_json(const std::filesystem::path &json_path, nlohmann::json &j);
 
+bool load_build_header_json(const std::filesystem::path &json_path, nlohmann::json &j);
+
 bool load_skill_data_map(const std::filesystem::path &json_path, nlohmann::json &j);
 
 std::string format_build_name(const std::string &raw_name);
 
-std::vector<BenchFileInfo> get_bench_files(const std::filesystem::path &bench_path);
-
-std::map<std::string, KeybindInfo> parse_xml_keybinds(const std::filesystem::path &xml_path);
-
-bool DownloadFile(const std::string &url, const std::filesystem::path &outputPath);
+std::vector<BenchFileInfo> get_bench_files(const std::filesystem::path &bench_path, const BuildsType &builds);
 
-bool ExtractZipFile(const std::filesystem::path &zipPath, const std::filesystem::path &extractPath);
+std::map<std::string, KeybindInfo> parse_xml_keybinds_buffer(std::string_view xml);
 
-void DropOldBuilds(const std::filesystem::path &addonPath);
+std::map<std::string, KeybindInfo> parse_xml_keybinds(const std::filesystem::path &xml_path);
 
-void DownloadAndExtractDataAsync(const std::filesystem::path &addonPath);
+uint64_t get_fnv1a_hash(std::string_view data);
 
-bool FileSelection();
+// Reparses the InputBinds file if its fingerprint changed. A missing or
+// unreadable file clears the keybinds and invalidates the fingerprint.
+// Returns true if the keybinds changed.
+bool reload_xml_keybinds_if_changed(const std::filesystem::path &xml_path,
+                                    FileFingerprint &fingerprint,
+                                    std::map<std::string, KeybindInfo> &keybinds);
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+// Immutable lookup tables built at compile time. The entries are sorted by the
+// consteval make_frozen_* builders, which also reject duplicate keys, so a
+// table is a plain constant array with no static initialization. FrozenSet and
+// FrozenMap are views onto such an array with the find/end API of std::set and
+// std::map, lookups are a binary search over contiguous memory.
+
+template <typename Key, size_t N>
+consteval std::array<Key, N> make_frozen_keys(const Key (&keys)[N])
+{
+    auto sorted = std::array<Key, N>{};
+    std::copy(keys, keys + N, sorted.begin());
+    std::sort(sorted.begin(), sorted.end());
+
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+        throw std::logic_error("Duplicate key in frozen set");
+
+    return sorted;
+}
+
+template <typename Key, typename Value, size_t N>
+consteval std::array<std::pair<Key, Value>, N> make_frozen_entries(const std::pair<Key, Value> (&entries)[N])
+{
+    const auto key_less = [](const std::pair<Key, Value> &lhs, const std::pair<Key, Value> &rhs) {
+        return lhs.first < rhs.first;
+    };
+    const auto key_equal = [](const std::pair<Key, Value> &lhs, const std::pair<Key, Value> &rhs) {
+        return lhs.first == rhs.first;
+    };
+
+    auto sorted = std::array<std::pair<Key, Value>, N>{};
+    std::copy(entries, entries + N, sorted.begin());
+    std::sort(sorted.begin(), sorted.end(), key_less);
+
+    if (std::adjacent_find(sorted.begin(), sorted.end(), key_equal) != sorted.end())
+        throw std::logic_error("Duplicate key in frozen map");
+
+    return sorted;
+}
+
+// Branchless binary search, the tables are small enough that a mispredicted
+// branch costs more than the extra comparison of the last step
+template <typename Entry, typename Key, typename Projection>
+constexpr const Entry *frozen_lower_bound(const Entry *first, size_t count, const Key &key, Projection projection)
+{
+    if (count == 0)
+        return first;
+
+    while (count > 1)
+    {
+        const auto half = count / 2;
+        first = projection(first[half - 1]) < key ? first + half : first;
+        count -= half;
+    }
+
+    return projection(*first) < key ? first + 1 : first;
+}
+
+template <typename Key>
+class FrozenSet
+{
+public:
+    using const_iterator = const Key *;
+
+    constexpr FrozenSet() = default;
+    template <size_t N>
+    constexpr FrozenSet(const std::array<Key, N> &keys) : first(keys.data()), count(N)
+    {
+    }
+
+    constexpr const_iterator begin() const
+    {
+        return first;
+    }
+    constexpr const_iterator end() const
+    {
+        return first + count;
+    }
+    constexpr size_t size() const
+    {
+        return count;
+    }
+    constexpr bool empty() const
+    {
+        return count == 0;
+    }
+
+    constexpr const_iterator find(const Key &key) const
+    {
+        const auto it = frozen_lower_bound(first, count, key, [](const Key &entry) -> const Key & { return entry; });
+        if (it != end() && !(key < *it))
+            return it;
+
+        return end();
+    }
+    constexpr bool contains(const Key &key) const
+    {
+        return find(key) != end();
+    }
+
+private:
+    const Key *first = nullptr;
+    size_t count = 0;
+};
+
+template <typename Key, typename Value>
+class FrozenMap
+{
+public:
+    using value_type = std::pair<Key, Value>;
+    using const_iterator = const value_type *;
+
+    constexpr FrozenMap() = default;
+    template <size_t N>
+    constexpr FrozenMap(const std::array<value_type, N> &entries) : first(entries.data()), count(N)
+    {
+    }
+
+    constexpr const_iterator begin() const
+    {
+        return first;
+    }
+    constexpr const_iterator end() const
+    {
+        return first + count;
+    }
+    constexpr size_t size() const
+    {
+        return count;
+    }
+    constexpr bool empty() const
+    {
+        return count == 0;
+    }
+
+    constexpr const_iterator find(const Key &key) const
+    {
+        const auto it =
+            frozen_lower_bound(first, count, key, [](const value_type &entry) -> const Key & { return entry.first; });
+        if (it != end() && !(key < it->first))
+            return it;
+
+        return end();
+    }
+    constexpr bool contains(const Key &key) const
+    {
+        return find(key) != end();
+    }
+
+    const Value &at(const Key &key) const
+    {
+        const auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("Key not in frozen map");
+
+        return it->second;
+    }
+
+private:
+    const value_type *first = nullptr;
+    size_t count = 0;
+};
@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "AtomicFile.h"
+#include "IconArchive.h"
+#include "MappedFile.h"
+#include "TextureLoader.h"
+
+namespace
+{
+constexpr auto ARCHIVE_MAGIC = std::string_view{"GRHI"};
+constexpr auto ARCHIVE_VERSION = uint32_t{2};
+constexpr auto HEADER_SIZE = size_t{40};
+constexpr auto ENTRY_SIZE = size_t{24};
+constexpr auto PAYLOAD_ALIGNMENT = size_t{16};
+// Icons decoded at once while packing, 4 MB of pixels for 128x128 icons
+constexpr auto ICON_ARCHIVE_BATCH_SIZE = size_t{64};
+
+template <typename T>
+T read_le(const char *data)
+{
+    auto value = T{};
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void append_le(std::string &buffer, const T value)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+}
+
+int64_t get_unix_mtime(const std::filesystem::directory_entry &entry)
+{
+    auto ec = std::error_code{};
+    const auto time = entry.last_write_time(ec);
+    if (ec)
+        return 0;
+
+    const auto system_time = std::chrono::file_clock::to_sys(time);
+    return std::chrono::duration_cast<std::chrono::seconds>(system_time.time_since_epoch()).count();
+}
+
+// The <icon_id>.png files of the folder sorted by icon id, like the pack script picks them
+std::vector<std::pair<int, std::filesystem::directory_entry>> get_icon_files(const std::filesystem::path &img_path)
+{
+    auto files = std::vector<std::pair<int, std::filesystem::directory_entry>>{};
+
+    auto ec = std::error_code{};
+    for (auto it = std::filesystem::directory_iterator{img_path, ec}; it != std::filesystem::directory_iterator{};
+         it.increment(ec))
+    {
+        if (ec)
+            break;
+        if (!it->is_regular_file(ec) || it->path().extension() != ".png")
+            continue;
+
+        const auto stem = it->path().stem().string();
+        auto icon_id = int{};
+        const auto [ptr, parse_ec] = std::from_chars(stem.data(), stem.data() + stem.size(), icon_id);
+        if (parse_ec != std::errc{} || ptr != stem.data() + stem.size() || stem.empty() || stem.front() == '-')
+            continue;
+
+        files.emplace_back(icon_id, *it);
+    }
+
+    std::ranges::sort(files, {}, &std::pair<int, std::filesystem::directory_entry>::first);
+    return files;
+}
+
+uint64_t get_level_size(const uint32_t width, const uint32_t height, const uint32_t level)
+{
+    const auto level_width = std::max(uint32_t{1}, width >> level);
+    const auto level_height = std::max(uint32_t{1}, height >> level);
+    return uint64_t{level_width} * level_height * 4;
+}
+
+class ArchiveImageDecoder final : public IImageDecoder
+{
+public:
+    ArchiveImageDecoder(const IconArchiveType &archive, std::unique_ptr<IImageDecoder> fallback)
+        : archive(archive), fallback(std::move(fallback))
+    {
+    }
+
+    bool decode(const std::filesystem::path &path, DecodedImage &image) override
+    {
+        const auto stem = path.stem().string();
+        auto icon_id = int{};
+        const auto [ptr, ec] = std::from_chars(stem.data(), stem.data() + stem.size(), icon_id);
+
+        const auto is_icon_id = ec == std::errc{} && ptr == stem.data() + stem.size();
+        const auto num_levels = is_icon_id ? archive.get_num_levels(icon_id) : uint32_t{0};
+        if (num_levels == 0)
+            return fallback != nullptr && fallback->decode(path, image);
+
+        // The packed levels are used as mip chain as they are, without resampling them again
+        image.mips.resize(num_levels - 1);
+        for (auto level = uint32_t{0}; level < num_levels; ++level)
+            copy_level(icon_id, level, level == 0 ? image : image.mips[level - 1]);
+
+        return true;
+    }
+
+private:
+    void copy_level(const int icon_id, const uint32_t level, DecodedImage &image) const
+    {
+        auto archive_image = IconArchiveImage{};
+        (void)archive.find(icon_id, level, archive_image);
+
+        image.width = archive_image.width;
+        image.height = archive_image.height;
+        image.pixels.assign(archive_image.pixels,
+                            archive_image.pixels + size_t{archive_image.width} * archive_image.height * 4);
+    }
+
+    const IconArchiveType &archive;
+    std::unique_ptr<IImageDecoder> fallback;
+};
+} // namespace
+
+bool IconArchiveType::open(const std::filesystem::path &path)
+{
+    close();
+
+    if (!file.open(path))
+        return false;
+
+    const auto data = file.view();
+    if (data.size() < HEADER_SIZE || data.substr(0, ARCHIVE_MAGIC.size()) != ARCHIVE_MAGIC ||
+        read_le<uint32_t>(data.data() + 4) != ARCHIVE_VERSION)
+    {
+        close();
+        return false;
+    }
+
+    source_info.num_files = read_le<uint32_t>(data.data() + 16);
+    source_info.total_size = read_le<uint64_t>(data.data() + 24);
+    source_info.max_mtime = read_le<int64_t>(data.data() + 32);
+
+    const auto num_entries = size_t{read_le<uint32_t>(data.data() + 8)};
+    if (num_entries > (data.size() - HEADER_SIZE) / ENTRY_SIZE)
+    {
+        close();
+        return false;
+    }
+
+    entries.reserve(num_entries);
+    for (auto idx = size_t{0}; idx < num_entries; ++idx)
+    {
+        const auto *record = data.data() + HEADER_SIZE + idx * ENTRY_SIZE;
+
+        auto entry = Entry{};
+        entry.icon_id = read_le<int32_t>(record);
+        entry.width = read_le<uint16_t>(record + 4);
+        entry.height = read_le<uint16_t>(record + 6);
+        entry.num_levels = read_le<uint16_t>(record + 8);
+        entry.offset = read_le<uint64_t>(record + 12);
+        entry.size = read_le<uint32_t>(record + 20);
+
+        auto expected_size = uint64_t{0};
+        for (auto level = uint32_t{0}; level < entry.num_levels; ++level)
+            expected_size += get_level_size(entry.width, entry.height, level);
+
+        const auto is_valid = entry.width > 0 && entry.height > 0 && entry.num_levels > 0 &&
+                              entry.size == expected_size && entry.offset <= data.size() &&
+                              entry.size <= data.size() - entry.offset;
+        if (!is_valid || (!entries.empty() && entries.back().icon_id >= entry.icon_id))
+        {
+            close();
+            return false;
+        }
+
+        entries.push_back(entry);
+    }
+
+    return true;
+}
+
+void IconArchiveType::close()
+{
+    entries.clear();
+    source_info = IconSourceInfo{};
+    file.close();
+}
+
+bool IconArchiveType::contains(const int icon_id) const
+{
+    return find_entry(icon_id) != nullptr;
+}
+
+uint32_t IconArchiveType::get_num_levels(const int icon_id) const
+{
+    const auto *entry = find_entry(icon_id);
+    return entry == nullptr ? 0 : uint32_t{entry->num_levels};
+}
+
+bool IconArchiveType::find(const int icon_id, const uint32_t level, IconArchiveImage &image) const
+{
+    const auto *entry = find_entry(icon_id);
+    if (entry == nullptr)
+        return false;
+
+    const auto last_level = std::min(level, uint32_t{entry->num_levels} - 1);
+
+    auto offset = entry->offset;
+    for (auto idx = uint32_t{0}; idx < last_level; ++idx)
+        offset += get_level_size(entry->width, entry->height, idx);
+
+    image.width = std::max(uint32_t{1}, uint32_t{entry->width} >> last_level);
+    image.height = std::max(uint32_t{1}, uint32_t{entry->height} >> last_level);
+    image.pixels = reinterpret_cast<const uint8_t *>(file.data()) + offset;
+
+    return true;
+}
+
+const IconArchiveType::Entry *IconArchiveType::find_entry(const int icon_id) const
+{
+    const auto it = std::ranges::lower_bound(entries, icon_id, {}, &Entry::icon_id);
+    if (it == entries.end() || it->icon_id != icon_id)
+        return nullptr;
+
+    return &*it;
+}
+
+std::filesystem::path get_icon_archive_path(const std::filesystem::path &data_path)
+{
+    return data_path / "icons.pack";
+}
+
+IconSourceInfo get_icon_source_info(const std::filesystem::path &img_path)
+{
+    auto source_info = IconSourceInfo{};
+    for (const auto &[icon_id, entry] : get_icon_files(img_path))
+    {
+        auto ec = std::error_code{};
+        const auto size = entry.file_size(ec);
+
+        ++source_info.num_files;
+        source_info.total_size += ec ? 0 : size;
+        source_info.max_mtime = std::max(source_info.max_mtime, get_unix_mtime(entry));
+    }
+
+    return source_info;
+}
+
+bool open_current_icon_archive(IconArchiveType &archive,
+                               const std::filesystem::path &archive_path,
+                               const std::filesystem::path &img_path)
+{
+    if (!archive.open(archive_path))
+        return false;
+
+    if (archive.get_source_info() != get_icon_source_info(img_path))
+    {
+        archive.close();
+        return false;
+    }
+
+    return true;
+}
+
+bool write_icon_archive(const std::filesystem::path &img_path,
+                        const std::filesystem::path &archive_path,
+                        const ImageDecoderFactory &decoder_factory,
+                        const size_t num_workers,
+                        const std::atomic<bool> *cancel)
+{
+    // Taken before decoding, so icons that change meanwhile make the archive stale right away
+    const auto source_info = get_icon_source_info(img_path);
+
+    auto requests = std::vector<ImageDecodeRequest>{};
+    for (const auto &[icon_id, entry] : get_icon_files(img_path))
+    {
+        if (requests.empty() || requests.back().icon_id != icon_id)
+            requests.push_back(ImageDecodeRequest{icon_id, entry.path()});
+    }
+
+    auto writer = AtomicFileWriterType{};
+    if (!writer.open(archive_path))
+        return false;
+
+    // The index is written last, with room for an entry per icon file. Slots of
+    // icons the decoders fail on stay unused between the index and the payloads.
+    const auto index_capacity = HEADER_SIZE + ENTRY_SIZE * requests.size();
+    if (!writer.write(std::string(index_capacity, '\0')))
+        return false;
+
+    auto index = std::string{};
+    index.reserve(ENTRY_SIZE * requests.size());
+    auto num_packed = uint32_t{0};
+    auto offset = uint64_t{index_capacity};
+
+    // Decoding in batches keeps one batch of pixels in memory instead of all icons
+    for (auto batch_start = size_t{0}; batch_start < requests.size(); batch_start += ICON_ARCHIVE_BATCH_SIZE)
+    {
+        const auto batch_end = std::min(batch_start + ICON_ARCHIVE_BATCH_SIZE, requests.size());
+        const auto batch = std::vector<ImageDecodeRequest>(requests.begin() + static_cast<std::ptrdiff_t>(batch_start),
+                                                           requests.begin() + static_cast<std::ptrdiff_t>(batch_end));
+
+        const auto icons = decode_image_batch(batch, decoder_factory, num_workers, cancel);
+        if (cancel && *cancel)
+            return false;
+
+        for (const auto &icon : icons)
+        {
+            const auto &image = icon.image;
+            if (!icon.success || image.width <= 0 || image.height <= 0 || image.width > 0xFFFF ||
+                image.height > 0xFFFF || image.pixels.size() != get_level_size(image.width, image.height, 0))
+                continue;
+
+            const auto padding = (PAYLOAD_ALIGNMENT - offset % PAYLOAD_ALIGNMENT) % PAYLOAD_ALIGNMENT;
+            if (!writer.write(std::string(padding, '\0')))
+                return false;
+            offset += padding;
+
+            append_le(index, static_cast<int32_t>(icon.icon_id));
+            append_le(index, static_cast<uint16_t>(image.width));
+            append_le(index, static_cast<uint16_t>(image.height));
+            append_le(index, uint16_t{1});
+            append_le(index, uint16_t{0});
+            append_le(index, offset);
+            append_le(index, static_cast<uint32_t>(image.pixels.size()));
+
+            const auto pixels =
+                std::string_view{reinterpret_cast<const char *>(image.pixels.data()), image.pixels.size()};
+            if (!writer.write(pixels))
+                return false;
+            offset += pixels.size();
+            ++num_packed;
+        }
+    }
+
+    if (num_packed == 0)
+        return false;
+
+    auto header = std::string{ARCHIVE_MAGIC};
+    append_le(header, ARCHIVE_VERSION);
+    append_le(header, num_packed);
+    append_le(header, uint32_t{0});
+    append_le(header, source_info.num_files);
+    append_le(header, uint32_t{0});
+    append_le(header, source_info.total_size);
+    append_le(header, source_info.max_mtime);
+
+    return writer.write_at(0, header + index) && writer.commit();
+}
+
+ImageDecoderFactory make_archive_decoder_factory(const IconArchiveType &archive,
+                                                 ImageDecoderFactory fallback_factory)
+{
+    return [&archive, fallback_factory = std::move(fallback_factory)]() -> std::unique_ptr<IImageDecoder> {
+        return std::make_unique<ArchiveImageDecoder>(archive, fallback_factory ? fallback_factory() : nullptr);
+    };
+}
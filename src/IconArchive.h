@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "MappedFile.h"
+#include "TextureLoader.h"
+
+// Fingerprint of the <icon_id>.png files the archive was packed from. The
+// archive is only used while it matches the files in the img folder, so an
+// update of the icons invalidates it. mtime is in seconds since the Unix
+// epoch, like the st_mtime the pack script stores.
+struct IconSourceInfo
+{
+    uint32_t num_files = 0;
+    uint64_t total_size = 0;
+    int64_t max_mtime = 0;
+
+    bool operator==(const IconSourceInfo &) const = default;
+};
+
+// RGBA8 pixels of one icon level, pointing into the mapped archive
+struct IconArchiveImage
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    const uint8_t *pixels = nullptr;
+};
+
+// Read-only view of the archive written by scripts/pack_icons.py. After
+// open() it may be read from several threads at once.
+class IconArchiveType
+{
+public:
+    bool open(const std::filesystem::path &path);
+    void close();
+
+    bool is_open() const
+    {
+        return !entries.empty();
+    }
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    const IconSourceInfo &get_source_info() const
+    {
+        return source_info;
+    }
+
+    bool contains(const int icon_id) const;
+
+    // Number of stored levels including the full size one, 0 if the icon is missing
+    uint32_t get_num_levels(const int icon_id) const;
+
+    // Level 0 is the full size icon, levels past the last one return the smallest
+    bool find(const int icon_id, const uint32_t level, IconArchiveImage &image) const;
+
+private:
+    struct Entry
+    {
+        int32_t icon_id = 0;
+        uint16_t width = 0;
+        uint16_t height = 0;
+        uint16_t num_levels = 0;
+        uint64_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    const Entry *find_entry(const int icon_id) const;
+
+    MappedFileType file;
+    std::vector<Entry> entries;
+    IconSourceInfo source_info;
+};
+
+std::filesystem::path get_icon_archive_path(const std::filesystem::path &data_path);
+
+IconSourceInfo get_icon_source_info(const std::filesystem::path &img_path);
+
+// Opens the archive only if it was packed from the current files in img_path
+bool open_current_icon_archive(IconArchiveType &archive,
+                               const std::filesystem::path &archive_path,
+                               const std::filesystem::path &img_path);
+
+// Packs the icons of img_path with one level each, the runtime counterpart of
+// scripts/pack_icons.py. Icons the decoders fail on are left out and keep
+// loading from their PNG. The icons are decoded and written in batches, so only
+// one batch of pixels is held in memory. The archive is replaced atomically,
+// which fails while another process or an open IconArchiveType maps it on Windows.
+bool write_icon_archive(const std::filesystem::path &img_path,
+                        const std::filesystem::path &archive_path,
+                        const ImageDecoderFactory &decoder_factory,
+                        const size_t num_workers,
+                        const std::atomic<bool> *cancel = nullptr);
+
+// Serves icons from the archive by the numeric file stem and decodes the
+// remaining ones with a decoder of the fallback factory
+ImageDecoderFactory make_archive_decoder_factory(const IconArchiveType &archive,
+                                                 ImageDecoderFactory fallback_factory);
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+struct IconCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t num_entries = 0;
+    size_t num_referenced = 0;
+    size_t resident_bytes = 0;
+    size_t unreferenced_bytes = 0;
+    size_t budget_bytes = 0;
+
+    double get_hit_rate() const
+    {
+        const auto total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+// Icon textures keyed by icon id that outlive a single build. Every loaded
+// build holds one reference per icon, icons without references stay resident
+// until the least recently released ones exceed the byte budget.
+// Only used from the render thread, so there is no locking.
+template <typename TextureT>
+class IconCacheType
+{
+public:
+    using TextureReleaser = std::function<void(TextureT texture)>;
+
+    static constexpr auto DEFAULT_BUDGET_BYTES = size_t{8 * 1024 * 1024};
+
+    IconCacheType(TextureReleaser releaser, const size_t budget_bytes = DEFAULT_BUDGET_BYTES)
+        : releaser(std::move(releaser)), budget_bytes(budget_bytes)
+    {
+    }
+
+    ~IconCacheType()
+    {
+        clear();
+    }
+
+    IconCacheType(const IconCacheType &) = delete;
+    IconCacheType &operator=(const IconCacheType &) = delete;
+
+    // Returns an empty texture on a miss, a hit takes a reference
+    TextureT acquire(const int icon_id)
+    {
+        const auto it = entries.find(icon_id);
+        if (it == entries.end())
+        {
+            ++misses;
+            return TextureT{};
+        }
+
+        ++hits;
+        auto &entry = it->second;
+        if (entry.ref_count++ == 0)
+        {
+            lru.erase(entry.lru_it);
+            unreferenced_bytes -= entry.size_bytes;
+        }
+
+        return entry.texture;
+    }
+
+    // Takes ownership of a newly created texture, which starts with one reference
+    void insert(const int icon_id, TextureT texture, const size_t size_bytes)
+    {
+        const auto it = entries.find(icon_id);
+        if (it != entries.end())
+            erase(it);
+
+        entries.emplace(icon_id, Entry{texture, size_bytes, 1, lru.end()});
+        resident_bytes += size_bytes;
+    }
+
+    void release(const int icon_id)
+    {
+        const auto it = entries.find(icon_id);
+        if (it == entries.end() || it->second.ref_count == 0)
+            return;
+
+        auto &entry = it->second;
+        if (--entry.ref_count != 0)
+            return;
+
+        lru.push_front(icon_id);
+        entry.lru_it = lru.begin();
+        unreferenced_bytes += entry.size_bytes;
+
+        evict_over_budget();
+    }
+
+    // Frees the texture right away whatever its references
+    void remove(const int icon_id)
+    {
+        const auto it = entries.find(icon_id);
+        if (it != entries.end())
+            erase(it);
+    }
+
+    void clear()
+    {
+        for (auto &[icon_id, entry] : entries)
+        {
+            if (releaser)
+                releaser(entry.texture);
+        }
+
+        entries.clear();
+        lru.clear();
+        resident_bytes = 0;
+        unreferenced_bytes = 0;
+    }
+
+    IconCacheStats get_stats() const
+    {
+        auto stats = IconCacheStats{};
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.num_entries = entries.size();
+        stats.num_referenced = entries.size() - lru.size();
+        stats.resident_bytes = resident_bytes;
+        stats.unreferenced_bytes = unreferenced_bytes;
+        stats.budget_bytes = budget_bytes;
+        return stats;
+    }
+
+private:
+    struct Entry
+    {
+        TextureT texture;
+        size_t size_bytes = 0;
+        uint32_t ref_count = 0;
+        std::list<int>::iterator lru_it;
+    };
+
+    using EntryMap = std::unordered_map<int, Entry>;
+
+    void erase(typename EntryMap::iterator it)
+    {
+        auto &entry = it->second;
+        if (entry.ref_count == 0)
+        {
+            lru.erase(entry.lru_it);
+            unreferenced_bytes -= entry.size_bytes;
+        }
+
+        resident_bytes -= entry.size_bytes;
+        if (releaser)
+            releaser(entry.texture);
+        entries.erase(it);
+    }
+
+    void evict_over_budget()
+    {
+        while (unreferenced_bytes > budget_bytes && !lru.empty())
+            erase(entries.find(lru.back()));
+    }
+
+    TextureReleaser releaser;
+    size_t budget_bytes = 0;
+
+    EntryMap entries;
+    std::list<int> lru; // Unreferenced icons, most recently released first
+    size_t resident_bytes = 0;
+    size_t unreferenced_bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+// Icons of the loaded build by icon id, each holding one reference of the cache
+template <typename TextureT>
+using IconMapType = std::unordered_map<int, TextureT>;
+
+// Drops the references of the loaded build, the textures stay in the cache
+template <typename TextureT>
+void release_icon_map(IconMapType<TextureT> &icon_map, IconCacheType<TextureT> &icon_cache)
+{
+    for (const auto &[icon_id, texture] : icon_map)
+        icon_cache.release(icon_id);
+
+    icon_map.clear();
+}
+
+// Drops the references of the icons is_packed accepts, for icons that moved
+// into an atlas. Their textures stay in the cache until they are evicted, so
+// loading the build again takes them from the cache instead of decoding them.
+// Returns the number of icons taken out of the map.
+template <typename TextureT, typename IsPackedT>
+size_t release_packed_icons(IconMapType<TextureT> &icon_map,
+                            IconCacheType<TextureT> &icon_cache,
+                            const IsPackedT &is_packed)
+{
+    auto num_released = size_t{0};
+    for (auto it = icon_map.begin(); it != icon_map.end();)
+    {
+        if (!is_packed(it->first))
+        {
+            ++it;
+            continue;
+        }
+
+        icon_cache.release(it->first);
+        it = icon_map.erase(it);
+        ++num_released;
+    }
+
+    return num_released;
+}
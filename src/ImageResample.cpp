@@ -0,0 +1,125 @@
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROTA_HAS_SSE2 1
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ImageResample.h"
+#include "TextureLoader.h"
+
+namespace
+{
+void downscale_pixel(const uint8_t *row0,
+                     const uint8_t *row1,
+                     const uint32_t x0,
+                     const uint32_t x1,
+                     uint8_t *dst)
+{
+    for (auto channel = size_t{0}; channel < 4; ++channel)
+    {
+        const auto sum = row0[x0 * 4 + channel] + row0[x1 * 4 + channel] + row1[x0 * 4 + channel] +
+                         row1[x1 * 4 + channel];
+        dst[channel] = static_cast<uint8_t>((sum + 2) >> 2);
+    }
+}
+
+#ifdef ROTA_HAS_SSE2
+// Two output pixels from 4x2 input pixels
+__m128i downscale_two_pixels(const uint8_t *row0, const uint8_t *row1)
+{
+    const auto zero = _mm_setzero_si128();
+    const auto top = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0));
+    const auto bottom = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1));
+
+    // Vertical sums of pixels 0,1 and 2,3 as 16 bit channels
+    const auto sum_01 = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+    const auto sum_23 = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+    // Horizontal sums of the pairs, then rounded average
+    const auto sum = _mm_add_epi16(_mm_unpacklo_epi64(sum_01, sum_23), _mm_unpackhi_epi64(sum_01, sum_23));
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+}
+#endif
+
+DecodedImage downscale_half(const DecodedImage &image, const bool use_simd)
+{
+    auto result = DecodedImage{};
+    if (image.width == 0 || image.height == 0 ||
+        image.pixels.size() < static_cast<size_t>(image.width) * image.height * 4)
+        return result;
+
+    result.width = std::max(uint32_t{1}, image.width / 2);
+    result.height = std::max(uint32_t{1}, image.height / 2);
+    result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+    const auto src_stride = static_cast<size_t>(image.width) * 4;
+    const auto dst_stride = static_cast<size_t>(result.width) * 4;
+
+    for (auto y = uint32_t{0}; y < result.height; ++y)
+    {
+        const auto *row0 = image.pixels.data() + std::min(2 * y, image.height - 1) * src_stride;
+        const auto *row1 = image.pixels.data() + std::min(2 * y + 1, image.height - 1) * src_stride;
+        auto *dst = result.pixels.data() + y * dst_stride;
+
+        auto x = uint32_t{0};
+#ifdef ROTA_HAS_SSE2
+        for (; use_simd && x + 4 <= result.width && 2 * x + 8 <= image.width; x += 4)
+        {
+            const auto lo = downscale_two_pixels(row0 + x * 8, row1 + x * 8);
+            const auto hi = downscale_two_pixels(row0 + x * 8 + 16, row1 + x * 8 + 16);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4), _mm_packus_epi16(lo, hi));
+        }
+#else
+        (void)use_simd;
+#endif
+        for (; x < result.width; ++x)
+        {
+            const auto x0 = std::min(2 * x, image.width - 1);
+            const auto x1 = std::min(2 * x + 1, image.width - 1);
+            downscale_pixel(row0, row1, x0, x1, dst + x * 4);
+        }
+    }
+
+    return result;
+}
+} // namespace
+
+DecodedImage downscale_half(const DecodedImage &image)
+{
+    return downscale_half(image, true);
+}
+
+DecodedImage downscale_half_scalar(const DecodedImage &image)
+{
+    return downscale_half(image, false);
+}
+
+void generate_mips(DecodedImage &image, const uint32_t min_size, const uint32_t max_levels)
+{
+    image.mips.clear();
+
+    const auto target_size = std::max(uint32_t{1}, min_size);
+    const auto *previous = &image;
+    while (image.mips.size() < max_levels && std::max(previous->width, previous->height) > target_size)
+    {
+        auto level = downscale_half(*previous);
+        if (level.pixels.empty())
+            break;
+
+        image.mips.push_back(std::move(level));
+        previous = &image.mips.back();
+    }
+}
+
+size_t get_image_bytes(const DecodedImage &image)
+{
+    auto bytes = image.pixels.size();
+    for (const auto &level : image.mips)
+        bytes += level.pixels.size();
+
+    return bytes;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "TextureLoader.h"
+
+// Halves an RGBA8 image with a rounded 2x2 box filter. Odd sizes repeat the
+// last row or column, so every level is max(1, size / 2).
+DecodedImage downscale_half(const DecodedImage &image);
+
+// Same result without the SSE2 path, the reference for tests and benchmarks
+DecodedImage downscale_half_scalar(const DecodedImage &image);
+
+// Fills image.mips with downscaled levels until the larger side is at most
+// min_size or max_levels levels were added
+void generate_mips(DecodedImage &image, const uint32_t min_size, const uint32_t max_levels = UINT32_MAX);
+
+// Bytes of the image including all mip levels
+size_t get_image_bytes(const DecodedImage &image);
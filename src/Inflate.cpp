@@ -0,0 +1,471 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Inflate.h"
+
+namespace
+{
+constexpr auto MAX_BITS = uint32_t{15};
+constexpr auto FAST_BITS = uint32_t{10};
+constexpr auto FAST_MASK = (uint64_t{1} << FAST_BITS) - 1;
+constexpr auto WINDOW_SIZE = size_t{32768};
+constexpr auto OUTPUT_SIZE = 2 * WINDOW_SIZE;
+constexpr auto MAX_MATCH = size_t{258};
+constexpr auto NUM_LITLEN_SYMBOLS = size_t{288};
+constexpr auto NUM_DIST_SYMBOLS = size_t{30};
+constexpr auto END_OF_BLOCK = 256;
+
+constexpr auto LENGTH_BASE = std::array<uint16_t, 29>{3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                                      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr auto LENGTH_EXTRA =
+    std::array<uint8_t, 29>{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr auto DIST_BASE =
+    std::array<uint16_t, 30>{1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                             193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr auto DIST_EXTRA = std::array<uint8_t, 30>{0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                                    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+constexpr auto CODE_LENGTH_ORDER =
+    std::array<uint8_t, 19>{16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// Canonical Huffman code. Codes up to FAST_BITS resolve with one lookup, the
+// longer ones walk the code lengths bit by bit.
+struct Huffman
+{
+    std::array<uint16_t, MAX_BITS + 1> counts{};
+    std::array<uint16_t, NUM_LITLEN_SYMBOLS> symbols{}; // Ordered by code length, then symbol
+    std::array<uint16_t, size_t{1} << FAST_BITS> fast{}; // Symbol | length << 12, 0 for longer codes
+};
+
+// Incomplete codes are allowed, RFC 1951 permits them for a single distance code
+bool build_huffman(Huffman &huffman, const uint8_t *lengths, const size_t num_symbols)
+{
+    huffman.counts.fill(0);
+    for (auto symbol = size_t{0}; symbol < num_symbols; ++symbol)
+        ++huffman.counts[lengths[symbol]];
+    huffman.counts[0] = 0;
+
+    auto left = 1;
+    for (auto length = uint32_t{1}; length <= MAX_BITS; ++length)
+    {
+        left = (left << 1) - huffman.counts[length];
+        if (left < 0)
+            return false;
+    }
+
+    auto offsets = std::array<uint16_t, MAX_BITS + 2>{};
+    auto next_code = std::array<uint32_t, MAX_BITS + 1>{};
+    for (auto length = uint32_t{1}; length <= MAX_BITS; ++length)
+    {
+        offsets[length + 1] = offsets[length] + huffman.counts[length];
+        next_code[length] = (next_code[length - 1] + huffman.counts[length - 1]) << 1;
+    }
+
+    huffman.fast.fill(0);
+    for (auto symbol = size_t{0}; symbol < num_symbols; ++symbol)
+    {
+        const auto length = uint32_t{lengths[symbol]};
+        if (length == 0)
+            continue;
+
+        huffman.symbols[offsets[length]++] = static_cast<uint16_t>(symbol);
+
+        const auto code = next_code[length]++;
+        if (length > FAST_BITS)
+            continue;
+
+        // Codes are stored MSB first but read LSB first
+        auto reversed = uint32_t{0};
+        for (auto bit = uint32_t{0}; bit < length; ++bit)
+            reversed |= ((code >> bit) & 1) << (length - 1 - bit);
+
+        for (auto idx = reversed; idx < huffman.fast.size(); idx += uint32_t{1} << length)
+            huffman.fast[idx] = static_cast<uint16_t>(symbol | (length << 12));
+    }
+
+    return true;
+}
+
+class InflateDecoder
+{
+public:
+    InflateDecoder(const uint8_t *data, const size_t size, const InflateSink &sink)
+        : data(data), size(size), sink(sink), output(OUTPUT_SIZE)
+    {
+    }
+
+    InflateStatus run(size_t *consumed)
+    {
+        auto is_final = false;
+        while (!is_final && status == InflateStatus::OK)
+        {
+            is_final = get_bits(1) == 1;
+            const auto type = get_bits(2);
+            if (status != InflateStatus::OK)
+                break;
+
+            if (type == 0)
+                read_stored_block();
+            else if (type == 1)
+                read_fixed_block();
+            else if (type == 2)
+                read_dynamic_block();
+            else
+                status = InflateStatus::INVALID_DATA;
+        }
+
+        if (status == InflateStatus::OK)
+            flush();
+
+        if (consumed)
+            *consumed = in_pos - bit_count / 8;
+
+        return status;
+    }
+
+private:
+    void refill()
+    {
+        if (in_pos + 8 <= size)
+        {
+            auto word = uint64_t{};
+            std::memcpy(&word, data + in_pos, sizeof(word));
+            bit_buffer |= word << bit_count;
+            in_pos += (63 - bit_count) >> 3;
+            bit_count |= 56;
+            return;
+        }
+
+        while (bit_count <= 56 && in_pos < size)
+        {
+            bit_buffer |= uint64_t{data[in_pos++]} << bit_count;
+            bit_count += 8;
+        }
+    }
+
+    void drop_bits(const uint32_t num_bits)
+    {
+        bit_buffer >>= num_bits;
+        bit_count -= num_bits;
+    }
+
+    uint32_t get_bits(const uint32_t num_bits)
+    {
+        if (bit_count < num_bits)
+        {
+            refill();
+            if (bit_count < num_bits)
+            {
+                status = InflateStatus::TRUNCATED;
+                return 0;
+            }
+        }
+
+        const auto value = static_cast<uint32_t>(bit_buffer & ((uint64_t{1} << num_bits) - 1));
+        drop_bits(num_bits);
+        return value;
+    }
+
+    // Returns -1 and sets the status on invalid or truncated codes
+    int decode_symbol(const Huffman &huffman)
+    {
+        if (bit_count < MAX_BITS)
+            refill();
+
+        const auto entry = huffman.fast[bit_buffer & FAST_MASK];
+        if (entry != 0)
+        {
+            const auto length = uint32_t{entry} >> 12;
+            if (length > bit_count)
+            {
+                status = InflateStatus::TRUNCATED;
+                return -1;
+            }
+
+            drop_bits(length);
+            return entry & 0x0FFF;
+        }
+
+        auto code = 0;
+        auto first = 0;
+        auto index = 0;
+        for (auto length = uint32_t{1}; length <= MAX_BITS && length <= bit_count; ++length)
+        {
+            code |= static_cast<int>((bit_buffer >> (length - 1)) & 1);
+            const auto count = int{huffman.counts[length]};
+            if (code - count < first)
+            {
+                drop_bits(length);
+                return huffman.symbols[index + (code - first)];
+            }
+
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+
+        status = bit_count < MAX_BITS ? InflateStatus::TRUNCATED : InflateStatus::INVALID_DATA;
+        return -1;
+    }
+
+    bool flush()
+    {
+        if (out_pos > flushed && !sink(output.data() + flushed, out_pos - flushed))
+        {
+            status = InflateStatus::SINK_FAILED;
+            return false;
+        }
+
+        flushed = out_pos;
+        return true;
+    }
+
+    // Makes room for num_bytes while keeping the last window for back references
+    bool reserve_output(const size_t num_bytes)
+    {
+        if (out_pos + num_bytes <= OUTPUT_SIZE)
+            return true;
+
+        if (!flush())
+            return false;
+
+        std::memmove(output.data(), output.data() + out_pos - WINDOW_SIZE, WINDOW_SIZE);
+        out_pos = WINDOW_SIZE;
+        flushed = WINDOW_SIZE;
+        return true;
+    }
+
+    void read_stored_block()
+    {
+        drop_bits(bit_count % 8);
+
+        const auto length = get_bits(16);
+        const auto complement = get_bits(16);
+        if (status != InflateStatus::OK)
+            return;
+        if (length != (~complement & 0xFFFF))
+        {
+            status = InflateStatus::INVALID_DATA;
+            return;
+        }
+
+        auto remaining = size_t{length};
+        while (remaining > 0 && bit_count >= 8)
+        {
+            if (!reserve_output(1))
+                return;
+
+            output[out_pos++] = static_cast<uint8_t>(get_bits(8));
+            --remaining;
+        }
+
+        // The buffer may hold bits of bytes past in_pos, which are copied directly below
+        bit_buffer &= (uint64_t{1} << bit_count) - 1;
+
+        if (remaining > size - in_pos)
+        {
+            status = InflateStatus::TRUNCATED;
+            return;
+        }
+
+        while (remaining > 0)
+        {
+            const auto chunk = std::min(remaining, WINDOW_SIZE);
+            if (!reserve_output(chunk))
+                return;
+
+            std::memcpy(output.data() + out_pos, data + in_pos, chunk);
+            out_pos += chunk;
+            in_pos += chunk;
+            remaining -= chunk;
+        }
+    }
+
+    void read_fixed_block()
+    {
+        if (!has_fixed_codes)
+        {
+            auto lengths = std::array<uint8_t, NUM_LITLEN_SYMBOLS>{};
+            std::fill(lengths.begin(), lengths.begin() + 144, uint8_t{8});
+            std::fill(lengths.begin() + 144, lengths.begin() + 256, uint8_t{9});
+            std::fill(lengths.begin() + 256, lengths.begin() + 280, uint8_t{7});
+            std::fill(lengths.begin() + 280, lengths.end(), uint8_t{8});
+            (void)build_huffman(fixed_litlen, lengths.data(), NUM_LITLEN_SYMBOLS);
+
+            lengths.fill(5);
+            (void)build_huffman(fixed_dist, lengths.data(), NUM_DIST_SYMBOLS);
+            has_fixed_codes = true;
+        }
+
+        read_compressed_data(fixed_litlen, fixed_dist);
+    }
+
+    void read_dynamic_block()
+    {
+        const auto num_litlen = get_bits(5) + 257;
+        const auto num_dist = get_bits(5) + 1;
+        const auto num_code_lengths = get_bits(4) + 4;
+        if (status != InflateStatus::OK)
+            return;
+        if (num_litlen > 286 || num_dist > NUM_DIST_SYMBOLS)
+        {
+            status = InflateStatus::INVALID_DATA;
+            return;
+        }
+
+        auto lengths = std::array<uint8_t, NUM_LITLEN_SYMBOLS + NUM_DIST_SYMBOLS>{};
+        for (auto idx = uint32_t{0}; idx < num_code_lengths; ++idx)
+            lengths[CODE_LENGTH_ORDER[idx]] = static_cast<uint8_t>(get_bits(3));
+
+        auto code_length_code = Huffman{};
+        if (status != InflateStatus::OK || !build_huffman(code_length_code, lengths.data(), CODE_LENGTH_ORDER.size()))
+        {
+            status = status == InflateStatus::OK ? InflateStatus::INVALID_DATA : status;
+            return;
+        }
+
+        const auto num_lengths = num_litlen + num_dist;
+        auto idx = uint32_t{0};
+        while (idx < num_lengths)
+        {
+            const auto symbol = decode_symbol(code_length_code);
+            if (symbol < 0)
+                return;
+
+            if (symbol < 16)
+            {
+                lengths[idx++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+
+            auto repeat_length = uint8_t{0};
+            auto repeat_count = uint32_t{0};
+            if (symbol == 16)
+            {
+                if (idx == 0)
+                {
+                    status = InflateStatus::INVALID_DATA;
+                    return;
+                }
+                repeat_length = lengths[idx - 1];
+                repeat_count = 3 + get_bits(2);
+            }
+            else if (symbol == 17)
+                repeat_count = 3 + get_bits(3);
+            else
+                repeat_count = 11 + get_bits(7);
+
+            if (status != InflateStatus::OK)
+                return;
+            if (idx + repeat_count > num_lengths)
+            {
+                status = InflateStatus::INVALID_DATA;
+                return;
+            }
+
+            std::fill_n(lengths.begin() + idx, repeat_count, repeat_length);
+            idx += repeat_count;
+        }
+
+        auto litlen = Huffman{};
+        auto dist = Huffman{};
+        if (lengths[END_OF_BLOCK] == 0 || !build_huffman(litlen, lengths.data(), num_litlen) ||
+            !build_huffman(dist, lengths.data() + num_litlen, num_dist))
+        {
+            status = InflateStatus::INVALID_DATA;
+            return;
+        }
+
+        read_compressed_data(litlen, dist);
+    }
+
+    void read_compressed_data(const Huffman &litlen, const Huffman &dist)
+    {
+        while (true)
+        {
+            const auto symbol = decode_symbol(litlen);
+            if (symbol < 0)
+                return;
+
+            if (symbol < END_OF_BLOCK)
+            {
+                if (!reserve_output(1))
+                    return;
+
+                output[out_pos++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+
+            if (symbol == END_OF_BLOCK)
+                return;
+
+            const auto length_symbol = static_cast<size_t>(symbol - END_OF_BLOCK - 1);
+            if (length_symbol >= LENGTH_BASE.size())
+            {
+                status = InflateStatus::INVALID_DATA;
+                return;
+            }
+            const auto length = size_t{LENGTH_BASE[length_symbol]} + get_bits(LENGTH_EXTRA[length_symbol]);
+
+            const auto dist_symbol = decode_symbol(dist);
+            if (dist_symbol < 0)
+                return;
+            if (static_cast<size_t>(dist_symbol) >= DIST_BASE.size())
+            {
+                status = InflateStatus::INVALID_DATA;
+                return;
+            }
+            const auto distance = size_t{DIST_BASE[dist_symbol]} + get_bits(DIST_EXTRA[dist_symbol]);
+
+            if (status != InflateStatus::OK || !reserve_output(MAX_MATCH))
+                return;
+            if (distance > out_pos)
+            {
+                status = InflateStatus::INVALID_DATA;
+                return;
+            }
+
+            auto *dst = output.data() + out_pos;
+            const auto *src = dst - distance;
+            if (distance >= length)
+                std::memcpy(dst, src, length);
+            else
+            {
+                // Overlapping copies repeat the last distance bytes
+                for (auto idx = size_t{0}; idx < length; ++idx)
+                    dst[idx] = src[idx];
+            }
+            out_pos += length;
+        }
+    }
+
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    size_t in_pos = 0;
+    uint64_t bit_buffer = 0;
+    uint32_t bit_count = 0;
+
+    const InflateSink &sink;
+    std::vector<uint8_t> output;
+    size_t out_pos = 0;
+    size_t flushed = 0;
+
+    Huffman fixed_litlen;
+    Huffman fixed_dist;
+    bool has_fixed_codes = false;
+
+    InflateStatus status = InflateStatus::OK;
+};
+} // namespace
+
+InflateStatus inflate_raw(const uint8_t *data, const size_t size, const InflateSink &sink, size_t *consumed)
+{
+    if (!sink)
+        return InflateStatus::SINK_FAILED;
+
+    auto decoder = InflateDecoder{data, size, sink};
+    return decoder.run(consumed);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+enum class InflateStatus : uint8_t
+{
+    OK,
+    INVALID_DATA,
+    TRUNCATED,
+    SINK_FAILED,
+};
+
+// Receives the decoded bytes, returning false aborts decoding
+using InflateSink = std::function<bool(const uint8_t *data, size_t size)>;
+
+// Decodes raw DEFLATE data (RFC 1951, no zlib or gzip header). The output is
+// handed to the sink in chunks while decoding, so memory stays at about twice
+// the 32 KiB window no matter how large the output is. consumed receives the
+// number of input bytes up to the end of the final block.
+InflateStatus inflate_raw(const uint8_t *data, const size_t size, const InflateSink &sink, size_t *consumed = nullptr);
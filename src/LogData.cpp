@@ -1,32 +1,26 @@
-#include <windows.h>
-
-#include <commdlg.h>
-#include <wininet.h>
-#pragma comment(lib, "wininet.lib")
-#include <wincodec.h>
-#pragma comment(lib, "windowscodecs.lib")
-#pragma comment(lib, "ole32.lib")
-#include <conio.h>
-#include <d3d11.h>
-
 #include <algorithm>
-#include <d3d11.h>
 #include <filesystem>
 #include <fstream>
 #include <future>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <set>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "nlohmann/json.hpp"
 
 #include "FileUtils.h"
 #include "LogData.h"
-#include "MumbleUtils.h"
+#include "Logger.h"
+#include "Profiler.h"
+#include "RuleMatcher.h"
 #include "Settings.h"
-#include "Shared.h"
 #include "SkillData.h"
 #include "Types.h"
 #include "TypesUtils.h"
@@ -42,19 +36,20 @@ void collect_json(const json &jval, IntNode &node, const bool drop_first_char =
     {
         for (auto it = jval.begin(); it != jval.end(); ++it)
         {
-            auto key = std::string{it.key()};
+            auto key = std::pmr::string{it.key(), node.children.get_allocator()};
             if (drop_first_char && !key.empty())
             {
-                key = key.substr(1);
+                key.erase(0, 1);
             }
-            collect_json(it.value(), node.children[key]);
+            collect_json(it.value(), node.children[std::move(key)]);
         }
     }
     else if (jval.is_array())
     {
         for (size_t i = 0; i < jval.size(); ++i)
         {
-            collect_json(jval[i], node.children[std::to_string(i)]);
+            auto key = std::pmr::string{std::to_string(i), node.children.get_allocator()};
+            collect_json(jval[i], node.children[std::move(key)]);
         }
     }
     else if (jval.is_number_integer())
@@ -71,7 +66,9 @@ void collect_json(const json &jval, IntNode &node, const bool drop_first_char =
     }
     else if (jval.is_string())
     {
-        node.value = jval.get<std::string>();
+        node.value.emplace(std::in_place_type<std::pmr::string>,
+                           jval.get_ref<const json::string_t &>(),
+                           node.children.get_allocator());
     }
 }
 
@@ -116,24 +113,24 @@ void get_skill_info(const IntNode &node, LogSkillInfoMap &log_skill_info_map)
 {
     for (const auto &[icon_id, skill_node] : node.children)
     {
-        auto name = std::string{};
+        auto name = InternedString{};
         auto icon = std::string{};
 
         const auto name_it = skill_node.children.find("name");
         if (name_it != skill_node.children.end() && name_it->second.value.has_value())
         {
-            if (const auto pval = std::get_if<std::string>(&name_it->second.value.value()))
-                name = *pval;
+            if (const auto pval = std::get_if<std::pmr::string>(&name_it->second.value.value()))
+                name = InternedString{std::string_view{*pval}};
         }
 
         const auto icon_it = skill_node.children.find("icon");
         if (icon_it != skill_node.children.end() && icon_it->second.value.has_value())
         {
-            if (const auto pval = std::get_if<std::string>(&icon_it->second.value.value()))
-                icon = convert_cache_url(*pval);
+            if (const auto pval = std::get_if<std::pmr::string>(&icon_it->second.value.value()))
+                icon = convert_cache_url(std::string{*pval});
         }
 
-        log_skill_info_map[std::stoi(icon_id)] = {
+        log_skill_info_map[std::stoi(std::string{icon_id})] = {
             name,
             icon,
         };
@@ -157,64 +154,85 @@ bool remove_skill_if(const RotationStep &current, const RotationStep &previous)
             (current.time_of_cast - previous.time_of_cast) < 250);
 }
 
-bool get_is_skill_dropped(const EliteSpecID elite_spec_id,
-                          const SkillData &skill_data,
-                          const SkillRules &skill_rules,
-                          const bool is_strict_mode,
-                          const bool show_weapon_swap,
-                          const bool is_easy_skill_mode)
+// Rule inputs that are the same for every step of one rotation
+struct SkillRuleContext
 {
-    const auto is_substr_drop_match = is_skill_in_set(skill_data.name, skill_rules.skills_substr_to_drop_names);
-    const auto is_exact_drop_match = is_skill_in_set(skill_data.name, skill_rules.skills_match_to_drop_names, true) ||
-                                     is_skill_in_set(skill_data.skill_id, skill_rules.skills_match_to_drop);
+    EliteSpecID elite_spec_id;
+    bool is_strict_mode;
+    bool show_weapon_swap;
+    bool is_easy_skill_mode;
+    bool has_build_file;
+    const FrozenSet<SkillID> *class_special_gray_out = nullptr;
+    const FrozenSet<SkillID> *class_easy_mode_gray_out = nullptr;
+    const FrozenSet<SkillID> *class_easy_mode_drop = nullptr;
+};
+
+SkillRuleContext get_skill_rule_context(const EliteSpecID elite_spec_id,
+                                        const std::filesystem::path &json_path,
+                                        const SkillRules &skill_rules,
+                                        const bool is_strict_mode,
+                                        const bool show_weapon_swap,
+                                        const bool is_easy_skill_mode)
+{
+    auto context = SkillRuleContext{
+        .elite_spec_id = elite_spec_id,
+        .is_strict_mode = is_strict_mode,
+        .show_weapon_swap = show_weapon_swap,
+        .is_easy_skill_mode = is_easy_skill_mode,
+        .has_build_file = false,
+    };
 
-    auto drop_skill = is_substr_drop_match || is_exact_drop_match;
-    if (!show_weapon_swap || is_strict_mode)
-    {
-        const auto drop_substr_swap = is_skill_in_set(skill_data.name, skill_rules.skills_substr_weapon_swap_like);
-        const auto drop_match_swap = is_skill_in_set(skill_data.name, skill_rules.skills_match_weapon_swap_like, true);
+    const auto class_name = json_path.stem().string();
+    if (class_name == "")
+        return context;
 
-        const auto is_unknownm = skill_data.name.find("Unknown Skill") != std::string::npos;
+    context.has_build_file = true;
 
-        drop_skill = is_substr_drop_match || is_exact_drop_match || drop_substr_swap || drop_match_swap || is_unknownm;
+    const auto find_class_set = [&class_name](const FrozenMap<std::string_view, FrozenSet<SkillID>> &class_map) {
+        const auto class_it = class_map.find(class_name);
+        return class_it != class_map.end() ? &class_it->second : nullptr;
+    };
+    context.class_special_gray_out = find_class_set(skill_rules.class_map_special_match_to_gray_out);
+    context.class_easy_mode_gray_out = find_class_set(skill_rules.class_map_easy_mode_match_to_gray_out);
+    context.class_easy_mode_drop = find_class_set(skill_rules.class_map_easy_mode_drop_match);
 
-        if (!drop_skill)
-        {
-            auto current_spec = get_current_spec_name();
-            auto spec_lower = to_lowercase(current_spec);
+    return context;
+}
 
-            if ((spec_lower == "vindicator" || spec_lower == "mirage" || spec_lower == "druid") &&
-                skill_data.name == "Dodge")
-                drop_skill = false;
-        }
+uint32_t get_skill_rule_mask(const SkillData &skill_data)
+{
+    const auto &matcher = SkillRuleData::skill_rule_matcher;
 
-        drop_skill = is_substr_drop_match || is_exact_drop_match || drop_substr_swap || drop_match_swap ||
-                     is_unknownm || drop_skill;
-    }
+    return matcher.get_name_mask(skill_data.name.view()) | matcher.get_id_mask(skill_data.skill_id);
+}
 
-    if (is_easy_skill_mode && !drop_skill)
+bool get_is_skill_dropped(const SkillData &skill_data, const uint32_t rule_mask, const SkillRuleContext &context)
+{
+    const auto is_drop_match = (rule_mask & (SkillRuleMask::DROP_NAME | SkillRuleMask::DROP_ID)) != 0;
+
+    auto drop_skill = is_drop_match;
+    if (!context.show_weapon_swap || context.is_strict_mode)
     {
-        auto is_exact_easy_mode_drop_match = is_skill_in_set(skill_data.skill_id, skill_rules.easy_mode_drop_match);
+        const auto is_swap_or_unknown =
+            (rule_mask & (SkillRuleMask::WEAPON_SWAP_NAME | SkillRuleMask::UNKNOWN_NAME)) != 0;
 
-        const auto stem = Globals::RenderData.selected_file_path.stem().string();
-        if (stem != "")
-        {
-            const auto class_name = stem;
-            const auto class_it = skill_rules.class_map_easy_mode_drop_match.find(class_name);
-            if (class_it != skill_rules.class_map_easy_mode_drop_match.end())
-            {
-                const auto &class_special_set = class_it->second;
-                is_exact_easy_mode_drop_match = is_skill_in_set(skill_data.skill_id, class_special_set);
-            }
-        }
+        drop_skill = is_drop_match || is_swap_or_unknown;
+    }
+
+    if (context.is_easy_skill_mode && !drop_skill)
+    {
+        // The set of the loaded build replaces the general one
+        auto is_exact_easy_mode_drop_match = (rule_mask & SkillRuleMask::EASY_MODE_DROP_ID) != 0;
+        if (context.class_easy_mode_drop != nullptr)
+            is_exact_easy_mode_drop_match = is_skill_in_set(skill_data.skill_id, *context.class_easy_mode_drop);
 
         if (!is_exact_easy_mode_drop_match)
-            is_exact_easy_mode_drop_match = is_skill_in_set(skill_data.name, skill_rules.easy_mode_names_drop_substr);
+            is_exact_easy_mode_drop_match = (rule_mask & SkillRuleMask::EASY_MODE_DROP_NAME) != 0;
 
         drop_skill = is_exact_easy_mode_drop_match;
     }
 
-    if (skill_data.skill_id == SkillID::SYMBOL_OF_BLADES && elite_spec_id == EliteSpecID::Luminary)
+    if (skill_data.skill_id == SkillID::SYMBOL_OF_BLADES && context.elite_spec_id == EliteSpecID::Luminary)
     {
         drop_skill = true;
     }
@@ -222,57 +240,36 @@ bool get_is_skill_dropped(const EliteSpecID elite_spec_id,
     return drop_skill;
 }
 
-bool get_is_special_skill(const SkillData &skill_data, const SkillRules &skill_rules, const bool is_easy_skill_mode)
+bool get_is_special_skill(const SkillData &skill_data, const uint32_t rule_mask, const SkillRuleContext &context)
 {
     if (skill_data.is_heal_skill)
         return true;
 
-    const auto is_substr_gray_out = is_skill_in_set(skill_data.name, skill_rules.special_substr_to_gray_out);
-    const auto is_match_gray_out =
-        is_skill_in_set(skill_data.name, skill_rules.special_match_to_gray_out_names, true) ||
-        is_skill_in_set(skill_data.skill_id, skill_rules.special_match_to_gray_out) ||
-        is_skill_in_set(skill_data.skill_id, skill_rules.special_match_to_gray_out_manual_ids);
-
-    const auto stem = Globals::RenderData.selected_file_path.stem().string();
-    if (stem != "")
+    if (context.has_build_file)
     {
-        const auto class_name = stem;
-        const auto class_it = skill_rules.class_map_special_match_to_gray_out.find(class_name);
-        if (class_it != skill_rules.class_map_special_match_to_gray_out.end())
-        {
-            const auto &class_special_set = class_it->second;
-            const auto is_class_special_gray_out = is_skill_in_set(skill_data.skill_id, class_special_set);
-            if (is_class_special_gray_out)
-                return true;
-        }
+        if (context.class_special_gray_out != nullptr &&
+            is_skill_in_set(skill_data.skill_id, *context.class_special_gray_out))
+            return true;
 
-        if (is_easy_skill_mode)
+        if (context.is_easy_skill_mode)
         {
-            const auto class_easy_it = skill_rules.class_map_easy_mode_match_to_gray_out.find(class_name);
-            if (class_easy_it != skill_rules.class_map_easy_mode_match_to_gray_out.end())
-            {
-                const auto &class_easy_set = class_easy_it->second;
-                const auto is_class_easy_gray_out = is_skill_in_set(skill_data.skill_id, class_easy_set);
-                if (is_class_easy_gray_out)
-                    return true;
-            }
+            if (context.class_easy_mode_gray_out != nullptr &&
+                is_skill_in_set(skill_data.skill_id, *context.class_easy_mode_gray_out))
+                return true;
 
-            if (skill_rules.easy_mode_match_to_gray_out.find(skill_data.skill_id) !=
-                skill_rules.easy_mode_match_to_gray_out.end())
+            if ((rule_mask & SkillRuleMask::EASY_MODE_GRAY_OUT_ID) != 0)
                 return true;
         }
     }
 
-    if (is_substr_gray_out || is_match_gray_out)
-        return true;
+    constexpr auto special_mask =
+        SkillRuleMask::GRAY_OUT_NAME | SkillRuleMask::GRAY_OUT_ID | SkillRuleMask::WEAPON_SWAP_NAME;
 
-    const auto drop_substr_swap = is_skill_in_set(skill_data.name, skill_rules.skills_substr_weapon_swap_like);
-    const auto drop_match_swap = is_skill_in_set(skill_data.name, skill_rules.skills_match_weapon_swap_like, true);
-
-    return drop_substr_swap || drop_match_swap;
+    return (rule_mask & special_mask) != 0;
 }
 
 void get_rotation_info(const EliteSpecID elite_spec_id,
+                       const std::filesystem::path &json_path,
                        const IntNode &node,
                        const LogSkillInfoMap &log_skill_info_map,
                        RotationSteps &all_rotation_steps,
@@ -281,6 +278,16 @@ void get_rotation_info(const EliteSpecID elite_spec_id,
                        const bool show_weapon_swap,
                        const bool is_easy_skill_mode)
 {
+    const auto rule_context = get_skill_rule_context(elite_spec_id,
+                                                     json_path,
+                                                     SkillRuleData::skill_rules,
+                                                     is_strict_mode,
+                                                     show_weapon_swap,
+                                                     is_easy_skill_mode);
+
+    // (is dropped, is special) per skill, a rotation casts the same few skills over and over
+    auto classified_skills = std::map<std::tuple<SkillID, InternedString, bool>, std::pair<bool, bool>>{};
+
     for (const auto &rotation_entry : node.children)
     {
         const auto &rotation_array = rotation_entry.second;
@@ -347,34 +354,35 @@ void get_rotation_info(const EliteSpecID elite_spec_id,
                 {
                     if (_icon_id == icon_id)
                     {
-                        if (_skill_data.name.find("Relic") != std::string::npos ||
-                            _skill_data.name.find("Sigil") != std::string::npos)
+                        if (_skill_data.name.view().find("Relic") != std::string::npos ||
+                            _skill_data.name.view().find("Sigil") != std::string::npos)
                             skip_skill = true;
 
-                        skill_data.skill_id = SafeConvertToSkillID(_icon_id); // TODO : check if we need this if at all
+                        // TODO : check if we need this if at all
+                        skill_data.skill_id = SafeConvertToSkillID(_icon_id, skill_data_map);
 
                         if (skill_data.skill_id == SkillID::NONE || skill_data.skill_id == SkillID::UNKNOWN_SKILL)
                         {
                             if (const auto it2 = SkillRuleData::unk_skill_id_based_on_icon_id_fix.find(icon_id);
                                 it2 != SkillRuleData::unk_skill_id_based_on_icon_id_fix.end())
                             {
-                                skill_data.skill_id = SafeConvertToSkillID(it2->second);
+                                skill_data.skill_id = SafeConvertToSkillID(it2->second, skill_data_map);
                             }
                         }
 
                         skill_data.name = _skill_data.name;
                         skill_data.icon_id = icon_id;
 
-                        if (_skill_data.name.find("Dual") != std::string::npos &&
-                            _skill_data.name.find("Attunement") != std::string::npos)
+                        if (_skill_data.name.view().find("Dual") != std::string::npos &&
+                            _skill_data.name.view().find("Attunement") != std::string::npos)
                         {
-                            if (_skill_data.name.find("Fire") != std::string::npos)
+                            if (_skill_data.name.view().find("Fire") != std::string::npos)
                                 skill_data.skill_id = SkillID::WEAPON_SWAP;
-                            else if (_skill_data.name.find("Air") != std::string::npos)
+                            else if (_skill_data.name.view().find("Air") != std::string::npos)
                                 skill_data.skill_id = SkillID::WEAPON_SWAP;
-                            else if (_skill_data.name.find("Earth") != std::string::npos)
+                            else if (_skill_data.name.view().find("Earth") != std::string::npos)
                                 skill_data.skill_id = SkillID::WEAPON_SWAP;
-                            else if (_skill_data.name.find("Water") != std::string::npos)
+                            else if (_skill_data.name.view().find("Water") != std::string::npos)
                                 skill_data.skill_id = SkillID::WEAPON_SWAP;
                             skill_data.name = "Weapon Swap";
                             skill_data.icon_id = (int)SkillID::WEAPON_SWAP;
@@ -396,17 +404,23 @@ void get_rotation_info(const EliteSpecID elite_spec_id,
                 skill_data.icon_id = -9999;
             }
 
-            const auto drop_skill = get_is_skill_dropped(elite_spec_id,
-                                                         skill_data,
-                                                         SkillRuleData::skill_rules,
-                                                         is_strict_mode,
-                                                         show_weapon_swap,
-                                                         is_easy_skill_mode);
+            auto classified_key = std::make_tuple(skill_data.skill_id, skill_data.name, skill_data.is_heal_skill);
+            auto classified_it = classified_skills.find(classified_key);
+            if (classified_it == classified_skills.end())
+            {
+                const auto rule_mask = get_skill_rule_mask(skill_data);
+                const auto drop_skill = get_is_skill_dropped(skill_data, rule_mask, rule_context);
+                const auto is_special_skill = !drop_skill && get_is_special_skill(skill_data, rule_mask, rule_context);
+
+                classified_it =
+                    classified_skills.emplace(std::move(classified_key), std::make_pair(drop_skill, is_special_skill))
+                        .first;
+            }
+
+            const auto [drop_skill, is_special_skill] = classified_it->second;
 
             if (!drop_skill)
             {
-                const auto is_special_skill =
-                    get_is_special_skill(skill_data, SkillRuleData::skill_rules, is_easy_skill_mode);
 
                 const auto cast_time_it = SkillRuleData::skill_cast_time_map.find(skill_data.skill_id);
                 if (cast_time_it != SkillRuleData::skill_cast_time_map.end())
@@ -435,10 +449,8 @@ void get_rotation_info(const EliteSpecID elite_spec_id,
 
     for (auto it = all_rotation_steps.begin(); it != all_rotation_steps.end();)
     {
-        const auto is_duplicate_skill =
-            is_skill_in_set(it->skill_data.name,
-                            SkillRuleData::skill_rules.special_substr_to_remove_duplicates_names) ||
-            is_skill_in_set(it->skill_data.skill_id, SkillRuleData::skill_rules.special_substr_to_remove_duplicates);
+        const auto is_duplicate_skill = (get_skill_rule_mask(it->skill_data) &
+                                         (SkillRuleMask::DUPLICATE_NAME | SkillRuleMask::DUPLICATE_ID)) != 0;
 
         bool should_remove = false;
         if (is_duplicate_skill && !it->skill_data.is_auto_attack) // && it->skill_data.skill_id != SkillID::DEVASTATOR)
@@ -463,9 +475,69 @@ void get_rotation_info(const EliteSpecID elite_spec_id,
     }
 }
 
-SkillDataMap get_skill_data_map(const nlohmann::json &j)
+std::tuple<LogSkillInfoMap, RotationSteps, RotationSteps, MetaData, SkillKeyMapping> get_dpsreport_data(
+    const EliteSpecID elite_spec_id,
+    const std::filesystem::path &json_path,
+    const SkillDataMap &skill_data_map,
+    std::pmr::memory_resource *resource)
 {
-    auto skill_data_map = SkillDataMap{};
+    auto json_rotation_log = nlohmann::json{};
+    auto is_load_success = load_rotaion_json(json_path, json_rotation_log);
+    if (!is_load_success)
+        return std::make_tuple(LogSkillInfoMap{resource},
+                               RotationSteps{},
+                               RotationSteps{},
+                               MetaData{},
+                               SkillKeyMapping{});
+
+    const auto rotation_data = json_rotation_log["rotation"];
+    const auto skill_data = json_rotation_log["skillMap"];
+
+    // The parse trees only live until the rotation steps are extracted, so
+    // their nodes are never freed one by one but dropped with the arena
+    auto parse_arena = std::pmr::monotonic_buffer_resource{};
+    auto kv_rotation = IntNode{&parse_arena};
+    collect_json(rotation_data, kv_rotation);
+    auto kv_skill = IntNode{&parse_arena};
+    collect_json(skill_data, kv_skill, true);
+
+    auto log_skill_info_map = LogSkillInfoMap{resource};
+    get_skill_info(kv_skill, log_skill_info_map);
+    auto rotation_steps = RotationSteps{};
+    get_rotation_info(elite_spec_id,
+                      json_path,
+                      kv_rotation,
+                      log_skill_info_map,
+                      rotation_steps,
+                      skill_data_map,
+                      false, // Settings::StrictModeForSkillDetection,
+                      Settings::ShowWeaponSwap,
+                      Settings::EasySkillMode);
+    auto rotation_steps_w_swap = RotationSteps{};
+    get_rotation_info(elite_spec_id,
+                      json_path,
+                      kv_rotation,
+                      log_skill_info_map,
+                      rotation_steps_w_swap,
+                      skill_data_map,
+                      false, //  Settings::StrictModeForSkillDetection,
+                      true,
+                      Settings::EasySkillMode);
+
+    auto metadata = get_metadata(json_path, json_rotation_log);
+    auto skill_key_mapping = get_skill_key_mapping(json_rotation_log);
+
+    return std::make_tuple(std::move(log_skill_info_map),
+                           std::move(rotation_steps),
+                           std::move(rotation_steps_w_swap),
+                           metadata,
+                           skill_key_mapping);
+}
+} // namespace
+
+SkillDataMap get_skill_data_map(const nlohmann::json &j, std::pmr::memory_resource *resource)
+{
+    auto skill_data_map = SkillDataMap{resource};
 
     for (const auto &[skill_id_str, skill_obj] : j.items())
     {
@@ -577,8 +649,8 @@ SkillDataMap get_skill_data_map(const nlohmann::json &j)
 
                     const auto msg = "Failed to parse icon ID from URL: " + icon_url +
                                      " for skill ID: " + std::to_string(skill_id_int) +
-                                     " and Skill Name: " + skill_data.name;
-                    (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", msg.c_str());
+                                     " and Skill Name: " + skill_data.name.str();
+                    log_message(LogLevel::WARNING, msg);
                 }
             }
             else
@@ -587,8 +659,8 @@ SkillDataMap get_skill_data_map(const nlohmann::json &j)
 
                 const auto msg = "Failed to parse icon ID from URL: " + icon_url +
                                  " for skill ID: " + std::to_string(skill_id_int) +
-                                 " and Skill Name: " + skill_data.name;
-                (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", msg.c_str());
+                                 " and Skill Name: " + skill_data.name.str();
+                log_message(LogLevel::WARNING, msg);
             }
         }
 
@@ -605,8 +677,8 @@ SkillDataMap get_skill_data_map(const nlohmann::json &j)
                 skill_data.name = "Unknown";
                 skill_data.icon_id = (int)SkillID::UNKNOWN_SKILL;
 
-                const auto msg = "Failed to parse skill name: " + skill_data.name;
-                (void)Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", msg.c_str());
+                const auto msg = "Failed to parse skill name: " + skill_data.name.str();
+                log_message(LogLevel::WARNING, msg);
             }
         }
 
@@ -673,7 +745,7 @@ MetaData get_metadata(const std::filesystem::path &json_path, const nlohmann::js
     if (build_meta.contains("html_file_path") && build_meta["html_file_path"].is_string())
         metadata.html_file_path = build_meta["html_file_path"].get<std::string>();
 
-    if (build_meta.contains("overall_dps") && build_meta["overall_dps"].is_number_float())
+    if (build_meta.contains("overall_dps") && build_meta["overall_dps"].is_number())
         metadata.overall_dps = build_meta["overall_dps"].get<double>();
 
     const auto filename = json_path.filename().string();
@@ -684,151 +756,6 @@ MetaData get_metadata(const std::filesystem::path &json_path, const nlohmann::js
     return metadata;
 }
 
-std::tuple<LogSkillInfoMap, RotationSteps, RotationSteps, MetaData, SkillKeyMapping> get_dpsreport_data(
-    const EliteSpecID elite_spec_id,
-    const std::filesystem::path &json_path,
-    const SkillDataMap &skill_data_map)
-{
-    auto json_rotation_log = nlohmann::json{};
-    auto is_load_success = load_rotaion_json(json_path, json_rotation_log);
-    if (!is_load_success)
-        return std::make_tuple(LogSkillInfoMap{}, RotationSteps{}, RotationSteps{}, MetaData{}, SkillKeyMapping{});
-
-    const auto rotation_data = json_rotation_log["rotation"];
-    const auto skill_data = json_rotation_log["skillMap"];
-
-    auto kv_rotation = IntNode{};
-    collect_json(rotation_data, kv_rotation);
-    auto kv_skill = IntNode{};
-    collect_json(skill_data, kv_skill, true);
-
-    auto log_skill_info_map = LogSkillInfoMap{};
-    get_skill_info(kv_skill, log_skill_info_map);
-    auto rotation_steps = RotationSteps{};
-    get_rotation_info(elite_spec_id,
-                      kv_rotation,
-                      log_skill_info_map,
-                      rotation_steps,
-                      skill_data_map,
-                      false, // Settings::StrictModeForSkillDetection,
-                      Settings::ShowWeaponSwap,
-                      Settings::EasySkillMode);
-    auto rotation_steps_w_swap = RotationSteps{};
-    get_rotation_info(elite_spec_id,
-                      kv_rotation,
-                      log_skill_info_map,
-                      rotation_steps_w_swap,
-                      skill_data_map,
-                      false, //  Settings::StrictModeForSkillDetection,
-                      true,
-                      Settings::EasySkillMode);
-
-    auto metadata = get_metadata(json_path, json_rotation_log);
-    auto skill_key_mapping = get_skill_key_mapping(json_rotation_log);
-
-    return std::make_tuple(log_skill_info_map, rotation_steps, rotation_steps_w_swap, metadata, skill_key_mapping);
-}
-
-bool DownloadFileFromURL(const std::string &url, const std::filesystem::path &out_path)
-{
-    const auto hInternet = InternetOpenA("GW2RotaHelper", INTERNET_OPEN_TYPE_PRECONFIG, NULL, NULL, 0);
-    if (!hInternet)
-    {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Failed to open internet connection");
-        return false;
-    }
-
-    const auto hFile = InternetOpenUrlA(hInternet, url.c_str(), NULL, 0, INTERNET_FLAG_RELOAD, 0);
-    if (!hFile)
-    {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Failed to open URL");
-        InternetCloseHandle(hInternet);
-        return false;
-    }
-
-    auto outFile = std::ofstream{out_path, std::ios::binary};
-    if (!outFile.is_open())
-    {
-        (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Failed to create output file");
-        InternetCloseHandle(hFile);
-        InternetCloseHandle(hInternet);
-        return false;
-    }
-
-    auto buffer = std::array<char, 4096>{};
-    auto bytesRead = DWORD{0};
-    auto success = true;
-
-    do
-    {
-        if (InternetReadFile(hFile, buffer.data(), buffer.size(), &bytesRead))
-        {
-            if (bytesRead > 0)
-            {
-                outFile.write(buffer.data(), bytesRead);
-                if (outFile.fail())
-                {
-                    (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Failed to write to file");
-                    success = false;
-                    break;
-                }
-            }
-        }
-        else
-        {
-            (void)Globals::APIDefs->Log(LOGL_CRITICAL, "GW2RotaHelper", "Failed to read from URL");
-            success = false;
-            break;
-        }
-    } while (bytesRead > 0);
-
-    // Cleanup
-    outFile.close();
-    InternetCloseHandle(hFile);
-    InternetCloseHandle(hInternet);
-
-    if (success)
-    {
-        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Successfully downloaded file");
-    }
-    else
-    {
-        std::filesystem::remove(out_path);
-    }
-
-    return success;
-}
-
-std::list<std::future<void>> StartDownloadAllSkillIcons(const LogSkillInfoMap &log_skill_info_map,
-                                                        const std::filesystem::path &img_folder)
-{
-    std::filesystem::create_directories(img_folder);
-    auto futures = std::list<std::future<void>>{};
-
-    for (const auto &[icon_id, info] : log_skill_info_map)
-    {
-        if (info.icon_url.empty() || info.icon_url.find("local://") == 0)
-            continue;
-
-        auto ext{std::string{".png"}};
-        const auto dot_pos{info.icon_url.find_last_of('.')};
-        if (dot_pos != std::string::npos && dot_pos + 1 < info.icon_url.size())
-        {
-            ext = info.icon_url.substr(dot_pos);
-        }
-        const auto out_path{img_folder / (std::to_string(icon_id) + ext)};
-        if (std::filesystem::exists(out_path))
-            continue;
-
-        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Downloading file");
-        futures.emplace_back(
-            std::async(std::launch::async, [url = info.icon_url, out_path]() { DownloadFileFromURL(url, out_path); }));
-    }
-
-    return futures;
-}
-} // namespace
-
 bool is_skill_in_set(const std::string &skill_name, const std::set<std::string> &set, const bool exact_match)
 {
     for (const auto &filter_string : set)
@@ -848,7 +775,7 @@ bool is_skill_in_set(const std::string &skill_name, const std::set<std::string>
     return false;
 }
 
-bool is_skill_in_set(std::string_view skill_name, const std::set<std::string_view> &set, const bool exact_match)
+bool is_skill_in_set(std::string_view skill_name, const FrozenSet<std::string_view> &set, const bool exact_match)
 {
     for (const auto &filter_string : set)
     {
@@ -867,20 +794,14 @@ bool is_skill_in_set(std::string_view skill_name, const std::set<std::string_vie
     return false;
 }
 
-bool is_skill_in_set(SkillID skill_id, const std::set<SkillID> &set)
+bool is_skill_in_set(SkillID skill_id, const FrozenSet<SkillID> &set)
 {
-    if (set.find(skill_id) != set.end())
-        return true;
-
-    return false;
+    return set.contains(skill_id);
 }
 
-bool is_skill_in_set(SkillID skill_id, const std::set<ManualSkillID> &set)
+bool is_skill_in_set(SkillID skill_id, const FrozenSet<ManualSkillID> &set)
 {
-    if (set.find(static_cast<ManualSkillID>(skill_id)) != set.end())
-        return true;
-
-    return false;
+    return set.contains(static_cast<ManualSkillID>(skill_id));
 }
 
 SkillState get_skill_state(const RotationLogType &rotation_run,
@@ -890,7 +811,7 @@ SkillState get_skill_state(const RotationLogType &rotation_run,
                            const bool is_auto_attack)
 {
     const auto is_current = (window_idx == static_cast<int32_t>(current_idx));
-    const auto is_last = (window_idx == Globals::RotationRun.all_rotation_steps.size() - 1);
+    const auto is_last = (window_idx == rotation_run.all_rotation_steps.size() - 1);
 
     return SkillState{
         .is_current = is_current,
@@ -899,92 +820,57 @@ SkillState get_skill_state(const RotationLogType &rotation_run,
     };
 }
 
-void RotationLogType::calculate_auto_attack_indices()
+void RotationLogType::calculate_auto_attack_runs()
 {
-    const auto &all_steps = all_rotation_steps;
-    auto &indices = auto_attack_indices;
-
-    indices.clear();
-    indices.resize(all_steps.size(), 0);
-
-    for (size_t i = 0; i < all_steps.size(); ++i)
-    {
-        if (!all_steps[i].skill_data.is_auto_attack)
-            continue;
-
-        auto sequence_start = i;
-        while (sequence_start > 0 && all_steps[sequence_start - 1].skill_data.is_auto_attack)
-            sequence_start--;
-
-        auto sequence_end = i;
-        while (sequence_end < all_steps.size() - 1 && all_steps[sequence_end + 1].skill_data.is_auto_attack)
-            sequence_end++;
+    auto_attack_runs = get_auto_attack_runs(all_rotation_steps, [](const SkillData &skill_data) {
+        return skill_data.is_auto_attack;
+    });
+}
 
-        auto sequence_length = sequence_end - sequence_start + 1;
-        if (sequence_length > 1)
-        {
-            for (size_t j = sequence_start; j <= sequence_end; ++j)
-            {
-                indices[j] = static_cast<int>(j - sequence_start + 1);
-            }
-        }
-    }
+int RotationLogType::get_auto_attack_index(const size_t idx) const
+{
+    return ::get_auto_attack_index(auto_attack_runs, idx);
 }
 
-void RotationLogType::load_data(const std::filesystem::path &json_path, const std::filesystem::path &img_path)
+void RotationLogType::load_data(const std::filesystem::path &json_path)
 {
+    const auto profile_scope = ProfileScopeType{ProfileZone::BUILD_LOAD};
+
     skill_data_map.clear();
     log_skill_info_map.clear();
     all_rotation_steps.clear();
-    auto_attack_indices.clear();
+    auto_attack_runs.clear();
+    pending_icon_downloads.clear();
+    build_arena.release();
 
     auto jsons_skill_data = nlohmann::json{};
     const auto load_success = load_skill_data_map(json_path, jsons_skill_data);
     if (!load_success)
         return;
-    skill_data_map = get_skill_data_map(jsons_skill_data);
+    skill_data_map = get_skill_data_map(jsons_skill_data, &build_arena);
 
     profession_id = meta_data.profession_id;
     elite_spec_id = meta_data.elite_spec_id;
 
-    const auto [_skill_info_map,
-                _bench_all_rotation_steps,
-                _bench_all_rotation_steps_w_swap,
-                _meta_data,
-                _skill_key_mapping] = get_dpsreport_data(elite_spec_id, json_path, skill_data_map);
+    auto [_skill_info_map,
+          _bench_all_rotation_steps,
+          _bench_all_rotation_steps_w_swap,
+          _meta_data,
+          _skill_key_mapping] = get_dpsreport_data(elite_spec_id, json_path, skill_data_map, &build_arena);
 
-    log_skill_info_map = _skill_info_map;
-    all_rotation_steps = _bench_all_rotation_steps;
-    all_rotation_steps_w_swap = _bench_all_rotation_steps_w_swap;
+    log_skill_info_map = std::move(_skill_info_map);
+    const auto skill_table = std::make_shared<RotationSkillTableType>();
+    all_rotation_steps = RotationTableType{_bench_all_rotation_steps, skill_table};
+    all_rotation_steps_w_swap = RotationTableType{_bench_all_rotation_steps_w_swap, skill_table};
     meta_data = _meta_data;
     skill_key_mapping = _skill_key_mapping;
 
     restart_rotation();
 
     if (!all_rotation_steps.empty())
-        calculate_auto_attack_indices();
-
-    futures = StartDownloadAllSkillIcons(log_skill_info_map, img_path);
-    (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Loaded Rotation");
-}
-
-void RotationLogType::get_rotation_skills()
-{
-    for (const auto &step : all_rotation_steps)
-    {
-        if (rotation_skills.find(step.skill_data.skill_id) == rotation_skills.end())
-        {
-            const auto icon_it = Globals::TextureMap.find(step.skill_data.icon_id);
-            if (icon_it == Globals::TextureMap.end())
-                continue;
+        calculate_auto_attack_runs();
 
-            const auto skill = RotationSkill{step.skill_data.skill_id,
-                                             step.skill_data.name,
-                                             icon_it->second,
-                                             step.skill_data.skill_slot};
-            rotation_skills.insert({step.skill_data.skill_id, skill});
-        }
-    }
+    log_message(LogLevel::DEBUG, "Loaded Rotation");
 }
 
 void RotationLogType::pop_bench_rotation_queue()
@@ -1015,17 +901,18 @@ std::tuple<std::int32_t, std::int32_t, size_t> RotationLogType::get_current_rota
     return {start, end, current_idx};
 }
 
-RotationStep RotationLogType::get_rotation_skill(const size_t idx) const
+RotationStepRef RotationLogType::get_rotation_skill(const size_t idx) const
 {
     if (idx < all_rotation_steps.size())
-        return all_rotation_steps.at(idx);
+        return all_rotation_steps[idx];
 
-    return RotationStep{};
+    static const auto empty_step = RotationStep{};
+    return empty_step;
 }
 
 void RotationLogType::restart_rotation()
 {
-    missing_rotation_steps = std::list<RotationStep>(all_rotation_steps.begin(), all_rotation_steps.end());
+    missing_rotation_steps = RotationSuffixType{all_rotation_steps};
 }
 
 bool RotationLogType::is_current_run_done() const
@@ -1040,16 +927,15 @@ void RotationLogType::reset_rotation()
     missing_rotation_steps.clear();
     skill_data_map.clear();
     meta_data = MetaData{};
-    auto_attack_indices.clear();
+    auto_attack_runs.clear();
     rotation_skills.clear();
-    (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Resetted Rotation");
+    build_arena.release();
+    log_message(LogLevel::DEBUG, "Resetted Rotation");
 }
 
-std::string RotationLogType::get_keybind_str(const RotationStep &rotation_step,
+std::string RotationLogType::get_keybind_str(const RotationStepRef &rotation_step,
                                              const std::map<std::string, KeybindInfo> &keybinds)
 {
-    const auto &skill_key_mapping = Globals::RotationRun.skill_key_mapping;
-    const auto &log_skill_info_map = Globals::RotationRun.log_skill_info_map;
     const auto skill_data = rotation_step.skill_data;
 
     std::string keybind_str;
@@ -1104,62 +990,30 @@ std::string RotationLogType::get_keybind_str(const RotationStep &rotation_step,
     return keybind_str;
 }
 
-void RotationLogType::get_rotation_icons()
-{
-    rotation_icon_lines.clear();
-    auto rotation_line = std::vector<std::tuple<ID3D11ShaderResourceView *, std::string, SkillID, bool>>{};
-
-    const auto &rotation = Globals::RotationRun.all_rotation_steps_w_swap;
-
-    for (const auto &rotation_step : rotation)
-    {
-        const auto skill_data = rotation_step.skill_data;
-        const auto weapon_type = skill_data.weapon_type;
-        const auto icon_it = Globals::TextureMap.find(skill_data.icon_id);
-
-        if (is_skill_in_set(skill_data.name, SkillRuleData::skill_rules.skills_match_weapon_swap_like))
-        {
-            rotation_icon_lines.push_back(rotation_line);
-            rotation_line = {};
-            continue;
-        }
-
-        if (icon_it != Globals::TextureMap.end())
-        {
-            if (!icon_it->second)
-                continue;
-            rotation_line.push_back(std::make_tuple(icon_it->second, skill_data.name, skill_data.skill_id, false));
-        }
-        else
-        {
-            continue;
-        }
-    }
-
-    if (!rotation_line.empty())
-    {
-        rotation_icon_lines.push_back(rotation_line);
-    }
-}
-
-void RotationLogType::get_rotation_text(const std::map<std::string, KeybindInfo> &keybinds)
+void RotationLogType::get_rotation_text(const std::map<std::string, KeybindInfo> &keybinds,
+                                        const ProfessionID player_profession_id,
+                                        const EliteSpecID player_elite_spec_id)
 {
     std::string line;
     rotation_text.clear();
 
     bool first_in_line = true;
 
-    const auto &rotation = Globals::RotationRun.all_rotation_steps_w_swap;
+    const auto &rotation = all_rotation_steps_w_swap;
+    const auto weapon_1_runs = get_auto_attack_runs(rotation, [](const SkillData &skill_data) {
+        return skill_data.skill_slot == SkillSlot::WEAPON_1;
+    });
+    auto run_it = weapon_1_runs.begin();
 
-    auto prev_was_aa = false;
-    for (const auto &rotation_step : rotation)
+    for (auto idx = size_t{0}; idx < rotation.size(); ++idx)
     {
+        const auto rotation_step = rotation[idx];
         const auto skill_data = rotation_step.skill_data;
         const auto weapon_type = skill_data.weapon_type;
         const auto weapon_type_str = weapon_type_to_string(weapon_type);
         const auto keybind_str = get_keybind_str(rotation_step, keybinds);
 
-        if (is_skill_in_set(skill_data.name, SkillRuleData::skill_rules.skills_match_weapon_swap_like))
+        if (is_skill_in_set(skill_data.name.view(), SkillRuleData::skill_rules.skills_match_weapon_swap_like))
         {
             if (line == "")
                 continue;
@@ -1168,30 +1022,30 @@ void RotationLogType::get_rotation_text(const std::map<std::string, KeybindInfo>
             {
                 // XXX: Hacky Solution
                 auto kit_name = std::string{"Utility"};
-                if (Globals::Identity.Profession == Mumble::EProfession::Engineer)
+                if (player_profession_id == ProfessionID::ENGINEER)
                 {
-                    if (static_cast<EliteSpecID>(Globals::Identity.Specialization) == EliteSpecID::Holosmith)
+                    if (player_elite_spec_id == EliteSpecID::Holosmith)
                         kit_name = "Forge";
                     else
                         kit_name = "Kit";
                 }
-                else if (Globals::Identity.Profession == Mumble::EProfession::Necromancer)
+                else if (player_profession_id == ProfessionID::NECROMANCER)
                     kit_name = "Shroud";
-                else if (Globals::Identity.Profession == Mumble::EProfession::Revenant)
+                else if (player_profession_id == ProfessionID::REVENANT)
                     kit_name = "Stance";
-                else if (Globals::Identity.Profession == Mumble::EProfession::Elementalist)
+                else if (player_profession_id == ProfessionID::ELEMENTALIST)
                     kit_name = "Attunement";
-                else if (static_cast<EliteSpecID>(Globals::Identity.Specialization) == EliteSpecID::Druid)
+                else if (player_elite_spec_id == EliteSpecID::Druid)
                     kit_name = "Avatar";
-                else if (static_cast<EliteSpecID>(Globals::Identity.Specialization) == EliteSpecID::Galeshot)
+                else if (player_elite_spec_id == EliteSpecID::Galeshot)
                     kit_name = "Cyclone";
-                else if (static_cast<EliteSpecID>(Globals::Identity.Specialization) == EliteSpecID::Untamed)
+                else if (player_elite_spec_id == EliteSpecID::Untamed)
                     kit_name = "Unleash";
-                else if (static_cast<EliteSpecID>(Globals::Identity.Specialization) == EliteSpecID::Luminary)
+                else if (player_elite_spec_id == EliteSpecID::Luminary)
                     kit_name = "Forge"; // TODO: Add in skills_match_weapon_swap_like
-                else if (static_cast<EliteSpecID>(Globals::Identity.Specialization) == EliteSpecID::Firebrand)
+                else if (player_elite_spec_id == EliteSpecID::Firebrand)
                     kit_name = "Tome"; // TODO: Add in skills_match_weapon_swap_like
-                else if (static_cast<EliteSpecID>(Globals::Identity.Specialization) == EliteSpecID::Bladesworn)
+                else if (player_elite_spec_id == EliteSpecID::Bladesworn)
                     kit_name = "Gunsaber";
 
                 line = kit_name + ": " + line;
@@ -1201,10 +1055,20 @@ void RotationLogType::get_rotation_text(const std::map<std::string, KeybindInfo>
             rotation_text.push_back(line);
             line.clear();
             first_in_line = true;
-            prev_was_aa = false;
         }
         else
         {
+            const auto curr_is_aa = skill_data.skill_slot == SkillSlot::WEAPON_1;
+            if (curr_is_aa)
+            {
+                while (run_it->start + run_it->length <= idx)
+                    ++run_it;
+
+                // The first step of an auto attack chain writes the length of the whole chain
+                if (run_it->start != idx)
+                    continue;
+            }
+
             if (line == "" && weapon_type_str != "None")
             {
                 line = weapon_type_str + ": ";
@@ -1215,38 +1079,11 @@ void RotationLogType::get_rotation_text(const std::map<std::string, KeybindInfo>
                 line += " - ";
             }
 
-            auto curr_is_aa = skill_data.skill_slot == SkillSlot::WEAPON_1;
-
             if (keybind_str != "")
             {
-                if (prev_was_aa && curr_is_aa)
-                {
-                    const auto search_str = std::string{"xAA"};
-                    const auto slcie_size = search_str.size() + 4;
-                    auto keep_slice = line.size() >= slcie_size ? line.substr(0, line.size() - slcie_size) : line;
-                    auto prev_counter =
-                        line.size() >= slcie_size ? line.substr(line.size() - slcie_size, slcie_size) : line;
-
-                    if (prev_counter.find(search_str) != std::string::npos)
-                    {
-                        auto found_idx = prev_counter.find("x");
-                        auto count_str = prev_counter.substr(0, found_idx);
-                        int count = 0;
-                        try
-                        {
-                            count = std::stoi(count_str);
-                        }
-                        catch (...)
-                        {
-                            count = 1;
-                        }
-                        count++;
-                        line = keep_slice + std::to_string(count) + "xAA";
-                    }
-                }
-                else if (curr_is_aa)
+                if (curr_is_aa)
                 {
-                    line += "1xAA";
+                    line += std::to_string(run_it->length) + "xAA";
                 }
                 else
                 {
@@ -1254,7 +1091,6 @@ void RotationLogType::get_rotation_text(const std::map<std::string, KeybindInfo>
                 }
             }
 
-            prev_was_aa = curr_is_aa;
             first_in_line = false;
         }
     }
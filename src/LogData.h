@@ -1,26 +1,31 @@
 #pragma once
 
-#include <d3d11.h>
-
 #include <filesystem>
-#include <future>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <set>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <variant>
 #include <vector>
 
 #include "nlohmann/json.hpp"
 
+#include "CompletionQueue.h"
+#include "Frozen.h"
+#include "RotationTable.h"
 #include "SkillIDs.h"
 #include "Types.h"
 
 using json = nlohmann::json;
 
+// Icon ids whose download finished, drained by the render thread
+using IconCompletionQueue = CompletionQueueType<int, 256>;
+
 class RotationLogType;
 
 SkillState get_skill_state(const RotationLogType &rotation_run,
@@ -32,43 +37,57 @@ SkillState get_skill_state(const RotationLogType &rotation_run,
 bool is_skill_in_set(const std::string &skill_name, const std::set<std::string> &set, const bool exact_match = false);
 
 bool is_skill_in_set(std::string_view skill_name,
-                     const std::set<std::string_view> &set,
+                     const FrozenSet<std::string_view> &set,
                      const bool exact_match = false);
 
-bool is_skill_in_set(SkillID skill_id, const std::set<SkillID> &set);
+bool is_skill_in_set(SkillID skill_id, const FrozenSet<SkillID> &set);
+
+bool is_skill_in_set(SkillID skill_id, const FrozenSet<ManualSkillID> &set);
 
-bool is_skill_in_set(SkillID skill_id, const std::set<ManualSkillID> &set);
+SkillKeyMapping get_skill_key_mapping(const nlohmann::json &j);
+
+MetaData get_metadata(const std::filesystem::path &json_path, const nlohmann::json &j);
+
+// Skill data of gw2_skills_en.json, the map allocates from the given resource
+SkillDataMap get_skill_data_map(const nlohmann::json &j, std::pmr::memory_resource *resource);
 
 class RotationLogType
 {
 public:
-    void load_data(const std::filesystem::path &json_path, const std::filesystem::path &img_path);
+    void load_data(const std::filesystem::path &json_path);
 
     void pop_bench_rotation_queue();
     std::tuple<int, int, size_t> get_current_rotation_indices() const;
-    RotationStep get_rotation_skill(const size_t idx) const;
-    void calculate_auto_attack_indices();
+    RotationStepRef get_rotation_skill(const size_t idx) const;
+    void calculate_auto_attack_runs();
+    int get_auto_attack_index(const size_t idx) const;
     void restart_rotation();
     void reset_rotation();
-    void get_rotation_skills();
     bool is_current_run_done() const;
 
-    std::string get_keybind_str(const RotationStep &rotation_step, const std::map<std::string, KeybindInfo> &keybinds);
-    void get_rotation_icons();
-    void get_rotation_text(const std::map<std::string, KeybindInfo> &keybinds);
-
-    std::list<std::future<void>> futures;
-    LogSkillInfoMap log_skill_info_map;
-    RotationSteps all_rotation_steps;
-    RotationSteps all_rotation_steps_w_swap;
-    RotationStepsList missing_rotation_steps;
-    SkillDataMap skill_data_map;
+    std::string get_keybind_str(const RotationStepRef &rotation_step,
+                                const std::map<std::string, KeybindInfo> &keybinds);
+    // The kit name of weapon swap like lines depends on the played character, not the build
+    void get_rotation_text(const std::map<std::string, KeybindInfo> &keybinds,
+                           const ProfessionID player_profession_id,
+                           const EliteSpecID player_elite_spec_id);
+
+    IconCompletionQueue downloaded_icons;
+    // Missing icons of the build that did not fit into the download queue yet
+    std::vector<int> pending_icon_downloads;
+    // Backs the per-build maps, released in one go when the build is unloaded
+    std::pmr::monotonic_buffer_resource build_arena{64 * 1024};
+    LogSkillInfoMap log_skill_info_map{&build_arena};
+    RotationTableType all_rotation_steps;
+    RotationTableType all_rotation_steps_w_swap;
+    RotationSuffixType missing_rotation_steps;
+    SkillDataMap skill_data_map{&build_arena};
     MetaData meta_data;
     SkillKeyMapping skill_key_mapping;
-    std::vector<int> auto_attack_indices;
+    std::vector<AutoAttackRun> auto_attack_runs;
 
     std::vector<std::string> rotation_text;
-    std::vector<std::vector<std::tuple<ID3D11ShaderResourceView *, std::string, SkillID, bool>>> rotation_icon_lines;
+    std::vector<std::vector<std::tuple<SkillIconView, InternedString, SkillID, bool>>> rotation_icon_lines;
     std::map<SkillID, RotationSkill> rotation_skills;
 
     ProfessionID profession_id;
@@ -0,0 +1,20 @@
+#include <atomic>
+
+#include "Logger.h"
+
+namespace
+{
+std::atomic<LoggerType *> current_logger = nullptr;
+} // namespace
+
+void set_logger(LoggerType *logger)
+{
+    current_logger.store(logger, std::memory_order_release);
+}
+
+void log_message(const LogLevel level, const char *message)
+{
+    auto *logger = current_logger.load(std::memory_order_acquire);
+    if (logger)
+        logger->log(level, message);
+}
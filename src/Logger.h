@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+enum class LogLevel : uint8_t
+{
+    CRITICAL,
+    WARNING,
+    INFO,
+    DEBUG,
+};
+
+// Destination of the log messages of the core. The addon forwards them to
+// Nexus, without a logger, e.g. in benchmarks, messages are dropped.
+class LoggerType
+{
+public:
+    virtual ~LoggerType() = default;
+
+    virtual void log(const LogLevel level, const char *message) = 0;
+};
+
+// The logger has to outlive every thread that logs, nullptr removes it
+void set_logger(LoggerType *logger);
+
+void log_message(const LogLevel level, const char *message);
+
+inline void log_message(const LogLevel level, const std::string &message)
+{
+    log_message(level, message.c_str());
+}
@@ -0,0 +1,131 @@
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <filesystem>
+
+#include "MappedFile.h"
+
+MappedFileType::~MappedFileType()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFileType::open(const std::filesystem::path &path)
+{
+    close();
+
+    auto handle = CreateFileW(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    auto size = LARGE_INTEGER{};
+    if (!GetFileSizeEx(handle, &size))
+    {
+        CloseHandle(handle);
+        return false;
+    }
+
+    file_handle = handle;
+    file_size = static_cast<size_t>(size.QuadPart);
+    is_mapped = true;
+
+    // Empty files cannot be mapped, they are exposed as an empty view
+    if (file_size == 0)
+        return true;
+
+    mapping_handle = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_handle == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    file_data = static_cast<const char *>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (file_data == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFileType::close()
+{
+    if (file_data != nullptr)
+        UnmapViewOfFile(file_data);
+    if (mapping_handle != nullptr)
+        CloseHandle(mapping_handle);
+    if (file_handle != nullptr)
+        CloseHandle(file_handle);
+
+    file_data = nullptr;
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+    file_size = 0;
+    is_mapped = false;
+}
+
+#else
+
+bool MappedFileType::open(const std::filesystem::path &path)
+{
+    close();
+
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat file_stat = {};
+    if (fstat(fd, &file_stat) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    file_descriptor = fd;
+    file_size = static_cast<size_t>(file_stat.st_size);
+    is_mapped = true;
+
+    if (file_size == 0)
+        return true;
+
+    auto *mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+
+    file_data = static_cast<const char *>(mapping);
+    return true;
+}
+
+void MappedFileType::close()
+{
+    if (file_data != nullptr)
+        munmap(const_cast<char *>(file_data), file_size);
+    if (file_descriptor >= 0)
+        ::close(file_descriptor);
+
+    file_data = nullptr;
+    file_descriptor = -1;
+    file_size = 0;
+    is_mapped = false;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+class MappedFileType
+{
+public:
+    MappedFileType() = default;
+    ~MappedFileType();
+
+    MappedFileType(const MappedFileType &) = delete;
+    MappedFileType &operator=(const MappedFileType &) = delete;
+
+    bool open(const std::filesystem::path &path);
+    void close();
+
+    const char *data() const
+    {
+        return file_data;
+    }
+    size_t size() const
+    {
+        return file_size;
+    }
+    std::string_view view() const
+    {
+        return std::string_view{file_data, file_size};
+    }
+    bool is_open() const
+    {
+        return is_mapped;
+    }
+
+private:
+    const char *file_data = nullptr;
+    size_t file_size = 0;
+    bool is_mapped = false;
+
+#ifdef _WIN32
+    void *file_handle = nullptr;
+    void *mapping_handle = nullptr;
+#else
+    int file_descriptor = -1;
+#endif
+};
@@ -1,6 +1,5 @@
-#include <windows.h>
-
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -9,29 +8,46 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "imgui.h"
-#include "mumble/Mumble.h"
 
-#include "ArcEvents.h"
 #include "Defines.h"
 #include "FileUtils.h"
 #include "LogData.h"
-#include "MumbleUtils.h"
+#include "Logger.h"
 #include "OptionsRender.h"
-#include "Render.h"
+#include "Profiler.h"
 #include "RenderUtils.h"
 #include "Rotation.h"
 #include "Settings.h"
-#include "Shared.h"
 #include "SkillData.h"
-#include "Textures.h"
 #include "Types.h"
 #include "TypesUtils.h"
+#include "UiShared.h"
 #include "Version.h"
 
+namespace
+{
+// Loads the selected build and starts the downloads of its missing icons
+void LoadSelectedRotation()
+{
+    Globals::RotationRun.load_data(Globals::RenderData.selected_file_path);
+    Globals::UiHost->start_icon_downloads();
+}
+
+void UpdateRotationText()
+{
+    Globals::RotationRun.get_rotation_text(Globals::RenderData.keybinds,
+                                           Globals::UiHost->get_profession(),
+                                           Globals::UiHost->get_elite_spec());
+}
+} // namespace
+
 void OptionsRenderType::render()
 {
+    const auto profile_scope = ProfileScopeType{ProfileZone::OPTIONS_RENDER};
+
 #ifdef _DEBUG
     const auto version_string = std::string("BETA v") + Globals::VersionString;
 #else
@@ -45,9 +61,13 @@ void OptionsRenderType::render()
     {
         if (Globals::ExtractedBenchData)
         {
-            Settings::VersionOfLastBenchFilesUpdate = Globals::VersionString;
-            Settings::BenchUpdateFailedBefore = false;
-            Settings::Save(Globals::SettingsPath);
+            if (Settings::VersionOfLastBenchFilesUpdate != Globals::VersionString ||
+                Settings::BenchUpdateFailedBefore)
+            {
+                Settings::VersionOfLastBenchFilesUpdate = Globals::VersionString;
+                Settings::BenchUpdateFailedBefore = false;
+                Settings::Save(Globals::SettingsPath);
+            }
 
             ImGui::Text("Successfully Downloaded and Extracted Bench Data.");
             ImGui::Text("Please disable and re-enable the addon within Nexus.");
@@ -57,8 +77,11 @@ void OptionsRenderType::render()
 
         if (Globals::BenchDataDownloadState == DownloadState::FAILED)
         {
-            Settings::BenchUpdateFailedBefore = true;
-            Settings::Save(Globals::SettingsPath);
+            if (!Settings::BenchUpdateFailedBefore)
+            {
+                Settings::BenchUpdateFailedBefore = true;
+                Settings::Save(Globals::SettingsPath);
+            }
 
             ImGui::Text("Failed Downloading/Extracting Bench Data.");
             ImGui::Text("Please send me a screenshot of the log messages.");
@@ -78,7 +101,7 @@ void OptionsRenderType::render()
         render_status();
     }
 
-    if (!IsValidMap())
+    if (!Globals::UiHost->is_valid_map())
     {
         const auto warning_text = "NOTE: Rotation tool is in PvP/WvW deactivated!";
         const auto centered_pos = calculate_centered_position({warning_text});
@@ -117,7 +140,7 @@ void OptionsRenderType::render_status()
                         Settings::VersionOfLastBenchFilesUpdate.c_str(),
                         Globals::BenchFilesLowerVersionString.c_str(),
                         Globals::BenchFilesUpperVersionString.c_str());
-                (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", buffer);
+                log_message(LogLevel::DEBUG, buffer);
             }
 
             const auto missing_content_text3 = "NOTE: There is a newer version for the builds.";
@@ -134,18 +157,8 @@ void OptionsRenderType::render_status()
             {
                 if (ImGui::Button(btn_text))
                 {
-                    const auto AddonPath = Globals::APIDefs->Paths_GetAddonDirectory("GW2RotaHelper");
-
-                    if (MAJOR == 0 && MINOR == 28 && BUILD == 0)
-                    {
-                        (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Dropping old builds");
-                        DropOldBuilds(AddonPath);
-                    }
-
-                    (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Started downloading bench data");
                     started_download = true;
-
-                    DownloadAndExtractDataAsync(AddonPath);
+                    Globals::UiHost->download_bench_data();
                 }
             }
             else
@@ -217,7 +230,7 @@ void OptionsRenderType::render_precast_window()
                 {
                     const auto &skill = skill_it->second;
 
-                    if (skill.texture)
+                    if (skill.icon.texture)
                     {
                         if (current_x + icon_size > ImGui::GetWindowWidth() - 20.0f && i > 0)
                         {
@@ -232,7 +245,10 @@ void OptionsRenderType::render_precast_window()
                         ImGui::PushID(counter1 + 1'000'000); // Use safe incremental ID based on count
                         ++counter1;
 
-                        ImGui::Image((ImTextureID)skill.texture, ImVec2(icon_size, icon_size));
+                        ImGui::Image((ImTextureID)skill.icon.texture,
+                                     ImVec2(icon_size, icon_size),
+                                     ImVec2(skill.icon.u0, skill.icon.v0),
+                                     ImVec2(skill.icon.u1, skill.icon.v1));
 
                         if (ImGui::IsItemHovered())
                         {
@@ -285,11 +301,11 @@ void OptionsRenderType::render_precast_window()
 
         for (const auto &[skill_id, rotation_skill] : Globals::RotationRun.rotation_skills)
         {
-            if (rotation_skill.texture && rotation_skill.texture != nullptr)
+            if (rotation_skill.icon.texture && rotation_skill.icon.texture != nullptr)
             {
                 auto current_skill_check = Globals::RotationRun.rotation_skills.find(skill_id);
                 if (current_skill_check == Globals::RotationRun.rotation_skills.end() ||
-                    current_skill_check->second.texture != rotation_skill.texture)
+                    current_skill_check->second.icon.texture != rotation_skill.icon.texture)
                 {
                     continue;
                 }
@@ -307,9 +323,12 @@ void OptionsRenderType::render_precast_window()
                 ImGui::PushID(counter2 + 100'000); // Use safe incremental ID based on count
                 ++counter2;
 
-                if (rotation_skill.texture != nullptr && (uintptr_t)rotation_skill.texture > 0x1000)
+                if (rotation_skill.icon.texture != nullptr && (uintptr_t)rotation_skill.icon.texture > 0x1000)
                 {
-                    ImGui::Image((ImTextureID)rotation_skill.texture, ImVec2(icon_size, icon_size));
+                    ImGui::Image((ImTextureID)rotation_skill.icon.texture,
+                                 ImVec2(icon_size, icon_size),
+                                 ImVec2(rotation_skill.icon.u0, rotation_skill.icon.v0),
+                                 ImVec2(rotation_skill.icon.u1, rotation_skill.icon.v1));
                 }
                 else
                 {
@@ -351,7 +370,7 @@ void OptionsRenderType::render_precast_window()
                          sizeof(log_msg),
                          "Precast skills configuration saved for build: %s",
                          curr_build_key.c_str());
-                (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", log_msg);
+                log_message(LogLevel::DEBUG, log_msg);
             }
         }
 
@@ -370,7 +389,7 @@ void OptionsRenderType::render_precast_window()
                          sizeof(log_msg),
                          "Precast skills configuration reset for build: %s",
                          curr_build_key.c_str());
-                (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", log_msg);
+                log_message(LogLevel::DEBUG, log_msg);
             }
         }
 
@@ -613,7 +632,7 @@ void OptionsRenderType::render_skill_slots_window()
 
                 char log_msg[256];
                 snprintf(log_msg, sizeof(log_msg), "Skill slot mapping saved for build: %s", curr_build_key.c_str());
-                (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", log_msg);
+                log_message(LogLevel::DEBUG, log_msg);
                 user_has_resetted = false;
             }
         }
@@ -749,7 +768,7 @@ void OptionsRenderType::render_options_checkboxes()
         if (Globals::RenderData.selected_file_path != "")
         {
             Globals::RotationRun.reset_rotation();
-            Globals::RotationRun.load_data(Globals::RenderData.selected_file_path, Globals::RenderData.img_path);
+            LoadSelectedRotation();
         }
     }
     SetTooltip("All weapon swap like skills will be shown in the rotation UI.");
@@ -763,7 +782,7 @@ void OptionsRenderType::render_options_checkboxes()
         if (Globals::RenderData.selected_file_path != "")
         {
             Globals::RotationRun.reset_rotation();
-            Globals::RotationRun.load_data(Globals::RenderData.selected_file_path, Globals::RenderData.img_path);
+            LoadSelectedRotation();
         }
     }
     SetTooltip("All weapon swap like skills will be shown in the rotation UI.");
@@ -792,7 +811,7 @@ void OptionsRenderType::render_options_checkboxes()
         if (Globals::RenderData.selected_file_path != "")
         {
             Globals::RotationRun.reset_rotation();
-            Globals::RotationRun.load_data(Globals::RenderData.selected_file_path, Globals::RenderData.img_path);
+            LoadSelectedRotation();
         }
     }
     SetTooltip(std::vector{
@@ -823,7 +842,7 @@ void OptionsRenderType::render_options_checkboxes()
         {
             Settings::Save(Globals::SettingsPath);
 
-            Globals::RotationRun.get_rotation_text(Globals::RenderData.keybinds);
+            UpdateRotationText();
         }
         SetTooltip(std::vector{
             std::string{"Shows the full rotation in a text form of the actual keybinds."},
@@ -836,7 +855,7 @@ void OptionsRenderType::render_options_checkboxes()
         {
             Settings::Save(Globals::SettingsPath);
 
-            Globals::RotationRun.get_rotation_icons();
+            GetRotationIcons(Globals::RotationRun, *Globals::UiHost);
         }
         SetTooltip(std::vector{
             std::string{"Shows the full rotation with skill icons, like in the simple rotation tab in dps.reports."},
@@ -848,7 +867,7 @@ void OptionsRenderType::render_options_checkboxes()
         if (ImGui::Checkbox("Rotation Window", &Globals::RenderData.show_rotation_window))
         {
             Settings::Save(Globals::SettingsPath);
-            Globals::RotationRun.get_rotation_text(Globals::RenderData.keybinds);
+            UpdateRotationText();
         }
         SetTooltip("Shows the rotation window of the last 2, the current and the next 7 skills.");
 
@@ -863,7 +882,7 @@ void OptionsRenderType::render_options_checkboxes()
             show_skill_slots_window = !show_skill_slots_window;
 
         if (Globals::RotationRun.rotation_skills.empty())
-            Globals::RotationRun.get_rotation_skills();
+            GetRotationSkills(Globals::RotationRun, *Globals::UiHost);
 
         if (show_precast_window)
             render_precast_window();
@@ -883,8 +902,7 @@ void OptionsRenderType::render_options_checkboxes()
 
     if (ImGui::Button("Open settings.json", ImVec2(debug_button_width, 0)))
     {
-        const auto settings_path = Globals::SettingsPath.string();
-        ShellExecuteA(nullptr, "open", settings_path.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
+        Globals::UiHost->open_in_shell(Globals::SettingsPath.string());
     }
 
     if (show_debug_window)
@@ -904,17 +922,17 @@ void OptionsRenderType::render_debug_data()
 {
     ImGui::Separator();
 
-    ImGui::Text("Profession: %d (%s)",
-                static_cast<int>(Globals::Identity.Profession),
-                profession_to_string(static_cast<ProfessionID>(Globals::Identity.Profession)).c_str());
+    const auto profession = Globals::UiHost->get_profession();
+    const auto elite_spec = Globals::UiHost->get_elite_spec();
+    ImGui::Text("Profession: %d (%s)", static_cast<int>(profession), profession_to_string(profession).c_str());
     ImGui::Text("Specialization: %u (%s)",
-                Globals::Identity.Specialization,
-                elite_spec_to_string(static_cast<EliteSpecID>(Globals::Identity.Specialization)).c_str());
-    ImGui::Text("Map ID: %u", Globals::Identity.MapID);
+                static_cast<uint32_t>(elite_spec),
+                elite_spec_to_string(elite_spec).c_str());
+    ImGui::Text("Map ID: %u", Globals::UiHost->get_map_id());
 
     ImGui::Separator();
 
-    ImGui::Text("Is in Combat: %d", Globals::MumbleData->Context.IsInCombat == true ? "true" : "false");
+    ImGui::Text("Is in Combat: %s", Globals::UiHost->is_in_combat() ? "true" : "false");
 
     ImGui::Text("Last Casted Skill ID: %u", Globals::RenderData.curr_combat_data.SkillID);
     ImGui::Text("Last Casted Skill Name: %s",
@@ -934,6 +952,23 @@ void OptionsRenderType::render_debug_data()
 
     ImGui::Text("Download State: %s", download_state_to_string(Globals::BenchDataDownloadState).c_str());
 
+    if (const auto cache_stats = Globals::UiHost->get_icon_cache_stats())
+    {
+        ImGui::Separator();
+
+        ImGui::Text("Icon Cache: %zu icons (%zu in use)", cache_stats->num_entries, cache_stats->num_referenced);
+        ImGui::Text("Icon Cache Hit Rate: %.1f%% (%llu hits, %llu misses)",
+                    cache_stats->get_hit_rate() * 100.0,
+                    static_cast<unsigned long long>(cache_stats->hits),
+                    static_cast<unsigned long long>(cache_stats->misses));
+        ImGui::Text("Icon Cache Memory: %.1f KiB (%.1f / %.1f KiB unused)",
+                    cache_stats->resident_bytes / 1024.0,
+                    cache_stats->unreferenced_bytes / 1024.0,
+                    cache_stats->budget_bytes / 1024.0);
+    }
+
+    render_profiler_data();
+
     if (!Globals::RenderData.keybinds.empty())
     {
         ImGui::Separator();
@@ -971,6 +1006,74 @@ void OptionsRenderType::render_debug_data()
     }
 }
 
+void OptionsRenderType::render_profiler_data()
+{
+    static auto profile_stats = std::vector<ProfileZoneStats>{};
+    static auto last_stats_update = std::chrono::steady_clock::time_point{};
+    static auto last_dump_path = std::filesystem::path{};
+
+    ImGui::Separator();
+
+    auto &profiler = get_profiler();
+    auto is_profiling = profiler.is_enabled();
+    if (ImGui::Checkbox("Profile Hot Paths", &is_profiling))
+    {
+        profiler.set_enabled(is_profiling);
+        if (!is_profiling)
+            profile_stats.clear();
+    }
+
+    if (!is_profiling)
+        return;
+
+    // Sorting the samples of every zone each frame would show up in the numbers themselves
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_stats_update > std::chrono::milliseconds(250))
+    {
+        profile_stats = profiler.get_stats(std::chrono::seconds(10));
+        last_stats_update = now;
+    }
+
+    ImGui::Text("Last 10s (p50 / p99 / max in ms):");
+    for (const auto &zone_stats : profile_stats)
+    {
+        ImGui::Text("%s: %.3f / %.3f / %.3f (%zu calls)",
+                    profile_zone_to_string(zone_stats.zone),
+                    zone_stats.p50_ms,
+                    zone_stats.p99_ms,
+                    zone_stats.max_ms,
+                    zone_stats.num_samples);
+    }
+
+    if (ImGui::Button("Dump Timings to CSV"))
+    {
+        const auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+        const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(since_epoch).count();
+        const auto csv_path = Globals::RenderData.data_path / ("profile_" + std::to_string(timestamp) + ".csv");
+
+        if (write_profile_csv(profiler.get_samples(), csv_path))
+        {
+            last_dump_path = csv_path;
+            log_message(LogLevel::INFO, "Wrote profile to " + csv_path.string());
+        }
+        else
+        {
+            last_dump_path.clear();
+            log_message(LogLevel::WARNING, "Could not write profile to " + csv_path.string());
+        }
+    }
+
+    ImGui::SameLine();
+    if (ImGui::Button("Clear Timings"))
+    {
+        profiler.clear();
+        profile_stats.clear();
+    }
+
+    if (!last_dump_path.empty())
+        ImGui::Text("Last Dump: %s", last_dump_path.filename().string().c_str());
+}
+
 void OptionsRenderType::render_text_filter()
 {
     ImGui::Text("Filter:");
@@ -997,22 +1100,14 @@ void OptionsRenderType::render_text_filter()
     if (ImGui::IsItemActive() && ImGui::IsKeyPressed(ImGuiKey_Tab))
         open_combo_next_frame = true;
 
+    const auto profession_name = Globals::UiHost->get_profession_name();
     const auto &[_filtered_files, directories_with_matches] =
-        get_file_data_pairs(Globals::RenderData.benches_files, Settings::FilterBuffer);
+        get_file_data_pairs(Globals::RenderData.benches_files, Settings::FilterBuffer, profession_name);
     filtered_files = _filtered_files;
 
-    auto combo_preview = std::string{};
     if (selected_bench_index >= 0 && selected_bench_index < Globals::RenderData.benches_files.size())
-        combo_preview = Globals::RenderData.benches_files[selected_bench_index].relative_path.filename().string();
-    else
-        combo_preview = "Select...";
-
-    auto combo_preview_slice = std::string{"Select..."};
-    if (combo_preview != "Select...")
     {
-        combo_preview_slice = combo_preview.substr(0, combo_preview.size() - 8);
-        formatted_name = format_build_name(combo_preview_slice);
-        formatted_name = formatted_name.substr(4);
+        formatted_name = Globals::RenderData.benches_files[selected_bench_index].formatted_name;
         if (Globals::RotationRun.meta_data.overall_dps > 0.0)
         {
             char buf[64];
@@ -1029,13 +1124,11 @@ void OptionsRenderType::set_data_on_build_load(const BenchFileInfo *const &file_
     Globals::RenderData.show_rotation_icons_overview = false;
     show_precast_window = false;
     show_skill_slots_window = false;
-    ReleaseTextureMap(Globals::TextureMap);
-    Globals::RotationRun.load_data(Globals::RenderData.selected_file_path, Globals::RenderData.img_path);
+    Globals::UiHost->release_build_icons();
+    LoadSelectedRotation();
     Globals::RenderData.current_build_key = Globals::RotationRun.meta_data.name;
     Globals::RotationRun.rotation_skills.clear();
-    Globals::TextureMap = LoadAllSkillTextures(Globals::RenderData.pd3dDevice,
-                                               Globals::RotationRun.log_skill_info_map,
-                                               Globals::RenderData.img_path);
+    Globals::UiHost->acquire_build_icons();
 }
 
 void OptionsRenderType::render_symbol_and_text(bool &is_selected,
@@ -1057,7 +1150,7 @@ void OptionsRenderType::render_symbol_and_text(bool &is_selected,
         set_data_on_build_load(file_info);
         ImGui::CloseCurrentPopup();
 
-        Globals::Render.restart_rotation(true);
+        Globals::UiHost->restart_rotation(true);
     }
 
     auto item_rect = ImGui::GetItemRectMin();
@@ -1091,17 +1184,30 @@ void OptionsRenderType::render_symbol_and_text(bool &is_selected,
             ImGui::Text("Untested build");
         ImGui::EndTooltip();
     }
+    else if (ImGui::IsItemHovered() && !file_info->build_info.benchmark_type.empty())
+    {
+        ImGui::SetTooltip("%s (%s benchmark)",
+                          file_info->build_info.name.c_str(),
+                          file_info->build_info.benchmark_type.c_str());
+    }
 
     auto text_pos =
         ImVec2(item_rect.x + symbol_size + 12, item_rect.y + (item_height - ImGui::GetTextLineHeight()) * 0.5f);
-    draw_list->AddText(text_pos, ImGui::GetColorU32(ImGuiCol_Text), base_formatted_name.substr(4).c_str());
+    draw_list->AddText(text_pos, ImGui::GetColorU32(ImGuiCol_Text), base_formatted_name.c_str());
+
+    if (!file_info->build_info_text.empty())
+    {
+        const auto info_size = ImGui::CalcTextSize(file_info->build_info_text.c_str());
+        const auto info_pos = ImVec2(ImGui::GetItemRectMax().x - info_size.x - 4, text_pos.y);
+        draw_list->AddText(info_pos, ImGui::GetColorU32(ImGuiCol_TextDisabled), file_info->build_info_text.c_str());
+    }
 }
 
 
 void OptionsRenderType::render_red_cross_and_text(bool &is_selected,
                                                   const int original_index,
                                                   const BenchFileInfo *const &file_info,
-                                                  const std::string base_formatted_name)
+                                                  const std::string &base_formatted_name)
 {
     auto draw_cross = draw_cross_factory(IM_COL32(220, 20, 60, 255));
     render_symbol_and_text(is_selected, original_index, file_info, base_formatted_name, "##red_cross_", draw_cross);
@@ -1110,7 +1216,7 @@ void OptionsRenderType::render_red_cross_and_text(bool &is_selected,
 void OptionsRenderType::render_orange_cross_and_text(bool &is_selected,
                                                      const int original_index,
                                                      const BenchFileInfo *const &file_info,
-                                                     const std::string base_formatted_name)
+                                                     const std::string &base_formatted_name)
 {
     auto draw_cross = draw_cross_factory(IM_COL32(255, 140, 0, 255));
     render_symbol_and_text(is_selected, original_index, file_info, base_formatted_name, "##ora_cross_", draw_cross);
@@ -1119,7 +1225,7 @@ void OptionsRenderType::render_orange_cross_and_text(bool &is_selected,
 void OptionsRenderType::render_untested_and_text(bool &is_selected,
                                                  const int original_index,
                                                  const BenchFileInfo *const &file_info,
-                                                 const std::string base_formatted_name)
+                                                 const std::string &base_formatted_name)
 {
     auto draw_question_mark = [](ImDrawList *draw_list, ImVec2 center, float radius, float size) {
         float line_thickness = 2.5f;
@@ -1151,7 +1257,7 @@ void OptionsRenderType::render_untested_and_text(bool &is_selected,
 void OptionsRenderType::render_tick_and_text(bool &is_selected,
                                              const int original_index,
                                              const BenchFileInfo *const &file_info,
-                                             const std::string base_formatted_name,
+                                             const std::string &base_formatted_name,
                                              const ImU32 Color,
                                              const std::string &label)
 {
@@ -1211,46 +1317,13 @@ void OptionsRenderType::render_selection()
                 {
                     auto is_selected = (selected_bench_index == original_index);
 
-                    auto base_formatted_name = std::string{};
-                    auto formatted_name_item = std::string{};
-                    auto is_red_crossed = false;
-                    auto is_green_ticked = false;
-                    auto is_orange_crossed = false;
-                    auto is_yellow_ticked = false;
-                    auto is_untested = false;
-
-                    if (file_info->is_directory_header)
-                    {
-                        formatted_name_item = file_info->display_name;
-                    }
-                    else
-                    {
-                        auto path_str = file_info->relative_path.string();
-                        auto build_type_postdic = std::string{};
-
-                        if (path_str.find("dps") != std::string::npos)
-                            build_type_postdic = "[DPS] ";
-                        else if (path_str.find("quick") != std::string::npos)
-                            build_type_postdic = "[Quick] ";
-                        else if (path_str.find("alac") != std::string::npos)
-                            build_type_postdic = "[Alac] ";
-
-                        if (path_str.find("power") != std::string::npos)
-                            build_type_postdic += "[Power] ";
-                        else if (path_str.find("condition") != std::string::npos)
-                            build_type_postdic += "[Condi] ";
-
-                        base_formatted_name = format_build_name(file_info->display_name);
-
-                        auto category = Globals::RenderData.builds.get_build_category(file_info->display_name);
-                        is_red_crossed = (category == BuildCategory::RED_CROSSED);
-                        is_orange_crossed = (category == BuildCategory::ORANGE_CROSSED);
-                        is_green_ticked = (category == BuildCategory::GREEN_TICKED);
-                        is_yellow_ticked = (category == BuildCategory::YELLOW_TICKED);
-                        is_untested = (category == BuildCategory::UNTESTED);
-
-                        formatted_name_item = base_formatted_name + "##" + build_type_postdic;
-                    }
+                    const auto &base_formatted_name = file_info->formatted_name;
+                    const auto category = file_info->category;
+                    const auto is_red_crossed = (category == BuildCategory::RED_CROSSED);
+                    const auto is_orange_crossed = (category == BuildCategory::ORANGE_CROSSED);
+                    const auto is_green_ticked = (category == BuildCategory::GREEN_TICKED);
+                    const auto is_yellow_ticked = (category == BuildCategory::YELLOW_TICKED);
+                    const auto is_untested = (category == BuildCategory::UNTESTED);
 
                     if (is_red_crossed)
                     {
@@ -1286,6 +1359,8 @@ void OptionsRenderType::render_selection()
                     }
                     else
                     {
+                        const auto formatted_name_item =
+                            base_formatted_name + "##" + std::string{file_info->build_type_tags};
                         if (ImGui::Selectable(formatted_name_item.c_str(), is_selected))
                         {
                             selected_bench_index = original_index;
@@ -1315,14 +1390,14 @@ void OptionsRenderType::render_load_buttons()
         if (ImGui::Button("Reload", ImVec2(button_width, 0)))
         {
             if (!Globals::RenderData.selected_file_path.empty())
-                Globals::Render.restart_rotation(true);
+                Globals::UiHost->restart_rotation(true);
         }
 
         ImGui::SameLine();
 
         if (ImGui::Button("Unload", ImVec2(button_width, 0)))
         {
-            Globals::Render.restart_rotation(true);
+            Globals::UiHost->restart_rotation(true);
             Globals::RotationRun.reset_rotation();
         }
     }
@@ -1369,18 +1444,30 @@ void OptionsRenderType::render_xml_selection()
 {
     if (!Settings::XmlSettingsPath.empty())
     {
-        if (!Globals::RenderData.keybinds_loaded && std::filesystem::exists(Settings::XmlSettingsPath))
+        const auto now = std::chrono::steady_clock::now();
+        // Also throttles the checks while the file is missing, a reset of keybinds_last_check forces a reload
+        if (now - Globals::RenderData.keybinds_last_check > std::chrono::seconds(1))
         {
-            Globals::RenderData.keybinds = parse_xml_keybinds(Settings::XmlSettingsPath);
+            Globals::RenderData.keybinds_last_check = now;
+
+            if (reload_xml_keybinds_if_changed(Settings::XmlSettingsPath,
+                                               Globals::RenderData.keybinds_fingerprint,
+                                               Globals::RenderData.keybinds))
+            {
+                log_message(LogLevel::DEBUG, "parsed XML InputBinds File.");
+
+                if (!Globals::RotationRun.all_rotation_steps.empty())
+                    UpdateRotationText();
+            }
 
-            Globals::RenderData.keybinds_loaded = true;
+            Globals::RenderData.keybinds_loaded = Globals::RenderData.keybinds_fingerprint.is_valid;
         }
     }
 
     const auto button_width = ImGui::GetWindowSize().x * 0.5f - ImGui::GetStyle().ItemSpacing.x * 0.5f;
 
     if (ImGui::Button("Select Keybinds", ImVec2(button_width, 0)))
-        FileSelection();
+        Globals::UiHost->select_keybinds_file();
 
     ImGui::SameLine();
 
@@ -1390,6 +1477,8 @@ void OptionsRenderType::render_xml_selection()
         Settings::Save(Globals::SettingsPath);
 
         Globals::RenderData.keybinds_loaded = false;
+        Globals::RenderData.keybinds_fingerprint = FileFingerprint{};
+        Globals::RenderData.keybinds_last_check = {};
         Globals::RenderData.keybinds.clear();
     }
 }
@@ -1,9 +1,14 @@
 #pragma once
 
-#include <d3d11.h>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "imgui.h"
 
+#include "Types.h"
+
 class OptionsRenderType
 {
 public:
@@ -19,6 +24,7 @@ public:
     void render_options_checkboxes();
     void render_debug_window(bool &show_debug_window);
     void render_debug_data();
+    void render_profiler_data();
     void render_text_filter();
     void set_data_on_build_load(const BenchFileInfo *const &file_info);
     void render_symbol_and_text(bool &is_selected,
@@ -30,19 +36,19 @@ public:
     void render_red_cross_and_text(bool &is_selected,
                                    const int original_index,
                                    const BenchFileInfo *const &file_info,
-                                   const std::string base_formatted_name);
+                                   const std::string &base_formatted_name);
     void render_orange_cross_and_text(bool &is_selected,
                                       const int original_index,
                                       const BenchFileInfo *const &file_info,
-                                      const std::string base_formatted_name);
+                                      const std::string &base_formatted_name);
     void render_untested_and_text(bool &is_selected,
                                   const int original_index,
                                   const BenchFileInfo *const &file_info,
-                                  const std::string base_formatted_name);
+                                  const std::string &base_formatted_name);
     void render_tick_and_text(bool &is_selected,
                               const int original_index,
                               const BenchFileInfo *const &file_info,
-                              const std::string base_formatted_name,
+                              const std::string &base_formatted_name,
                               const ImU32 Color,
                               const std::string &label);
     void render_selection();
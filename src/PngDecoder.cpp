@@ -0,0 +1,340 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Inflate.h"
+#include "MappedFile.h"
+#include "PngDecoder.h"
+#include "TextureLoader.h"
+
+namespace
+{
+constexpr auto PNG_SIGNATURE = std::string_view{"\x89PNG\r\n\x1a\n", 8};
+constexpr auto IHDR_SIZE = uint32_t{13};
+constexpr auto MAX_DIMENSION = uint32_t{16384};
+
+constexpr auto COLOR_GRAY = uint8_t{0};
+constexpr auto COLOR_RGB = uint8_t{2};
+constexpr auto COLOR_PALETTE = uint8_t{3};
+constexpr auto COLOR_GRAY_ALPHA = uint8_t{4};
+constexpr auto COLOR_RGBA = uint8_t{6};
+
+uint32_t read_be32(const uint8_t *data)
+{
+    return (uint32_t{data[0]} << 24) | (uint32_t{data[1]} << 16) | (uint32_t{data[2]} << 8) | uint32_t{data[3]};
+}
+
+uint32_t get_channels(const uint8_t color_type)
+{
+    switch (color_type)
+    {
+    case COLOR_GRAY:
+    case COLOR_PALETTE:
+        return 1;
+    case COLOR_GRAY_ALPHA:
+        return 2;
+    case COLOR_RGB:
+        return 3;
+    case COLOR_RGBA:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+uint32_t get_adler32(const uint8_t *data, size_t size)
+{
+    // 5552 is the largest block whose sums cannot overflow 32 bits before the modulo
+    constexpr auto MODULO = uint32_t{65521};
+    constexpr auto BLOCK_SIZE = size_t{5552};
+
+    auto a = uint32_t{1};
+    auto b = uint32_t{0};
+    while (size > 0)
+    {
+        const auto block_size = std::min(size, BLOCK_SIZE);
+        for (auto idx = size_t{0}; idx < block_size; ++idx)
+        {
+            a += data[idx];
+            b += a;
+        }
+
+        a %= MODULO;
+        b %= MODULO;
+        data += block_size;
+        size -= block_size;
+    }
+
+    return (b << 16) | a;
+}
+
+uint8_t paeth_predictor(const int left, const int up, const int up_left)
+{
+    const auto estimate = left + up - up_left;
+    const auto dist_left = std::abs(estimate - left);
+    const auto dist_up = std::abs(estimate - up);
+    const auto dist_up_left = std::abs(estimate - up_left);
+
+    if (dist_left <= dist_up && dist_left <= dist_up_left)
+        return static_cast<uint8_t>(left);
+    if (dist_up <= dist_up_left)
+        return static_cast<uint8_t>(up);
+    return static_cast<uint8_t>(up_left);
+}
+
+// Undoes the filter of one row in place, previous is all zero for the first row
+bool unfilter_row(const uint8_t filter_type,
+                  uint8_t *row,
+                  const uint8_t *previous,
+                  const size_t stride,
+                  const size_t bpp)
+{
+    switch (filter_type)
+    {
+    case 0:
+        return true;
+    case 1:
+        for (auto idx = bpp; idx < stride; ++idx)
+            row[idx] = static_cast<uint8_t>(row[idx] + row[idx - bpp]);
+        return true;
+    case 2:
+        for (auto idx = size_t{0}; idx < stride; ++idx)
+            row[idx] = static_cast<uint8_t>(row[idx] + previous[idx]);
+        return true;
+    case 3:
+        for (auto idx = size_t{0}; idx < bpp; ++idx)
+            row[idx] = static_cast<uint8_t>(row[idx] + (previous[idx] >> 1));
+        for (auto idx = bpp; idx < stride; ++idx)
+            row[idx] = static_cast<uint8_t>(row[idx] + ((row[idx - bpp] + previous[idx]) >> 1));
+        return true;
+    case 4:
+        for (auto idx = size_t{0}; idx < bpp; ++idx)
+            row[idx] = static_cast<uint8_t>(row[idx] + previous[idx]);
+        for (auto idx = bpp; idx < stride; ++idx)
+        {
+            const auto predictor = paeth_predictor(row[idx - bpp], previous[idx], previous[idx - bpp]);
+            row[idx] = static_cast<uint8_t>(row[idx] + predictor);
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Color of the tRNS chunk of gray and RGB images, pixels of exactly this color are transparent
+struct ColorKey
+{
+    bool is_set = false;
+    std::array<uint8_t, 3> rgb = {};
+};
+
+// The chunk holds 16 bit samples, an 8 bit image only matches values below 256
+ColorKey get_color_key(const uint8_t color_type, const uint8_t *chunk, const size_t length)
+{
+    auto key = ColorKey{};
+    if (color_type == COLOR_GRAY && length >= 2 && chunk[0] == 0)
+    {
+        key.is_set = true;
+        key.rgb = {chunk[1], chunk[1], chunk[1]};
+    }
+    else if (color_type == COLOR_RGB && length >= 6 && chunk[0] == 0 && chunk[2] == 0 && chunk[4] == 0)
+    {
+        key.is_set = true;
+        key.rgb = {chunk[1], chunk[3], chunk[5]};
+    }
+
+    return key;
+}
+
+void expand_row(const uint8_t color_type,
+                const uint8_t *row,
+                const uint32_t width,
+                const std::array<uint8_t, 1024> &palette,
+                const ColorKey &color_key,
+                uint8_t *dst)
+{
+    switch (color_type)
+    {
+    case COLOR_RGBA:
+        std::memcpy(dst, row, static_cast<size_t>(width) * 4);
+        break;
+    case COLOR_RGB:
+        for (auto x = uint32_t{0}; x < width; ++x, row += 3, dst += 4)
+        {
+            dst[0] = row[0];
+            dst[1] = row[1];
+            dst[2] = row[2];
+            dst[3] = color_key.is_set && std::memcmp(row, color_key.rgb.data(), 3) == 0 ? 0 : 0xFF;
+        }
+        break;
+    case COLOR_GRAY:
+        for (auto x = uint32_t{0}; x < width; ++x, ++row, dst += 4)
+        {
+            dst[0] = dst[1] = dst[2] = row[0];
+            dst[3] = color_key.is_set && row[0] == color_key.rgb[0] ? 0 : 0xFF;
+        }
+        break;
+    case COLOR_GRAY_ALPHA:
+        for (auto x = uint32_t{0}; x < width; ++x, row += 2, dst += 4)
+        {
+            dst[0] = dst[1] = dst[2] = row[0];
+            dst[3] = row[1];
+        }
+        break;
+    case COLOR_PALETTE:
+        for (auto x = uint32_t{0}; x < width; ++x, ++row, dst += 4)
+            std::memcpy(dst, palette.data() + size_t{row[0]} * 4, 4);
+        break;
+    default:
+        break;
+    }
+}
+
+class PngImageDecoder final : public IImageDecoder
+{
+public:
+    explicit PngImageDecoder(std::unique_ptr<IImageDecoder> fallback) : fallback(std::move(fallback))
+    {
+    }
+
+    bool decode(const std::filesystem::path &path, DecodedImage &image) override
+    {
+        auto file = MappedFileType{};
+        if (file.open(path) &&
+            decode_png(reinterpret_cast<const uint8_t *>(file.data()), file.size(), scratch, image))
+            return true;
+
+        return fallback != nullptr && fallback->decode(path, image);
+    }
+
+private:
+    PngScratch scratch;
+    std::unique_ptr<IImageDecoder> fallback;
+};
+} // namespace
+
+bool decode_png(const uint8_t *data, const size_t size, PngScratch &scratch, DecodedImage &image)
+{
+    if (size < PNG_SIGNATURE.size() || std::memcmp(data, PNG_SIGNATURE.data(), PNG_SIGNATURE.size()) != 0)
+        return false;
+
+    auto width = uint32_t{0};
+    auto height = uint32_t{0};
+    auto color_type = uint8_t{0};
+    auto has_header = false;
+    auto palette = std::array<uint8_t, 1024>{}; // RGBA per index, opaque unless tRNS says otherwise
+    auto palette_size = size_t{0};
+    auto color_key = ColorKey{};
+
+    scratch.compressed.clear();
+
+    auto pos = PNG_SIGNATURE.size();
+    while (pos + 12 <= size)
+    {
+        const auto length = size_t{read_be32(data + pos)};
+        const auto *type = data + pos + 4;
+        const auto *chunk = data + pos + 8;
+        if (length > size - pos - 12)
+            return false;
+        pos += 12 + length;
+
+        if (std::memcmp(type, "IHDR", 4) == 0)
+        {
+            if (length != IHDR_SIZE)
+                return false;
+
+            width = read_be32(chunk);
+            height = read_be32(chunk + 4);
+            const auto bit_depth = chunk[8];
+            color_type = chunk[9];
+            const auto interlace = chunk[12];
+            if (width == 0 || height == 0 || width > MAX_DIMENSION || height > MAX_DIMENSION || bit_depth != 8 ||
+                interlace != 0 || get_channels(color_type) == 0)
+                return false;
+
+            has_header = true;
+        }
+        else if (std::memcmp(type, "PLTE", 4) == 0)
+        {
+            palette_size = std::min(length / 3, size_t{256});
+            for (auto idx = size_t{0}; idx < palette_size; ++idx)
+            {
+                std::memcpy(palette.data() + idx * 4, chunk + idx * 3, 3);
+                palette[idx * 4 + 3] = 0xFF;
+            }
+        }
+        else if (std::memcmp(type, "tRNS", 4) == 0)
+        {
+            for (auto idx = size_t{0}; idx < std::min(length, palette_size); ++idx)
+                palette[idx * 4 + 3] = chunk[idx];
+            color_key = get_color_key(color_type, chunk, length);
+        }
+        else if (std::memcmp(type, "IDAT", 4) == 0)
+            scratch.compressed.insert(scratch.compressed.end(), chunk, chunk + length);
+        else if (std::memcmp(type, "IEND", 4) == 0)
+            break;
+    }
+
+    // zlib stream: CMF and FLG, raw deflate data, Adler-32 of the output
+    const auto &compressed = scratch.compressed;
+    if (!has_header || (color_type == COLOR_PALETTE && palette_size == 0) || compressed.size() < 6 ||
+        (compressed[0] & 0x0F) != 8 || (compressed[1] & 0x20) != 0 || ((compressed[0] << 8) | compressed[1]) % 31 != 0)
+        return false;
+
+    const auto bpp = size_t{get_channels(color_type)};
+    const auto stride = static_cast<size_t>(width) * bpp;
+    const auto filtered_size = (stride + 1) * height;
+
+    auto &filtered = scratch.filtered;
+    filtered.clear();
+    filtered.reserve(filtered_size);
+
+    size_t consumed = 0;
+    const auto status = inflate_raw(
+        compressed.data() + 2,
+        compressed.size() - 2,
+        [&filtered, filtered_size](const uint8_t *chunk, size_t chunk_size) {
+            if (chunk_size > filtered_size - filtered.size())
+                return false;
+
+            filtered.insert(filtered.end(), chunk, chunk + chunk_size);
+            return true;
+        },
+        &consumed);
+    if (status != InflateStatus::OK || filtered.size() != filtered_size || consumed + 6 > compressed.size() ||
+        read_be32(compressed.data() + 2 + consumed) != get_adler32(filtered.data(), filtered.size()))
+        return false;
+
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    image.mips.clear();
+
+    const auto zero_row = std::vector<uint8_t>(stride, 0);
+    const auto *previous = zero_row.data();
+    for (auto y = uint32_t{0}; y < height; ++y)
+    {
+        auto *row = filtered.data() + y * (stride + 1);
+        if (!unfilter_row(row[0], row + 1, previous, stride, bpp))
+            return false;
+
+        auto *dst = image.pixels.data() + static_cast<size_t>(y) * width * 4;
+        expand_row(color_type, row + 1, width, palette, color_key, dst);
+        previous = row + 1;
+    }
+
+    return true;
+}
+
+ImageDecoderFactory make_png_decoder_factory(ImageDecoderFactory fallback_factory)
+{
+    return [fallback_factory = std::move(fallback_factory)]() -> std::unique_ptr<IImageDecoder> {
+        return std::make_unique<PngImageDecoder>(fallback_factory ? fallback_factory() : nullptr);
+    };
+}
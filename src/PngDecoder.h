@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TextureLoader.h"
+
+// Scratch buffers of one decoding thread, reused across images
+struct PngScratch
+{
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> filtered;
+};
+
+// Decodes non-interlaced 8 bit PNGs of every color type into RGBA8, the same
+// subset scripts/pack_icons.py reads. Returns false for anything else.
+bool decode_png(const uint8_t *data, const size_t size, PngScratch &scratch, DecodedImage &image);
+
+// Decodes PNGs natively and hands the remaining files to a decoder of the fallback factory
+ImageDecoderFactory make_png_decoder_factory(ImageDecoderFactory fallback_factory);
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Profiler.h"
+
+namespace
+{
+constexpr auto ZONE_NAMES = std::array<const char *, static_cast<size_t>(ProfileZone::COUNT)>{
+    "AddonRender",
+    "Render",
+    "OptionsRender",
+    "RotationRender",
+    "KeypressDetection",
+    "SkillDetection",
+    "ArcCombatEvent",
+    "TextureDecode",
+    "TextureUpload",
+    "BuildLoad",
+};
+
+int64_t get_ns(const std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+double get_ms(const int64_t ns)
+{
+    return static_cast<double>(ns) / 1e6;
+}
+
+// Nearest rank of the sorted durations
+int64_t get_percentile(const std::vector<int64_t> &sorted_ns, const double percentile)
+{
+    const auto rank = static_cast<size_t>(percentile * static_cast<double>(sorted_ns.size() - 1) + 0.5);
+
+    return sorted_ns[std::min(rank, sorted_ns.size() - 1)];
+}
+} // namespace
+
+const char *profile_zone_to_string(const ProfileZone zone)
+{
+    const auto idx = static_cast<size_t>(zone);
+
+    return idx < ZONE_NAMES.size() ? ZONE_NAMES[idx] : "Unknown";
+}
+
+// Gives the ring back when its thread exits
+class ProfilerType::ThreadRingHandle
+{
+public:
+    ~ThreadRingHandle()
+    {
+        if (ring)
+            ring->in_use.store(false, std::memory_order_release);
+    }
+
+    RingType *ring = nullptr;
+};
+
+void ProfilerType::set_enabled(const bool is_enabled)
+{
+    enabled.store(is_enabled, std::memory_order_relaxed);
+}
+
+ProfilerType::RingType &ProfilerType::get_thread_ring()
+{
+    thread_local auto handle = ThreadRingHandle{};
+    if (handle.ring)
+        return *handle.ring;
+
+    const auto lock = std::lock_guard{rings_mutex};
+
+    // The samples of the previous owner keep its index, the new owner gets the next one
+    for (auto &ring : rings)
+    {
+        auto expected = false;
+        if (ring->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            ring->thread_idx = num_ring_owners++;
+            handle.ring = ring.get();
+            return *handle.ring;
+        }
+    }
+
+    auto &ring = rings.emplace_back(std::make_unique<RingType>());
+    ring->thread_idx = num_ring_owners++;
+    ring->in_use = true;
+    handle.ring = ring.get();
+
+    return *handle.ring;
+}
+
+void ProfilerType::record(const ProfileZone zone,
+                          const std::chrono::steady_clock::time_point start,
+                          const std::chrono::steady_clock::time_point end)
+{
+    auto &ring = get_thread_ring();
+
+    // A seqlock per slot: readers that see the odd sequence or a changed one drop the slot
+    const auto position = ring.write_position.load(std::memory_order_relaxed);
+    auto &slot = ring.slots[position % RING_CAPACITY];
+    slot.sequence.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.zone.store(zone, std::memory_order_relaxed);
+    slot.thread_idx.store(ring.thread_idx, std::memory_order_relaxed);
+    slot.start_ns.store(get_ns(start.time_since_epoch()), std::memory_order_relaxed);
+    slot.duration_ns.store(get_ns(end - start), std::memory_order_relaxed);
+
+    slot.sequence.store(2 * position + 2, std::memory_order_release);
+    ring.write_position.store(position + 1, std::memory_order_release);
+}
+
+std::vector<ProfileSample> ProfilerType::get_samples(const std::chrono::steady_clock::duration window) const
+{
+    const auto min_start_ns = get_ns((std::chrono::steady_clock::now() - window).time_since_epoch());
+
+    auto samples = std::vector<ProfileSample>{};
+
+    {
+        const auto rings_lock = std::lock_guard{rings_mutex};
+
+        // Only guards the list of rings, the owners keep writing while they are copied
+        for (const auto &ring : rings)
+        {
+            const auto end = ring->write_position.load(std::memory_order_acquire);
+            const auto clear_position = ring->clear_position.load(std::memory_order_acquire);
+            const auto begin = std::max(end - std::min<uint64_t>(end, RING_CAPACITY), clear_position);
+
+            for (auto position = begin; position < end; ++position)
+            {
+                const auto &slot = ring->slots[position % RING_CAPACITY];
+                const auto sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence != 2 * position + 2)
+                    continue;
+
+                const auto sample = ProfileSample{
+                    .zone = slot.zone.load(std::memory_order_relaxed),
+                    .thread_idx = slot.thread_idx.load(std::memory_order_relaxed),
+                    .start_ns = slot.start_ns.load(std::memory_order_relaxed),
+                    .duration_ns = slot.duration_ns.load(std::memory_order_relaxed),
+                };
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+                    continue;
+
+                if (sample.start_ns >= min_start_ns)
+                    samples.push_back(sample);
+            }
+        }
+    }
+
+    std::ranges::sort(samples, {}, &ProfileSample::start_ns);
+
+    return samples;
+}
+
+std::vector<ProfileSample> ProfilerType::get_samples() const
+{
+    return get_samples(std::chrono::steady_clock::now().time_since_epoch());
+}
+
+std::vector<ProfileZoneStats> ProfilerType::get_stats(const std::chrono::steady_clock::duration window) const
+{
+    auto zone_durations = std::array<std::vector<int64_t>, static_cast<size_t>(ProfileZone::COUNT)>{};
+    for (const auto &sample : get_samples(window))
+    {
+        const auto idx = static_cast<size_t>(sample.zone);
+        if (idx < zone_durations.size())
+            zone_durations[idx].push_back(sample.duration_ns);
+    }
+
+    auto stats = std::vector<ProfileZoneStats>{};
+    for (auto idx = size_t{0}; idx < zone_durations.size(); ++idx)
+    {
+        auto &durations = zone_durations[idx];
+        if (durations.empty())
+            continue;
+
+        std::ranges::sort(durations);
+
+        stats.push_back(ProfileZoneStats{
+            .zone = static_cast<ProfileZone>(idx),
+            .num_samples = durations.size(),
+            .p50_ms = get_ms(get_percentile(durations, 0.50)),
+            .p99_ms = get_ms(get_percentile(durations, 0.99)),
+            .max_ms = get_ms(durations.back()),
+        });
+    }
+
+    return stats;
+}
+
+void ProfilerType::clear()
+{
+    const auto rings_lock = std::lock_guard{rings_mutex};
+
+    // The owners keep writing, the samples before their current position are hidden
+    for (auto &ring : rings)
+        ring->clear_position.store(ring->write_position.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+ProfilerType &get_profiler()
+{
+    static auto profiler = ProfilerType{};
+
+    return profiler;
+}
+
+bool write_profile_csv(const std::vector<ProfileSample> &samples, const std::filesystem::path &csv_path)
+{
+    auto file = std::ofstream{csv_path};
+    if (!file.is_open())
+        return false;
+
+    const auto origin_ns = samples.empty() ? int64_t{0} : samples.front().start_ns;
+
+    file << std::fixed << std::setprecision(6);
+    file << "thread,zone,start_ms,duration_ms\n";
+    for (const auto &sample : samples)
+    {
+        file << sample.thread_idx << ',' << profile_zone_to_string(sample.zone) << ','
+             << get_ms(sample.start_ns - origin_ns) << ',' << get_ms(sample.duration_ns) << '\n';
+    }
+
+    return file.good();
+}
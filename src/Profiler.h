@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Hot paths that are timed when profiling is enabled
+enum class ProfileZone : uint8_t
+{
+    ADDON_RENDER,
+    RENDER,
+    OPTIONS_RENDER,
+    ROTATION_RENDER,
+    KEYPRESS_DETECTION,
+    SKILL_DETECTION,
+    ARC_COMBAT_EVENT,
+    TEXTURE_DECODE,
+    TEXTURE_UPLOAD,
+    BUILD_LOAD,
+    COUNT,
+};
+
+const char *profile_zone_to_string(const ProfileZone zone);
+
+struct ProfileSample
+{
+    ProfileZone zone = ProfileZone::COUNT;
+    uint32_t thread_idx = 0;
+    int64_t start_ns = 0; // Steady clock time since its epoch
+    int64_t duration_ns = 0;
+};
+
+struct ProfileZoneStats
+{
+    ProfileZone zone = ProfileZone::COUNT;
+    size_t num_samples = 0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+// Collects the timings of the zones. Every thread writes into its own ring of
+// the last RING_CAPACITY samples without taking a lock. Readers copy the rings
+// while they are written: each slot carries the position of its sample, a slot
+// that changed during the copy is skipped. The ring of a finished thread is
+// handed to the next new thread under a new thread index, the number of rings
+// stays at the number of threads running at the same time. While disabled a
+// scope only loads a flag. A thread remembers its ring in a thread_local that
+// is not tied to an instance, so the one profiler is reached through
+// get_profiler().
+class ProfilerType
+{
+public:
+    static constexpr auto RING_CAPACITY = size_t{4096};
+
+    ProfilerType(const ProfilerType &) = delete;
+    ProfilerType &operator=(const ProfilerType &) = delete;
+
+    void set_enabled(const bool is_enabled);
+    bool is_enabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void record(const ProfileZone zone,
+                const std::chrono::steady_clock::time_point start,
+                const std::chrono::steady_clock::time_point end);
+
+    // Samples of all threads that started within the window before now, oldest first
+    std::vector<ProfileSample> get_samples(const std::chrono::steady_clock::duration window) const;
+    std::vector<ProfileSample> get_samples() const;
+    // Rolling statistics of every zone with samples in the window
+    std::vector<ProfileZoneStats> get_stats(const std::chrono::steady_clock::duration window) const;
+
+    void clear();
+
+private:
+    friend ProfilerType &get_profiler();
+
+    ProfilerType() = default;
+
+    struct SlotType
+    {
+        // 2 * position + 1 while the sample is written, 2 * position + 2 once it is complete
+        std::atomic<uint64_t> sequence = 0;
+        std::atomic<ProfileZone> zone = ProfileZone::COUNT;
+        std::atomic<uint32_t> thread_idx = 0;
+        std::atomic<int64_t> start_ns = 0;
+        std::atomic<int64_t> duration_ns = 0;
+    };
+
+    // Written by the owning thread only
+    struct RingType
+    {
+        std::array<SlotType, RING_CAPACITY> slots{};
+        std::atomic<uint64_t> write_position = 0;
+        std::atomic<uint64_t> clear_position = 0; // Samples before it are hidden from the readers
+        uint32_t thread_idx = 0;
+        std::atomic<bool> in_use = false;
+    };
+
+    class ThreadRingHandle;
+
+    RingType &get_thread_ring();
+
+    std::atomic<bool> enabled = false;
+    mutable std::mutex rings_mutex;
+    std::vector<std::unique_ptr<RingType>> rings;
+    uint32_t num_ring_owners = 0;
+};
+
+ProfilerType &get_profiler();
+
+// Times the enclosing scope:
+//   const auto profile_scope = ProfileScopeType{ProfileZone::RENDER};
+class ProfileScopeType
+{
+public:
+    explicit ProfileScopeType(const ProfileZone zone) : zone(zone), is_active(get_profiler().is_enabled())
+    {
+        if (is_active)
+            start = std::chrono::steady_clock::now();
+    }
+    ~ProfileScopeType()
+    {
+        if (is_active)
+            get_profiler().record(zone, start, std::chrono::steady_clock::now());
+    }
+
+    ProfileScopeType(const ProfileScopeType &) = delete;
+    ProfileScopeType &operator=(const ProfileScopeType &) = delete;
+
+private:
+    ProfileZone zone;
+    bool is_active = false;
+    std::chrono::steady_clock::time_point start{};
+};
+
+// One line per sample: thread,zone,start_ms,duration_ms, the start relative to the oldest sample
+bool write_profile_csv(const std::vector<ProfileSample> &samples, const std::filesystem::path &csv_path);
@@ -22,22 +22,28 @@
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "imgui.h"
 
 #include "mumble/Mumble.h"
 
+#include "AddonFiles.h"
 #include "ArcEvents.h"
 #include "Defines.h"
 #include "FileUtils.h"
+#include "IconArchive.h"
 #include "LogData.h"
+#include "Logger.h"
 #include "MumbleUtils.h"
+#include "Profiler.h"
 #include "Render.h"
 #include "RenderUtils.h"
 #include "Rotation.h"
 #include "Settings.h"
 #include "Shared.h"
 #include "SkillData.h"
+#include "TextureLoader.h"
 #include "Textures.h"
 #include "Types.h"
 #include "TypesUtils.h"
@@ -46,11 +52,13 @@
 namespace
 {
 static auto last_time_aa_did_skip = std::chrono::steady_clock::time_point{};
+
+constexpr auto TEXTURE_UPLOAD_BUDGET = TextureUploadBudget{4, std::chrono::microseconds(1000)};
 } // namespace
 
 RenderType::~RenderType()
 {
-    ReleaseTextureMap(Globals::TextureMap);
+    Globals::TextureMap.clear();
 }
 
 void RenderType::set_data_path(const std::filesystem::path &path)
@@ -59,8 +67,22 @@ void RenderType::set_data_path(const std::filesystem::path &path)
     Globals::RenderData.img_path = Globals::RenderData.data_path / "img";
     Globals::RenderData.bench_path = Globals::RenderData.data_path / "bench";
 
+    const auto archive_path = get_icon_archive_path(Globals::RenderData.data_path);
+    if (open_current_icon_archive(Globals::IconArchive, archive_path, Globals::RenderData.img_path))
+    {
+        log_message(LogLevel::DEBUG, "Loaded icon archive");
+    }
+    else if (!Globals::IconArchiveBuild.valid())
+    {
+        // Icons load from their PNGs for now, the next start uses the new archive
+        log_message(LogLevel::INFO, "Icon archive missing or outdated, packing it.");
+        Globals::IconArchiveBuild = std::async(std::launch::async, [data_path = Globals::RenderData.data_path]() {
+            return BuildIconArchiveIfStale(data_path, &Globals::CancelIconArchiveBuild);
+        });
+    }
+
     Globals::RenderData.builds.initialize_build_categories();
-    Globals::RenderData.benches_files = get_bench_files(Globals::RenderData.bench_path);
+    Globals::RenderData.benches_files = get_bench_files(Globals::RenderData.bench_path, Globals::RenderData.builds);
 }
 
 void RenderType::append_to_played_rotation(const EvCombatDataPersistent &combat_data)
@@ -118,8 +140,8 @@ void RenderType::CycleSkillsLogic(const EvCombatDataPersistent &skill_ev)
     if (skill_ev.SkillID == SkillID::NONE || skill_ev.SkillID == SkillID::FALLBACK)
         return;
 
-    const auto debug_msg = std::string{"Player Casted Skill: "} + skill_ev.SkillName;
-    (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", debug_msg.c_str());
+    const auto debug_msg = std::string{"Player Casted Skill: "} + skill_ev.SkillName.str();
+    log_message(LogLevel::DEBUG, debug_msg);
 
     SkillDetectionLogic(num_skills_wo_match, time_since_last_match, Globals::RotationRun, skill_ev);
 }
@@ -148,8 +170,78 @@ void RenderType::restart_rotation(const bool not_ooc_triggered)
     }
 }
 
+void RenderType::request_downloaded_icons()
+{
+    SubmitPendingSkillIconDownloads(Globals::DownloadService.get(), Globals::RotationRun, Globals::RenderData.img_path);
+
+    auto icon_id = int{};
+
+    while (Globals::RotationRun.downloaded_icons.try_pop(icon_id))
+    {
+        if (!Globals::TextureLoader || Globals::TextureMap.contains(icon_id) || Globals::IconAtlas.find(icon_id))
+            continue;
+
+        // Downloads of a previously selected build are not needed anymore
+        const auto info_it = Globals::RotationRun.log_skill_info_map.find(icon_id);
+        if (info_it == Globals::RotationRun.log_skill_info_map.end())
+            continue;
+
+        RequestSkillTexture(*Globals::TextureLoader,
+                            icon_id,
+                            info_it->second,
+                            Globals::RenderData.img_path,
+                            TexturePriority::NORMAL);
+    }
+}
+
+void RenderType::upload_skill_textures()
+{
+    (void)Globals::IconSampler.create(Globals::RenderData.pd3dDevice);
+
+    auto has_new_icons = false;
+    if (Globals::IconAtlas.upload(Globals::RenderData.pd3dDevice))
+    {
+        if (Globals::IconCache)
+            (void)ReleasePackedTextures(Globals::IconAtlas, Globals::TextureMap, *Globals::IconCache);
+        has_new_icons = true;
+    }
+
+    if (Globals::TextureLoader && Globals::IconCache && !Globals::TextureLoader->is_idle())
+    {
+        const auto [start, end, current_idx] = Globals::RotationRun.get_current_rotation_indices();
+        auto visible_icon_ids = std::vector<int>{};
+        for (auto idx = std::max(start, 0); idx <= end; ++idx)
+        {
+            const auto &rotation_step = Globals::RotationRun.get_rotation_skill(static_cast<size_t>(idx));
+            visible_icon_ids.push_back(rotation_step.skill_data.icon_id);
+        }
+        Globals::TextureLoader->prioritize(visible_icon_ids);
+
+        const auto num_uploaded = UploadDecodedTextures(Globals::RenderData.pd3dDevice,
+                                                        *Globals::TextureLoader,
+                                                        *Globals::IconCache,
+                                                        Globals::TextureMap,
+                                                        Globals::IconAtlas,
+                                                        TEXTURE_UPLOAD_BUDGET);
+        has_new_icons |= num_uploaded > 0;
+    }
+    else if (Globals::TextureLoader)
+    {
+        Globals::IconAtlas.build();
+    }
+
+    if (!has_new_icons)
+        return;
+
+    GetRotationSkills(Globals::RotationRun, Globals::AddonHost);
+    if (Globals::RenderData.show_rotation_icons_overview || !Globals::RotationRun.rotation_icon_lines.empty())
+        GetRotationIcons(Globals::RotationRun, Globals::AddonHost);
+}
+
 void RenderType::render(ID3D11Device *pd3dDevice)
 {
+    const auto profile_scope = ProfileScopeType{ProfileZone::RENDER};
+
     Globals::RenderData.pd3dDevice = pd3dDevice;
 
     static auto time_went_ooc = std::chrono::steady_clock::now();
@@ -157,7 +249,7 @@ void RenderType::render(ID3D11Device *pd3dDevice)
     if (!Settings::ShowWindow)
         return;
 
-    KeypressSkillDetectionLogic(Globals::RotationRun);
+    KeypressSkillDetectionLogic(Globals::RotationRun, Globals::RenderData.keybinds, Globals::CurrentlyPressedKeys);
 
     if (Globals::RenderData.skill_event_in_this_frame)
     {
@@ -185,31 +277,16 @@ void RenderType::render(ID3D11Device *pd3dDevice)
     }
 
     if (Globals::RenderData.benches_files.size() == 0)
-        Globals::RenderData.benches_files = get_bench_files(Globals::RenderData.bench_path);
+        Globals::RenderData.benches_files = get_bench_files(Globals::RenderData.bench_path, Globals::RenderData.builds);
 
     Globals::OptionsRender.render();
 
-    if (Globals::RotationRun.futures.size() != 0)
-    {
-        if (Globals::RotationRun.futures.front().valid())
-        {
-            Globals::RotationRun.futures.front().get();
-            Globals::RotationRun.futures.pop_front();
-        }
-
-        return;
-    }
+    request_downloaded_icons();
+    upload_skill_textures();
 
     if (Globals::RotationRun.all_rotation_steps.size() == 0)
         return;
 
-    if (Globals::TextureMap.size() == 0)
-    {
-        Globals::TextureMap = LoadAllSkillTextures(Globals::RenderData.pd3dDevice,
-                                                   Globals::RotationRun.log_skill_info_map,
-                                                   Globals::RenderData.img_path);
-    }
-
     if (!IsValidMap())
         return;
 
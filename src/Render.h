@@ -2,6 +2,7 @@
 
 #include <d3d11.h>
 
+#include <chrono>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -11,45 +12,11 @@
 #include "Builds.h"
 #include "LogData.h"
 #include "OptionsRender.h"
+#include "RenderData.h"
 #include "RotationRender.h"
 #include "Textures.h"
 #include "Types.h"
 
-struct RenderDataType
-{
-    ID3D11Device *pd3dDevice = nullptr;
-
-    BuildsType builds;
-
-    std::filesystem::path data_path;
-    std::filesystem::path img_path;
-    std::filesystem::path bench_path;
-    std::vector<BenchFileInfo> benches_files;
-
-    std::map<std::string, KeybindInfo> keybinds{};
-    bool keybinds_loaded = false;
-
-    std::string current_build_key;
-    std::vector<uint32_t> precast_skills_order;
-    int precast_drag_source = -1;
-    int precast_drag_dest = -1;
-
-    bool is_not_ui_adjust_active = false;
-
-    bool skill_event_in_this_frame;
-    EvCombatDataPersistent curr_combat_data{};
-    std::vector<EvCombatDataPersistent> played_rotation{};
-
-    bool show_rotation_keybinds = false;
-    bool show_rotation_window = true;
-    bool show_rotation_icons_overview = false;
-
-    bool do_highlight_skill = false;
-    SkillID highlight_skill_id = SkillID::NONE;
-
-    std::filesystem::path selected_file_path;
-};
-
 class RenderType
 {
 public:
@@ -66,6 +33,8 @@ public:
     EvCombatDataPersistent get_current_skill();
     void CycleSkillsLogic(const EvCombatDataPersistent &skill_ev);
     void set_data_path(const std::filesystem::path &path);
+    void request_downloaded_icons();
+    void upload_skill_textures();
 
 public:
     bool show_window;
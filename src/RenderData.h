@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Builds.h"
+#include "Types.h"
+
+struct ID3D11Device;
+
+// State of the addon windows, shared by the render loop and the windows
+struct RenderDataType
+{
+    ID3D11Device *pd3dDevice = nullptr;
+
+    BuildsType builds;
+
+    std::filesystem::path data_path;
+    std::filesystem::path img_path;
+    std::filesystem::path bench_path;
+    std::vector<BenchFileInfo> benches_files;
+
+    std::map<std::string, KeybindInfo> keybinds{};
+    bool keybinds_loaded = false;
+    FileFingerprint keybinds_fingerprint{};
+    std::chrono::steady_clock::time_point keybinds_last_check{};
+
+    std::string current_build_key;
+    std::vector<uint32_t> precast_skills_order;
+    int precast_drag_source = -1;
+    int precast_drag_dest = -1;
+
+    bool is_not_ui_adjust_active = false;
+
+    bool skill_event_in_this_frame;
+    EvCombatDataPersistent curr_combat_data{};
+    std::vector<EvCombatDataPersistent> played_rotation{};
+
+    bool show_rotation_keybinds = false;
+    bool show_rotation_window = true;
+    bool show_rotation_icons_overview = false;
+
+    bool do_highlight_skill = false;
+    SkillID highlight_skill_id = SkillID::NONE;
+
+    std::filesystem::path selected_file_path;
+};
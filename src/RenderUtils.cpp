@@ -1,12 +1,13 @@
-#include <windows.h>
-
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "imgui.h"
 
+#include "LogData.h"
 #include "RenderUtils.h"
-#include "Shared.h"
+#include "SkillData.h"
+#include "UiShared.h"
 
 void SetTooltip(const std::string &text)
 {
@@ -31,7 +32,7 @@ void SetTooltip(const std::vector<std::string> &texts)
 
 void open_url_in_browser(const std::string &url)
 {
-    ShellExecuteA(nullptr, "open", url.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
+    Globals::UiHost->open_in_shell(url);
 }
 
 float calculate_centered_position(const std::vector<std::string> &items, const float add_width)
@@ -53,7 +54,7 @@ float calculate_centered_position(const std::vector<std::string> &items, const f
     return ((window_width - total_width) * 0.5F);
 }
 
-void DrawRect(const RotationStep &rotation_step,
+void DrawRect(const RotationStepRef &rotation_step,
               const std::string &text,
               const ImU32 color,
               const float border_thickness,
@@ -90,9 +91,9 @@ void DrawRect(const RotationStep &rotation_step,
                              IM_COL32(0, 0, 0, 0)); // Transparent to cut out inner area
 }
 
-std::string get_skill_text(const RotationStep &rotation_step)
+std::string get_skill_text(const RotationStepRef &rotation_step)
 {
-    auto text = rotation_step.skill_data.name;
+    auto text = rotation_step.skill_data.name.str();
 
     if (rotation_step.time_of_cast != 0.0f)
     {
@@ -112,3 +113,50 @@ bool IsVersionIsRange(const std::string version,
 {
     return version >= lower_version_bound && version <= upper_version_bound;
 }
+
+void GetRotationSkills(RotationLogType &rotation_run, const UiHostType &host)
+{
+    auto &rotation_skills = rotation_run.rotation_skills;
+
+    // Icons move from their single texture into the atlas, so known skills are updated as well
+    for (const auto &step : rotation_run.all_rotation_steps)
+    {
+        const auto icon = host.get_skill_icon(step.skill_data.icon_id);
+        if (!icon.texture)
+            continue;
+
+        const auto skill =
+            RotationSkill{step.skill_data.skill_id, step.skill_data.name, icon, step.skill_data.skill_slot};
+        rotation_skills.insert_or_assign(step.skill_data.skill_id, skill);
+    }
+}
+
+void GetRotationIcons(RotationLogType &rotation_run, const UiHostType &host)
+{
+    auto &rotation_icon_lines = rotation_run.rotation_icon_lines;
+    rotation_icon_lines.clear();
+    auto rotation_line = std::vector<std::tuple<SkillIconView, InternedString, SkillID, bool>>{};
+
+    for (const auto &rotation_step : rotation_run.all_rotation_steps_w_swap)
+    {
+        const auto skill_data = rotation_step.skill_data;
+        const auto icon = host.get_skill_icon(skill_data.icon_id);
+
+        if (is_skill_in_set(skill_data.name.view(), SkillRuleData::skill_rules.skills_match_weapon_swap_like))
+        {
+            rotation_icon_lines.push_back(rotation_line);
+            rotation_line = {};
+            continue;
+        }
+
+        if (!icon.texture)
+            continue;
+
+        rotation_line.push_back(std::make_tuple(icon, skill_data.name, skill_data.skill_id, false));
+    }
+
+    if (!rotation_line.empty())
+    {
+        rotation_icon_lines.push_back(rotation_line);
+    }
+}
@@ -5,7 +5,10 @@
 
 #include "imgui.h"
 
-#include "Shared.h"
+#include "LogData.h"
+#include "Types.h"
+#include "UiHost.h"
+#include "UiShared.h"
 
 void SetTooltip(const std::string &text);
 
@@ -15,16 +18,22 @@ void open_url_in_browser(const std::string &url);
 
 float calculate_centered_position(const std::vector<std::string> &items, const float add_width = 0);
 
-void DrawRect(const RotationStep &rotation_step,
+void DrawRect(const RotationStepRef &rotation_step,
               const std::string &text,
               const ImU32 color,
               const float border_thickness = 2.0f,
               const float icon_size = Globals::SkillIconSize);
 
-std::string get_skill_text(const RotationStep &rotation_step);
+std::string get_skill_text(const RotationStepRef &rotation_step);
 
+// Skills of the rotation that have an icon, for the skill slot windows
+void GetRotationSkills(RotationLogType &rotation_run, const UiHostType &host);
 
-auto draw_cross_factory(ImU32 color)
+// Icons of the rotation, one line per weapon swap like skill
+void GetRotationIcons(RotationLogType &rotation_run, const UiHostType &host);
+
+
+inline auto draw_cross_factory(ImU32 color)
 {
     return [color](ImDrawList *draw_list, ImVec2 center, float radius, float size) {
         float line_thickness = 2.0f;
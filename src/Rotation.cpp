@@ -1,18 +1,23 @@
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <map>
 #include <string>
+#include <vector>
 
+#include "Clock.h"
 #include "LogData.h"
-#include "MumbleUtils.h"
+#include "Logger.h"
+#include "Profiler.h"
 #include "Rotation.h"
 #include "Settings.h"
-#include "Shared.h"
 #include "SkillData.h"
 #include "Types.h"
 #include "TypesUtils.h"
 
 namespace
 {
-bool IsSkillAutoAttack(const SkillID skill_id, const std::string &skill_name, const SkillDataMap &skill_data_map)
+bool IsSkillAutoAttack(const SkillID skill_id, const InternedString skill_name, const SkillDataMap &skill_data_map)
 {
     auto it = skill_data_map.find(skill_id);
 
@@ -97,7 +102,7 @@ bool CheckTheNextNskills(const EvCombatDataPersistent &current_casted_skill,
 
 void ResetSkillDetectionData(SkillDetectionTimers &timers, uint32_t &num_skills_wo_match)
 {
-    const auto now = std::chrono::steady_clock::now();
+    const auto now = get_clock().now();
     timers.time_of_last_pop = now;
     timers.time_of_last_next_skill_check = now;
     timers.time_of_last_next_next_skill_check = now;
@@ -107,7 +112,7 @@ void ResetSkillDetectionData(SkillDetectionTimers &timers, uint32_t &num_skills_
 
 float GetTimeSinceInSeconds(const std::chrono::steady_clock::time_point &t0)
 {
-    const auto now = std::chrono::steady_clock::now();
+    const auto now = get_clock().now();
     const auto time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - t0).count();
     return static_cast<float>(time_ms) / 1000.0f;
 }
@@ -116,7 +121,7 @@ RotaSkillWindow _GetRotaWindowFromRotationSteps(RotationLogType &rotation_run, S
 {
     auto rota_window = RotaSkillWindow{};
 
-    const auto now = std::chrono::steady_clock::now();
+    const auto now = get_clock().now();
     const auto time_since_last_pop_ms =
         std::chrono::duration_cast<std::chrono::milliseconds>(now - timers.time_of_last_pop).count();
 
@@ -129,7 +134,8 @@ RotaSkillWindow _GetRotaWindowFromRotationSteps(RotationLogType &rotation_run, S
         auto cast_time_ms = 150.0F;
         if (rota_window.curr_rota_skill.skill_data.cast_time_with_quickness > 0)
         {
-            cast_time_ms = max(cast_time_ms, rota_window.curr_rota_skill.skill_data.cast_time_with_quickness * 1000.0f);
+            cast_time_ms =
+                std::max(cast_time_ms, rota_window.curr_rota_skill.skill_data.cast_time_with_quickness * 1000.0f);
         }
 
         const auto can_pop = (time_since_last_pop_ms > cast_time_ms);
@@ -139,7 +145,7 @@ RotaSkillWindow _GetRotaWindowFromRotationSteps(RotationLogType &rotation_run, S
             it = rotation_run.missing_rotation_steps.begin();
             rota_window.curr_rota_skill = *it;
 
-            timers.time_of_last_pop = std::chrono::steady_clock::now();
+            timers.time_of_last_pop = get_clock().now();
         }
 
         ++it;
@@ -225,18 +231,23 @@ RotaSkillWindow GetRotaSkillWindow(RotationLogType &rotation_run, SkillDetection
 }
 } // namespace
 
-void KeypressSkillDetectionLogic(RotationLogType &rotation_run)
+void KeypressSkillDetectionLogic(RotationLogType &rotation_run,
+                                 const std::map<std::string, KeybindInfo> &keybinds,
+                                 std::vector<uint32_t> &pressed_keys)
 {
+    const auto profile_scope = ProfileScopeType{ProfileZone::KEYPRESS_DETECTION};
+
     static auto timers = SkillDetectionTimers{};
+    static auto last_key_press_skill_id = SkillID{0};
+    static auto last_key_press_skill_time = get_clock().now();
 
     if (!Settings::UseSkillEvents)
         return;
 
-    auto &currentKeys = Globals::CurrentlyPressedKeys;
-    if (currentKeys.empty())
+    if (pressed_keys.empty())
         return;
 
-    const auto windows_key = static_cast<WindowsKeys>(currentKeys[0]);
+    const auto windows_key = static_cast<WindowsKeys>(pressed_keys[0]);
     const auto gw2_key = windows_key_to_keys_enum(windows_key);
 
     auto detected_skill_slot = SkillSlot::NONE;
@@ -244,7 +255,7 @@ void KeypressSkillDetectionLogic(RotationLogType &rotation_run)
 
     default_gw2key_to_skillslot_mapping(gw2_key, detected_skill_slot, detected_action_name);
 
-    for (const auto &[action_name, keybind_info] : Globals::RenderData.keybinds)
+    for (const auto &[action_name, keybind_info] : keybinds)
     {
         if (keybind_info.button == gw2_key && keybind_info.device == Device::KEYBOARD &&
             keybind_info.modifier == Modifiers::NONE)
@@ -259,7 +270,7 @@ void KeypressSkillDetectionLogic(RotationLogType &rotation_run)
         return;
 
     auto detected_skill_id = SkillID{0};
-    for (const auto skill : Globals::RotationRun.rotation_skills)
+    for (const auto skill : rotation_run.rotation_skills)
     {
         if (skill.second.skill_slot == detected_skill_slot)
         {
@@ -281,18 +292,18 @@ void KeypressSkillDetectionLogic(RotationLogType &rotation_run)
     const auto rota_window = GetRotaSkillWindow(rotation_run, timers);
     const auto curr_rota_skill = rota_window.curr_rota_skill;
     const auto curr_skill_id = curr_rota_skill.skill_data.skill_id;
-    const auto rota_keybind_str = rotation_run.get_keybind_str(curr_rota_skill, Globals::RenderData.keybinds);
-    const auto casted_keybind_str = rotation_run.get_keybind_str(casted_skill, Globals::RenderData.keybinds);
+    const auto rota_keybind_str = rotation_run.get_keybind_str(curr_rota_skill, keybinds);
+    const auto casted_keybind_str = rotation_run.get_keybind_str(casted_skill, keybinds);
 
     if (casted_keybind_str == rota_keybind_str && detected_skill_id == curr_skill_id)
     {
         // Check if this is the same skill as last pressed
-        if (detected_skill_id == Globals::LastKeyPressSkillID)
+        if (detected_skill_id == last_key_press_skill_id)
         {
             // Same skill - check if enough time has passed based on recharge time
-            const auto now = std::chrono::steady_clock::now();
+            const auto now = get_clock().now();
             const auto time_since_last_press_ms =
-                std::chrono::duration_cast<std::chrono::milliseconds>(now - Globals::LastKeyPressSkillTime).count();
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - last_key_press_skill_time).count();
 
             const auto recharge_time_ms = curr_rota_skill.skill_data.recharge_time * 1000.0f;
 
@@ -300,15 +311,15 @@ void KeypressSkillDetectionLogic(RotationLogType &rotation_run)
                 return;
         }
 
-        const auto success_msg = "Matched skill: " + curr_rota_skill.skill_data.name +
+        const auto success_msg = "Matched skill: " + curr_rota_skill.skill_data.name.str() +
                                  " (ID: " + std::to_string((uint32_t)curr_skill_id) + ")";
-        (void)Globals::APIDefs->Log(LOGL_INFO, "GW2RotaHelper", success_msg.c_str());
+        log_message(LogLevel::INFO, success_msg);
 
         // Update tracking for this skill
-        Globals::LastKeyPressSkillID = detected_skill_id;
-        Globals::LastKeyPressSkillTime = std::chrono::steady_clock::now();
+        last_key_press_skill_id = detected_skill_id;
+        last_key_press_skill_time = get_clock().now();
 
-        currentKeys.clear();
+        pressed_keys.clear();
     }
 }
 
@@ -328,15 +339,17 @@ void SkillDetectionLogic(uint32_t &num_skills_wo_match,
                          RotationLogType &rotation_run,
                          const EvCombatDataPersistent &current_casted_skill)
 {
+    const auto profile_scope = ProfileScopeType{ProfileZone::SKILL_DETECTION};
+
     static auto timers = SkillDetectionTimers{};
 
     const auto duration_since_last_match = GetTimeSinceInSeconds(time_since_last_match);
     const auto curr_casted_is_auto_attack = IsSkillAutoAttack(current_casted_skill.SkillID,
                                                               current_casted_skill.SkillName,
-                                                              Globals::RotationRun.skill_data_map);
+                                                              rotation_run.skill_data_map);
 
     if (num_skills_wo_match == 0)
-        time_since_last_match = std::chrono::steady_clock::now();
+        time_since_last_match = get_clock().now();
 
     auto rota_window = GetRotaSkillWindow(rotation_run, timers);
     const auto num_special_skills_in_window = (rota_window.curr_rota_skill.is_special_skill ? 1 : 0) +
@@ -360,7 +373,8 @@ void SkillDetectionLogic(uint32_t &num_skills_wo_match,
     if (still_look_into_in_strict_mode && !curr_casted_is_auto_attack)
     {
         const auto current_casted_is_profession_reset_like_skill =
-            SkillRuleData::IsProfessionResetLikeSKill(current_casted_skill.SkillID);
+            SkillRuleData::IsProfessionResetLikeSKill(current_casted_skill.SkillID,
+                                                      static_cast<ProfessionID>(current_casted_skill.SrcProfession));
 
         if (current_casted_is_profession_reset_like_skill)
             return;
@@ -372,7 +386,7 @@ void SkillDetectionLogic(uint32_t &num_skills_wo_match,
 
             if (rota_window.next_rota_skill.skill_data.is_auto_attack &&
                 rota_window.next_next_rota_skill.skill_data.is_auto_attack)
-                timers.time_of_last_aa_skip = std::chrono::steady_clock::now();
+                timers.time_of_last_aa_skip = get_clock().now();
 
             timers.is_first_check_for_next_next = false;
             return;
@@ -426,7 +440,7 @@ void SkillDetectionLogic(uint32_t &num_skills_wo_match,
                 rotation_run.missing_rotation_steps.pop_front();
 
                 num_skills_wo_match = 0U;
-                time_since_last_match = std::chrono::steady_clock::now();
+                time_since_last_match = get_clock().now();
                 return;
             }
         }
@@ -2,12 +2,18 @@
 
 #include <chrono>
 #include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "LogData.h"
 #include "Types.h"
 #include "TypesUtils.h"
 
-void KeypressSkillDetectionLogic(RotationLogType &RotationRun);
+// Matches the first pressed key against the current rotation step, the keys are consumed on a match
+void KeypressSkillDetectionLogic(RotationLogType &rotation_run,
+                                 const std::map<std::string, KeybindInfo> &keybinds,
+                                 std::vector<uint32_t> &pressed_keys);
 
 void SkillDetectionLogic(uint32_t &num_skills_wo_match,
                          std::chrono::steady_clock::time_point &time_since_last_match,
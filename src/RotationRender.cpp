@@ -1,13 +1,3 @@
-#include <windows.h>
-
-#include <commdlg.h>
-#include <wininet.h>
-#pragma comment(lib, "wininet.lib")
-#include <wincodec.h>
-#pragma comment(lib, "windowscodecs.lib")
-#pragma comment(lib, "ole32.lib")
-#include <d3d11.h>
-
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
@@ -24,22 +14,18 @@
 #include <utility>
 
 #include "imgui.h"
-#include "mumble/Mumble.h"
 
-#include "ArcEvents.h"
 #include "Defines.h"
 #include "FileUtils.h"
 #include "LogData.h"
-#include "MumbleUtils.h"
-#include "Render.h"
+#include "Profiler.h"
 #include "RenderUtils.h"
 #include "Rotation.h"
 #include "Settings.h"
-#include "Shared.h"
 #include "SkillData.h"
-#include "Textures.h"
 #include "Types.h"
 #include "TypesUtils.h"
+#include "UiShared.h"
 
 #include "RotationRender.h"
 
@@ -180,6 +166,8 @@ void DrawKeybind(const std::string &keybind_str)
 
 void RotationRenderType::render()
 {
+    const auto profile_scope = ProfileScopeType{ProfileZone::ROTATION_RENDER};
+
     float window_width = 600.0f;
     float window_height = 100.0f;
     ImGuiIO &io = ImGui::GetIO();
@@ -205,10 +193,13 @@ void RotationRenderType::render()
         if (ImGui::Begin("##GW2RotaHelper_Rota_Horizontal", &Settings::ShowWindow, curr_flags_rota))
         {
             const auto current_window_size = ImGui::GetWindowSize();
-            Globals::SkillIconSize = min(current_window_size.y * 0.7f, 120.0f);
-            Globals::SkillIconSize = max(Globals::SkillIconSize, 24.0f);
+            Globals::SkillIconSize = std::min(current_window_size.y * 0.7f, 120.0f);
+            Globals::SkillIconSize = std::max(Globals::SkillIconSize, 24.0f);
 
+            auto *draw_list = ImGui::GetWindowDrawList();
+            Globals::UiHost->begin_icon_draws(draw_list);
             render_rotation_horizontal();
+            Globals::UiHost->end_icon_draws(draw_list);
         }
 
         ImGui::End();
@@ -253,18 +244,20 @@ void RotationRenderType::render_rotation_icons_overview(bool &show_rotation_icon
     {
         auto should_break = false;
         auto icons_in_line = 0;
+        auto *draw_list = ImGui::GetWindowDrawList();
+        Globals::UiHost->begin_icon_draws(draw_list);
 
         for (const auto &icon_lines : Globals::RotationRun.rotation_icon_lines)
         {
             bool first_in_line = true;
             for (const auto &line_data : icon_lines)
             {
-                auto *texture = std::get<0>(line_data);
+                const auto &icon = std::get<0>(line_data);
                 auto name = std::get<1>(line_data);
                 auto skill_id = std::get<2>(line_data);
                 auto is_auto_attack = std::get<3>(line_data);
 
-                if (!texture || !Globals::RenderData.pd3dDevice)
+                if (!icon.texture)
                     continue;
 
                 if (!first_in_line)
@@ -303,7 +296,7 @@ void RotationRenderType::render_rotation_icons_overview(bool &show_rotation_icon
                     DrawRect(rotation_step, "", IM_COL32(255, 255, 255, 255), 2.0F, icon_size);
                 else if (rotation_step.skill_data.is_auto_attack) // orange
                     DrawRect(rotation_step, "", IM_COL32(255, 165, 0, 255), 2.0F);
-                render_skill_texture(rotation_step, texture, 0, icon_size, false, alpha_offset);
+                render_skill_texture(rotation_step, icon, 0, icon_size, false, alpha_offset);
 
                 if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) &&
                     ImGui::GetIO().KeyCtrl)
@@ -323,6 +316,8 @@ void RotationRenderType::render_rotation_icons_overview(bool &show_rotation_icon
             if (num_icons > 0)
                 ImGui::Dummy(ImVec2(0, 2));
         }
+
+        Globals::UiHost->end_icon_draws(draw_list);
     }
 
     ImGui::End();
@@ -350,7 +345,7 @@ void RotationRenderType::render_rotation_horizontal()
             const auto skill_it = Globals::RotationRun.rotation_skills.find(static_cast<SkillID>(skill_id));
             if (skill_it != Globals::RotationRun.rotation_skills.end())
             {
-                if (skill_it->second.texture)
+                if (skill_it->second.icon.texture)
                 {
                     RotationStep precast_step;
                     precast_step.skill_data.name = skill_it->second.name;
@@ -364,7 +359,7 @@ void RotationRenderType::render_rotation_horizontal()
 
                     render_rotation_icons(precast_skill_state,
                                           precast_step,
-                                          skill_it->second.texture,
+                                          skill_it->second.icon,
                                           "PreCast",
                                           0,
                                           true);
@@ -380,7 +375,7 @@ void RotationRenderType::render_rotation_horizontal()
             continue;
 
         const auto &rotation_step = Globals::RotationRun.get_rotation_skill(static_cast<size_t>(window_idx));
-        const auto *texture = Globals::TextureMap[rotation_step.skill_data.icon_id];
+        const auto icon = Globals::UiHost->get_skill_icon(rotation_step.skill_data.icon_id);
 
         const auto skill_state = get_skill_state(Globals::RotationRun,
                                                  Globals::RenderData.played_rotation,
@@ -388,10 +383,8 @@ void RotationRenderType::render_rotation_horizontal()
                                                  current_idx,
                                                  rotation_step.skill_data.is_auto_attack);
         const auto text = std::string{""};
-        const int aa_index = (static_cast<size_t>(window_idx) < Globals::RotationRun.auto_attack_indices.size())
-                                 ? Globals::RotationRun.auto_attack_indices[window_idx]
-                                 : 0;
-        render_rotation_icons(skill_state, rotation_step, texture, text, aa_index);
+        const auto aa_index = Globals::RotationRun.get_auto_attack_index(static_cast<size_t>(window_idx));
+        render_rotation_icons(skill_state, rotation_step, icon, text, aa_index);
 
         ImGui::SameLine();
     }
@@ -400,8 +393,8 @@ void RotationRenderType::render_rotation_horizontal()
 }
 
 void RotationRenderType::render_rotation_icons(const SkillState &skill_state,
-                                               const RotationStep &rotation_step,
-                                               const ID3D11ShaderResourceView *texture,
+                                               const RotationStepRef &rotation_step,
+                                               const SkillIconView &icon,
                                                const std::string &text,
                                                const int auto_attack_index,
                                                const bool is_precast)
@@ -411,7 +404,7 @@ void RotationRenderType::render_rotation_icons(const SkillState &skill_state,
     if (is_precast)
     {
         DrawRect(rotation_step, text, IM_COL32(0, 0, 0, 255), 2.0F);
-        render_skill_texture(rotation_step, texture, auto_attack_index, Globals::SkillIconSize, false);
+        render_skill_texture(rotation_step, icon, auto_attack_index, Globals::SkillIconSize, false);
 
         auto *draw_list = ImGui::GetWindowDrawList();
         auto icon_pos = ImGui::GetItemRectMin();
@@ -437,8 +430,8 @@ void RotationRenderType::render_rotation_icons(const SkillState &skill_state,
     else if (rotation_step.skill_data.is_auto_attack) // orange
         DrawRect(rotation_step, text, IM_COL32(255, 165, 0, 255), 2.0F);
 
-    if (texture && Globals::RenderData.pd3dDevice)
-        render_skill_texture(rotation_step, texture, auto_attack_index, Globals::SkillIconSize, Settings::ShowKeybind);
+    if (icon.texture)
+        render_skill_texture(rotation_step, icon, auto_attack_index, Globals::SkillIconSize, Settings::ShowKeybind);
     else if (rotation_step.skill_data.icon_id == DODGE_ICON_ID)
         render_dodge_placeholder();
     else if (rotation_step.skill_data.icon_id == UNK_SKILL_ICON_ID)
@@ -450,8 +443,8 @@ void RotationRenderType::render_rotation_icons(const SkillState &skill_state,
         Globals::RenderData.is_not_ui_adjust_active = !Globals::RenderData.is_not_ui_adjust_active;
 }
 
-void RotationRenderType::render_skill_texture(const RotationStep &rotation_step,
-                                              const ID3D11ShaderResourceView *texture,
+void RotationRenderType::render_skill_texture(const RotationStepRef &rotation_step,
+                                              const SkillIconView &icon,
                                               const int auto_attack_index,
                                               const float icon_size,
                                               const bool show_keybind,
@@ -462,12 +455,16 @@ void RotationRenderType::render_skill_texture(const RotationStep &rotation_step,
     if (is_special_skill)
         tint_color = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
     if (alpha_offset != 0.0f)
-        tint_color.w = max(0.1f, min(1.0f, tint_color.w + alpha_offset));
+        tint_color.w = std::max(0.1f, std::min(1.0f, tint_color.w + alpha_offset));
 
-    if (!texture)
+    if (!icon.texture)
         return;
 
-    ImGui::Image((ImTextureID)texture, ImVec2(icon_size, icon_size), ImVec2(0, 0), ImVec2(1, 1), tint_color);
+    ImGui::Image((ImTextureID)icon.texture,
+                 ImVec2(icon_size, icon_size),
+                 ImVec2(icon.u0, icon.v0),
+                 ImVec2(icon.u1, icon.v1),
+                 tint_color);
 
     if (show_keybind)
         render_keybind(rotation_step);
@@ -495,7 +492,7 @@ void RotationRenderType::render_skill_texture(const RotationStep &rotation_step,
     SetTooltip(tooltip_text);
 }
 
-void RotationRenderType::render_keybind(const RotationStep &rotation_step)
+void RotationRenderType::render_keybind(const RotationStepRef &rotation_step)
 {
     const auto &skill_key_mapping = Globals::RotationRun.skill_key_mapping;
     const auto skill_slot = rotation_step.skill_data.skill_slot;
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <d3d11.h>
+#include <string>
 
 #include "imgui.h"
 
+#include "Types.h"
+
 class RotationRenderType
 {
 public:
@@ -15,18 +17,18 @@ public:
     void render_rotation_keybinds(bool &show_rotation_keybinds);
     void render_rotation_horizontal();
     void render_rotation_icons(const SkillState &skill_state,
-                               const RotationStep &rotation_step,
-                               const ID3D11ShaderResourceView *texture,
+                               const RotationStepRef &rotation_step,
+                               const SkillIconView &icon,
                                const std::string &text,
                                const int auto_attack_index = 0,
                                const bool is_precast = false);
-    void render_skill_texture(const RotationStep &rotation_step,
-                              const ID3D11ShaderResourceView *texture,
+    void render_skill_texture(const RotationStepRef &rotation_step,
+                              const SkillIconView &icon,
                               const int auto_attack_index,
                               const float icon_size,
                               const bool show_keybind,
                               const float alpha_offset = 0.0F);
-    void render_keybind(const RotationStep &rotation_step);
+    void render_keybind(const RotationStepRef &rotation_step);
     void render_dodge_placeholder();
     void render_unknown_placeholder();
     void render_empty_placeholder();
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Logger.h"
+#include "RotationTable.h"
+#include "Types.h"
+
+std::optional<uint16_t> RotationSkillTableType::intern(const SkillData &skill_data)
+{
+    const auto [first, last] = indices_by_id.equal_range(skill_data.skill_id);
+    for (auto it = first; it != last; ++it)
+    {
+        if (skills[it->second] == skill_data)
+            return it->second;
+    }
+
+    if (skills.size() >= MAX_SKILLS)
+        return std::nullopt;
+
+    const auto skill_idx = static_cast<uint16_t>(skills.size());
+    skills.push_back(skill_data);
+    indices_by_id.emplace(skill_data.skill_id, skill_idx);
+    return skill_idx;
+}
+
+RotationTableType::RotationTableType(const RotationSteps &steps, std::shared_ptr<RotationSkillTableType> skill_table)
+    : skill_table(std::move(skill_table))
+{
+    times_of_cast.reserve(steps.size());
+    durations_ms.reserve(steps.size());
+    skill_indices.reserve(steps.size());
+    flags.reserve(steps.size());
+
+    for (const auto &step : steps)
+    {
+        const auto skill_idx = this->skill_table->intern(step.skill_data);
+        if (!skill_idx)
+        {
+            log_message(LogLevel::WARNING,
+                        "Rotation has more than " + std::to_string(RotationSkillTableType::MAX_SKILLS) +
+                            " distinct skills, it is not loaded.");
+            clear();
+            return;
+        }
+
+        times_of_cast.push_back(step.time_of_cast);
+        durations_ms.push_back(step.duration_ms);
+        skill_indices.push_back(*skill_idx);
+        flags.push_back(step.is_special_skill ? FLAG_SPECIAL_SKILL : uint8_t{0});
+    }
+}
+
+void RotationTableType::clear()
+{
+    times_of_cast.clear();
+    durations_ms.clear();
+    skill_indices.clear();
+    flags.clear();
+    skill_table.reset();
+}
+
+std::vector<AutoAttackRun> get_auto_attack_runs(const RotationTableType &table,
+                                                bool (*is_auto_attack)(const SkillData &skill_data))
+{
+    auto runs = std::vector<AutoAttackRun>{};
+
+    for (auto idx = size_t{0}; idx < table.size(); ++idx)
+    {
+        const auto &skill_data = table.get_skill_data(idx);
+        if (!is_auto_attack(skill_data))
+            continue;
+
+        if (!runs.empty() && runs.back().start + runs.back().length == idx)
+            ++runs.back().length;
+        else
+            runs.push_back(AutoAttackRun{static_cast<uint32_t>(idx), 1, skill_data.weapon_type});
+    }
+
+    return runs;
+}
+
+int get_auto_attack_index(const std::vector<AutoAttackRun> &runs, const size_t idx)
+{
+    const auto it = std::upper_bound(runs.begin(), runs.end(), idx, [](const size_t value, const AutoAttackRun &run) {
+        return value < run.start;
+    });
+    if (it == runs.begin())
+        return 0;
+
+    const auto &run = *std::prev(it);
+    if (run.length < 2 || idx >= run.start + run.length)
+        return 0;
+
+    return static_cast<int>(idx - run.start + 1);
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Types.h"
+
+// Every distinct SkillData of a loaded rotation, stored once and shared by the
+// tables of that rotation
+class RotationSkillTableType
+{
+public:
+    static constexpr auto MAX_SKILLS = size_t{std::numeric_limits<uint16_t>::max()} + 1;
+
+    // Index of an equal entry, the skill is added if there is none. Empty once
+    // the table holds MAX_SKILLS entries and the skill is not one of them.
+    std::optional<uint16_t> intern(const SkillData &skill_data);
+
+    const SkillData &get(const uint16_t skill_idx) const
+    {
+        return skills[skill_idx];
+    }
+    size_t size() const
+    {
+        return skills.size();
+    }
+
+private:
+    std::vector<SkillData> skills;
+    std::unordered_multimap<SkillID, uint16_t> indices_by_id; // Entries of equal ids differ in other fields
+};
+
+// The steps of a rotation as columns: cast time, duration, index into the
+// shared skill table and flags. Reading a step yields a RotationStepRef with the
+// fields of a RotationStep, so walking the rotation touches about 11 bytes per
+// step instead of a full SkillData copy.
+class RotationTableType
+{
+public:
+    static constexpr auto FLAG_SPECIAL_SKILL = uint8_t{1u << 0};
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = RotationStep;
+        using difference_type = std::ptrdiff_t;
+        using reference = RotationStepRef;
+
+        const_iterator() = default;
+        const_iterator(const RotationTableType *table, const size_t idx) : table(table), idx(idx)
+        {
+        }
+
+        RotationStepRef operator*() const
+        {
+            return (*table)[idx];
+        }
+        RotationStepRef operator[](const difference_type offset) const
+        {
+            return (*table)[idx + offset];
+        }
+
+        const_iterator &operator++()
+        {
+            ++idx;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            auto prev = *this;
+            ++idx;
+            return prev;
+        }
+        const_iterator &operator--()
+        {
+            --idx;
+            return *this;
+        }
+        const_iterator operator--(int)
+        {
+            auto prev = *this;
+            --idx;
+            return prev;
+        }
+        const_iterator &operator+=(const difference_type offset)
+        {
+            idx += offset;
+            return *this;
+        }
+        const_iterator &operator-=(const difference_type offset)
+        {
+            idx -= offset;
+            return *this;
+        }
+        const_iterator operator+(const difference_type offset) const
+        {
+            return const_iterator{table, idx + offset};
+        }
+        const_iterator operator-(const difference_type offset) const
+        {
+            return const_iterator{table, idx - offset};
+        }
+        difference_type operator-(const const_iterator &other) const
+        {
+            return static_cast<difference_type>(idx) - static_cast<difference_type>(other.idx);
+        }
+
+        bool operator==(const const_iterator &other) const
+        {
+            return idx == other.idx;
+        }
+        auto operator<=>(const const_iterator &other) const
+        {
+            return idx <=> other.idx;
+        }
+
+        size_t get_index() const
+        {
+            return idx;
+        }
+
+    private:
+        const RotationTableType *table = nullptr;
+        size_t idx = 0;
+    };
+
+    RotationTableType() = default;
+    // The table stays empty if the steps hold more distinct skills than the skill table can index
+    RotationTableType(const RotationSteps &steps, std::shared_ptr<RotationSkillTableType> skill_table);
+
+    void clear();
+
+    size_t size() const
+    {
+        return times_of_cast.size();
+    }
+    bool empty() const
+    {
+        return times_of_cast.empty();
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{this, 0};
+    }
+    const_iterator end() const
+    {
+        return const_iterator{this, size()};
+    }
+
+    RotationStepRef operator[](const size_t idx) const
+    {
+        return RotationStepRef{times_of_cast[idx],
+                               durations_ms[idx],
+                               skill_table->get(skill_indices[idx]),
+                               (flags[idx] & FLAG_SPECIAL_SKILL) != 0};
+    }
+
+    float get_time_of_cast(const size_t idx) const
+    {
+        return times_of_cast[idx];
+    }
+    float get_duration_ms(const size_t idx) const
+    {
+        return durations_ms[idx];
+    }
+    const SkillData &get_skill_data(const size_t idx) const
+    {
+        return skill_table->get(skill_indices[idx]);
+    }
+    bool is_special_skill(const size_t idx) const
+    {
+        return (flags[idx] & FLAG_SPECIAL_SKILL) != 0;
+    }
+
+private:
+    std::vector<float> times_of_cast;
+    std::vector<float> durations_ms;
+    std::vector<uint16_t> skill_indices;
+    std::vector<uint8_t> flags;
+    std::shared_ptr<RotationSkillTableType> skill_table;
+};
+
+// Consecutive auto attack steps of a table, weapon_type is the weapon of the first one
+struct AutoAttackRun
+{
+    uint32_t start;
+    uint32_t length;
+    WeaponType weapon_type;
+};
+
+// All runs of steps matching is_auto_attack in one pass, single steps included
+std::vector<AutoAttackRun> get_auto_attack_runs(const RotationTableType &table,
+                                                bool (*is_auto_attack)(const SkillData &skill_data));
+
+// Position of step idx in its run counted from 1, 0 for steps outside a run of two or more
+int get_auto_attack_index(const std::vector<AutoAttackRun> &runs, const size_t idx);
+
+// The steps of a table from the current one to the end. pop_front only moves
+// the start, so the steps still to play need no copy of the rotation.
+class RotationSuffixType
+{
+public:
+    RotationSuffixType() = default;
+    explicit RotationSuffixType(const RotationTableType &table) : table(&table)
+    {
+    }
+
+    void clear()
+    {
+        table = nullptr;
+        first = 0;
+    }
+
+    size_t size() const
+    {
+        if (table == nullptr || first >= table->size())
+            return 0;
+
+        return table->size() - first;
+    }
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    RotationTableType::const_iterator begin() const
+    {
+        return table == nullptr ? RotationTableType::const_iterator{} : table->end() - size();
+    }
+    RotationTableType::const_iterator end() const
+    {
+        return table == nullptr ? RotationTableType::const_iterator{} : table->end();
+    }
+
+    RotationStepRef front() const
+    {
+        return (*table)[first];
+    }
+    void pop_front()
+    {
+        if (!empty())
+            ++first;
+    }
+
+private:
+    const RotationTableType *table = nullptr;
+    size_t first = 0;
+};
@@ -0,0 +1,164 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "RuleMatcher.h"
+#include "SkillIDs.h"
+#include "Types.h"
+
+namespace
+{
+template <typename SetType>
+void add_substrings(RuleMatcherType &matcher, const SetType &patterns, const uint32_t mask)
+{
+    for (const auto &pattern : patterns)
+        matcher.add_substring(pattern, mask);
+}
+
+template <typename SetType>
+void add_exacts(RuleMatcherType &matcher, const SetType &patterns, const uint32_t mask)
+{
+    for (const auto &pattern : patterns)
+        matcher.add_exact(pattern, mask);
+}
+
+template <typename SetType>
+void add_ids(std::unordered_map<int32_t, uint32_t> &ids, const SetType &skill_ids, const uint32_t mask)
+{
+    for (const auto skill_id : skill_ids)
+        ids[static_cast<int32_t>(skill_id)] |= mask;
+}
+} // namespace
+
+void RuleMatcherType::add_substring(std::string_view pattern, const uint32_t mask)
+{
+    substring_patterns.emplace_back(std::string{pattern}, mask);
+}
+
+void RuleMatcherType::add_exact(std::string_view pattern, const uint32_t mask)
+{
+    exact_patterns[std::string{pattern}] |= mask;
+}
+
+void RuleMatcherType::build()
+{
+    symbols.fill(0);
+    num_symbols = 1;
+    for (const auto &[pattern, mask] : substring_patterns)
+    {
+        for (const auto c : pattern)
+        {
+            auto &symbol = symbols[static_cast<uint8_t>(c)];
+            if (symbol == 0)
+                symbol = static_cast<uint16_t>(num_symbols++);
+        }
+    }
+
+    // Trie of the patterns, state 0 is the root and never a child so 0 marks a missing edge
+    transitions.assign(num_symbols, 0);
+    outputs.assign(1, 0);
+    for (const auto &[pattern, mask] : substring_patterns)
+    {
+        auto state = uint32_t{0};
+        for (const auto c : pattern)
+        {
+            const auto edge = state * num_symbols + symbols[static_cast<uint8_t>(c)];
+            if (transitions[edge] == 0)
+            {
+                transitions[edge] = static_cast<uint32_t>(outputs.size());
+                transitions.resize(transitions.size() + num_symbols, 0);
+                outputs.push_back(0);
+            }
+            state = transitions[edge];
+        }
+        outputs[state] |= mask;
+    }
+
+    // Breadth first over the trie, so the failure state of every state is complete before
+    // the state itself. Missing edges are filled from the failure state, which turns the
+    // trie into a DFA without failure links left to follow while matching.
+    auto failure = std::vector<uint32_t>(outputs.size(), 0);
+    auto queue = std::vector<uint32_t>{};
+    queue.reserve(outputs.size());
+    for (auto symbol = uint32_t{0}; symbol < num_symbols; ++symbol)
+    {
+        if (transitions[symbol] != 0)
+            queue.push_back(transitions[symbol]);
+    }
+
+    for (auto head = size_t{0}; head < queue.size(); ++head)
+    {
+        const auto state = queue[head];
+        const auto fail_state = failure[state];
+        outputs[state] |= outputs[fail_state];
+
+        for (auto symbol = uint32_t{0}; symbol < num_symbols; ++symbol)
+        {
+            auto &next = transitions[state * num_symbols + symbol];
+            const auto fail_next = transitions[fail_state * num_symbols + symbol];
+            if (next != 0)
+            {
+                failure[next] = fail_next;
+                queue.push_back(next);
+            }
+            else
+            {
+                next = fail_next;
+            }
+        }
+    }
+}
+
+uint32_t RuleMatcherType::match(std::string_view text) const
+{
+    if (outputs.empty())
+        return 0;
+
+    // The root output holds the masks of empty patterns, which are part of every text
+    auto mask = outputs[0];
+    auto state = uint32_t{0};
+    for (const auto c : text)
+    {
+        state = transitions[state * num_symbols + symbols[static_cast<uint8_t>(c)]];
+        mask |= outputs[state];
+    }
+
+    const auto exact_it = exact_patterns.find(text);
+    if (exact_it != exact_patterns.end())
+        mask |= exact_it->second;
+
+    return mask;
+}
+
+SkillRuleMatcherType::SkillRuleMatcherType(const SkillRules &skill_rules)
+{
+    add_substrings(names, skill_rules.skills_substr_to_drop_names, SkillRuleMask::DROP_NAME);
+    add_exacts(names, skill_rules.skills_match_to_drop_names, SkillRuleMask::DROP_NAME);
+    add_substrings(names, skill_rules.skills_substr_weapon_swap_like, SkillRuleMask::WEAPON_SWAP_NAME);
+    add_exacts(names, skill_rules.skills_match_weapon_swap_like, SkillRuleMask::WEAPON_SWAP_NAME);
+    names.add_substring("Unknown Skill", SkillRuleMask::UNKNOWN_NAME);
+    add_substrings(names, skill_rules.special_substr_to_gray_out, SkillRuleMask::GRAY_OUT_NAME);
+    add_exacts(names, skill_rules.special_match_to_gray_out_names, SkillRuleMask::GRAY_OUT_NAME);
+    add_substrings(names, skill_rules.special_substr_to_remove_duplicates_names, SkillRuleMask::DUPLICATE_NAME);
+    add_substrings(names, skill_rules.easy_mode_names_drop_substr, SkillRuleMask::EASY_MODE_DROP_NAME);
+    names.build();
+
+    add_ids(ids, skill_rules.skills_match_to_drop, SkillRuleMask::DROP_ID);
+    add_ids(ids, skill_rules.special_match_to_gray_out, SkillRuleMask::GRAY_OUT_ID);
+    add_ids(ids, skill_rules.special_match_to_gray_out_manual_ids, SkillRuleMask::GRAY_OUT_ID);
+    add_ids(ids, skill_rules.special_substr_to_remove_duplicates, SkillRuleMask::DUPLICATE_ID);
+    add_ids(ids, skill_rules.easy_mode_drop_match, SkillRuleMask::EASY_MODE_DROP_ID);
+    add_ids(ids, skill_rules.easy_mode_match_to_gray_out, SkillRuleMask::EASY_MODE_GRAY_OUT_ID);
+}
+
+uint32_t SkillRuleMatcherType::get_id_mask(const SkillID skill_id) const
+{
+    const auto it = ids.find(static_cast<int32_t>(skill_id));
+    if (it == ids.end())
+        return 0;
+
+    return it->second;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SkillIDs.h"
+#include "Types.h"
+
+// Categories of SkillRules a skill matches, by name or by id
+namespace SkillRuleMask
+{
+constexpr uint32_t DROP_NAME = 1u << 0;
+constexpr uint32_t DROP_ID = 1u << 1;
+constexpr uint32_t WEAPON_SWAP_NAME = 1u << 2;
+constexpr uint32_t UNKNOWN_NAME = 1u << 3;
+constexpr uint32_t GRAY_OUT_NAME = 1u << 4;
+constexpr uint32_t GRAY_OUT_ID = 1u << 5;
+constexpr uint32_t DUPLICATE_NAME = 1u << 6;
+constexpr uint32_t DUPLICATE_ID = 1u << 7;
+constexpr uint32_t EASY_MODE_DROP_NAME = 1u << 8;
+constexpr uint32_t EASY_MODE_DROP_ID = 1u << 9;
+constexpr uint32_t EASY_MODE_GRAY_OUT_ID = 1u << 10;
+} // namespace SkillRuleMask
+
+// Matches a text against many substring and exact patterns at once. The
+// substring patterns are compiled into an Aho-Corasick automaton, so match()
+// reads each byte of the text once no matter how many patterns there are and
+// returns the OR of the masks of all patterns found.
+class RuleMatcherType
+{
+public:
+    void add_substring(std::string_view pattern, const uint32_t mask);
+    void add_exact(std::string_view pattern, const uint32_t mask);
+
+    // Compiles the substring patterns, has to run before match()
+    void build();
+
+    uint32_t match(std::string_view text) const;
+
+private:
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const
+        {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    // Bytes that occur in no pattern share symbol 0, which always leads back to the root
+    std::array<uint16_t, 256> symbols{};
+    uint32_t num_symbols = 1;
+    std::vector<uint32_t> transitions; // num_states * num_symbols
+    std::vector<uint32_t> outputs;     // Masks of all patterns ending in a state, suffixes included
+
+    std::vector<std::pair<std::string, uint32_t>> substring_patterns;
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> exact_patterns;
+};
+
+// SkillRules compiled once, names into a RuleMatcherType and ids into one mask per id
+class SkillRuleMatcherType
+{
+public:
+    explicit SkillRuleMatcherType(const SkillRules &skill_rules);
+
+    uint32_t get_name_mask(std::string_view name) const
+    {
+        return names.match(name);
+    }
+    uint32_t get_id_mask(const SkillID skill_id) const;
+
+private:
+    RuleMatcherType names;
+    std::unordered_map<int32_t, uint32_t> ids;
+};
@@ -1,12 +1,18 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "AtomicFile.h"
+#include "Logger.h"
 #include "Settings.h"
-#include "Shared.h"
 
 const char *SHOW_WINDOW = "ShowWindow";
 const char *FILTER_BUFFER = "FilterBuffer";
@@ -23,6 +29,74 @@ const char *WINDOW_SIZE_RIGHT = "WindowSizeRight";
 const char *PRECAST_SKILLS = "PrecastSkills";
 const char *UTILITY_SKILL_SLOTS = "UtilitySkillSlots";
 
+namespace
+{
+constexpr auto SAVE_DEBOUNCE = std::chrono::milliseconds(500);
+
+std::mutex WriterMutex;
+// Held from taking the pending settings until their write finished, so the
+// writer that Flush stops and the one a concurrent Save starts write in order
+std::mutex FileMutex;
+std::condition_variable WriterCondition;
+std::thread WriterThread;
+// Flush bumps the generation, a writer of an older generation writes what is
+// pending without the debounce and exits
+uint64_t WriterGeneration = 0;
+bool WriterDirty = false;
+json PendingSettings;
+std::filesystem::path PendingPath;
+std::chrono::steady_clock::time_point LastSaveRequest;
+std::atomic<size_t> NumWrites = 0;
+
+bool WriteSettingsFile(const std::filesystem::path &aPath, const std::string &aContent)
+{
+    if (!write_file_atomic(aPath, aContent))
+    {
+        log_message(LogLevel::WARNING, "Settings.json could not be written.");
+        return false;
+    }
+
+    ++NumWrites;
+    return true;
+}
+
+void WriterLoop(const uint64_t generation)
+{
+    std::unique_lock<std::mutex> lock(WriterMutex);
+    const auto is_stopped = [generation] { return WriterGeneration != generation; };
+
+    while (true)
+    {
+        WriterCondition.wait(lock, [&is_stopped] { return WriterDirty || is_stopped(); });
+        if (!WriterDirty)
+            break;
+
+        // Coalesce saves until no new request arrived within the debounce window
+        while (!is_stopped())
+        {
+            const auto deadline = LastSaveRequest + SAVE_DEBOUNCE;
+            if (WriterCondition.wait_until(lock, deadline, is_stopped))
+                break;
+            if (std::chrono::steady_clock::now() >= LastSaveRequest + SAVE_DEBOUNCE)
+                break;
+        }
+
+        std::unique_lock<std::mutex> file_lock(FileMutex);
+        if (!WriterDirty)
+            continue;
+
+        const auto settings = std::move(PendingSettings);
+        const auto path = PendingPath;
+        WriterDirty = false;
+
+        lock.unlock();
+        (void)WriteSettingsFile(path, settings.dump(1, '\t') + "\n");
+        file_lock.unlock();
+        lock.lock();
+    }
+}
+} // namespace
+
 namespace Settings
 {
 std::mutex Mutex;
@@ -43,8 +117,8 @@ void Load(std::filesystem::path aPath)
         }
         catch (json::parse_error &ex)
         {
-            Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", "Settings.json could not be parsed.");
-            Globals::APIDefs->Log(LOGL_WARNING, "GW2RotaHelper", ex.what());
+            log_message(LogLevel::WARNING, "Settings.json could not be parsed.");
+            log_message(LogLevel::WARNING, ex.what());
         }
     }
     Settings::Mutex.unlock();
@@ -55,7 +129,8 @@ void Load(std::filesystem::path aPath)
     if (!Settings[FILTER_BUFFER].is_null())
     {
         auto filter_str = Settings[FILTER_BUFFER].get<std::string>();
-        strncpy_s(FilterBuffer, sizeof(FilterBuffer), filter_str.c_str(), _TRUNCATE);
+        const auto length = filter_str.copy(FilterBuffer, sizeof(FilterBuffer) - 1);
+        FilterBuffer[length] = '\0';
     }
     if (!Settings[SHOW_WEAPON_SWAP].is_null())
         Settings[SHOW_WEAPON_SWAP].get_to<bool>(ShowWeaponSwap);
@@ -107,20 +182,48 @@ void Save(std::filesystem::path aPath)
         Settings[PRECAST_SKILLS] = PrecastSkills;
         Settings[UTILITY_SKILL_SLOTS] = UtilitySkillSlots;
 
-        std::ofstream file(aPath);
-        file << Settings.dump(1, '\t') << std::endl;
-        file.close();
+        std::lock_guard<std::mutex> writer_lock(WriterMutex);
+        PendingSettings = Settings;
+        PendingPath = aPath;
+        WriterDirty = true;
+        LastSaveRequest = std::chrono::steady_clock::now();
+
+        if (!WriterThread.joinable())
+            WriterThread = std::thread(WriterLoop, WriterGeneration);
     }
     Settings::Mutex.unlock();
 
-    Load(aPath);
+    // A writer that Flush is stopping may wait next to the current one
+    WriterCondition.notify_all();
+}
+
+void Flush()
+{
+    // The writer is taken out under the lock, a Save during the join starts a
+    // new writer of the next generation instead of relying on this one
+    auto writer = std::thread{};
+    {
+        std::lock_guard<std::mutex> lock(WriterMutex);
+        if (!WriterThread.joinable())
+            return;
+        ++WriterGeneration;
+        writer = std::move(WriterThread);
+    }
+    WriterCondition.notify_all();
+
+    writer.join();
+}
+
+size_t GetNumWrites()
+{
+    return NumWrites.load();
 }
 
 void ToggleShowWindow(std::filesystem::path SettingsPath)
 {
     ShowWindow = !ShowWindow;
     Settings[SHOW_WINDOW] = ShowWindow;
-    Save(Globals::SettingsPath);
+    Save(SettingsPath);
 }
 
 bool ShowWindow = true;
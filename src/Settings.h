@@ -10,10 +10,6 @@
 #include "nlohmann/json.hpp"
 using json = nlohmann::json;
 
-#include "mumble/Mumble.h"
-#include "nexus/Nexus.h"
-#include "rtapi/RTAPI.hpp"
-
 extern const char *SHOW_WINDOW;
 extern const char *FILTER_BUFFER;
 extern const char *SHOW_WEAPON_SWAP;
@@ -36,6 +32,9 @@ extern json Settings;
 
 void Load(std::filesystem::path aPath);
 void Save(std::filesystem::path aPath);
+void Flush();
+// Number of completed writes of the settings file, saves within the debounce window share one write
+size_t GetNumWrites();
 void ToggleShowWindow(std::filesystem::path SettingsPath);
 
 extern bool ShowWindow;
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Sha256.h"
+
+namespace
+{
+constexpr auto ROUND_CONSTANTS = std::array<uint32_t, 64>{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr auto INITIAL_STATE = std::array<uint32_t, 8>{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+constexpr auto READ_BUFFER_SIZE = size_t{64 * 1024};
+
+constexpr uint32_t rotate_right(const uint32_t value, const uint32_t bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+uint32_t read_be32(const uint8_t *data)
+{
+    return (uint32_t{data[0]} << 24) | (uint32_t{data[1]} << 16) | (uint32_t{data[2]} << 8) | uint32_t{data[3]};
+}
+} // namespace
+
+Sha256Type::Sha256Type() : state(INITIAL_STATE)
+{
+}
+
+void Sha256Type::update(const uint8_t *data, size_t size)
+{
+    total_size += size;
+
+    if (buffer_size > 0)
+    {
+        const auto num_bytes = std::min(size, buffer.size() - buffer_size);
+        std::memcpy(buffer.data() + buffer_size, data, num_bytes);
+        buffer_size += num_bytes;
+        data += num_bytes;
+        size -= num_bytes;
+
+        if (buffer_size < buffer.size())
+            return;
+
+        process_block(buffer.data());
+        buffer_size = 0;
+    }
+
+    for (; size >= buffer.size(); data += buffer.size(), size -= buffer.size())
+        process_block(data);
+
+    std::memcpy(buffer.data(), data, size);
+    buffer_size = size;
+}
+
+Sha256Digest Sha256Type::finalize()
+{
+    const auto bit_size = total_size * 8;
+
+    const auto padding = std::array<uint8_t, 64>{0x80};
+    const auto padding_size = buffer_size < 56 ? 56 - buffer_size : 120 - buffer_size;
+    update(padding.data(), padding_size);
+
+    auto length = std::array<uint8_t, 8>{};
+    for (auto idx = size_t{0}; idx < length.size(); ++idx)
+        length[idx] = static_cast<uint8_t>(bit_size >> (56 - 8 * idx));
+    update(length.data(), length.size());
+
+    auto digest = Sha256Digest{};
+    for (auto idx = size_t{0}; idx < state.size(); ++idx)
+    {
+        digest[idx * 4 + 0] = static_cast<uint8_t>(state[idx] >> 24);
+        digest[idx * 4 + 1] = static_cast<uint8_t>(state[idx] >> 16);
+        digest[idx * 4 + 2] = static_cast<uint8_t>(state[idx] >> 8);
+        digest[idx * 4 + 3] = static_cast<uint8_t>(state[idx]);
+    }
+
+    return digest;
+}
+
+void Sha256Type::process_block(const uint8_t *block)
+{
+    auto words = std::array<uint32_t, 64>{};
+    for (auto idx = size_t{0}; idx < 16; ++idx)
+        words[idx] = read_be32(block + idx * 4);
+
+    for (auto idx = size_t{16}; idx < words.size(); ++idx)
+    {
+        const auto s0 = rotate_right(words[idx - 15], 7) ^ rotate_right(words[idx - 15], 18) ^ (words[idx - 15] >> 3);
+        const auto s1 = rotate_right(words[idx - 2], 17) ^ rotate_right(words[idx - 2], 19) ^ (words[idx - 2] >> 10);
+        words[idx] = words[idx - 16] + s0 + words[idx - 7] + s1;
+    }
+
+    auto [a, b, c, d, e, f, g, h] = state;
+    for (auto idx = size_t{0}; idx < words.size(); ++idx)
+    {
+        const auto s1 = rotate_right(e, 6) ^ rotate_right(e, 11) ^ rotate_right(e, 25);
+        const auto choice = (e & f) ^ (~e & g);
+        const auto temp1 = h + s1 + choice + ROUND_CONSTANTS[idx] + words[idx];
+        const auto s0 = rotate_right(a, 2) ^ rotate_right(a, 13) ^ rotate_right(a, 22);
+        const auto majority = (a & b) ^ (a & c) ^ (b & c);
+        const auto temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+std::string sha256_to_hex(const Sha256Digest &digest)
+{
+    constexpr auto HEX_DIGITS = "0123456789abcdef";
+
+    auto hex = std::string{};
+    hex.reserve(digest.size() * 2);
+    for (const auto byte : digest)
+    {
+        hex.push_back(HEX_DIGITS[byte >> 4]);
+        hex.push_back(HEX_DIGITS[byte & 0x0F]);
+    }
+
+    return hex;
+}
+
+std::string hash_file_sha256(const std::filesystem::path &path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    if (!file.is_open())
+        return {};
+
+    auto sha256 = Sha256Type{};
+    auto buffer = std::vector<char>(READ_BUFFER_SIZE);
+    while (file)
+    {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto num_read = static_cast<size_t>(file.gcount());
+        sha256.update(reinterpret_cast<const uint8_t *>(buffer.data()), num_read);
+    }
+
+    if (file.bad())
+        return {};
+
+    return sha256_to_hex(sha256.finalize());
+}
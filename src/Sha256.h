@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+using Sha256Digest = std::array<uint8_t, 32>;
+
+// Incremental SHA-256 (FIPS 180-4)
+class Sha256Type
+{
+public:
+    Sha256Type();
+
+    void update(const uint8_t *data, size_t size);
+    Sha256Digest finalize();
+
+private:
+    void process_block(const uint8_t *block);
+
+    std::array<uint32_t, 8> state;
+    std::array<uint8_t, 64> buffer{};
+    size_t buffer_size = 0;
+    uint64_t total_size = 0;
+};
+
+std::string sha256_to_hex(const Sha256Digest &digest);
+
+// Lowercase hex digest of the file content, empty if it could not be read
+std::string hash_file_sha256(const std::filesystem::path &path);
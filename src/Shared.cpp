@@ -1,5 +1,8 @@
 #include <array>
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <string>
 
 #include "arcdps/ArcDPS.h"
@@ -10,7 +13,6 @@
 #include "Render.h"
 #include "Shared.h"
 #include "Types.h"
-#include "Version.h"
 
 namespace Globals
 {
@@ -22,30 +24,22 @@ std::string AccountName;
 ArcDPS::Exports ArcExports = {};
 
 std::filesystem::path Logpath;
-RotationLogType RotationRun{};
-TextureMapType Globals::TextureMap{};
-std::filesystem::path Globals::SettingsPath;
-float SkillIconSize = 28.0F;
-std::string VersionString = std::string{VERSION_STRING};
-std::string BenchFilesLowerVersionString = std::string{LOWER_VERSION_RANGE};
-std::string BenchFilesUpperVersionString = std::string{UPPER_VERSION_RANGE};
-
-RenderDataType RenderData{};
+TextureMapType TextureMap{};
+
 RenderType Render{};
-OptionsRenderType OptionsRender{};
-RotationRenderType RotationRender{};
+AddonHostType AddonHost{};
 
-DownloadState BenchDataDownloadState = DownloadState::NOT_STARTED;
-bool ExtractedBenchData = false;
+std::unique_ptr<DownloadServiceType> DownloadService = nullptr;
+IconArchiveType IconArchive{};
+std::future<bool> IconArchiveBuild{};
+std::atomic<bool> CancelIconArchiveBuild = false;
+SkillAtlasType IconAtlas{};
+SkillIconSamplerType IconSampler{};
+std::unique_ptr<TextureLoaderType> TextureLoader = nullptr;
+std::unique_ptr<SkillIconCacheType> IconCache = nullptr;
 
 Mumble::Identity Identity = {};
 
-bool IsSameCast = false;
 std::map<SkillID, std::chrono::steady_clock::time_point> SkillLastTimeCast = {};
-std::string LastArcEventSkillName = "";
-
-std::vector<uint32_t> CurrentlyPressedKeys = {};
 
-SkillID LastKeyPressSkillID = SkillID{0};
-std::chrono::steady_clock::time_point LastKeyPressSkillTime = std::chrono::steady_clock::now();
 }; // namespace Globals
@@ -2,7 +2,10 @@
 #define SHARED_H
 
 #include <array>
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <string>
 
 #include "arcdps/ArcDPS.h"
@@ -10,10 +13,13 @@
 #include "nexus/Nexus.h"
 #include "rtapi/RTAPI.hpp"
 
+#include "AddonHost.h"
+#include "Downloader.h"
+#include "IconArchive.h"
 #include "Render.h"
-#include "OptionsRender.h"
-#include "RotationRender.h"
+#include "TextureLoader.h"
 #include "Types.h"
+#include "UiShared.h"
 
 namespace Globals
 {
@@ -25,32 +31,24 @@ extern Mumble::Data *MumbleData;
 extern ArcDPS::Exports ArcExports;
 
 extern std::filesystem::path Logpath;
-extern RotationLogType RotationRun;
 extern TextureMapType TextureMap;
-extern std::filesystem::path SettingsPath;
-extern float SkillIconSize;
-extern std::string VersionString;
-extern std::string BenchFilesLowerVersionString;
-extern std::string BenchFilesUpperVersionString;
 
-extern RenderDataType RenderData;
 extern RenderType Render;
-extern OptionsRenderType OptionsRender;
-extern RotationRenderType RotationRender;
+extern AddonHostType AddonHost;
 
-extern DownloadState BenchDataDownloadState;
-extern bool ExtractedBenchData;
+extern std::unique_ptr<DownloadServiceType> DownloadService;
+extern IconArchiveType IconArchive;
+extern std::future<bool> IconArchiveBuild;
+extern std::atomic<bool> CancelIconArchiveBuild;
+extern SkillAtlasType IconAtlas;
+extern SkillIconSamplerType IconSampler;
+extern std::unique_ptr<TextureLoaderType> TextureLoader;
+extern std::unique_ptr<SkillIconCacheType> IconCache;
 
 extern Mumble::Identity Identity;
 
-extern bool IsSameCast;
 extern std::map<SkillID, std::chrono::steady_clock::time_point> SkillLastTimeCast;
-extern std::string LastArcEventSkillName;
 
-extern std::vector<uint32_t> CurrentlyPressedKeys;
-
-extern SkillID LastKeyPressSkillID;
-extern std::chrono::steady_clock::time_point LastKeyPressSkillTime;
 }; // namespace Globals
 
 #endif
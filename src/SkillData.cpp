@@ -1,17 +1,15 @@
-#include <map>
-#include <set>
 #include <string>
 #include <string_view>
 
-#include "FileUtils.h"
-#include "MumbleUtils.h"
+#include "Frozen.h"
+#include "RuleMatcher.h"
 #include "SkillData.h"
 #include "Types.h"
 
 namespace SkillRuleData
 {
 
-const std::set<std::string_view> skills_match_weapon_swap_like = {
+constexpr auto skills_match_weapon_swap_like = make_frozen_keys<std::string_view>({
     "Weapon Swap",
     // GUARDIAN
     "Radiant Forge",
@@ -54,9 +52,9 @@ const std::set<std::string_view> skills_match_weapon_swap_like = {
     "Legendary Centaur Stance",
     "Legendary Assassin Stance",
     "Legendary Dragon Stance",
-};
+});
 
-const std::set<std::string_view> skills_substr_weapon_swap_like = {
+constexpr auto skills_substr_weapon_swap_like = make_frozen_keys<std::string_view>({
     // GUARDIAN
     // WARRIOR
     "Berserk",
@@ -72,10 +70,10 @@ const std::set<std::string_view> skills_substr_weapon_swap_like = {
     // MESMER
     // NECROMANCER
     // REVENANT
-};
+});
 
 /* In Genreal Traits/Effects that are in the log */
-const std::set<std::string_view> skills_substr_to_drop_names = {
+constexpr auto skills_substr_to_drop_names = make_frozen_keys<std::string_view>({
     "Bloodstone Fervor",
     "Relic of",
     "Nourys's Hunger",
@@ -95,10 +93,10 @@ const std::set<std::string_view> skills_substr_to_drop_names = {
     // NECROMANCER
     // REVENANT
     "Form of the ",
-};
+});
 
 /* In Genreal Traits/Effects that are in the log */
-const std::set<std::string_view> skills_match_to_drop_names = {
+constexpr auto skills_match_to_drop_names = make_frozen_keys<std::string_view>({
     "Doom",
     // GUARDIAN
     // WARRIOR
@@ -134,9 +132,9 @@ const std::set<std::string_view> skills_match_to_drop_names = {
     // REVENANT
     "Invoke Torment",
     "Mistfire",
-};
+});
 
-const std::set<ManualSkillID> skills_match_to_drop = {
+constexpr auto skills_match_to_drop = make_frozen_keys<ManualSkillID>({
     // NECROMANCER
     ManualSkillID::APPORACHING_DOOM,
     ManualSkillID::CHILLING_NOVA,
@@ -149,9 +147,9 @@ const std::set<ManualSkillID> skills_match_to_drop = {
     // ELEMENTALIST
     ManualSkillID::SUNSPOT,
     ManualSkillID::FLAME_EXPLOSION,
-};
+});
 
-const std::set<std::string_view> special_substr_to_gray_out = {
+constexpr auto special_substr_to_gray_out = make_frozen_keys<std::string_view>({
     // GUARDIAN
     "Chapter ",
     "Tome of ", // 10 different tomes
@@ -175,13 +173,13 @@ const std::set<std::string_view> special_substr_to_gray_out = {
     // NECROMANCER
     // REVENANT
     "True Nature",
-};
+});
 
-const std::set<std::string_view> special_match_to_gray_out_names = {
+constexpr auto special_match_to_gray_out_names = make_frozen_keys<std::string_view>({
     "Dodge",
-};
+});
 
-const std::set<ManualSkillID> special_match_to_gray_out_manual_ids = {
+constexpr auto special_match_to_gray_out_manual_ids = make_frozen_keys<ManualSkillID>({
     // WARRIOR
     ManualSkillID::CYCLONE_TRIGGER,
     ManualSkillID::STEEL_DIVIDE,
@@ -192,16 +190,15 @@ const std::set<ManualSkillID> special_match_to_gray_out_manual_ids = {
     ManualSkillID::CALCIFY,
     ManualSkillID::SPLASH,
     ManualSkillID::ZAP,
-};
+});
 
-const std::set<SkillID> special_match_to_gray_out = {
+constexpr auto special_match_to_gray_out = make_frozen_keys<SkillID>({
     // GUARDIAN
     SkillID::ZEALOT_S_FLAME,
     SkillID::RUSHING_JUSTICE,
     SkillID::SYMBOL_OF_PUNISHMENT,
     SkillID::FLOWING_RESOLVE,
     SkillID::JURISDICTION,
-    SkillID::ZEALOT_S_FLAME,
     SkillID::ZEALOT_S_FLAME_1,
     SkillID::SYMBOL_OF_RESOLUTION,
     SkillID::SWORD_OF_JUSTICE,
@@ -257,8 +254,6 @@ const std::set<SkillID> special_match_to_gray_out = {
     SkillID::NAPALM,
     SkillID::GLUE_SHOT,
     SkillID::ACID_BOMB,
-    SkillID::FLAME_BLAST,
-    SkillID::AIR_BLAST,
     SkillID::EVOLVE,
     SkillID::EVOLVE_1,
     SkillID::ROCKET_PUNCH,
@@ -298,10 +293,8 @@ const std::set<SkillID> special_match_to_gray_out = {
     SkillID::SHARPEN_SPINES,
     SkillID::VULTURE_STANCE,
     SkillID::QUARRY_S_PERIL,
-    SkillID::PERFECT_STORM,
     SkillID::ENVELOPING_HAZE,
     SkillID::VENOMOUS_OUTBURST,
-    SkillID::SIC_EM,
     SkillID::BUMBLE,
     SkillID::RAIN_OF_SPIKES,
     SkillID::VIPER_S_NEST,
@@ -385,8 +378,6 @@ const std::set<SkillID> special_match_to_gray_out = {
     SkillID::INNERVATE_WANDERLUST_1,
     SkillID::PLAGUE_SIGNET,
     SkillID::PLAGUELANDS,
-    SkillID::ELIXIR_OF_PROMISE,
-    SkillID::ELIXIR_OF_PROMISE_1,
     SkillID::GARISH_PILLAR,
     SkillID::HAUNT,
     SkillID::NEFARIOUS_FAVOR,
@@ -425,104 +416,91 @@ const std::set<SkillID> special_match_to_gray_out = {
     SkillID::RELEASE_POTENTIAL_MESMER,
     SkillID::TWIN_MOON_SWEEP,
     SkillID::TWIN_MOON_SWEEP_1,
-};
+});
 
-const std::map<std::string_view, std::set<SkillID>> class_map_special_match_to_gray_out = {
-    {
-        "power_tempest_sword_dagger_v4",
-        {
-            SkillID::RIDE_THE_LIGHTNING,
-        },
-    },
-    {
-        "condition_weaver_scepter_warhorn_v4",
-        {
-            SkillID::SIGNET_OF_EARTH,
-            SkillID::SIGNET_OF_FIRE,
-            SkillID::PRIMORDIAL_STANCE,
-        },
-    },
-    {
-        "power_weaver_sword_dagger_v4",
-        {
-            SkillID::RIDE_THE_LIGHTNING,
-        },
-    },
-    {
-        "power_luminary_spear_greatsword_v4",
-        {
-            SkillID::EFFULGENT_STANCE,
-            SkillID::DARING_ADVANCE,
-            SkillID::DARING_ADVANCE_1,
-        },
-    },
-    {
-        "power_virtuoso_spear_greatsword_v4",
-        {SkillID::SPATIAL_SURGE},
-    },
-    {
-        "power_virtuoso_greatsword_dagger_sword_v4",
-        {SkillID::SPATIAL_SURGE},
-    },
-    {
-        "power_conduit_greatsword_sword_sword",
-        {
-            SkillID::TWIN_MOON_SWEEP,
-            SkillID::TWIN_MOON_SWEEP_1,
-        },
-    },
-};
+constexpr auto tempest_sword_dagger_gray_out = make_frozen_keys<SkillID>({
+    SkillID::RIDE_THE_LIGHTNING,
+});
 
-const std::map<std::string_view, std::set<SkillID>> class_map_easy_mode_match_to_gray_out = {
-    {
-        "condition_weaver_scepter_warhorn_v4",
-        {
-            SkillID::SIGNET_OF_EARTH,
-            SkillID::SIGNET_OF_FIRE,
-        },
-    },
-    {
-        "power_weaver_sword_dagger_v4",
-        {
-            SkillID::ARCANE_BLAST,
-        },
-    },
-    {
-        "power_scrapper_hammer_v4",
-        {
-            SkillID::POSITIVE_STRIKE,
-            SkillID::NEGATIVE_BASH,
-            SkillID::EQUALIZING_BLOW,
-        },
-    },
-};
+constexpr auto weaver_scepter_warhorn_gray_out = make_frozen_keys<SkillID>({
+    SkillID::SIGNET_OF_EARTH,
+    SkillID::SIGNET_OF_FIRE,
+    SkillID::PRIMORDIAL_STANCE,
+});
 
-const std::map<std::string_view, std::set<SkillID>> class_map_easy_mode_drop_match = {
-    {
-        "condition_weaver_scepter_warhorn_v4",
-        {
-            SkillID::FLAMESTRIKE,
-        },
-    },
-    {
-        "condition_mechanist_one_kit_spear_v4",
-        {
-            SkillID::ROLLING_SMASH,
-            SkillID::DISCHARGE_ARRAY,
-            SkillID::SKY_CIRCUS,
-            SkillID::JADE_MORTAR,
-        },
-    },
-    {
-        "power_ritualist_greatsword_spear_v4",
-        {
-            SkillID::WANDERLUST_1,
-            SkillID::SUMMON_SPIRITS_1,
-        },
-    },
-};
+constexpr auto weaver_sword_dagger_gray_out = make_frozen_keys<SkillID>({
+    SkillID::RIDE_THE_LIGHTNING,
+});
+
+constexpr auto luminary_spear_greatsword_gray_out = make_frozen_keys<SkillID>({
+    SkillID::EFFULGENT_STANCE,
+    SkillID::DARING_ADVANCE,
+    SkillID::DARING_ADVANCE_1,
+});
+
+constexpr auto virtuoso_gray_out = make_frozen_keys<SkillID>({
+    SkillID::SPATIAL_SURGE,
+});
+
+constexpr auto conduit_greatsword_sword_sword_gray_out = make_frozen_keys<SkillID>({
+    SkillID::TWIN_MOON_SWEEP,
+    SkillID::TWIN_MOON_SWEEP_1,
+});
+
+constexpr auto class_map_special_match_to_gray_out = make_frozen_entries<std::string_view, FrozenSet<SkillID>>({
+    {"power_tempest_sword_dagger_v4", tempest_sword_dagger_gray_out},
+    {"condition_weaver_scepter_warhorn_v4", weaver_scepter_warhorn_gray_out},
+    {"power_weaver_sword_dagger_v4", weaver_sword_dagger_gray_out},
+    {"power_luminary_spear_greatsword_v4", luminary_spear_greatsword_gray_out},
+    {"power_virtuoso_spear_greatsword_v4", virtuoso_gray_out},
+    {"power_virtuoso_greatsword_dagger_sword_v4", virtuoso_gray_out},
+    {"power_conduit_greatsword_sword_sword", conduit_greatsword_sword_sword_gray_out},
+});
+
+constexpr auto weaver_scepter_warhorn_easy_mode_gray_out = make_frozen_keys<SkillID>({
+    SkillID::SIGNET_OF_EARTH,
+    SkillID::SIGNET_OF_FIRE,
+});
+
+constexpr auto weaver_sword_dagger_easy_mode_gray_out = make_frozen_keys<SkillID>({
+    SkillID::ARCANE_BLAST,
+});
+
+constexpr auto scrapper_hammer_easy_mode_gray_out = make_frozen_keys<SkillID>({
+    SkillID::POSITIVE_STRIKE,
+    SkillID::NEGATIVE_BASH,
+    SkillID::EQUALIZING_BLOW,
+});
+
+constexpr auto class_map_easy_mode_match_to_gray_out = make_frozen_entries<std::string_view, FrozenSet<SkillID>>({
+    {"condition_weaver_scepter_warhorn_v4", weaver_scepter_warhorn_easy_mode_gray_out},
+    {"power_weaver_sword_dagger_v4", weaver_sword_dagger_easy_mode_gray_out},
+    {"power_scrapper_hammer_v4", scrapper_hammer_easy_mode_gray_out},
+});
+
+constexpr auto weaver_scepter_warhorn_easy_mode_drop = make_frozen_keys<SkillID>({
+    SkillID::FLAMESTRIKE,
+});
+
+constexpr auto mechanist_one_kit_spear_easy_mode_drop = make_frozen_keys<SkillID>({
+    SkillID::ROLLING_SMASH,
+    SkillID::DISCHARGE_ARRAY,
+    SkillID::SKY_CIRCUS,
+    SkillID::JADE_MORTAR,
+});
+
+constexpr auto ritualist_greatsword_spear_easy_mode_drop = make_frozen_keys<SkillID>({
+    SkillID::WANDERLUST_1,
+    SkillID::SUMMON_SPIRITS_1,
+});
 
-const std::set<SkillID> easy_mode_match_to_gray_out = {
+constexpr auto class_map_easy_mode_drop_match = make_frozen_entries<std::string_view, FrozenSet<SkillID>>({
+    {"condition_weaver_scepter_warhorn_v4", weaver_scepter_warhorn_easy_mode_drop},
+    {"condition_mechanist_one_kit_spear_v4", mechanist_one_kit_spear_easy_mode_drop},
+    {"power_ritualist_greatsword_spear_v4", ritualist_greatsword_spear_easy_mode_drop},
+});
+
+constexpr auto easy_mode_match_to_gray_out = make_frozen_keys<SkillID>({
     // MESMER
     SkillID::SPATIAL_SURGE,
     // ELEMENTALIST
@@ -551,9 +529,9 @@ const std::set<SkillID> easy_mode_match_to_gray_out = {
     SkillID::BIG_OL_BOMB,
     SkillID::SMOKE_BOMB,
     SkillID::MAGNETIC_BOMB,
-};
+});
 
-const std::set<SkillID> easy_mode_drop_match = {
+constexpr auto easy_mode_drop_match = make_frozen_keys<SkillID>({
     // REVENANT1
     SkillID::ABYSSAL_STRIKE,
     SkillID::ABYSSAL_FIRE,
@@ -571,18 +549,18 @@ const std::set<SkillID> easy_mode_drop_match = {
     SkillID::CRISIS_ZONE,
     SkillID::BARRIER_BURST,
     SkillID::DISCHARGE_ARRAY,
-};
+});
 
-const std::set<std::string_view> easy_mode_names_drop_substr = {
+constexpr auto easy_mode_names_drop_substr = make_frozen_keys<std::string_view>({
     "Offensive Protocol: ",
     "Defensive Protocol: ",
-};
+});
 
-const std::set<std::string_view> special_substr_to_remove_duplicates_names = {
+constexpr auto special_substr_to_remove_duplicates_names = make_frozen_keys<std::string_view>({
     "Offensive Protocol: Demolish",
-};
+});
 
-const std::set<SkillID> special_substr_to_remove_duplicates = {
+constexpr auto special_substr_to_remove_duplicates = make_frozen_keys<SkillID>({
     // REVENANT
     SkillID::LEGENDARY_ALLIANCE,
     SkillID::LEGENDARY_ALLIANCE_STANCE,
@@ -615,9 +593,9 @@ const std::set<SkillID> special_substr_to_remove_duplicates = {
     SkillID::TWILIGHT_COMBO,
     SkillID::DEATH_BLOSSOM,
     SkillID::BEGUILING_HAZE,
-};
+});
 
-const SkillRules skill_rules = SkillRules{
+constexpr SkillRules skill_rules = SkillRules{
     .skills_substr_weapon_swap_like = skills_substr_weapon_swap_like,
     .skills_match_weapon_swap_like = skills_match_weapon_swap_like,
     .skills_substr_to_drop_names = skills_substr_to_drop_names,
@@ -637,18 +615,24 @@ const SkillRules skill_rules = SkillRules{
     .class_map_easy_mode_drop_match = class_map_easy_mode_drop_match,
 };
 
-const std::set<SkillID> skills_to_not_track = {
+const SkillRuleMatcherType skill_rule_matcher = SkillRuleMatcherType{skill_rules};
+
+constexpr auto skills_to_not_track_keys = make_frozen_keys<SkillID>({
     SkillID::RIFLE_BURST_GRENADE,
-};
+});
 
-const std::map<SkillID, SkillID> special_mapping_skills = {
+constexpr FrozenSet<SkillID> skills_to_not_track = skills_to_not_track_keys;
+
+constexpr auto special_mapping_skills_entries = make_frozen_entries<SkillID, SkillID>({
     {SkillID::DEVASTATOR, SkillID::FOCUSED_DEVASTATION},
     {SkillID::FOCUSED_DEVASTATION, SkillID::DEVASTATOR},
     {SkillID::LIGHTNING_ROD, SkillID::ELECTRIC_ARTILLERY},
     {SkillID::ELECTRIC_ARTILLERY, SkillID::LIGHTNING_ROD},
-};
+});
 
-const std::set<SkillID> berserker_f1_skills = {
+constexpr FrozenMap<SkillID, SkillID> special_mapping_skills = special_mapping_skills_entries;
+
+constexpr auto berserker_f1_skills_keys = make_frozen_keys<SkillID>({
     SkillID::EVISCERATE,
     SkillID::EARTHSHAKER,
     SkillID::ARC_DIVIDER,
@@ -657,9 +641,11 @@ const std::set<SkillID> berserker_f1_skills = {
     SkillID::RUPTURING_SMASH,
     SkillID::WILD_THROW,
     SkillID::SCORCHED_EARTH,
-};
+});
 
-const std::set<SkillID> mesmer_weapon_4_skills = {
+constexpr FrozenSet<SkillID> berserker_f1_skills = berserker_f1_skills_keys;
+
+constexpr auto mesmer_weapon_4_skills_keys = make_frozen_keys<SkillID>({
     SkillID::PHANTASMAL_DUELIST,
     SkillID::TEMPORAL_CURTAIN,
     SkillID::PHANTASMAL_BERSERKER,
@@ -674,9 +660,11 @@ const std::set<SkillID> mesmer_weapon_4_skills = {
     SkillID::ECHO_OF_MEMORY,
     SkillID::PHANTASMAL_SHARPSHOOTER,
     SkillID::PHANTASMAL_LANCER,
-};
+});
 
-const std::set<SkillID> reset_like_skill = {
+constexpr FrozenSet<SkillID> mesmer_weapon_4_skills = mesmer_weapon_4_skills_keys;
+
+constexpr auto reset_like_skill_keys = make_frozen_keys<SkillID>({
     // WARRRIOR
     SkillID::CRUSHING_BLOW,
     // ENGINEER
@@ -689,9 +677,11 @@ const std::set<SkillID> reset_like_skill = {
     SkillID::OVERLOAD_FIRE,
     SkillID::OVERLOAD_WATER,
     SkillID::OVERLOAD_EARTH,
-};
+});
 
-const std::map<SkillID, float> skill_cast_time_map = {
+constexpr FrozenSet<SkillID> reset_like_skill = reset_like_skill_keys;
+
+constexpr auto skill_cast_time_map_entries = make_frozen_entries<SkillID, float>({
     {SkillID::ESSENCE_BLAST, 0.75f},    // rit shroud aa
     {SkillID::ISOLATE, 0.25f},          //
     {SkillID::PERFORATE, 1.0f},         //
@@ -729,9 +719,11 @@ const std::map<SkillID, float> skill_cast_time_map = {
     {SkillID::ORB_OF_WRATH, 0.5f},      // gaurd scepter 1
     {SkillID::POLARIC_SLASH, 0.5f},     //
     {SkillID::FIRE_SWIPE, 0.5f},        //
-};
+});
 
-const std::map<SkillID, float> grey_skill_cast_time_map = {
+constexpr FrozenMap<SkillID, float> skill_cast_time_map = skill_cast_time_map_entries;
+
+constexpr auto grey_skill_cast_time_map_entries = make_frozen_entries<SkillID, float>({
     // GUARDIAN
     {SkillID::RUSHING_JUSTICE, 0.5f},
     {SkillID::SYMBOL_OF_PUNISHMENT, 0.25f},
@@ -752,20 +744,26 @@ const std::map<SkillID, float> grey_skill_cast_time_map = {
     {SkillID::AERIAL_AGILITY, 0.5f},
     {SkillID::AERIAL_AGILITY_1, 0.5f},
     {SkillID::AERIAL_AGILITY_2, 0.5f},
-};
+});
 
-const std::map<int, int> unk_skill_id_fix = {
+constexpr FrozenMap<SkillID, float> grey_skill_cast_time_map = grey_skill_cast_time_map_entries;
+
+constexpr auto unk_skill_id_fix_entries = make_frozen_entries<int, int>({
     {1, 73055},     // daybreaking slash
     {72923, 73055}, // daybreaking slash
     {7, 62668},     // rushing justice
-};
+});
 
-const std::map<int, int> unk_skill_id_based_on_icon_id_fix = {
+constexpr FrozenMap<int, int> unk_skill_id_fix = unk_skill_id_fix_entries;
+
+constexpr auto unk_skill_id_based_on_icon_id_fix_entries = make_frozen_entries<int, int>({
     {3680120, 77370}, // Zap
-};
+});
+
+constexpr FrozenMap<int, int> unk_skill_id_based_on_icon_id_fix = unk_skill_id_based_on_icon_id_fix_entries;
 
 // TODO: Check if can be moved to skill_data_unk_map
-const std::map<int, int> fix_skill_img_ids = {
+constexpr auto fix_skill_img_ids_entries = make_frozen_entries<int, int>({
     {3332122, 3379164}, // Isolate
     {3332077, 3379162}, // Perforate
     {3332117, 3379165}, // Distress
@@ -773,7 +771,9 @@ const std::map<int, int> fix_skill_img_ids = {
     {1, 3379124},       // daybreaking slash
     {7, 2479367},       // rushing justice
     {103641, 1012878},  // procession of blades
-};
+});
+
+constexpr FrozenMap<int, int> fix_skill_img_ids = fix_skill_img_ids_entries;
 
 SkillData GetDataByID(const SkillID skill_id, const SkillDataMap &skill_data_map)
 {
@@ -785,17 +785,14 @@ SkillData GetDataByID(const SkillID skill_id, const SkillDataMap &skill_data_map
     return {};
 }
 
-bool IsProfessionResetLikeSKill(const SkillID skill_id)
+bool IsProfessionResetLikeSKill(const SkillID skill_id, const ProfessionID profession_id)
 {
-    auto current_profession = get_current_profession_name();
-    auto profession_lower = to_lowercase(current_profession);
-
     auto is_mesmer_weapon_4 = false;
     auto is_berserker_f1 = false;
-    if (profession_lower == "mesmer")
+    if (profession_id == ProfessionID::MESMER)
         is_mesmer_weapon_4 =
             SkillRuleData::mesmer_weapon_4_skills.find(skill_id) != SkillRuleData::mesmer_weapon_4_skills.end();
-    else if (profession_lower == "warrior")
+    else if (profession_id == ProfessionID::WARRIOR)
         is_berserker_f1 = SkillRuleData::berserker_f1_skills.find(skill_id) != SkillRuleData::berserker_f1_skills.end();
 
     return is_mesmer_weapon_4 || is_berserker_f1;
@@ -1,39 +1,41 @@
 #pragma once
 
-#include <map>
-#include <set>
 #include <string>
 #include <string_view>
 
+#include "Frozen.h"
+#include "RuleMatcher.h"
 #include "Types.h"
 
 namespace SkillRuleData
 {
 
-extern const std::set<SkillID> skills_to_not_track;
+extern const FrozenSet<SkillID> skills_to_not_track;
 
-extern const std::map<SkillID, SkillID> special_mapping_skills;
+extern const FrozenMap<SkillID, SkillID> special_mapping_skills;
 
-extern const std::set<SkillID> berserker_f1_skills;
+extern const FrozenSet<SkillID> berserker_f1_skills;
 
-extern const std::set<SkillID> mesmer_weapon_4_skills;
+extern const FrozenSet<SkillID> mesmer_weapon_4_skills;
 
-extern const std::set<SkillID> reset_like_skill;
+extern const FrozenSet<SkillID> reset_like_skill;
 
-extern const std::map<SkillID, float> skill_cast_time_map;
+extern const FrozenMap<SkillID, float> skill_cast_time_map;
 
-extern const std::map<SkillID, float> grey_skill_cast_time_map;
+extern const FrozenMap<SkillID, float> grey_skill_cast_time_map;
 
 extern const SkillRules skill_rules;
 
-extern const std::map<int, int> unk_skill_id_fix;
+extern const SkillRuleMatcherType skill_rule_matcher;
 
-extern const std::map<int, int> unk_skill_id_based_on_icon_id_fix;
+extern const FrozenMap<int, int> unk_skill_id_fix;
 
-extern const std::map<int, int> fix_skill_img_ids;
+extern const FrozenMap<int, int> unk_skill_id_based_on_icon_id_fix;
+
+extern const FrozenMap<int, int> fix_skill_img_ids;
 
 SkillData GetDataByID(const SkillID skill_id, const SkillDataMap &skill_data_map);
 
-bool IsProfessionResetLikeSKill(const SkillID skill_id);
+bool IsProfessionResetLikeSKill(const SkillID skill_id, const ProfessionID profession_id);
 
 } // namespace SkillRuleData
@@ -0,0 +1,47 @@
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include "StringInterner.h"
+
+const StringInternerType::Entry *StringInternerType::intern(std::string_view str)
+{
+    if (str.empty())
+        return nullptr;
+
+    {
+        const auto lock = std::shared_lock{mutex};
+        const auto it = entries.find(str);
+        if (it != entries.end())
+            return &*it;
+    }
+
+    const auto lock = std::unique_lock{mutex};
+    const auto id = static_cast<uint32_t>(entries.size() + 1);
+    const auto [it, _] = entries.try_emplace(std::string{str}, id);
+
+    return &*it;
+}
+
+size_t StringInternerType::size() const
+{
+    const auto lock = std::shared_lock{mutex};
+
+    return entries.size();
+}
+
+StringInternerType &get_string_interner()
+{
+    static auto interner = StringInternerType{};
+
+    return interner;
+}
+
+const std::string &InternedString::str() const
+{
+    static const auto empty_str = std::string{};
+
+    return entry ? entry->first : empty_str;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+// Stores every distinct string once for the lifetime of the process. Entries
+// are never moved or freed, so the handles given out stay valid and two
+// strings are equal exactly when they share an entry. Lookups of known strings
+// only take a shared lock, the combat event thread interns concurrently.
+class StringInternerType
+{
+public:
+    using Entry = std::pair<const std::string, uint32_t>;
+
+    // nullptr for the empty string, which needs no entry
+    const Entry *intern(std::string_view str);
+    size_t size() const;
+
+private:
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const
+        {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>> entries;
+};
+
+StringInternerType &get_string_interner();
+
+// Handle to a string in the process-wide interner. Copies and comparisons are
+// a pointer copy and a pointer compare, the text stays available for the UI.
+class InternedString
+{
+public:
+    InternedString() = default;
+    InternedString(std::string_view str) : entry(get_string_interner().intern(str))
+    {
+    }
+    InternedString(const std::string &str) : InternedString(std::string_view{str})
+    {
+    }
+    InternedString(const char *str) : InternedString(std::string_view{str})
+    {
+    }
+
+    // 0 for the empty string, otherwise unique per distinct text
+    uint32_t id() const
+    {
+        return entry ? entry->second : 0;
+    }
+    bool empty() const
+    {
+        return entry == nullptr;
+    }
+
+    const std::string &str() const;
+    std::string_view view() const
+    {
+        return str();
+    }
+    const char *c_str() const
+    {
+        return str().c_str();
+    }
+
+    friend bool operator==(const InternedString &lhs, const InternedString &rhs) = default;
+    friend std::strong_ordering operator<=>(const InternedString &lhs, const InternedString &rhs)
+    {
+        return lhs.id() <=> rhs.id();
+    }
+
+private:
+    const StringInternerType::Entry *entry = nullptr;
+};
@@ -0,0 +1,349 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ImageResample.h"
+#include "Profiler.h"
+#include "TextureLoader.h"
+
+namespace
+{
+// Half-open index range [begin, end) of a batch, packed into one word so that
+// pops of the owner and steals of other workers are a single CAS each
+struct alignas(64) BatchSlice
+{
+    std::atomic<uint64_t> range = 0;
+};
+
+uint64_t pack_range(const uint32_t begin, const uint32_t end)
+{
+    return (uint64_t{end} << 32) | begin;
+}
+
+uint32_t get_range_size(const uint64_t range)
+{
+    const auto begin = static_cast<uint32_t>(range);
+    const auto end = static_cast<uint32_t>(range >> 32);
+    return end > begin ? end - begin : 0;
+}
+
+bool pop_front(BatchSlice &slice, uint32_t &index)
+{
+    auto range = slice.range.load();
+    while (get_range_size(range) > 0)
+    {
+        const auto begin = static_cast<uint32_t>(range);
+        if (slice.range.compare_exchange_weak(range, pack_range(begin + 1, static_cast<uint32_t>(range >> 32))))
+        {
+            index = begin;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Takes the back half of the victim's remaining range
+bool steal_half(BatchSlice &victim, uint64_t &stolen)
+{
+    auto range = victim.range.load();
+    while (get_range_size(range) > 0)
+    {
+        const auto begin = static_cast<uint32_t>(range);
+        const auto end = static_cast<uint32_t>(range >> 32);
+        const auto split = end - (end - begin + 1) / 2;
+        if (victim.range.compare_exchange_weak(range, pack_range(begin, split)))
+        {
+            stolen = pack_range(split, end);
+            return true;
+        }
+    }
+
+    return false;
+}
+} // namespace
+
+std::vector<uint8_t> PixelBufferPoolType::acquire()
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    if (buffers.empty())
+        return {};
+
+    auto buffer = std::move(buffers.back());
+    buffers.pop_back();
+    buffer.clear();
+    return buffer;
+}
+
+void PixelBufferPoolType::release(DecodedImage &image)
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    if (buffers.size() < max_buffers && image.pixels.capacity() > 0)
+        buffers.push_back(std::move(image.pixels));
+
+    for (auto &level : image.mips)
+    {
+        if (buffers.size() < max_buffers && level.pixels.capacity() > 0)
+            buffers.push_back(std::move(level.pixels));
+    }
+}
+
+std::vector<DecodedIcon> decode_image_batch(const std::vector<ImageDecodeRequest> &requests,
+                                            const ImageDecoderFactory &decoder_factory,
+                                            size_t num_workers,
+                                            const std::atomic<bool> *cancel)
+{
+    auto results = std::vector<DecodedIcon>(requests.size());
+    for (auto idx = size_t{0}; idx < requests.size(); ++idx)
+        results[idx].icon_id = requests[idx].icon_id;
+
+    if (requests.empty() || !decoder_factory)
+        return results;
+
+    num_workers = std::clamp(num_workers, size_t{1}, requests.size());
+
+    const auto num_requests = static_cast<uint32_t>(requests.size());
+    auto slices = std::vector<BatchSlice>(num_workers);
+    for (auto worker = size_t{0}; worker < num_workers; ++worker)
+    {
+        const auto begin = static_cast<uint32_t>(num_requests * worker / num_workers);
+        const auto end = static_cast<uint32_t>(num_requests * (worker + 1) / num_workers);
+        slices[worker].range = pack_range(begin, end);
+    }
+
+    const auto run_worker = [&](const size_t worker) {
+        auto decoder = decoder_factory();
+        if (!decoder)
+            return;
+
+        while (true)
+        {
+            auto index = uint32_t{0};
+            while (pop_front(slices[worker], index))
+            {
+                if (cancel && *cancel)
+                    return;
+
+                const auto profile_scope = ProfileScopeType{ProfileZone::TEXTURE_DECODE};
+                auto &result = results[index];
+                result.success = decoder->decode(requests[index].path, result.image);
+            }
+
+            auto victim = slices.end();
+            auto victim_size = uint32_t{0};
+            for (auto it = slices.begin(); it != slices.end(); ++it)
+            {
+                const auto size = get_range_size(it->range.load());
+                if (size > victim_size)
+                {
+                    victim = it;
+                    victim_size = size;
+                }
+            }
+
+            if (victim == slices.end())
+                return;
+
+            auto stolen = uint64_t{0};
+            if (!steal_half(*victim, stolen))
+                continue;
+
+            // Only this worker refills its own empty slice, so a plain store is enough
+            slices[worker].range = stolen;
+        }
+    };
+
+    auto workers = std::vector<std::thread>{};
+    workers.reserve(num_workers - 1);
+    for (auto worker = size_t{1}; worker < num_workers; ++worker)
+        workers.emplace_back(run_worker, worker);
+
+    run_worker(0);
+
+    for (auto &worker : workers)
+        worker.join();
+
+    return results;
+}
+
+TextureLoaderType::TextureLoaderType(ImageDecoderFactory decoder_factory, size_t num_workers, uint32_t min_mip_size)
+    : decoder_factory(std::move(decoder_factory)), min_mip_size(min_mip_size)
+{
+    num_workers = std::max(size_t{1}, num_workers);
+    workers.reserve(num_workers);
+    for (auto i = size_t{0}; i < num_workers; ++i)
+        workers.emplace_back(&TextureLoaderType::worker_loop, this);
+}
+
+TextureLoaderType::~TextureLoaderType()
+{
+    shutdown();
+}
+
+void TextureLoaderType::request(const int icon_id, const std::filesystem::path &path, const TexturePriority priority)
+{
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        if (stop || decoding.contains(icon_id))
+            return;
+
+        const auto it = pending.find(icon_id);
+        if (it != pending.end())
+        {
+            it->second.priority = std::min(it->second.priority, priority);
+            return;
+        }
+
+        pending.emplace(icon_id, Request{path, priority, next_sequence++});
+    }
+
+    work_available.notify_one();
+}
+
+void TextureLoaderType::prioritize(const std::vector<int> &icon_ids)
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    for (const auto icon_id : icon_ids)
+    {
+        const auto it = pending.find(icon_id);
+        if (it != pending.end())
+            it->second.priority = TexturePriority::VISIBLE;
+    }
+}
+
+size_t TextureLoaderType::upload(const TextureUploader &uploader, const TextureUploadBudget &budget)
+{
+    const auto profile_scope = ProfileScopeType{ProfileZone::TEXTURE_UPLOAD};
+
+    const auto start = std::chrono::steady_clock::now();
+    auto num_uploaded = size_t{0};
+
+    while (num_uploaded < budget.max_uploads)
+    {
+        auto texture = DecodedTexture{};
+        {
+            auto lock = std::lock_guard<std::mutex>{mutex};
+            if (decoded.empty())
+                break;
+
+            texture = std::move(decoded.front());
+            decoded.pop_front();
+        }
+
+        if (uploader(texture.icon_id, texture.image))
+            ++num_uploaded;
+        buffer_pool.release(texture.image);
+
+        if (std::chrono::steady_clock::now() - start >= budget.max_time)
+            break;
+    }
+
+    return num_uploaded;
+}
+
+void TextureLoaderType::clear()
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    pending.clear();
+    decoding.clear();
+    decoded.clear();
+    ++generation;
+}
+
+void TextureLoaderType::shutdown()
+{
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        if (stop && workers.empty())
+            return;
+        stop = true;
+    }
+
+    work_available.notify_all();
+
+    for (auto &worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    pending.clear();
+    decoded.clear();
+}
+
+bool TextureLoaderType::is_idle() const
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    return pending.empty() && decoding.empty() && decoded.empty();
+}
+
+std::map<int, TextureLoaderType::Request>::iterator TextureLoaderType::get_next_request()
+{
+    // A build only has a few dozen icons, a linear pick keeps priority updates trivial
+    return std::ranges::min_element(pending, [](const auto &lhs, const auto &rhs) {
+        return std::make_pair(lhs.second.priority, lhs.second.sequence) <
+               std::make_pair(rhs.second.priority, rhs.second.sequence);
+    });
+}
+
+void TextureLoaderType::worker_loop()
+{
+    auto decoder = decoder_factory ? decoder_factory() : nullptr;
+
+    while (true)
+    {
+        auto icon_id = int{};
+        auto path = std::filesystem::path{};
+        auto request_generation = uint64_t{};
+        {
+            auto lock = std::unique_lock<std::mutex>{mutex};
+            work_available.wait(lock, [this] { return stop || !pending.empty(); });
+            if (stop)
+                return;
+
+            const auto it = get_next_request();
+            icon_id = it->first;
+            path = std::move(it->second.path);
+            request_generation = generation;
+            pending.erase(it);
+            decoding[icon_id] = request_generation;
+        }
+
+        auto texture = DecodedTexture{icon_id, DecodedImage{}};
+        texture.image.pixels = buffer_pool.acquire();
+
+        auto success = false;
+        {
+            const auto profile_scope = ProfileScopeType{ProfileZone::TEXTURE_DECODE};
+            success = decoder != nullptr && decoder->decode(path, texture.image);
+            if (success && min_mip_size > 0 && texture.image.mips.empty())
+                generate_mips(texture.image, min_mip_size);
+        }
+
+        auto lock = std::unique_lock<std::mutex>{mutex};
+
+        // After a clear() the same icon may already be decoding again for the new generation
+        const auto decoding_it = decoding.find(icon_id);
+        if (decoding_it != decoding.end() && decoding_it->second == request_generation)
+            decoding.erase(decoding_it);
+
+        if (success && request_generation == generation)
+        {
+            decoded.push_back(std::move(texture));
+            continue;
+        }
+
+        lock.unlock();
+        buffer_pool.release(texture.image);
+    }
+}
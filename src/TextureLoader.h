@@ -0,0 +1,146 @@
+#pragma once
+
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct DecodedImage
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels; // RGBA8, tightly packed
+    std::vector<DecodedImage> mips; // Optional downscaled levels, each half the size of the previous one
+};
+
+// Decodes an image file into RGBA pixels. Every loader worker owns one
+// decoder, so implementations may keep per-thread state without locking.
+class IImageDecoder
+{
+public:
+    virtual ~IImageDecoder() = default;
+
+    virtual bool decode(const std::filesystem::path &path, DecodedImage &image) = 0;
+};
+
+using ImageDecoderFactory = std::function<std::unique_ptr<IImageDecoder>()>;
+
+// Called on the render thread, returns false if the texture could not be created
+using TextureUploader = std::function<bool(int icon_id, const DecodedImage &image)>;
+
+enum class TexturePriority : uint8_t
+{
+    VISIBLE,
+    NORMAL,
+};
+
+struct TextureUploadBudget
+{
+    size_t max_uploads = 8;
+    std::chrono::microseconds max_time = std::chrono::microseconds(1000);
+};
+
+// Keeps the pixel buffers of uploaded images, so the next decodes reuse their
+// capacity instead of allocating again
+class PixelBufferPoolType
+{
+public:
+    explicit PixelBufferPoolType(size_t max_buffers = 32) : max_buffers(max_buffers)
+    {
+    }
+
+    std::vector<uint8_t> acquire();
+    void release(DecodedImage &image);
+
+private:
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>> buffers;
+    size_t max_buffers = 0;
+};
+
+struct ImageDecodeRequest
+{
+    int icon_id = 0;
+    std::filesystem::path path;
+};
+
+struct DecodedIcon
+{
+    int icon_id = 0;
+    bool success = false;
+    DecodedImage image;
+};
+
+// Decodes a batch on num_workers threads with one decoder each. Every worker
+// starts on its own slice of the batch and steals half of the largest
+// remaining slice once it runs dry. The results keep the request order.
+std::vector<DecodedIcon> decode_image_batch(const std::vector<ImageDecodeRequest> &requests,
+                                            const ImageDecoderFactory &decoder_factory,
+                                            size_t num_workers,
+                                            const std::atomic<bool> *cancel = nullptr);
+
+class TextureLoaderType
+{
+public:
+    // Images without mips from the decoder get a mip chain down to min_mip_size, 0 disables that
+    TextureLoaderType(ImageDecoderFactory decoder_factory, size_t num_workers = 2, uint32_t min_mip_size = 16);
+    ~TextureLoaderType();
+
+    TextureLoaderType(const TextureLoaderType &) = delete;
+    TextureLoaderType &operator=(const TextureLoaderType &) = delete;
+
+    // Requests for an icon that is already queued only raise its priority
+    void request(const int icon_id, const std::filesystem::path &path, const TexturePriority priority);
+    void prioritize(const std::vector<int> &icon_ids);
+
+    // Hands decoded images to the uploader until the budget of this frame is used up
+    size_t upload(const TextureUploader &uploader, const TextureUploadBudget &budget);
+
+    // Drops queued and decoded images, images still being decoded are discarded once done,
+    // so the same icons can be requested again right away
+    void clear();
+    void shutdown();
+
+    bool is_idle() const;
+
+private:
+    struct Request
+    {
+        std::filesystem::path path;
+        TexturePriority priority = TexturePriority::NORMAL;
+        uint64_t sequence = 0;
+    };
+
+    struct DecodedTexture
+    {
+        int icon_id = 0;
+        DecodedImage image;
+    };
+
+    void worker_loop();
+    std::map<int, Request>::iterator get_next_request();
+
+    ImageDecoderFactory decoder_factory;
+    uint32_t min_mip_size = 0;
+    PixelBufferPoolType buffer_pool;
+
+    mutable std::mutex mutex;
+    std::condition_variable work_available;
+    std::map<int, Request> pending;
+    std::map<int, uint64_t> decoding; // Icon id to the generation of its request
+    std::deque<DecodedTexture> decoded;
+    uint64_t generation = 0;
+    uint64_t next_sequence = 0;
+    bool stop = false;
+
+    std::vector<std::thread> workers;
+};
@@ -8,245 +8,536 @@
 #include <d3d11.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "imgui.h"
 
 #include "nexus/Nexus.h"
 
+#include "AtlasBuilder.h"
+#include "Downloader.h"
+#include "IconArchive.h"
+#include "ImageResample.h"
 #include "LogData.h"
+#include "Logger.h"
+#include "PngDecoder.h"
 #include "SkillData.h"
+#include "TextureLoader.h"
 #include "Textures.h"
 #include "Types.h"
 
-ID3D11ShaderResourceView *LoadTextureFromPNG_WIC(ID3D11Device *device, const std::wstring &filename)
+namespace
 {
-    if (!device)
-        return nullptr;
+class WicImageDecoder final : public IImageDecoder
+{
+public:
+    WicImageDecoder()
+    {
+        const auto hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        com_initialized = SUCCEEDED(hr);
 
-    IWICImagingFactory *factory = nullptr;
-    IWICBitmapDecoder *decoder = nullptr;
-    IWICBitmapFrameDecode *frame = nullptr;
-    IWICFormatConverter *converter = nullptr;
-    ID3D11Texture2D *texture = nullptr;
-    ID3D11ShaderResourceView *srv = nullptr;
+        if (FAILED(hr) && hr != RPC_E_CHANGED_MODE)
+            return;
 
-    auto hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
-    auto com_initialized = SUCCEEDED(hr);
+        if (FAILED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory))))
+            factory = nullptr;
+    }
 
-    if (FAILED(hr) && hr != RPC_E_CHANGED_MODE)
-        return nullptr;
+    ~WicImageDecoder() override
+    {
+        if (factory)
+            factory->Release();
+        if (com_initialized)
+            CoUninitialize();
+    }
 
-    try
+    bool decode(const std::filesystem::path &path, DecodedImage &image) override
     {
-        hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory));
-        if (FAILED(hr))
-        {
-            if (com_initialized)
-                CoUninitialize();
-            return nullptr;
-        }
+        if (!factory)
+            return false;
 
-        hr = factory->CreateDecoderFromFilename(filename.c_str(),
-                                                nullptr,
-                                                GENERIC_READ,
-                                                WICDecodeMetadataCacheOnLoad,
-                                                &decoder);
-        if (FAILED(hr))
+        IWICBitmapDecoder *decoder = nullptr;
+        IWICBitmapFrameDecode *frame = nullptr;
+        IWICFormatConverter *converter = nullptr;
+
+        auto success = false;
+
+        try
         {
-            factory->Release();
-            if (com_initialized)
-                CoUninitialize();
-            return nullptr;
-        }
+            auto hr = factory->CreateDecoderFromFilename(path.wstring().c_str(),
+                                                         nullptr,
+                                                         GENERIC_READ,
+                                                         WICDecodeMetadataCacheOnLoad,
+                                                         &decoder);
+            if (SUCCEEDED(hr))
+                hr = decoder->GetFrame(0, &frame);
+            if (SUCCEEDED(hr))
+                hr = factory->CreateFormatConverter(&converter);
+            if (SUCCEEDED(hr))
+                hr = converter->Initialize(frame,
+                                           GUID_WICPixelFormat32bppRGBA,
+                                           WICBitmapDitherTypeNone,
+                                           nullptr,
+                                           0.f,
+                                           WICBitmapPaletteTypeCustom);
+
+            UINT width = 0;
+            UINT height = 0;
+            if (SUCCEEDED(hr))
+                hr = converter->GetSize(&width, &height);
 
-        hr = decoder->GetFrame(0, &frame);
-        if (FAILED(hr))
+            if (SUCCEEDED(hr) && width > 0 && height > 0)
+            {
+                image.width = width;
+                image.height = height;
+                image.pixels.resize(static_cast<size_t>(width) * height * 4);
+                hr = converter->CopyPixels(nullptr,
+                                           width * 4,
+                                           static_cast<UINT>(image.pixels.size()),
+                                           image.pixels.data());
+                success = SUCCEEDED(hr);
+            }
+        }
+        catch (const std::exception &e)
         {
-            decoder->Release();
-            factory->Release();
-            if (com_initialized)
-                CoUninitialize();
-            return nullptr;
+            success = false;
         }
 
-        hr = factory->CreateFormatConverter(&converter);
-        if (FAILED(hr))
-        {
+        if (converter)
+            converter->Release();
+        if (frame)
             frame->Release();
+        if (decoder)
             decoder->Release();
-            factory->Release();
-            if (com_initialized)
-                CoUninitialize();
-            return nullptr;
+
+        return success;
+    }
+
+private:
+    IWICImagingFactory *factory = nullptr;
+    bool com_initialized = false;
+};
+
+void BindSkillIconSampler(const ImDrawList *, const ImDrawCmd *cmd)
+{
+    auto *sampler = static_cast<ID3D11SamplerState *>(cmd->UserCallbackData);
+
+    ID3D11Device *device = nullptr;
+    sampler->GetDevice(&device);
+    if (!device)
+        return;
+
+    ID3D11DeviceContext *context = nullptr;
+    device->GetImmediateContext(&context);
+    if (context)
+    {
+        context->PSSetSamplers(0, 1, &sampler);
+        context->Release();
+    }
+
+    device->Release();
+}
+
+std::filesystem::path GetSkillIconDownloadPath(const std::filesystem::path &img_folder,
+                                               const int icon_id,
+                                               const std::string &icon_url)
+{
+    auto ext = std::string{".png"};
+    const auto dot_pos = icon_url.find_last_of('.');
+    if (dot_pos != std::string::npos && dot_pos + 1 < icon_url.size())
+        ext = icon_url.substr(dot_pos);
+
+    return img_folder / (std::to_string(icon_id) + ext);
+}
+} // namespace
+
+std::unique_ptr<IImageDecoder> make_wic_image_decoder()
+{
+    return std::make_unique<WicImageDecoder>();
+}
+
+ImageDecoderFactory make_skill_icon_decoder_factory(const IconArchiveType &icon_archive)
+{
+    return make_archive_decoder_factory(icon_archive, make_png_decoder_factory(make_wic_image_decoder));
+}
+
+ID3D11ShaderResourceView *CreateTextureFromImage(ID3D11Device *device, const DecodedImage &image)
+{
+    if (!device || image.width == 0 || image.height == 0 ||
+        image.pixels.size() < static_cast<size_t>(image.width) * image.height * 4)
+        return nullptr;
+
+    auto sub_resources = std::vector<D3D11_SUBRESOURCE_DATA>{};
+    sub_resources.push_back(D3D11_SUBRESOURCE_DATA{image.pixels.data(), image.width * 4, 0});
+
+    // The mip chain is only used if every level has the size D3D expects, otherwise the top level is uploaded alone
+    auto width = image.width;
+    auto height = image.height;
+    for (const auto &level : image.mips)
+    {
+        width = std::max(uint32_t{1}, width / 2);
+        height = std::max(uint32_t{1}, height / 2);
+        if (level.width != width || level.height != height ||
+            level.pixels.size() < static_cast<size_t>(width) * height * 4)
+        {
+            sub_resources.resize(1);
+            break;
         }
 
-        hr = converter->Initialize(frame,
-                                   GUID_WICPixelFormat32bppRGBA,
-                                   WICBitmapDitherTypeNone,
-                                   nullptr,
-                                   0.f,
-                                   WICBitmapPaletteTypeCustom);
-        if (FAILED(hr))
+        sub_resources.push_back(D3D11_SUBRESOURCE_DATA{level.pixels.data(), width * 4, 0});
+    }
+
+    ID3D11Texture2D *texture = nullptr;
+    ID3D11ShaderResourceView *srv = nullptr;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = image.width;
+    desc.Height = image.height;
+    desc.MipLevels = static_cast<UINT>(sub_resources.size());
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_IMMUTABLE;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    auto hr = device->CreateTexture2D(&desc, sub_resources.data(), &texture);
+    if (SUCCEEDED(hr))
+        hr = device->CreateShaderResourceView(texture, nullptr, &srv);
+
+    if (texture)
+        texture->Release();
+
+    return SUCCEEDED(hr) ? srv : nullptr;
+}
+
+void ReleaseSkillTexture(ID3D11ShaderResourceView *texture)
+{
+    if (texture)
+        texture->Release();
+}
+
+std::filesystem::path GetSkillTexturePath(const int icon_id,
+                                          const LogSkillInfo &info,
+                                          const std::filesystem::path &img_folder)
+{
+    if (info.name.empty())
+        return {};
+
+    auto actual_icon_id = icon_id;
+    if (SkillRuleData::fix_skill_img_ids.find(icon_id) != SkillRuleData::fix_skill_img_ids.end())
+        actual_icon_id = SkillRuleData::fix_skill_img_ids.at(icon_id);
+
+    std::string ext = ".png";
+    size_t dot = info.icon_url.find_last_of('.');
+    if (dot != std::string::npos && dot + 1 < info.icon_url.size())
+        ext = info.icon_url.substr(dot);
+
+    return img_folder / (std::to_string(actual_icon_id) + ext);
+}
+
+void RequestSkillTexture(TextureLoaderType &texture_loader,
+                         const int icon_id,
+                         const LogSkillInfo &info,
+                         const std::filesystem::path &img_folder,
+                         const TexturePriority priority)
+{
+    const auto img_path = GetSkillTexturePath(icon_id, info, img_folder);
+    if (!img_path.empty())
+        texture_loader.request(icon_id, img_path, priority);
+}
+
+void AcquireAllSkillTextures(SkillIconCacheType &icon_cache,
+                             TextureLoaderType &texture_loader,
+                             TextureMapType &texture_map,
+                             const LogSkillInfoMap &log_skill_info_map,
+                             const std::filesystem::path &img_folder)
+{
+    for (const auto &[icon_id, info] : log_skill_info_map)
+    {
+        if (info.name.empty() || texture_map.contains(icon_id))
+            continue;
+
+        auto *texture = icon_cache.acquire(icon_id);
+        if (texture)
         {
-            converter->Release();
-            frame->Release();
-            decoder->Release();
-            factory->Release();
-            if (com_initialized)
-                CoUninitialize();
-            return nullptr;
+            texture_map[icon_id] = texture;
+            continue;
         }
 
-        UINT width, height;
-        converter->GetSize(&width, &height);
-        std::vector<BYTE> buffer(width * height * 4);
-        converter->CopyPixels(nullptr, width * 4, static_cast<uint32_t>(buffer.size()), buffer.data());
-
-        D3D11_TEXTURE2D_DESC desc = {};
-        desc.Width = width;
-        desc.Height = height;
-        desc.MipLevels = 1;
-        desc.ArraySize = 1;
-        desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        desc.SampleDesc.Count = 1;
-        desc.Usage = D3D11_USAGE_DEFAULT;
-        desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-
-        D3D11_SUBRESOURCE_DATA subResource = {};
-        subResource.pSysMem = buffer.data();
-        subResource.SysMemPitch = width * 4;
-
-        hr = device->CreateTexture2D(&desc, &subResource, &texture);
-        if (SUCCEEDED(hr))
+        try
         {
-            hr = device->CreateShaderResourceView(texture, nullptr, &srv);
+            RequestSkillTexture(texture_loader, icon_id, info, img_folder, TexturePriority::NORMAL);
         }
+        catch (const std::exception &e)
+        {
+            continue;
+        }
+    }
+}
 
-        // Cleanup
-        if (texture)
-            texture->Release();
-        converter->Release();
-        frame->Release();
-        decoder->Release();
-        factory->Release();
+size_t UploadDecodedTextures(ID3D11Device *device,
+                             TextureLoaderType &texture_loader,
+                             SkillIconCacheType &icon_cache,
+                             TextureMapType &texture_map,
+                             SkillAtlasType &atlas,
+                             const TextureUploadBudget &budget)
+{
+    if (!device)
+        return 0;
 
-        if (com_initialized)
-            CoUninitialize();
+    return texture_loader.upload(
+        [device, &icon_cache, &texture_map, &atlas](const int icon_id, const DecodedImage &image) {
+            if (texture_map.contains(icon_id))
+                return false;
 
-        return srv;
-    }
-    catch (const std::bad_alloc &e)
+            auto *texture = CreateTextureFromImage(device, image);
+            if (!texture)
+                return false;
+
+            icon_cache.insert(icon_id, texture, get_image_bytes(image));
+            texture_map[icon_id] = texture;
+            atlas.add(icon_id, image);
+            return true;
+        },
+        budget);
+}
+
+void ReleaseTextureMap(TextureMapType &texture_map, SkillIconCacheType &icon_cache)
+{
+    release_icon_map(texture_map, icon_cache);
+}
+
+size_t ReleasePackedTextures(const SkillAtlasType &atlas, TextureMapType &texture_map, SkillIconCacheType &icon_cache)
+{
+    return release_packed_icons(texture_map, icon_cache, [&atlas](const int icon_id) {
+        return atlas.find(icon_id) != nullptr;
+    });
+}
+
+SkillAtlasType::~SkillAtlasType()
+{
+    release();
+}
+
+void SkillAtlasType::add(const int icon_id, const DecodedImage &image)
+{
+    if (is_packing)
+        return;
+
+    auto top_level = DecodedImage{};
+    top_level.width = image.width;
+    top_level.height = image.height;
+    top_level.pixels = image.pixels;
+    collecting->add(icon_id, std::move(top_level));
+}
+
+void SkillAtlasType::build()
+{
+    if (is_packing || collecting->get_num_images() == 0)
+        return;
+
+    is_packing = true;
+    worker = std::thread([this, builder = std::move(collecting)]() mutable {
+        (void)builder->build();
+        if (cancel)
+            return;
+
+        builder->generate_page_mips();
+        if (cancel)
+            return;
+
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        finished = std::move(builder);
+    });
+    collecting = std::make_unique<AtlasBuilderType>();
+}
+
+bool SkillAtlasType::upload(ID3D11Device *device)
+{
+    if (!device)
+        return false;
+
+    auto builder = std::unique_ptr<AtlasBuilderType>{};
     {
-        if (texture)
-            texture->Release();
-        if (converter)
-            converter->Release();
-        if (frame)
-            frame->Release();
-        if (decoder)
-            decoder->Release();
-        if (factory)
-            factory->Release();
-        if (com_initialized)
-            CoUninitialize();
-        return nullptr;
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        builder = std::move(finished);
     }
-    catch (const std::exception &e)
+
+    if (!builder)
+        return false;
+
+    for (const auto &page : builder->get_pages())
+        pages.push_back(CreateTextureFromImage(device, page));
+
+    for (const auto &[icon_id, entry] : builder->get_entries())
     {
+        auto *texture = pages[entry.page];
         if (texture)
-            texture->Release();
-        if (converter)
-            converter->Release();
-        if (frame)
-            frame->Release();
-        if (decoder)
-            decoder->Release();
-        if (factory)
-            factory->Release();
-        if (com_initialized)
-            CoUninitialize();
-        return nullptr;
+            views[icon_id] = SkillIconView{texture, entry.u0, entry.v0, entry.u1, entry.v1};
     }
-    catch (...)
+
+    return true;
+}
+
+void SkillAtlasType::release()
+{
+    cancel_build();
+
+    for (auto *page : pages)
     {
-        if (texture)
-            texture->Release();
-        if (converter)
-            converter->Release();
-        if (frame)
-            frame->Release();
-        if (decoder)
-            decoder->Release();
-        if (factory)
-            factory->Release();
-        if (com_initialized)
-            CoUninitialize();
-        return nullptr;
+        if (page)
+            page->Release();
     }
+
+    pages.clear();
+    views.clear();
+    collecting->clear();
+    is_packing = false;
 }
 
-TextureMapType LoadAllSkillTextures(ID3D11Device *device,
-                                    const LogSkillInfoMap &log_skill_info_map,
-                                    const std::filesystem::path &img_folder)
+const SkillIconView *SkillAtlasType::find(const int icon_id) const
 {
+    const auto it = views.find(icon_id);
+    return it != views.end() ? &it->second : nullptr;
+}
+
+void SkillAtlasType::cancel_build()
+{
+    cancel = true;
+    if (worker.joinable())
+        worker.join();
+    cancel = false;
+
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    finished.reset();
+}
+
+SkillIconSamplerType::~SkillIconSamplerType()
+{
+    release();
+}
+
+bool SkillIconSamplerType::create(ID3D11Device *device)
+{
+    if (sampler)
+        return true;
     if (!device)
-        return {};
+        return false;
 
-    TextureMapType texture_map;
+    D3D11_SAMPLER_DESC desc = {};
+    desc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    desc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+    desc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+    desc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+    desc.ComparisonFunc = D3D11_COMPARISON_ALWAYS;
+    desc.MinLOD = 0.0f;
+    desc.MaxLOD = D3D11_FLOAT32_MAX;
 
-    try
-    {
-        for (const auto &[icon_id, info] : log_skill_info_map)
-        {
-            try
-            {
-                if (info.name.empty())
-                    continue;
+    return SUCCEEDED(device->CreateSamplerState(&desc, &sampler));
+}
 
-                auto actual_icon_id = icon_id;
-                if (SkillRuleData::fix_skill_img_ids.find(icon_id) != SkillRuleData::fix_skill_img_ids.end())
-                    actual_icon_id = SkillRuleData::fix_skill_img_ids.at(icon_id);
+void SkillIconSamplerType::release()
+{
+    if (sampler)
+        sampler->Release();
+    sampler = nullptr;
+}
 
-                std::string ext = ".png";
-                size_t dot = info.icon_url.find_last_of('.');
-                if (dot != std::string::npos && dot + 1 < info.icon_url.size())
-                    ext = info.icon_url.substr(dot);
+void SkillIconSamplerType::begin(ImDrawList *draw_list) const
+{
+    if (sampler && draw_list)
+        draw_list->AddCallback(BindSkillIconSampler, sampler);
+}
 
-                const auto img_path = img_folder / (std::to_string(actual_icon_id) + ext);
-                if (!std::filesystem::exists(img_path))
-                    continue;
+void SkillIconSamplerType::end(ImDrawList *draw_list) const
+{
+    if (sampler && draw_list)
+        draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+}
 
-                auto *tex = LoadTextureFromPNG_WIC(device, img_path.wstring());
-                if (tex)
-                    texture_map[icon_id] = tex;
-            }
-            catch (const std::exception &e)
-            {
-                continue;
-            }
-        }
-    }
-    catch (const std::exception &e)
+SkillIconView GetSkillIconView(const SkillAtlasType &atlas, const TextureMapType &texture_map, const int icon_id)
+{
+    if (const auto *view = atlas.find(icon_id))
+        return *view;
+
+    const auto it = texture_map.find(icon_id);
+    if (it == texture_map.end())
+        return SkillIconView{};
+
+    return SkillIconView{it->second};
+}
+
+void StartDownloadAllSkillIcons(DownloadServiceType *download_service,
+                                RotationLogType &rotation_run,
+                                const std::filesystem::path &img_folder)
+{
+    std::filesystem::create_directories(img_folder);
+
+    auto &pending_icon_downloads = rotation_run.pending_icon_downloads;
+    pending_icon_downloads.clear();
+
+    if (!download_service)
+        return;
+
+    for (const auto &[icon_id, info] : rotation_run.log_skill_info_map)
     {
-        ReleaseTextureMap(texture_map);
-        return {};
+        if (info.icon_url.empty() || info.icon_url.find("local://") == 0)
+            continue;
+
+        if (!std::filesystem::exists(GetSkillIconDownloadPath(img_folder, icon_id, info.icon_url)))
+            pending_icon_downloads.push_back(icon_id);
     }
 
-    return texture_map;
+    SubmitPendingSkillIconDownloads(download_service, rotation_run, img_folder);
 }
 
-void ReleaseTextureMap(TextureMapType &texture_map)
+void SubmitPendingSkillIconDownloads(DownloadServiceType *download_service,
+                                     RotationLogType &rotation_run,
+                                     const std::filesystem::path &img_folder)
 {
-    for (auto &[icon_id, texture] : texture_map)
+    auto &pending_icon_downloads = rotation_run.pending_icon_downloads;
+    if (!download_service || pending_icon_downloads.empty())
+        return;
+
+    auto &downloaded_icons = rotation_run.downloaded_icons;
+
+    // Called on the render thread, a build with more missing icons than the queue holds must not block it
+    auto num_submitted = size_t{0};
+    for (const auto icon_id : pending_icon_downloads)
     {
-        if (texture)
+        const auto info_it = rotation_run.log_skill_info_map.find(icon_id);
+        if (info_it == rotation_run.log_skill_info_map.end())
         {
-            texture->Release();
-            texture = nullptr;
+            ++num_submitted;
+            continue;
         }
+
+        const auto &icon_url = info_it->second.icon_url;
+        const auto submitted = download_service->try_submit(
+            icon_url,
+            GetSkillIconDownloadPath(img_folder, icon_id, icon_url),
+            [icon_id, &downloaded_icons](const DownloadResult &result) {
+                // A full queue only delays the icon until the next build load picks it up from disk
+                if (result.success && !downloaded_icons.try_push(icon_id))
+                    log_message(LogLevel::WARNING, "Icon completion queue is full");
+            });
+        if (!submitted)
+            break;
+
+        log_message(LogLevel::DEBUG, "Downloading file");
+        ++num_submitted;
     }
 
-    texture_map.clear();
+    pending_icon_downloads.erase(pending_icon_downloads.begin(),
+                                 pending_icon_downloads.begin() + static_cast<std::ptrdiff_t>(num_submitted));
 }
@@ -2,21 +2,158 @@
 
 #include <d3d11.h>
 
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
+
+#include "imgui.h"
 
 #include "nexus/Nexus.h"
 
+#include "AtlasBuilder.h"
+#include "IconArchive.h"
+#include "IconCache.h"
+#include "LogData.h"
+#include "TextureLoader.h"
 #include "Types.h"
 
-using TextureMapType = std::unordered_map<int, ID3D11ShaderResourceView *>;
+class DownloadServiceType;
+class SkillAtlasType;
+
+// Textures of the loaded build, owned by the icon cache
+using TextureMapType = IconMapType<ID3D11ShaderResourceView *>;
+using SkillIconCacheType = IconCacheType<ID3D11ShaderResourceView *>;
+
+std::unique_ptr<IImageDecoder> make_wic_image_decoder();
+
+// Icons from the icon archive, the rest from the loose PNGs via WIC
+ImageDecoderFactory make_skill_icon_decoder_factory(const IconArchiveType &icon_archive);
+
+// Uploads the image together with its mip levels
+ID3D11ShaderResourceView *CreateTextureFromImage(ID3D11Device *device, const DecodedImage &image);
+
+void ReleaseSkillTexture(ID3D11ShaderResourceView *texture);
+
+// Empty if the icon has no name. The file itself may be missing, icons from the
+// icon archive or still pending downloads fail in the decoder instead.
+std::filesystem::path GetSkillTexturePath(const int icon_id,
+                                          const LogSkillInfo &info,
+                                          const std::filesystem::path &img_folder);
+
+void RequestSkillTexture(TextureLoaderType &texture_loader,
+                         const int icon_id,
+                         const LogSkillInfo &info,
+                         const std::filesystem::path &img_folder,
+                         const TexturePriority priority);
+
+// Takes cached icons into the texture map and requests the missing ones from the loader
+void AcquireAllSkillTextures(SkillIconCacheType &icon_cache,
+                             TextureLoaderType &texture_loader,
+                             TextureMapType &texture_map,
+                             const LogSkillInfoMap &log_skill_info_map,
+                             const std::filesystem::path &img_folder);
+
+// Uploads at most the budget of decoded icons, returns the number of new textures.
+// Every uploaded image is also handed to the atlas, so it is decoded only once.
+size_t UploadDecodedTextures(ID3D11Device *device,
+                             TextureLoaderType &texture_loader,
+                             SkillIconCacheType &icon_cache,
+                             TextureMapType &texture_map,
+                             SkillAtlasType &atlas,
+                             const TextureUploadBudget &budget);
+
+// Drops the references of the loaded build, the textures stay in the icon cache
+void ReleaseTextureMap(TextureMapType &texture_map, SkillIconCacheType &icon_cache);
+
+// Drops the single textures of the icons the atlas holds from the texture map, returns their number.
+// They stay in the icon cache, so loading the build again does not decode them again.
+size_t ReleasePackedTextures(const SkillAtlasType &atlas, TextureMapType &texture_map, SkillIconCacheType &icon_cache);
+
+// All icons of the loaded build packed into a few atlas pages, so icon lists
+// draw from one texture. The atlas collects the images the texture loader
+// decoded and packs them on a background thread once the loader is idle.
+// Icons that arrive after that keep their single texture.
+class SkillAtlasType
+{
+public:
+    SkillAtlasType() = default;
+    ~SkillAtlasType();
+
+    SkillAtlasType(const SkillAtlasType &) = delete;
+    SkillAtlasType &operator=(const SkillAtlasType &) = delete;
+
+    // Copies the top level of a decoded icon, ignored once packing started
+    void add(const int icon_id, const DecodedImage &image);
+
+    // Starts packing the collected icons, does nothing if it already started
+    void build();
+
+    // Creates the page textures once packing finished, returns true if the atlas changed
+    bool upload(ID3D11Device *device);
+
+    // Drops the pages and the collected icons, for the next build
+    void release();
+
+    const SkillIconView *find(const int icon_id) const;
+
+    size_t get_num_pages() const
+    {
+        return pages.size();
+    }
+
+private:
+    void cancel_build();
+
+    std::unique_ptr<AtlasBuilderType> collecting = std::make_unique<AtlasBuilderType>();
+    bool is_packing = false;
+
+    std::thread worker;
+    std::atomic<bool> cancel = false;
+    std::mutex mutex;
+    std::unique_ptr<AtlasBuilderType> finished;
+
+    std::vector<ID3D11ShaderResourceView *> pages;
+    std::unordered_map<int, SkillIconView> views;
+};
+
+// Trilinear sampler for icon draws. The sampler of the ImGui DX11 backend only
+// reads the top mip level, so icons drawn between begin() and end() of a draw
+// list use it to pick the mip level closest to their on-screen size.
+class SkillIconSamplerType
+{
+public:
+    SkillIconSamplerType() = default;
+    ~SkillIconSamplerType();
+
+    SkillIconSamplerType(const SkillIconSamplerType &) = delete;
+    SkillIconSamplerType &operator=(const SkillIconSamplerType &) = delete;
+
+    bool create(ID3D11Device *device);
+    void release();
+
+    void begin(ImDrawList *draw_list) const;
+    void end(ImDrawList *draw_list) const;
 
+private:
+    ID3D11SamplerState *sampler = nullptr;
+};
 
-ID3D11ShaderResourceView *LoadTextureFromPNG_WIC(ID3D11Device *device, const std::wstring &filename);
+// Prefers the atlas and falls back to the single icon texture
+SkillIconView GetSkillIconView(const SkillAtlasType &atlas, const TextureMapType &texture_map, const int icon_id);
 
-TextureMapType LoadAllSkillTextures(ID3D11Device *device,
-                                    const LogSkillInfoMap &log_skill_info_map,
-                                    const std::filesystem::path &img_folder);
+// Downloads the icons of the build that are not on disk yet, each finished icon
+// id is pushed to the completion queue of the rotation. Icons that do not fit
+// into the download queue wait in the pending downloads of the rotation.
+void StartDownloadAllSkillIcons(DownloadServiceType *download_service,
+                                RotationLogType &rotation_run,
+                                const std::filesystem::path &img_folder);
 
-void ReleaseTextureMap(TextureMapType &texture_map);
+// Submits pending icon downloads until the download queue is full, once per frame
+void SubmitPendingSkillIconDownloads(DownloadServiceType *download_service,
+                                     RotationLogType &rotation_run,
+                                     const std::filesystem::path &img_folder);
@@ -1,20 +1,25 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
-#include <d3d11.h>
 #include <filesystem>
 #include <list>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
-#include "arcdps/ArcDPS.h"
-
 #include "Defines.h"
+#include "Frozen.h"
 #include "SkillIDs.h"
+#include "StringInterner.h"
+
+// Only passed around as a pointer, the addon gets the definition from d3d11.h
+struct ID3D11ShaderResourceView;
 
 struct EvCombatDataPersistent
 {
@@ -22,22 +27,12 @@ struct EvCombatDataPersistent
     uintptr_t SrcID;
     uint32_t SrcProfession;
     uint32_t SrcSpecialization;
-    std::string SkillName;
-    SkillID SkillID;
+    InternedString SkillName;
+    ::SkillID SkillID;
     uint64_t EventID;
     bool RepeatedSkill;
 };
 
-struct EvCombatData
-{
-    ArcDPS::CombatEvent *ev;
-    ArcDPS::AgentShort *src;
-    ArcDPS::AgentShort *dst;
-    char *skillname;
-    uint64_t id;
-    uint64_t revision;
-};
-
 struct EvAgentUpdate
 {
     char account[64];     // dst->name  = account name
@@ -53,6 +48,33 @@ struct EvAgentUpdate
     uint16_t subgroup;    // dst->team  = subgroup
 };
 
+enum class BuildCategory
+{
+    RED_CROSSED,
+    ORANGE_CROSSED,
+    GREEN_TICKED,
+    YELLOW_TICKED,
+    UNTESTED
+};
+
+struct SkillKeyMapping
+{
+    int skill_7;
+    int skill_8;
+    int skill_9;
+};
+
+struct BenchBuildInfo
+{
+    double overall_dps = 0.0;
+    std::string name;
+    std::string profession;
+    std::string elite_spec;
+    std::string build_type;
+    std::string benchmark_type;
+    SkillKeyMapping skill_key_mapping{};
+};
+
 struct BenchFileInfo
 {
     std::filesystem::path full_path;
@@ -60,6 +82,15 @@ struct BenchFileInfo
     std::string display_name;
     bool is_directory_header;
 
+    // Display metadata, resolved once in get_bench_files
+    std::string formatted_name;
+    std::string_view build_type_tags;
+    std::string search_name;
+    std::string search_path;
+    BuildCategory category = BuildCategory::UNTESTED;
+    BenchBuildInfo build_info;
+    std::string build_info_text;
+
     BenchFileInfo(const std::filesystem::path &full, const std::filesystem::path &relative, bool is_header = false);
 };
 
@@ -72,17 +103,39 @@ struct SkillState
 
 struct LogSkillInfo
 {
-    std::string name;
+    InternedString name;
     std::string icon_url;
 };
 
-using LogSkillInfoMap = std::map<int, LogSkillInfo>;
+// Per-build maps, allocated from the arena of the loaded build
+using LogSkillInfoMap = std::pmr::map<int, LogSkillInfo>;
 
-using LogDataTypes = std::variant<int, float, bool, std::string>;
+using LogDataTypes = std::variant<int, float, bool, std::pmr::string>;
 
+// Parse tree of a log file. Children and string values are allocated from the
+// allocator of the root node, which is passed down to every node it creates.
 struct IntNode
 {
-    std::map<std::string, IntNode> children;
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    IntNode() = default;
+    explicit IntNode(const allocator_type &allocator) : children(allocator)
+    {
+    }
+    IntNode(const IntNode &other, const allocator_type &allocator)
+        : children(other.children, allocator), value(other.value)
+    {
+    }
+    IntNode(IntNode &&other, const allocator_type &allocator)
+        : children(std::move(other.children), allocator), value(std::move(other.value))
+    {
+    }
+    IntNode(const IntNode &other) = default;
+    IntNode(IntNode &&other) = default;
+    IntNode &operator=(const IntNode &other) = default;
+    IntNode &operator=(IntNode &&other) = default;
+
+    std::pmr::map<std::pmr::string, IntNode, std::less<>> children;
     std::optional<LogDataTypes> value;
 };
 
@@ -136,7 +189,7 @@ struct SkillData
 {
     int icon_id;
     SkillID skill_id;
-    std::string name;
+    InternedString name;
     float recharge_time;
     float recharge_time_with_alacrity;
     float cast_time;
@@ -149,6 +202,8 @@ struct SkillData
     bool is_profession_skill;
     SkillSlot skill_slot;
     WeaponType weapon_type;
+
+    bool operator==(const SkillData &) const = default;
 };
 
 struct RotationStep
@@ -159,17 +214,56 @@ struct RotationStep
     bool is_special_skill;
 };
 
+// A rotation step read in place, from a RotationTableType or a RotationStep
+struct RotationStepRef
+{
+    float time_of_cast;
+    float duration_ms;
+    const SkillData &skill_data;
+    bool is_special_skill;
+
+    RotationStepRef(const float time_of_cast,
+                    const float duration_ms,
+                    const SkillData &skill_data,
+                    const bool is_special_skill)
+        : time_of_cast(time_of_cast), duration_ms(duration_ms), skill_data(skill_data),
+          is_special_skill(is_special_skill)
+    {
+    }
+    RotationStepRef(const RotationStep &rotation_step)
+        : RotationStepRef(rotation_step.time_of_cast,
+                          rotation_step.duration_ms,
+                          rotation_step.skill_data,
+                          rotation_step.is_special_skill)
+    {
+    }
+
+    operator RotationStep() const
+    {
+        return RotationStep{time_of_cast, duration_ms, skill_data, is_special_skill};
+    }
+};
+
+// Texture and uv rect of an icon, either a single texture or a part of an atlas page
+struct SkillIconView
+{
+    ID3D11ShaderResourceView *texture = nullptr;
+    float u0 = 0.0f;
+    float v0 = 0.0f;
+    float u1 = 1.0f;
+    float v1 = 1.0f;
+};
+
 struct RotationSkill
 {
     SkillID skill_id;
-    std::string name;
-    ID3D11ShaderResourceView *texture;
+    InternedString name;
+    SkillIconView icon;
     SkillSlot skill_slot;
 };
 
 using RotationSteps = std::vector<RotationStep>;
-using RotationStepsList = std::list<RotationStep>;
-using SkillDataMap = std::map<SkillID, SkillData>;
+using SkillDataMap = std::pmr::map<SkillID, SkillData>;
 
 enum class ProfessionID : uint32_t
 {
@@ -261,13 +355,6 @@ struct MetaData
     std::string html_file_path;
 };
 
-struct SkillKeyMapping
-{
-    int skill_7;
-    int skill_8;
-    int skill_9;
-};
-
 enum class Device
 {
     KEYBOARD,
@@ -488,6 +575,14 @@ enum class Modifiers
     RCTRL = 6, // Checked
 };
 
+struct FileFingerprint
+{
+    int64_t mtime = 0;
+    uintmax_t size = 0;
+    uint64_t hash = 0;
+    bool is_valid = false;
+};
+
 struct KeybindInfo
 {
     std::string action_name;
@@ -526,23 +621,23 @@ enum class ManualSkillID : int32_t
 
 struct SkillRules
 {
-    const std::set<std::string_view> &skills_substr_weapon_swap_like;
-    const std::set<std::string_view> &skills_match_weapon_swap_like;
-    const std::set<std::string_view> &skills_substr_to_drop_names;
-    const std::set<std::string_view> &skills_match_to_drop_names;
-    const std::set<ManualSkillID> &skills_match_to_drop;
-    const std::set<std::string_view> &special_substr_to_gray_out;
-    const std::set<std::string_view> &special_match_to_gray_out_names;
-    const std::set<ManualSkillID> &special_match_to_gray_out_manual_ids;
-    const std::set<SkillID> &special_match_to_gray_out;
-    const std::set<std::string_view> &special_substr_to_remove_duplicates_names;
-    const std::set<SkillID> &special_substr_to_remove_duplicates;
-    const std::set<SkillID> &easy_mode_drop_match;
-    const std::set<std::string_view> easy_mode_names_drop_substr;
-    const std::set<SkillID> &easy_mode_match_to_gray_out;
-    const std::map<std::string_view, std::set<SkillID>> &class_map_easy_mode_match_to_gray_out;
-    const std::map<std::string_view, std::set<SkillID>> &class_map_special_match_to_gray_out;
-    const std::map<std::string_view, std::set<SkillID>> &class_map_easy_mode_drop_match;
+    FrozenSet<std::string_view> skills_substr_weapon_swap_like;
+    FrozenSet<std::string_view> skills_match_weapon_swap_like;
+    FrozenSet<std::string_view> skills_substr_to_drop_names;
+    FrozenSet<std::string_view> skills_match_to_drop_names;
+    FrozenSet<ManualSkillID> skills_match_to_drop;
+    FrozenSet<std::string_view> special_substr_to_gray_out;
+    FrozenSet<std::string_view> special_match_to_gray_out_names;
+    FrozenSet<ManualSkillID> special_match_to_gray_out_manual_ids;
+    FrozenSet<SkillID> special_match_to_gray_out;
+    FrozenSet<std::string_view> special_substr_to_remove_duplicates_names;
+    FrozenSet<SkillID> special_substr_to_remove_duplicates;
+    FrozenSet<SkillID> easy_mode_drop_match;
+    FrozenSet<std::string_view> easy_mode_names_drop_substr;
+    FrozenSet<SkillID> easy_mode_match_to_gray_out;
+    FrozenMap<std::string_view, FrozenSet<SkillID>> class_map_easy_mode_match_to_gray_out;
+    FrozenMap<std::string_view, FrozenSet<SkillID>> class_map_special_match_to_gray_out;
+    FrozenMap<std::string_view, FrozenSet<SkillID>> class_map_easy_mode_drop_match;
 };
 
 enum class DownloadState : uint8_t
@@ -576,12 +671,3 @@ struct SkillDetectionTimers
     bool is_first_check_for_next_next = true;
     bool is_first_check_for_next_next_next = true;
 };
-
-enum class BuildCategory
-{
-    RED_CROSSED,
-    ORANGE_CROSSED,
-    GREEN_TICKED,
-    YELLOW_TICKED,
-    UNTESTED
-};
@@ -7,7 +7,6 @@
 #include <vector>
 
 #include "FileUtils.h"
-#include "Shared.h"
 #include "SkillData.h"
 #include "Types.h"
 
@@ -698,11 +697,10 @@ std::pair<Keys, Modifiers> get_keybind_for_skill_type(SkillSlot skill_slot,
     return std::make_pair(Keys::NONE, Modifiers::NONE);
 }
 
-SkillID SafeConvertToSkillID(uint64_t skill_id_raw)
+SkillID SafeConvertToSkillID(uint64_t skill_id_raw, const SkillDataMap &skill_data_map)
 {
     auto skill_id = static_cast<SkillID>(skill_id_raw);
 
-    const auto &skill_data_map = Globals::RotationRun.skill_data_map;
     if (skill_data_map.find(skill_id) == skill_data_map.end())
     {
         if (SkillRuleData::unk_skill_id_fix.find(skill_id_raw) != SkillRuleData::unk_skill_id_fix.end())
@@ -36,7 +36,7 @@ std::string download_state_to_string(DownloadState state);
 
 std::string weapon_type_to_string(WeaponType weapon_type);
 
-SkillID SafeConvertToSkillID(uint64_t skill_id_raw);
+SkillID SafeConvertToSkillID(uint64_t skill_id_raw, const SkillDataMap &skill_data_map);
 
 std::string windows_key_to_string(WindowsKeys key);
 
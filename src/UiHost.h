@@ -0,0 +1,49 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "IconCache.h"
+#include "Types.h"
+
+struct ImDrawList;
+
+// Everything the addon windows need from the shell around them. The addon
+// implements it with Nexus, Mumble and D3D11 (AddonHostType), the render harness
+// without them, so the windows build against plain ImGui on every platform.
+class UiHostType
+{
+public:
+    virtual ~UiHostType() = default;
+
+    // Player and map, from Mumble in the addon
+    virtual bool is_valid_map() const = 0;
+    virtual bool is_in_combat() const = 0;
+    virtual unsigned int get_map_id() const = 0;
+    virtual ProfessionID get_profession() const = 0;
+    virtual EliteSpecID get_elite_spec() const = 0;
+    // Empty if the profession is not known yet
+    virtual std::string get_profession_name() const = 0;
+
+    // Prefers the atlas and falls back to the single icon texture, empty if the icon is not loaded
+    virtual SkillIconView get_skill_icon(const int icon_id) const = 0;
+    // Icons drawn between these two use the mip mapped icon sampler
+    virtual void begin_icon_draws(ImDrawList *draw_list) const = 0;
+    virtual void end_icon_draws(ImDrawList *draw_list) const = 0;
+
+    // Drops the icons of the loaded build, before the next build is loaded
+    virtual void release_build_icons() = 0;
+    // Takes the icons of the loaded build from the icon cache and requests the missing ones
+    virtual void acquire_build_icons() = 0;
+    // Downloads the icons of the loaded build that are not on disk yet
+    virtual void start_icon_downloads() = 0;
+    virtual std::optional<IconCacheStats> get_icon_cache_stats() const = 0;
+
+    virtual void restart_rotation(const bool not_ooc_triggered) = 0;
+    // Downloads the bench data into the addon directory on a detached thread
+    virtual void download_bench_data() = 0;
+    // Opens the file dialog for the keybinds XML
+    virtual void select_keybinds_file() = 0;
+    // Opens a URL in the browser or a file in its default program
+    virtual void open_in_shell(const std::string &target) = 0;
+};
@@ -0,0 +1,32 @@
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Types.h"
+#include "UiShared.h"
+#include "Version.h"
+
+namespace Globals
+{
+RotationLogType RotationRun{};
+std::filesystem::path SettingsPath;
+float SkillIconSize = 28.0F;
+std::string VersionString = std::string{VERSION_STRING};
+std::string BenchFilesLowerVersionString = std::string{LOWER_VERSION_RANGE};
+std::string BenchFilesUpperVersionString = std::string{UPPER_VERSION_RANGE};
+
+RenderDataType RenderData{};
+OptionsRenderType OptionsRender{};
+RotationRenderType RotationRender{};
+UiHostType *UiHost = nullptr;
+
+DownloadState BenchDataDownloadState = DownloadState::NOT_STARTED;
+bool ExtractedBenchData = false;
+
+bool IsSameCast = false;
+InternedString LastArcEventSkillName = InternedString{};
+
+std::vector<uint32_t> CurrentlyPressedKeys = {};
+
+}; // namespace Globals
@@ -0,0 +1,42 @@
+#ifndef UI_SHARED_H
+#define UI_SHARED_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "LogData.h"
+#include "OptionsRender.h"
+#include "RenderData.h"
+#include "RotationRender.h"
+#include "Types.h"
+#include "UiHost.h"
+
+// The globals of the addon windows. They build without the Windows API, the
+// rest of the addon state is in Shared.h and reaches the windows through UiHost.
+namespace Globals
+{
+extern RotationLogType RotationRun;
+extern std::filesystem::path SettingsPath;
+extern float SkillIconSize;
+extern std::string VersionString;
+extern std::string BenchFilesLowerVersionString;
+extern std::string BenchFilesUpperVersionString;
+
+extern RenderDataType RenderData;
+extern OptionsRenderType OptionsRender;
+extern RotationRenderType RotationRender;
+extern UiHostType *UiHost;
+
+extern DownloadState BenchDataDownloadState;
+extern bool ExtractedBenchData;
+
+extern bool IsSameCast;
+extern InternedString LastArcEventSkillName;
+
+extern std::vector<uint32_t> CurrentlyPressedKeys;
+
+}; // namespace Globals
+
+#endif
@@ -0,0 +1,387 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "Inflate.h"
+#include "MappedFile.h"
+#include "ZipArchive.h"
+
+namespace
+{
+constexpr auto LOCAL_HEADER_SIGNATURE = uint32_t{0x04034b50};
+constexpr auto CENTRAL_HEADER_SIGNATURE = uint32_t{0x02014b50};
+constexpr auto END_OF_CENTRAL_DIR_SIGNATURE = uint32_t{0x06054b50};
+constexpr auto ZIP64_END_OF_CENTRAL_DIR_SIGNATURE = uint32_t{0x06064b50};
+constexpr auto ZIP64_LOCATOR_SIGNATURE = uint32_t{0x07064b50};
+constexpr auto ZIP64_EXTRA_FIELD_ID = uint16_t{0x0001};
+
+constexpr auto LOCAL_HEADER_SIZE = size_t{30};
+constexpr auto CENTRAL_HEADER_SIZE = size_t{46};
+constexpr auto END_OF_CENTRAL_DIR_SIZE = size_t{22};
+constexpr auto ZIP64_END_OF_CENTRAL_DIR_SIZE = size_t{56};
+constexpr auto ZIP64_LOCATOR_SIZE = size_t{20};
+constexpr auto MAX_COMMENT_SIZE = size_t{0xFFFF};
+
+constexpr auto METHOD_STORED = uint16_t{0};
+constexpr auto METHOD_DEFLATED = uint16_t{8};
+constexpr auto FLAG_ENCRYPTED = uint16_t{0x0001};
+
+constexpr auto WRITE_CHUNK_SIZE = size_t{64 * 1024};
+
+// Slicing-by-8 tables, table[k][b] is the CRC of byte b followed by k zero bytes
+constexpr auto CRC_TABLES = []() {
+    auto tables = std::array<std::array<uint32_t, 256>, 8>{};
+    for (auto byte = uint32_t{0}; byte < 256; ++byte)
+    {
+        auto crc = byte;
+        for (auto bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        tables[0][byte] = crc;
+    }
+
+    for (auto byte = size_t{0}; byte < 256; ++byte)
+    {
+        for (auto slice = size_t{1}; slice < tables.size(); ++slice)
+            tables[slice][byte] = (tables[slice - 1][byte] >> 8) ^ tables[0][tables[slice - 1][byte] & 0xFF];
+    }
+
+    return tables;
+}();
+
+template <typename T>
+T read_le(const char *data)
+{
+    auto value = T{};
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// Replaces the 32 bit fields marked with 0xFFFFFFFF by their ZIP64 extra field values
+bool read_zip64_extra_field(std::string_view extra, ZipEntry &entry)
+{
+    while (extra.size() >= 4)
+    {
+        const auto id = read_le<uint16_t>(extra.data());
+        const auto size = size_t{read_le<uint16_t>(extra.data() + 2)};
+        if (size > extra.size() - 4)
+            return false;
+
+        if (id == ZIP64_EXTRA_FIELD_ID)
+        {
+            auto field = extra.substr(4, size);
+            for (auto *value : {&entry.uncompressed_size, &entry.compressed_size, &entry.local_header_offset})
+            {
+                if (*value != 0xFFFFFFFF)
+                    continue;
+                if (field.size() < 8)
+                    return false;
+
+                *value = read_le<uint64_t>(field.data());
+                field.remove_prefix(8);
+            }
+            return true;
+        }
+
+        extra.remove_prefix(4 + size);
+    }
+
+    return true;
+}
+
+bool find_central_directory(std::string_view data, uint64_t &offset, uint64_t &size, uint64_t &num_entries)
+{
+    if (data.size() < END_OF_CENTRAL_DIR_SIZE)
+        return false;
+
+    // The record sits at the end, only followed by a comment of at most 64 KiB
+    const auto search_end = data.size() - END_OF_CENTRAL_DIR_SIZE;
+    const auto search_begin = search_end > MAX_COMMENT_SIZE ? search_end - MAX_COMMENT_SIZE : size_t{0};
+
+    auto record_pos = search_end + 1;
+    for (auto pos = search_end + 1; pos-- > search_begin;)
+    {
+        if (read_le<uint32_t>(data.data() + pos) == END_OF_CENTRAL_DIR_SIGNATURE)
+        {
+            record_pos = pos;
+            break;
+        }
+    }
+    if (record_pos > search_end)
+        return false;
+
+    const auto *record = data.data() + record_pos;
+    if (read_le<uint16_t>(record + 4) != 0 || read_le<uint16_t>(record + 6) != 0)
+        return false;
+
+    num_entries = read_le<uint16_t>(record + 10);
+    size = read_le<uint32_t>(record + 12);
+    offset = read_le<uint32_t>(record + 16);
+
+    const auto is_zip64 = num_entries == 0xFFFF || size == 0xFFFFFFFF || offset == 0xFFFFFFFF;
+    if (!is_zip64)
+        return true;
+
+    if (record_pos < ZIP64_LOCATOR_SIZE)
+        return false;
+
+    const auto *locator = record - ZIP64_LOCATOR_SIZE;
+    if (read_le<uint32_t>(locator) != ZIP64_LOCATOR_SIGNATURE)
+        return false;
+
+    const auto zip64_pos = read_le<uint64_t>(locator + 8);
+    if (zip64_pos > data.size() || data.size() - zip64_pos < ZIP64_END_OF_CENTRAL_DIR_SIZE)
+        return false;
+
+    const auto *zip64_record = data.data() + zip64_pos;
+    if (read_le<uint32_t>(zip64_record) != ZIP64_END_OF_CENTRAL_DIR_SIGNATURE)
+        return false;
+
+    num_entries = read_le<uint64_t>(zip64_record + 32);
+    size = read_le<uint64_t>(zip64_record + 40);
+    offset = read_le<uint64_t>(zip64_record + 48);
+    return true;
+}
+} // namespace
+
+ZipStatus ZipArchiveType::open(const std::filesystem::path &path)
+{
+    close();
+
+    if (!file.open(path))
+        return ZipStatus::OPEN_FAILED;
+
+    const auto data = file.view();
+
+    auto cd_offset = uint64_t{0};
+    auto cd_size = uint64_t{0};
+    auto num_entries = uint64_t{0};
+    if (!find_central_directory(data, cd_offset, cd_size, num_entries) || cd_offset > data.size() ||
+        cd_size > data.size() - cd_offset || num_entries > cd_size / CENTRAL_HEADER_SIZE)
+    {
+        close();
+        return ZipStatus::INVALID_ARCHIVE;
+    }
+
+    auto directory = data.substr(cd_offset, cd_size);
+    entries.reserve(num_entries);
+    for (auto idx = uint64_t{0}; idx < num_entries; ++idx)
+    {
+        if (directory.size() < CENTRAL_HEADER_SIZE || read_le<uint32_t>(directory.data()) != CENTRAL_HEADER_SIGNATURE)
+        {
+            close();
+            return ZipStatus::INVALID_ARCHIVE;
+        }
+
+        const auto *header = directory.data();
+        const auto name_size = size_t{read_le<uint16_t>(header + 28)};
+        const auto extra_size = size_t{read_le<uint16_t>(header + 30)};
+        const auto comment_size = size_t{read_le<uint16_t>(header + 32)};
+        const auto record_size = CENTRAL_HEADER_SIZE + name_size + extra_size + comment_size;
+        if (record_size > directory.size())
+        {
+            close();
+            return ZipStatus::INVALID_ARCHIVE;
+        }
+
+        auto entry = ZipEntry{};
+        entry.flags = read_le<uint16_t>(header + 8);
+        entry.method = read_le<uint16_t>(header + 10);
+        entry.crc32 = read_le<uint32_t>(header + 16);
+        entry.compressed_size = read_le<uint32_t>(header + 20);
+        entry.uncompressed_size = read_le<uint32_t>(header + 24);
+        entry.local_header_offset = read_le<uint32_t>(header + 42);
+        entry.name = std::string{directory.substr(CENTRAL_HEADER_SIZE, name_size)};
+
+        if (!read_zip64_extra_field(directory.substr(CENTRAL_HEADER_SIZE + name_size, extra_size), entry))
+        {
+            close();
+            return ZipStatus::INVALID_ARCHIVE;
+        }
+
+        entries.push_back(std::move(entry));
+        directory.remove_prefix(record_size);
+    }
+
+    return ZipStatus::OK;
+}
+
+void ZipArchiveType::close()
+{
+    entries.clear();
+    file.close();
+}
+
+ZipStatus ZipArchiveType::extract(const ZipEntry &entry, const std::filesystem::path &extract_path) const
+{
+    const auto out_path = get_zip_entry_path(extract_path, entry.name);
+    if (out_path.empty())
+        return ZipStatus::UNSAFE_PATH;
+
+    auto ec = std::error_code{};
+    if (entry.is_directory())
+    {
+        std::filesystem::create_directories(out_path, ec);
+        return ec ? ZipStatus::WRITE_FAILED : ZipStatus::OK;
+    }
+
+    if ((entry.flags & FLAG_ENCRYPTED) != 0 || (entry.method != METHOD_STORED && entry.method != METHOD_DEFLATED))
+        return ZipStatus::UNSUPPORTED_ENTRY;
+
+    const auto data = file.view();
+    if (entry.local_header_offset > data.size() || data.size() - entry.local_header_offset < LOCAL_HEADER_SIZE)
+        return ZipStatus::INVALID_ARCHIVE;
+
+    const auto *local_header = data.data() + entry.local_header_offset;
+    if (read_le<uint32_t>(local_header) != LOCAL_HEADER_SIGNATURE)
+        return ZipStatus::INVALID_ARCHIVE;
+
+    // Sizes come from the central directory, local headers written with a data descriptor have them zeroed
+    const auto data_offset = entry.local_header_offset + LOCAL_HEADER_SIZE + read_le<uint16_t>(local_header + 26) +
+                             read_le<uint16_t>(local_header + 28);
+    if (data_offset > data.size() || entry.compressed_size > data.size() - data_offset)
+        return ZipStatus::INVALID_ARCHIVE;
+
+    std::filesystem::create_directories(out_path.parent_path(), ec);
+
+    auto part_path = out_path;
+    part_path += ".part";
+
+    auto status = ZipStatus::OK;
+    auto crc = uint32_t{0};
+    auto bytes_written = uint64_t{0};
+    {
+        auto out_file = std::ofstream{part_path, std::ios::binary | std::ios::trunc};
+        if (!out_file.is_open())
+            return ZipStatus::WRITE_FAILED;
+
+        const auto write = [&](const uint8_t *chunk, size_t chunk_size) {
+            if (chunk_size > entry.uncompressed_size - bytes_written)
+                return false;
+
+            crc = update_crc32(crc, chunk, chunk_size);
+            bytes_written += chunk_size;
+            out_file.write(reinterpret_cast<const char *>(chunk), static_cast<std::streamsize>(chunk_size));
+            return out_file.good();
+        };
+
+        const auto *compressed = reinterpret_cast<const uint8_t *>(data.data() + data_offset);
+        if (entry.method == METHOD_STORED)
+        {
+            if (entry.compressed_size != entry.uncompressed_size)
+                status = ZipStatus::INVALID_DATA;
+
+            for (auto offset = uint64_t{0}; status == ZipStatus::OK && offset < entry.compressed_size;)
+            {
+                const auto remaining = entry.compressed_size - offset;
+                const auto chunk_size = static_cast<size_t>(std::min<uint64_t>(WRITE_CHUNK_SIZE, remaining));
+                if (!write(compressed + offset, chunk_size))
+                    status = out_file.good() ? ZipStatus::INVALID_DATA : ZipStatus::WRITE_FAILED;
+                offset += chunk_size;
+            }
+        }
+        else
+        {
+            const auto inflate_status = inflate_raw(compressed, static_cast<size_t>(entry.compressed_size), write);
+            if (inflate_status == InflateStatus::SINK_FAILED && !out_file.good())
+                status = ZipStatus::WRITE_FAILED;
+            else if (inflate_status != InflateStatus::OK)
+                status = ZipStatus::INVALID_DATA;
+        }
+
+        out_file.flush();
+        if (status == ZipStatus::OK && !out_file.good())
+            status = ZipStatus::WRITE_FAILED;
+    }
+
+    if (status == ZipStatus::OK && bytes_written != entry.uncompressed_size)
+        status = ZipStatus::INVALID_DATA;
+    if (status == ZipStatus::OK && crc != entry.crc32)
+        status = ZipStatus::CRC_MISMATCH;
+
+    if (status == ZipStatus::OK)
+    {
+        std::filesystem::rename(part_path, out_path, ec);
+        if (!ec)
+            return ZipStatus::OK;
+        status = ZipStatus::WRITE_FAILED;
+    }
+
+    std::filesystem::remove(part_path, ec);
+    return status;
+}
+
+ZipStatus ZipArchiveType::extract_all(const std::filesystem::path &extract_path) const
+{
+    for (const auto &entry : entries)
+    {
+        const auto status = extract(entry, extract_path);
+        if (status != ZipStatus::OK)
+            return status;
+    }
+
+    return ZipStatus::OK;
+}
+
+uint32_t update_crc32(uint32_t crc, const uint8_t *data, const size_t size)
+{
+    crc = ~crc;
+
+    auto idx = size_t{0};
+    for (; idx + 8 <= size; idx += 8)
+    {
+        const auto low = read_le<uint32_t>(reinterpret_cast<const char *>(data + idx)) ^ crc;
+        const auto high = read_le<uint32_t>(reinterpret_cast<const char *>(data + idx + 4));
+        crc = CRC_TABLES[7][low & 0xFF] ^ CRC_TABLES[6][(low >> 8) & 0xFF] ^ CRC_TABLES[5][(low >> 16) & 0xFF] ^
+              CRC_TABLES[4][low >> 24] ^ CRC_TABLES[3][high & 0xFF] ^ CRC_TABLES[2][(high >> 8) & 0xFF] ^
+              CRC_TABLES[1][(high >> 16) & 0xFF] ^ CRC_TABLES[0][high >> 24];
+    }
+
+    for (; idx < size; ++idx)
+        crc = (crc >> 8) ^ CRC_TABLES[0][(crc ^ data[idx]) & 0xFF];
+
+    return ~crc;
+}
+
+std::filesystem::path get_zip_entry_path(const std::filesystem::path &extract_path, const std::string &name)
+{
+    const auto relative_path = std::filesystem::path{std::u8string{name.begin(), name.end()}}.lexically_normal();
+    if (relative_path.empty() || relative_path.has_root_name() || relative_path.has_root_directory())
+        return {};
+
+    const auto first = relative_path.begin();
+    if (first == relative_path.end() || *first == "..")
+        return {};
+
+    return extract_path / relative_path;
+}
+
+std::string zip_status_to_string(const ZipStatus status)
+{
+    switch (status)
+    {
+    case ZipStatus::OK:
+        return "OK";
+    case ZipStatus::OPEN_FAILED:
+        return "Could not open the archive";
+    case ZipStatus::INVALID_ARCHIVE:
+        return "Invalid archive";
+    case ZipStatus::UNSUPPORTED_ENTRY:
+        return "Unsupported entry";
+    case ZipStatus::UNSAFE_PATH:
+        return "Entry path leaves the extraction folder";
+    case ZipStatus::INVALID_DATA:
+        return "Invalid compressed data";
+    case ZipStatus::CRC_MISMATCH:
+        return "CRC mismatch";
+    case ZipStatus::WRITE_FAILED:
+        return "Could not write the extracted file";
+    }
+
+    return "Unknown";
+}
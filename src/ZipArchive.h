@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+enum class ZipStatus : uint8_t
+{
+    OK,
+    OPEN_FAILED,
+    INVALID_ARCHIVE,
+    UNSUPPORTED_ENTRY,
+    UNSAFE_PATH,
+    INVALID_DATA,
+    CRC_MISMATCH,
+    WRITE_FAILED,
+};
+
+struct ZipEntry
+{
+    std::string name; // Forward slashes, as stored in the archive
+    uint16_t method = 0;
+    uint16_t flags = 0;
+    uint32_t crc32 = 0;
+    uint64_t compressed_size = 0;
+    uint64_t uncompressed_size = 0;
+    uint64_t local_header_offset = 0;
+
+    bool is_directory() const
+    {
+        return !name.empty() && name.back() == '/';
+    }
+};
+
+// Reads a ZIP file through a memory mapping and extracts stored and deflated
+// entries without loading them into memory. Only the central directory is
+// parsed on open, multi-disk and encrypted archives are rejected.
+class ZipArchiveType
+{
+public:
+    ZipStatus open(const std::filesystem::path &path);
+    void close();
+
+    bool is_open() const
+    {
+        return file.is_open();
+    }
+    const std::vector<ZipEntry> &get_entries() const
+    {
+        return entries;
+    }
+
+    // The file is written next to its target and renamed once size and CRC
+    // match, so a failed extraction never leaves a partial file behind
+    ZipStatus extract(const ZipEntry &entry, const std::filesystem::path &extract_path) const;
+    ZipStatus extract_all(const std::filesystem::path &extract_path) const;
+
+private:
+    MappedFileType file;
+    std::vector<ZipEntry> entries;
+};
+
+uint32_t update_crc32(uint32_t crc, const uint8_t *data, const size_t size);
+
+// Joins the entry name to extract_path, empty if it is absolute or leaves extract_path
+std::filesystem::path get_zip_entry_path(const std::filesystem::path &extract_path, const std::string &name);
+
+std::string zip_status_to_string(const ZipStatus status);
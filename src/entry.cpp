@@ -1,6 +1,7 @@
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -16,16 +17,23 @@
 #include "nexus/Nexus.h"
 #include "rtapi/RTAPI.hpp"
 
+#include "AddonFiles.h"
 #include "ArcEvents.h"
 #include "Constants.h"
+#include "Downloader.h"
 #include "FileUtils.h"
+#include "IconArchive.h"
 #include "KeyboardCapture.h"
+#include "Logger.h"
 #include "MumbleUtils.h"
+#include "Profiler.h"
 #include "Render.h"
 #include "Settings.h"
 #include "Shared.h"
 #include "TEX_GW2RotaHelperHOVER_data.h"
 #include "TEX_GW2RotaHelperNORMAL_data.h"
+#include "TextureLoader.h"
+#include "Textures.h"
 #include "Version.h"
 
 namespace dx = DirectX;
@@ -42,6 +50,38 @@ AddonDefinition_t AddonDef{};
 std::filesystem::path AddonPath;
 ID3D11Device *pd3dDevice = nullptr;
 
+namespace
+{
+// Forwards the log messages of the core to the Nexus log
+class NexusLoggerType final : public LoggerType
+{
+public:
+    void log(const LogLevel level, const char *message) override
+    {
+        if (Globals::APIDefs)
+            (void)Globals::APIDefs->Log(to_nexus_log_level(level), "GW2RotaHelper", message);
+    }
+
+private:
+    static ELogLevel to_nexus_log_level(const LogLevel level)
+    {
+        switch (level)
+        {
+        case LogLevel::CRITICAL:
+            return LOGL_CRITICAL;
+        case LogLevel::WARNING:
+            return LOGL_WARNING;
+        case LogLevel::INFO:
+            return LOGL_INFO;
+        default:
+            return LOGL_DEBUG;
+        }
+    }
+};
+
+NexusLoggerType NexusLogger;
+} // namespace
+
 void ToggleShowWindowGW2_RotaHelper(const char *, bool isKeyDown)
 {
     static bool wasKeyPressed = false;
@@ -134,6 +174,8 @@ void AddonLoad(AddonAPI_t *aApi)
     keyboardCapture.Initialize(aApi->WndProc_Register, aApi->WndProc_Deregister);
 
     Globals::APIDefs = aApi;
+    Globals::UiHost = &Globals::AddonHost;
+    set_logger(&NexusLogger);
     ImGui::SetCurrentContext((ImGuiContext *)Globals::APIDefs->ImguiContext);
     ImGui::SetAllocatorFunctions((void *(*)(size_t, void *))Globals::APIDefs->ImguiMalloc,
                                  (void (*)(void *, void *))Globals::APIDefs->ImguiFree);
@@ -183,6 +225,11 @@ void AddonLoad(AddonAPI_t *aApi)
         }
     }
 
+    Globals::DownloadService = std::make_unique<DownloadServiceType>(make_wininet_transport);
+    Globals::TextureLoader =
+        std::make_unique<TextureLoaderType>(make_skill_icon_decoder_factory(Globals::IconArchive));
+    Globals::IconCache = std::make_unique<SkillIconCacheType>(ReleaseSkillTexture);
+
     Globals::Render.set_data_path(data_path);
 
     Settings::Load(Globals::SettingsPath);
@@ -221,6 +268,17 @@ void AddonUnload()
 
     KeyboardCapture::GetInstance().Shutdown();
 
+    Globals::DownloadService.reset();
+    Globals::TextureLoader.reset();
+    Globals::IconAtlas.release();
+    Globals::IconSampler.release();
+    Globals::CancelIconArchiveBuild = true;
+    if (Globals::IconArchiveBuild.valid())
+        Globals::IconArchiveBuild.wait();
+    Globals::IconArchive.close();
+    Globals::TextureMap.clear();
+    Globals::IconCache.reset();
+
     Globals::APIDefs->GUI_Deregister(AddonRender);
     Globals::APIDefs->GUI_Deregister(AddonOptions);
 
@@ -228,11 +286,13 @@ void AddonUnload()
     Globals::RTAPIData = nullptr;
 
     Settings::Save(Globals::SettingsPath);
+    Settings::Flush();
 
     DeregisterQuickAccessShortcut();
 
     Globals::APIDefs->Events_Unsubscribe("EV_ARCDPS_COMBATEVENT_LOCAL_RAW", ArcEv::OnCombatLocal);
     (void)Globals::APIDefs->Log(LOGL_DEBUG, "GW2RotaHelper", "Unloaded Addon");
+    set_logger(nullptr);
 }
 
 void TriggerParseMumble()
@@ -281,6 +341,8 @@ void TriggerParseMumble()
 
 void AddonRender()
 {
+    const auto profile_scope = ProfileScopeType{ProfileZone::ADDON_RENDER};
+
     static auto profession = ProfessionID::UNKNOWN;
 
     if ((!Globals::NexusLink) || (!Globals::NexusLink->IsGameplay) || (!Settings::ShowWindow))
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "AtlasBuilder.h"
+#include "TextureLoader.h"
+
+#include "Tests.h"
+
+namespace
+{
+// Every pixel encodes its position and the icon, so misplaced copies show up
+DecodedImage make_image(const uint32_t width, const uint32_t height, const uint8_t icon_tag)
+{
+    auto image = DecodedImage{};
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (auto y = uint32_t{0}; y < height; ++y)
+    {
+        for (auto x = uint32_t{0}; x < width; ++x)
+        {
+            auto *pixel = image.pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+            pixel[0] = static_cast<uint8_t>(x);
+            pixel[1] = static_cast<uint8_t>(y);
+            pixel[2] = icon_tag;
+            pixel[3] = 255;
+        }
+    }
+
+    return image;
+}
+
+const uint8_t *get_pixel(const DecodedImage &image, const uint32_t x, const uint32_t y)
+{
+    return image.pixels.data() + (static_cast<size_t>(y) * image.width + x) * 4;
+}
+
+bool is_same_pixel(const uint8_t *lhs, const uint8_t *rhs)
+{
+    return std::memcmp(lhs, rhs, 4) == 0;
+}
+
+// The padded slots of two icons on the same page must not share a pixel
+bool is_overlapping(const AtlasEntry &lhs, const AtlasEntry &rhs, const uint32_t padding)
+{
+    if (lhs.page != rhs.page)
+        return false;
+
+    const auto lhs_x0 = lhs.rect.x - padding;
+    const auto lhs_y0 = lhs.rect.y - padding;
+    const auto rhs_x0 = rhs.rect.x - padding;
+    const auto rhs_y0 = rhs.rect.y - padding;
+    const auto lhs_x1 = lhs.rect.x + lhs.rect.width + padding;
+    const auto lhs_y1 = lhs.rect.y + lhs.rect.height + padding;
+    const auto rhs_x1 = rhs.rect.x + rhs.rect.width + padding;
+    const auto rhs_y1 = rhs.rect.y + rhs.rect.height + padding;
+
+    return lhs_x0 < rhs_x1 && rhs_x0 < lhs_x1 && lhs_y0 < rhs_y1 && rhs_y0 < lhs_y1;
+}
+
+void test_packs_without_overlap(TestContextType &ctx)
+{
+    const auto config = AtlasConfig{};
+    auto builder = AtlasBuilderType{config};
+
+    // Mixed icon sizes like the shipped ones, from a fixed LCG
+    constexpr auto num_icons = 300;
+    auto seed = uint32_t{12345};
+    for (auto icon_id = 0; icon_id < num_icons; ++icon_id)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const auto width = 16 + (seed >> 8) % 49;
+        const auto height = 16 + (seed >> 16) % 49;
+        builder.add(icon_id, make_image(width, height, static_cast<uint8_t>(icon_id)));
+    }
+    builder.add(num_icons, DecodedImage{});
+
+    ctx.check(builder.build(), "everything fits");
+    ctx.check_equal(builder.get_num_images(), size_t{num_icons}, "empty images are ignored");
+    ctx.check_equal(builder.get_pages().size(), size_t{1}, "one page");
+
+    const auto &entries = builder.get_entries();
+    if (!ctx.check_equal(entries.size(), size_t{num_icons}, "every icon has an entry"))
+        return;
+
+    for (const auto &[icon_id, entry] : entries)
+    {
+        const auto &page = builder.get_pages()[entry.page];
+        const auto name = "icon " + std::to_string(icon_id);
+        ctx.check(entry.rect.x >= config.padding && entry.rect.y >= config.padding, name + " padding");
+        ctx.check(entry.rect.x + entry.rect.width + config.padding <= page.width &&
+                      entry.rect.y + entry.rect.height + config.padding <= page.height,
+                  name + " inside the page");
+        ctx.check((entry.rect.x - config.padding) % config.alignment == 0 &&
+                      (entry.rect.y - config.padding) % config.alignment == 0,
+                  name + " aligned");
+        ctx.check(std::abs(entry.u0 * static_cast<float>(page.width) - static_cast<float>(entry.rect.x)) < 1e-3f &&
+                      std::abs(entry.v1 * static_cast<float>(page.height) -
+                               static_cast<float>(entry.rect.y + entry.rect.height)) < 1e-3f,
+                  name + " uv");
+    }
+
+    auto num_overlaps = 0;
+    for (auto lhs = entries.begin(); lhs != entries.end(); ++lhs)
+    {
+        for (auto rhs = std::next(lhs); rhs != entries.end(); ++rhs)
+            num_overlaps += is_overlapping(lhs->second, rhs->second, config.padding) ? 1 : 0;
+    }
+    ctx.check_equal(num_overlaps, 0, "no overlapping slots");
+
+    // The shelves of sorted heights leave little room, the padding takes the most
+    ctx.check(builder.get_fill_ratio() > 0.6, "fill ratio " + std::to_string(builder.get_fill_ratio()));
+}
+
+void test_spills_into_pages(TestContextType &ctx)
+{
+    auto config = AtlasConfig{};
+    config.page_size = 128;
+    auto builder = AtlasBuilderType{config};
+
+    // Slots of 36x36, three by three per page
+    for (auto icon_id = 0; icon_id < 40; ++icon_id)
+        builder.add(icon_id, make_image(32, 32, static_cast<uint8_t>(icon_id)));
+
+    ctx.check(builder.build(), "everything fits");
+    if (!ctx.check_equal(builder.get_pages().size(), size_t{5}, "five pages"))
+        return;
+
+    for (const auto &page : builder.get_pages())
+        ctx.check(page.width <= 128 && page.height <= 128, "page size");
+    ctx.check_equal(builder.get_pages().back().height, uint32_t{72}, "the last page is cut to its two shelves");
+    ctx.check_equal(builder.get_entries().at(39).page, uint32_t{4}, "last icon");
+}
+
+void test_oversized_icon_is_left_out(TestContextType &ctx)
+{
+    auto config = AtlasConfig{};
+    config.page_size = 64;
+    auto builder = AtlasBuilderType{config};
+    builder.add(1, make_image(64, 8, 1));
+    builder.add(2, make_image(16, 16, 2));
+
+    ctx.check(!builder.build(), "the wide icon does not fit");
+    ctx.check(!builder.get_entries().contains(1), "left out");
+    ctx.check(builder.get_entries().contains(2), "the rest is packed");
+}
+
+void test_blit_fills_padding(TestContextType &ctx)
+{
+    auto config = AtlasConfig{};
+    config.padding = 2;
+    auto builder = AtlasBuilderType{config};
+
+    const auto image = make_image(5, 3, 7);
+    builder.add(7, image);
+    ctx.check(builder.build(), "build");
+
+    const auto &page = builder.get_pages().at(0);
+    const auto &rect = builder.get_entries().at(7).rect;
+    const auto padding = static_cast<int>(config.padding);
+
+    for (auto y = -padding; y < static_cast<int>(rect.height) + padding; ++y)
+    {
+        for (auto x = -padding; x < static_cast<int>(rect.width) + padding; ++x)
+        {
+            // Outside the icon the nearest edge pixel is repeated
+            const auto src_x = static_cast<uint32_t>(std::clamp(x, 0, static_cast<int>(image.width) - 1));
+            const auto src_y = static_cast<uint32_t>(std::clamp(y, 0, static_cast<int>(image.height) - 1));
+            const auto *dst = get_pixel(page, rect.x + x, rect.y + y);
+            ctx.check(is_same_pixel(dst, get_pixel(image, src_x, src_y)),
+                      "pixel " + std::to_string(x) + "," + std::to_string(y));
+        }
+    }
+}
+
+void test_page_mips(TestContextType &ctx)
+{
+    auto builder = AtlasBuilderType{};
+    for (auto icon_id = 0; icon_id < 8; ++icon_id)
+        builder.add(icon_id, make_image(64, 64, static_cast<uint8_t>(icon_id)));
+    ctx.check(builder.build(), "build");
+    builder.generate_page_mips();
+
+    // A padding of 2 and slots aligned to 4 keep one level inside the slots
+    const auto &page = builder.get_pages().at(0);
+    if (!ctx.check_equal(page.mips.size(), size_t{1}, "one mip level"))
+        return;
+    ctx.check(page.mips[0].width == page.width / 2 && page.mips[0].height == page.height / 2, "half size");
+}
+} // namespace
+
+void add_atlas_builder_tests(TestRunnerType &runner)
+{
+    runner.add("atlas_builder/packs_without_overlap", test_packs_without_overlap);
+    runner.add("atlas_builder/spills_into_pages", test_spills_into_pages);
+    runner.add("atlas_builder/oversized_icon_is_left_out", test_oversized_icon_is_left_out);
+    runner.add("atlas_builder/blit_fills_padding", test_blit_fills_padding);
+    runner.add("atlas_builder/page_mips", test_page_mips);
+}
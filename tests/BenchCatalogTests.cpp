@@ -0,0 +1,101 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "BenchCatalog.h"
+
+#include "Tests.h"
+
+namespace
+{
+void write_text(const std::filesystem::path &path, const std::string &text)
+{
+    std::filesystem::create_directories(path.parent_path());
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file << text;
+}
+
+void write_build(const std::filesystem::path &path, const std::string &name)
+{
+    write_text(path,
+               "{\"buildMetadata\": {\"name\": \"" + name +
+                   "\", \"profession\": \"Engineer\", \"elite_spec\": \"Holosmith\", \"overall_dps\": 40000}, "
+                   "\"rotation\": [], \"SkillKeyMapping\": {\"slot_7\": 5, \"slot_8\": -1, \"slot_9\": 9}}");
+}
+
+void test_load_rejects_missing_keys(TestContextType &ctx)
+{
+    const auto catalog_path = ctx.get_temp_path() / "bench_catalog.json";
+
+    static constexpr const char *broken_catalogs[] = {
+        R"({"version": 2, "directories": {}})",
+        R"({"version": 2, "files": {}})",
+        R"({"version": 2, "directories": {"": {"subdirs": [], "files": []}}, "files": {}})",
+        R"({"version": 2, "directories": {}, "files": {"a.json": {"size": 1, "mtime": 2}}})",
+        R"({"version": 2, "directories": {"": {"mtime": 1, "subdirs": [], "files": [)",
+    };
+
+    for (const auto *text : broken_catalogs)
+    {
+        write_text(catalog_path, text);
+
+        auto catalog = BenchCatalogType{};
+        ctx.check(!catalog.load(catalog_path), text);
+        ctx.check(catalog.directories.empty() && catalog.files.empty(), "a rejected catalog is left empty");
+    }
+}
+
+void test_save_load_round_trip(TestContextType &ctx)
+{
+    const auto bench_path = ctx.get_temp_path() / "bench";
+    write_build(bench_path / "dps" / "a.json", "Build A");
+    write_build(bench_path / "dps" / "power" / "b.json", "Build B");
+
+    auto catalog = BenchCatalogType{};
+    ctx.check(catalog.refresh(bench_path), "the first refresh finds the files");
+    ctx.check(catalog.save(get_bench_catalog_path(bench_path)), "save");
+    ctx.check(!std::filesystem::exists(get_bench_catalog_path(bench_path).string() + ".tmp"), "no temp file is left");
+
+    auto loaded = BenchCatalogType{};
+    ctx.check(loaded.load(get_bench_catalog_path(bench_path)), "load");
+    ctx.check(!loaded.refresh(bench_path), "an unchanged folder needs no update");
+    ctx.check_equal(loaded.files.size(), size_t{2}, "both files are loaded");
+    ctx.check_equal(loaded.files["dps/power/b.json"].build_info.name, std::string{"Build B"}, "metadata of b");
+
+    const auto &skill_key_mapping = loaded.files["dps/power/b.json"].build_info.skill_key_mapping;
+    ctx.check(skill_key_mapping.skill_7 == 5 && skill_key_mapping.skill_8 == -1 && skill_key_mapping.skill_9 == 9,
+              "skill key mapping of b");
+}
+
+void test_in_place_rewrite_is_detected(TestContextType &ctx)
+{
+    const auto bench_path = ctx.get_temp_path() / "bench";
+    const auto dir_path = bench_path / "dps";
+    const auto file_path = dir_path / "a.json";
+    write_build(file_path, "Old");
+
+    auto catalog = BenchCatalogType{};
+    (void)catalog.refresh(bench_path);
+    ctx.check_equal(catalog.files["dps/a.json"].build_info.name, std::string{"Old"}, "initial metadata");
+
+    // Same directory listing and mtime, only the content of the file changes
+    const auto dir_mtime = std::filesystem::last_write_time(dir_path);
+    const auto file_mtime = std::filesystem::last_write_time(file_path);
+    write_build(file_path, "Rewritten Build");
+    std::filesystem::last_write_time(file_path, file_mtime + std::chrono::seconds(1));
+    std::filesystem::last_write_time(dir_path, dir_mtime);
+
+    ctx.check(catalog.refresh(bench_path), "the rewritten file is reported as a change");
+    ctx.check_equal(catalog.files["dps/a.json"].build_info.name,
+                    std::string{"Rewritten Build"},
+                    "metadata is read again");
+}
+} // namespace
+
+void add_bench_catalog_tests(TestRunnerType &runner)
+{
+    runner.add("bench_catalog/load_rejects_missing_keys", test_load_rejects_missing_keys);
+    runner.add("bench_catalog/save_load_round_trip", test_save_load_round_trip);
+    runner.add("bench_catalog/in_place_rewrite_is_detected", test_in_place_rewrite_is_detected);
+}
@@ -0,0 +1,123 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CompletionQueue.h"
+
+#include "Tests.h"
+
+namespace
+{
+constexpr auto NUM_PRODUCERS = uint32_t{4};
+constexpr auto NUM_CONSUMERS = uint32_t{4};
+constexpr auto ITEMS_PER_PRODUCER = uint32_t{100000};
+
+void test_full_and_empty(TestContextType &ctx)
+{
+    auto queue = CompletionQueueType<int, 4>{};
+    auto value = -1;
+
+    ctx.check(!queue.try_pop(value), "a new queue is empty");
+    ctx.check_equal(value, -1, "a failed pop leaves the value");
+
+    // Several laps, so the sequence numbers wrap around the cells
+    for (auto lap = 0; lap < 3; ++lap)
+    {
+        const auto name = "lap " + std::to_string(lap) + " ";
+        for (auto idx = 0; idx < 4; ++idx)
+            ctx.check(queue.try_push(lap * 10 + idx), name + "push below the capacity");
+        ctx.check(!queue.try_push(99), name + "a full queue rejects the push");
+
+        for (auto idx = 0; idx < 4; ++idx)
+        {
+            ctx.check(queue.try_pop(value), name + "pop");
+            ctx.check_equal(value, lap * 10 + idx, name + "first in, first out");
+        }
+        ctx.check(!queue.try_pop(value), name + "empty after popping every item");
+    }
+
+    // One free cell after a pop from a full queue
+    for (auto idx = 0; idx < 4; ++idx)
+        (void)queue.try_push(idx);
+    ctx.check(queue.try_pop(value) && value == 0, "pop from a full queue");
+    ctx.check(queue.try_push(4), "the freed cell takes a push");
+    ctx.check(!queue.try_push(5), "full again");
+}
+
+// Items encode the producer and a running index, so every consumer sees the
+// items of one producer in order and the counts show lost or doubled items
+void test_concurrent_producers_and_consumers(TestContextType &ctx)
+{
+    auto queue = CompletionQueueType<uint32_t, 64>{};
+    auto num_delivered = std::vector<std::atomic<uint32_t>>(NUM_PRODUCERS * ITEMS_PER_PRODUCER);
+    auto num_out_of_order = std::atomic<uint32_t>{0};
+    auto num_producers_done = std::atomic<uint32_t>{0};
+
+    auto threads = std::vector<std::thread>{};
+    for (auto producer = uint32_t{0}; producer < NUM_PRODUCERS; ++producer)
+    {
+        threads.emplace_back([&queue, &num_producers_done, producer]() {
+            for (auto idx = uint32_t{0}; idx < ITEMS_PER_PRODUCER; ++idx)
+            {
+                while (!queue.try_push(producer * ITEMS_PER_PRODUCER + idx))
+                    std::this_thread::yield();
+            }
+            ++num_producers_done;
+        });
+    }
+
+    for (auto consumer = uint32_t{0}; consumer < NUM_CONSUMERS; ++consumer)
+    {
+        threads.emplace_back([&]() {
+            auto last_idx = std::vector<int64_t>(NUM_PRODUCERS, -1);
+            auto item = uint32_t{0};
+            while (true)
+            {
+                // Read before the pop, an empty queue after every producer finished stays empty
+                const auto is_done = num_producers_done == NUM_PRODUCERS;
+                if (!queue.try_pop(item))
+                {
+                    if (is_done)
+                        break;
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                ++num_delivered[item];
+                const auto producer = item / ITEMS_PER_PRODUCER;
+                const auto idx = static_cast<int64_t>(item % ITEMS_PER_PRODUCER);
+                if (idx <= last_idx[producer])
+                    ++num_out_of_order;
+                last_idx[producer] = idx;
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    auto num_lost = size_t{0};
+    auto num_doubled = size_t{0};
+    for (const auto &count : num_delivered)
+    {
+        num_lost += count == 0;
+        num_doubled += count > 1;
+    }
+
+    ctx.check_equal(num_lost, size_t{0}, "every item is delivered");
+    ctx.check_equal(num_doubled, size_t{0}, "no item is delivered twice");
+    ctx.check_equal(num_out_of_order.load(), uint32_t{0}, "the items of a producer stay in order");
+
+    auto item = uint32_t{0};
+    ctx.check(!queue.try_pop(item), "the queue is drained");
+}
+} // namespace
+
+void add_completion_queue_tests(TestRunnerType &runner)
+{
+    runner.add("completion_queue/full_and_empty", test_full_and_empty);
+    runner.add("completion_queue/concurrent_producers_and_consumers", test_concurrent_producers_and_consumers);
+}
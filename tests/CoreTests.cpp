@@ -0,0 +1,73 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Clock.h"
+#include "Logger.h"
+
+#include "Tests.h"
+
+namespace
+{
+class RecordingLoggerType final : public LoggerType
+{
+public:
+    void log(const LogLevel level, const char *message) override
+    {
+        levels.push_back(level);
+        messages.push_back(message);
+    }
+
+    std::vector<LogLevel> levels;
+    std::vector<std::string> messages;
+};
+
+class FixedClockType final : public ClockType
+{
+public:
+    std::chrono::steady_clock::time_point now() const override
+    {
+        return std::chrono::steady_clock::time_point{std::chrono::seconds(42)};
+    }
+};
+
+void test_logger_forwarding(TestContextType &ctx)
+{
+    auto logger = RecordingLoggerType{};
+
+    log_message(LogLevel::INFO, "dropped without a logger");
+
+    set_logger(&logger);
+    log_message(LogLevel::WARNING, "first");
+    log_message(LogLevel::DEBUG, std::string{"second"});
+    set_logger(nullptr);
+
+    log_message(LogLevel::INFO, "dropped again");
+
+    ctx.check_equal(logger.messages.size(), size_t{2}, "only messages while set are forwarded");
+    if (logger.messages.size() == 2)
+    {
+        ctx.check(logger.messages[0] == "first" && logger.levels[0] == LogLevel::WARNING, "first message");
+        ctx.check(logger.messages[1] == "second" && logger.levels[1] == LogLevel::DEBUG, "second message");
+    }
+}
+
+void test_clock_override(TestContextType &ctx)
+{
+    const auto fixed_clock = FixedClockType{};
+
+    set_clock(&fixed_clock);
+    ctx.check(get_clock().now() == std::chrono::steady_clock::time_point{std::chrono::seconds(42)},
+              "the set clock is used");
+
+    set_clock(nullptr);
+    const auto before = std::chrono::steady_clock::now();
+    ctx.check(get_clock().now() >= before, "nullptr restores the steady clock");
+}
+} // namespace
+
+void add_core_tests(TestRunnerType &runner)
+{
+    runner.add("core/logger_forwarding", test_logger_forwarding);
+    runner.add("core/clock_override", test_clock_override);
+}
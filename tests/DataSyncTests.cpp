@@ -0,0 +1,154 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "DataSync.h"
+#include "Downloader.h"
+#include "Sha256.h"
+
+#include "LoopbackHttp.h"
+#include "Tests.h"
+
+namespace
+{
+constexpr auto TEST_TIMEOUT = std::chrono::seconds(10);
+
+std::string read_text(const std::filesystem::path &path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+void write_text(const std::filesystem::path &path, const std::string &text)
+{
+    std::filesystem::create_directories(path.parent_path());
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file << text;
+}
+
+std::string get_sha256(const std::string &content)
+{
+    auto sha256 = Sha256Type{};
+    sha256.update(reinterpret_cast<const uint8_t *>(content.data()), content.size());
+    return sha256_to_hex(sha256.finalize());
+}
+
+std::string get_file_body(const size_t idx, const char first)
+{
+    auto body = std::string(500 + idx * 311, '\0');
+    for (auto byte_idx = size_t{0}; byte_idx < body.size(); ++byte_idx)
+        body[byte_idx] = static_cast<char>(first + (idx + byte_idx) % 26);
+
+    return body;
+}
+
+// Serves the files of the manifest below /data/ like the release tag
+DataManifest serve_manifest(LoopbackHttpServerType &server, const std::vector<std::string> &paths)
+{
+    auto manifest = DataManifest{};
+    manifest.base_url = server.get_url("/data/");
+    for (auto idx = size_t{0}; idx < paths.size(); ++idx)
+    {
+        const auto body = get_file_body(idx, 'a');
+        server.set_file(get_data_file_url("/data/", paths[idx]), body);
+        manifest.files.push_back(DataManifestFile{paths[idx], body.size(), get_sha256(body)});
+    }
+
+    return manifest;
+}
+
+void test_delta_sync(TestContextType &ctx)
+{
+    auto server = LoopbackHttpServerType{};
+    if (!server.start())
+        return;
+
+    auto paths = std::vector<std::string>{};
+    for (auto idx = 0; idx < 40; ++idx)
+        paths.push_back("bench/dps/power/build " + std::to_string(idx) + ".json");
+    const auto manifest = serve_manifest(server, paths);
+
+    // 10 files are current, 10 have the same size but old content, 20 are missing
+    const auto data_path = ctx.get_temp_path();
+    for (auto idx = size_t{0}; idx < 20; ++idx)
+        write_text(data_path / paths[idx], get_file_body(idx, idx < 10 ? 'a' : 'A'));
+    write_text(data_path / "bench" / "dps" / "removed.json", "{}");
+
+    const auto outdated_files = get_outdated_data_files(manifest, data_path);
+    if (!ctx.check_equal(outdated_files.size(), size_t{30}, "outdated files"))
+        return;
+
+    auto service = DownloadServiceType{make_loopback_transport, DownloadServiceConfig{4, 8}};
+    const auto stats = sync_data_files(service, manifest, outdated_files, data_path);
+
+    ctx.check_equal(stats.num_updated, size_t{30}, "updated");
+    ctx.check_equal(stats.num_failed, size_t{0}, "failed");
+    ctx.check_equal(stats.bytes_downloaded, uintmax_t{stats.outdated_bytes}, "only the outdated bytes");
+    ctx.check(stats.duration < TEST_TIMEOUT, "wall time " + std::to_string(stats.duration.count()) + " ms");
+
+    const auto server_stats = server.get_stats();
+    ctx.check_equal(server_stats.num_requests, size_t{30}, "current files are not requested");
+    ctx.check_equal(server_stats.bytes_sent, stats.bytes_downloaded, "bytes on the wire");
+
+    ctx.check(get_outdated_data_files(manifest, data_path).empty(), "in sync afterwards");
+    ctx.check(read_text(data_path / paths[15]) == get_file_body(15, 'a'), "old content replaced");
+    ctx.check_equal(remove_unlisted_data_files(manifest, data_path, "bench"), size_t{1}, "unlisted file removed");
+}
+
+void test_hash_mismatch_keeps_file(TestContextType &ctx)
+{
+    auto server = LoopbackHttpServerType{};
+    if (!server.start())
+        return;
+
+    auto manifest = serve_manifest(server, {"skills/skills.json", "img/1.png"});
+
+    // The served file moved on since the manifest was written, as with a base_url on main
+    server.set_file("/data/skills/skills.json", get_file_body(0, 'A'));
+    const auto data_path = ctx.get_temp_path();
+    write_text(data_path / "skills" / "skills.json", "old");
+
+    auto service = DownloadServiceType{make_loopback_transport, DownloadServiceConfig{2}};
+    const auto stats = sync_data_files(service, manifest, get_outdated_data_files(manifest, data_path), data_path);
+
+    ctx.check_equal(stats.num_updated, size_t{1}, "the matching file");
+    ctx.check_equal(stats.num_failed, size_t{1}, "the changed file");
+    ctx.check(read_text(data_path / "skills" / "skills.json") == "old", "the local file is kept");
+    ctx.check(!std::filesystem::exists(data_path / "skills" / "skills.json.download"), "no download is left");
+
+    // Paths that leave the data folder are never requested
+    manifest.files = {DataManifestFile{"../evil.json", 2, get_sha256("{}")}};
+    const auto unsafe = sync_data_files(service, manifest, manifest.files, data_path);
+    ctx.check(unsafe.num_failed == 1 && server.get_stats().num_requests == 2, "unsafe path");
+}
+
+void test_manifest(TestContextType &ctx)
+{
+    auto manifest = DataManifest{};
+    const auto content = std::string{R"({"version": 1, "base_url": "https://host/4.3.0/data/",
+        "files": [{"path": "bench/a b.json", "size": 2, "sha256": "ab"}]})"};
+    if (!ctx.check(parse_data_manifest(content, manifest), "parse"))
+        return;
+
+    ctx.check_equal(manifest.files.size(), size_t{1}, "files");
+    ctx.check_equal(get_data_file_url(manifest.base_url, manifest.files[0].path),
+                    std::string{"https://host/4.3.0/data/bench/a%20b.json"},
+                    "escaped url");
+    ctx.check_equal(get_data_file_url("https://host/data", "x.json"), std::string{"https://host/data/x.json"}, "slash");
+
+    ctx.check(!parse_data_manifest(R"({"version": 2, "base_url": "x", "files": []})", manifest), "version");
+    ctx.check(!parse_data_manifest(R"({"version": 1, "base_url": "", "files": []})", manifest), "no base_url");
+    ctx.check(!parse_data_manifest("not json", manifest), "not json");
+}
+} // namespace
+
+void add_data_sync_tests(TestRunnerType &runner)
+{
+    runner.add("data_sync/delta_sync", test_delta_sync);
+    runner.add("data_sync/hash_mismatch_keeps_file", test_hash_mismatch_keeps_file);
+    runner.add("data_sync/manifest", test_manifest);
+}
@@ -0,0 +1,320 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Downloader.h"
+
+#include "LoopbackHttp.h"
+#include "Tests.h"
+
+namespace
+{
+constexpr auto TEST_TIMEOUT = std::chrono::seconds(10);
+
+std::string read_text(const std::filesystem::path &path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+std::string get_file_body(const size_t idx, const size_t size)
+{
+    auto body = std::string(size, '\0');
+    for (auto byte_idx = size_t{0}; byte_idx < size; ++byte_idx)
+        body[byte_idx] = static_cast<char>('a' + (idx + byte_idx) % 26);
+
+    return body;
+}
+
+bool is_ready(std::future<DownloadResult> &future)
+{
+    return future.wait_for(TEST_TIMEOUT) == std::future_status::ready;
+}
+
+bool has_part_files(const std::filesystem::path &path)
+{
+    for (const auto &entry : std::filesystem::directory_iterator{path})
+    {
+        if (entry.path().extension() == ".part")
+            return true;
+    }
+
+    return false;
+}
+
+// Holds every download until it is released, to fill the queue
+class GateTransport final : public IHttpTransport
+{
+public:
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool is_open = false;
+        std::atomic<size_t> num_started = 0;
+    };
+
+    explicit GateTransport(State &state) : state(state)
+    {
+    }
+
+    HttpStatus get(const std::string &url, const DataSink &on_data) override
+    {
+        ++state.num_started;
+        {
+            auto lock = std::unique_lock<std::mutex>{state.mutex};
+            state.cv.wait(lock, [this] { return state.is_open; });
+        }
+
+        return on_data(url.data(), url.size()) ? HttpStatus::OK : HttpStatus::FAILED;
+    }
+
+private:
+    State &state;
+};
+
+void test_downloads_files(TestContextType &ctx)
+{
+    auto server = LoopbackHttpServerType{};
+    if (!server.start())
+        return;
+
+    constexpr auto num_files = size_t{32};
+    for (auto idx = size_t{0}; idx < num_files; ++idx)
+        server.set_file("/img/" + std::to_string(idx) + ".png", get_file_body(idx, 1000 + idx * 997));
+
+    auto service = DownloadServiceType{make_loopback_transport, DownloadServiceConfig{4, 8}};
+
+    auto futures = std::vector<std::future<DownloadResult>>{};
+    for (auto idx = size_t{0}; idx < num_files; ++idx)
+    {
+        const auto name = std::to_string(idx) + ".png";
+        futures.push_back(service.submit(server.get_url("/img/" + name), ctx.get_temp_path() / name));
+    }
+
+    auto bytes = uintmax_t{0};
+    for (auto idx = size_t{0}; idx < num_files; ++idx)
+    {
+        if (!ctx.check(is_ready(futures[idx]), "download finished"))
+            return;
+
+        const auto result = futures[idx].get();
+        ctx.check(result.success && result.attempts == 1, result.url);
+        ctx.check(read_text(result.out_path) == get_file_body(idx, 1000 + idx * 997), "file content");
+        bytes += result.bytes;
+    }
+    ctx.check(!has_part_files(ctx.get_temp_path()), "no part file is left");
+
+    const auto stats = server.get_stats();
+    ctx.check_equal(stats.num_requests, num_files, "one request per file");
+    ctx.check_equal(stats.bytes_sent, bytes, "bytes");
+    ctx.check(stats.num_connections <= service.get_num_workers(), "each worker keeps its connection alive");
+}
+
+void test_retries_and_failures(TestContextType &ctx)
+{
+    auto server = LoopbackHttpServerType{};
+    if (!server.start())
+        return;
+
+    server.set_file("/flaky.json", "{}");
+    server.set_failures("/flaky.json", 2, 503);
+    server.set_file("/limited.json", "{}");
+    server.set_failures("/limited.json", 5, 429);
+
+    auto config = DownloadServiceConfig{};
+    config.num_workers = 2;
+    config.max_attempts = 3;
+    config.initial_backoff = std::chrono::milliseconds(1);
+    auto service = DownloadServiceType{make_loopback_transport, config};
+
+    const auto out_path = ctx.get_temp_path();
+    auto flaky = service.submit(server.get_url("/flaky.json"), out_path / "flaky.json");
+    auto limited = service.submit(server.get_url("/limited.json"), out_path / "limited.json");
+    auto missing = service.submit(server.get_url("/missing.json"), out_path / "missing.json");
+    if (!ctx.check(is_ready(flaky) && is_ready(limited) && is_ready(missing), "downloads finished"))
+        return;
+
+    const auto flaky_result = flaky.get();
+    ctx.check(flaky_result.success && flaky_result.attempts == 3, "two 503 are retried");
+
+    const auto limited_result = limited.get();
+    ctx.check(!limited_result.success && limited_result.attempts == 3, "gives up after max_attempts");
+    ctx.check(!std::filesystem::exists(out_path / "limited.json"), "no file after a failure");
+
+    const auto missing_result = missing.get();
+    ctx.check(!missing_result.success && missing_result.attempts == 1, "a 404 is not retried");
+    ctx.check(!has_part_files(out_path), "no part file after a failure");
+}
+
+void test_try_submit_never_blocks(TestContextType &ctx)
+{
+    auto state = GateTransport::State{};
+    auto config = DownloadServiceConfig{};
+    config.num_workers = 1;
+    config.max_queue_depth = 2;
+    auto service = DownloadServiceType{[&state]() { return std::make_unique<GateTransport>(state); }, config};
+
+    const auto out_path = ctx.get_temp_path();
+    const auto try_submit = [&service, &out_path](const size_t idx) {
+        const auto name = std::to_string(idx);
+        return service.try_submit("/" + name, out_path / name);
+    };
+
+    // 1 running and 2 queued, the queue rejects the rest instead of growing
+    constexpr auto num_jobs = size_t{20};
+    auto futures = std::vector<std::future<DownloadResult>>{};
+    futures.push_back(*try_submit(0));
+    while (state.num_started == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    auto submitted = std::async(std::launch::async, [&]() {
+        auto num_rejected = size_t{0};
+        for (auto idx = size_t{1}; idx < num_jobs; ++idx)
+        {
+            auto future = try_submit(idx);
+            if (future)
+                futures.push_back(std::move(*future));
+            else
+                ++num_rejected;
+        }
+        return num_rejected;
+    });
+
+    const auto is_submitted = submitted.wait_for(TEST_TIMEOUT) == std::future_status::ready;
+    ctx.check(is_submitted, "try_submit returns while the queue is full");
+
+    {
+        auto lock = std::lock_guard<std::mutex>{state.mutex};
+        state.is_open = true;
+    }
+    state.cv.notify_all();
+
+    if (!is_submitted)
+        return;
+
+    ctx.check_equal(submitted.get(), num_jobs - 3, "jobs beyond the queue depth are rejected");
+    ctx.check_equal(futures.size(), size_t{3}, "the running and queued jobs");
+
+    // The caller submits the rejected jobs again, like the render thread on the next frames
+    const auto deadline = std::chrono::steady_clock::now() + TEST_TIMEOUT;
+    for (auto idx = futures.size(); idx < num_jobs && std::chrono::steady_clock::now() < deadline;)
+    {
+        auto future = try_submit(idx);
+        if (!future)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        futures.push_back(std::move(*future));
+        ++idx;
+    }
+
+    if (!ctx.check_equal(futures.size(), num_jobs, "every job is accepted once the queue drains"))
+        return;
+    for (auto &future : futures)
+    {
+        if (!ctx.check(is_ready(future), "job finished"))
+            return;
+        ctx.check(future.get().success, "job succeeded");
+    }
+    ctx.check_equal(state.num_started.load(), num_jobs, "every job ran once");
+}
+
+void test_same_out_path(TestContextType &ctx)
+{
+    auto state = GateTransport::State{};
+    auto config = DownloadServiceConfig{};
+    config.num_workers = 2;
+    auto service = DownloadServiceType{[&state]() { return std::make_unique<GateTransport>(state); }, config};
+
+    // Both jobs write their body before either of them renames its file
+    const auto out_path = ctx.get_temp_path() / "icon.png";
+    auto first = service.submit("/first", out_path);
+    auto second = service.submit("/second", out_path);
+    while (state.num_started < 2)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    {
+        auto lock = std::lock_guard<std::mutex>{state.mutex};
+        state.is_open = true;
+    }
+    state.cv.notify_all();
+
+    if (!ctx.check(is_ready(first) && is_ready(second), "downloads finished"))
+        return;
+    ctx.check(first.get().success && second.get().success, "both jobs succeed");
+
+    const auto content = read_text(out_path);
+    ctx.check(content == "/first" || content == "/second", "the file holds one whole body");
+    ctx.check(!has_part_files(ctx.get_temp_path()), "no part file is left");
+}
+
+void test_submit_during_backoff(TestContextType &ctx)
+{
+    auto server = LoopbackHttpServerType{};
+    if (!server.start())
+        return;
+
+    server.set_file("/ok.json", "{}");
+    server.set_failures("/busy.json", 100, 503);
+
+    auto config = DownloadServiceConfig{};
+    config.num_workers = 2;
+    config.max_attempts = 5;
+    config.initial_backoff = std::chrono::seconds(60);
+    auto service = DownloadServiceType{make_loopback_transport, config};
+
+    const auto out_path = ctx.get_temp_path();
+    auto busy = service.submit(server.get_url("/busy.json"), out_path / "busy.json");
+    while (server.get_stats().num_requests == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // One worker sleeps in its backoff, the other one has to pick the job up
+    for (auto idx = 0; idx < 10; ++idx)
+    {
+        auto ok = service.submit(server.get_url("/ok.json"), out_path / "ok.json");
+        if (!ctx.check(ok.wait_for(TEST_TIMEOUT) == std::future_status::ready, "not stuck behind the backoff"))
+            break;
+        ctx.check(ok.get().success, "download during the backoff");
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    service.shutdown();
+    ctx.check(std::chrono::steady_clock::now() - t0 < TEST_TIMEOUT, "shutdown interrupts the backoff");
+    ctx.check(is_ready(busy) && !busy.get().success, "the interrupted job failed");
+}
+
+void test_submit_after_shutdown(TestContextType &ctx)
+{
+    auto service = DownloadServiceType{make_loopback_transport, DownloadServiceConfig{1}};
+    service.shutdown();
+
+    const auto out_path = ctx.get_temp_path() / "file";
+    auto blocking = service.submit("http://127.0.0.1:1/file", out_path);
+    auto non_blocking = service.try_submit("http://127.0.0.1:1/file", out_path);
+    ctx.check(is_ready(blocking) && !blocking.get().success, "submit after shutdown fails");
+    ctx.check(non_blocking && is_ready(*non_blocking) && !non_blocking->get().success,
+              "try_submit after shutdown fails");
+}
+} // namespace
+
+void add_downloader_tests(TestRunnerType &runner)
+{
+    runner.add("downloader/downloads_files", test_downloads_files);
+    runner.add("downloader/retries_and_failures", test_retries_and_failures);
+    runner.add("downloader/try_submit_never_blocks", test_try_submit_never_blocks);
+    runner.add("downloader/same_out_path", test_same_out_path);
+    runner.add("downloader/submit_during_backoff", test_submit_during_backoff);
+    runner.add("downloader/submit_after_shutdown", test_submit_after_shutdown);
+}
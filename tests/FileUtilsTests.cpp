@@ -0,0 +1,219 @@
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "FileUtils.h"
+#include "Types.h"
+
+#include "Tests.h"
+
+namespace
+{
+void write_text(const std::filesystem::path &path, const std::string &text)
+{
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file << text;
+}
+
+std::vector<std::filesystem::path> get_shipped_bench_files(const std::filesystem::path &data_path)
+{
+    auto paths = std::vector<std::filesystem::path>{};
+
+    auto ec = std::error_code{};
+    for (auto it = std::filesystem::recursive_directory_iterator{data_path / "bench", ec};
+         it != std::filesystem::recursive_directory_iterator{};
+         it.increment(ec))
+    {
+        if (ec)
+            break;
+        if (it->is_regular_file() && it->path().extension() == ".json")
+            paths.push_back(it->path());
+    }
+
+    return paths;
+}
+
+void test_build_header_matches_full_parse(TestContextType &ctx)
+{
+    const auto paths = get_shipped_bench_files(ctx.data_path);
+    if (paths.empty())
+        return;
+
+    for (const auto &path : paths)
+    {
+        auto header = nlohmann::json{};
+        auto full = nlohmann::json{};
+        ctx.check(load_build_header_json(path, header), path.string());
+        ctx.check(load_rotaion_json(path, full), path.string());
+        ctx.check(header["buildMetadata"] == full["buildMetadata"], path.string());
+        ctx.check(header["SkillKeyMapping"] == full["SkillKeyMapping"], path.string());
+    }
+}
+
+void test_build_header_key_order(TestContextType &ctx)
+{
+    const auto path = ctx.get_temp_path() / "build.json";
+    const auto metadata = nlohmann::json{{"name", "Test Build"}, {"profession", "Engineer"}};
+
+    // Metadata first, the tail read has to fall back to scanning the whole file
+    write_text(path,
+               "{\"buildMetadata\": " + metadata.dump() + ", \"rotation\": [\"" + std::string(8192, 'x') + "\"]}");
+    auto j = nlohmann::json{};
+    ctx.check(load_build_header_json(path, j) && j["buildMetadata"] == metadata, "metadata as first key");
+
+    // The key only appears inside a string of the last value
+    write_text(path,
+               "{\"buildMetadata\": " + metadata.dump() +
+                   ", \"notes\": {\"text\": \", \\\"buildMetadata\\\": {}\"}}");
+    j = nlohmann::json{};
+    ctx.check(load_build_header_json(path, j) && j["buildMetadata"] == metadata, "key inside a string");
+
+    // Metadata last, behind a value larger than the tail
+    write_text(path,
+               "{\"rotation\": [\"" + std::string(8192, 'x') + "\"], \"buildMetadata\": " + metadata.dump() + "}\n");
+    j = nlohmann::json{};
+    ctx.check(load_build_header_json(path, j) && j["buildMetadata"] == metadata, "metadata as last key");
+
+    // The mapping in front of a value larger than the tail, the metadata still at the end
+    const auto mapping = nlohmann::json{{"slot_7", 1}, {"slot_8", 2}, {"slot_9", -1}};
+    write_text(path,
+               "{\"SkillKeyMapping\": " + mapping.dump() + ", \"rotation\": [\"" + std::string(8192, 'x') +
+                   "\"], \"buildMetadata\": " + metadata.dump() + "}");
+    j = nlohmann::json{};
+    ctx.check(load_build_header_json(path, j) && j["buildMetadata"] == metadata && j["SkillKeyMapping"] == mapping,
+              "mapping as first key");
+
+    // Both last, the layout of the converter
+    write_text(path,
+               "{\"rotation\": [\"" + std::string(8192, 'x') + "\"], \"SkillKeyMapping\": " + mapping.dump() +
+                   ",\n \"buildMetadata\": " + metadata.dump() + "}");
+    j = nlohmann::json{};
+    ctx.check(load_build_header_json(path, j) && j["buildMetadata"] == metadata && j["SkillKeyMapping"] == mapping,
+              "mapping before the metadata");
+
+    write_text(path, "{\"rotation\": []}");
+    j = nlohmann::json{};
+    ctx.check(!load_build_header_json(path, j), "missing metadata");
+
+    j = nlohmann::json{};
+    ctx.check(!load_build_header_json(ctx.get_temp_path() / "missing.json", j), "missing file");
+}
+
+bool has_keybind(const std::map<std::string, KeybindInfo> &keybinds,
+                 const std::string &name,
+                 const Device device,
+                 const Keys button,
+                 const Modifiers modifier)
+{
+    const auto it = keybinds.find(name);
+    return it != keybinds.end() && it->second.device == device && it->second.button == button &&
+           it->second.modifier == modifier;
+}
+
+void test_keybinds_attributes(TestContextType &ctx)
+{
+    const auto keybinds = parse_xml_keybinds_buffer(
+        "<?xml version=\"1.0\"?>\n<InputBindings>\n<actions count=\"3\">\n"
+        "<action name=\"Weapon Skill 1\" device=\"Keyboard\" button=\"49\" mod=\"0\"/>\n"
+        "<action mod=\"2\" button=\"50\" name=\"Weapon Skill 2\" device=\"Keyboard\"/>\n"
+        "<action name = 'Weapon Skill 3'\n\tdevice='Mouse' button='3' mod='4'></action>\n"
+        "<action name=\"Heal\" button=\"54\" unknown=\"x\" mod=\"1\">\n"
+        "</actions>\n</InputBindings>\n");
+
+    ctx.check_equal(keybinds.size(), size_t{4}, "all actions are parsed, <actions> is skipped");
+    ctx.check(has_keybind(keybinds, "Weapon Skill 1", Device::KEYBOARD, static_cast<Keys>(49), Modifiers::NONE),
+              "self-closing tag");
+    ctx.check(has_keybind(keybinds, "Weapon Skill 2", Device::KEYBOARD, static_cast<Keys>(50), Modifiers::CTRL),
+              "attributes in any order");
+    ctx.check(has_keybind(keybinds, "Weapon Skill 3", Device::MOUSE, static_cast<Keys>(3), Modifiers::ALT),
+              "single quotes, whitespace and a closing tag");
+    ctx.check(has_keybind(keybinds, "Heal", Device::KEYBOARD, static_cast<Keys>(54), Modifiers::SHIFT),
+              "missing device and unknown attributes");
+}
+
+void test_keybinds_entities(TestContextType &ctx)
+{
+    const auto keybinds = parse_xml_keybinds_buffer(
+        "<action name=\"Dodge &amp; Jump\" button=\"49\"/>"
+        "<action name=\"&lt;Target&gt; &quot;Next&quot; &apos;Ally&apos;\" button=\"50\"/>"
+        "<action name=\"A &unknown; &amp\" button=\"51\"/>");
+
+    ctx.check(keybinds.contains("Dodge & Jump"), "&amp;");
+    ctx.check(keybinds.contains("<Target> \"Next\" 'Ally'"), "&lt; &gt; &quot; &apos;");
+    ctx.check(keybinds.contains("A &unknown; &amp"), "unknown entities are kept");
+}
+
+void test_keybinds_missing_values(TestContextType &ctx)
+{
+    const auto keybinds = parse_xml_keybinds_buffer(
+        "<action name=\"No Button\" device=\"Keyboard\" mod=\"2\"/>\n"
+        "<action name=\"Unbound\" device=\"Keyboard\" button=\"0\"/>\n"
+        "<action name=\"Bad Button\" button=\"abc\"/>\n"
+        "<action device=\"Keyboard\" button=\"49\"/>\n"
+        "<action name=\"\" button=\"49\"/>\n"
+        "<action name=\"No Mod\" device=\"Keyboard\" button=\"52\"/>\n"
+        "<action name=\"Bad Mod\" button=\"53\" mod=\"x\"/>\n"
+        "<action name=\"Unterminated\" button=\"55");
+
+    ctx.check_equal(keybinds.size(), size_t{2}, "actions without a name or button are dropped");
+    ctx.check(has_keybind(keybinds, "No Mod", Device::KEYBOARD, static_cast<Keys>(52), Modifiers::NONE),
+              "missing mod");
+    ctx.check(has_keybind(keybinds, "Bad Mod", Device::KEYBOARD, static_cast<Keys>(53), Modifiers::NONE),
+              "invalid mod");
+}
+
+void test_keybinds_secondary_binding(TestContextType &ctx)
+{
+    const auto keybinds = parse_xml_keybinds_buffer(
+        "<action name=\"Both\" device=\"Keyboard\" button=\"49\" mod=\"1\" "
+        "device2=\"Mouse\" button2=\"3\" mod2=\"2\"/>\n"
+        "<action name=\"Only Button2\" device=\"Keyboard\" button=\"49\" mod=\"1\" button2=\"50\"/>\n"
+        "<action name=\"Empty Button2\" button=\"49\" button2=\"\"/>\n");
+
+    ctx.check(has_keybind(keybinds, "Both", Device::MOUSE, static_cast<Keys>(3), Modifiers::CTRL),
+              "the secondary binding wins");
+    ctx.check(has_keybind(keybinds, "Only Button2", Device::KEYBOARD, static_cast<Keys>(50), Modifiers::NONE),
+              "button2 without device2 and mod2");
+    ctx.check(!keybinds.contains("Empty Button2"), "an empty button2 drops the action");
+}
+
+void test_keybinds_reload(TestContextType &ctx)
+{
+    const auto path = ctx.get_temp_path() / "InputBinds.xml";
+    auto fingerprint = FileFingerprint{};
+    auto keybinds = std::map<std::string, KeybindInfo>{};
+
+    write_text(path, "<action name=\"Heal\" button=\"54\"/>");
+    ctx.check(reload_xml_keybinds_if_changed(path, fingerprint, keybinds), "first load");
+    ctx.check(fingerprint.is_valid && keybinds.contains("Heal"), "loaded keybinds");
+    ctx.check(!reload_xml_keybinds_if_changed(path, fingerprint, keybinds), "unchanged file");
+
+    std::filesystem::remove(path);
+    ctx.check(reload_xml_keybinds_if_changed(path, fingerprint, keybinds), "a deleted file changes the keybinds");
+    ctx.check(!fingerprint.is_valid && keybinds.empty(), "the stale keybinds are cleared");
+    ctx.check(!reload_xml_keybinds_if_changed(path, fingerprint, keybinds), "still missing");
+
+    // Unreadable: a directory at the path of the file
+    write_text(path, "<action name=\"Heal\" button=\"54\"/>");
+    ctx.check(reload_xml_keybinds_if_changed(path, fingerprint, keybinds), "the file is back");
+    std::filesystem::remove(path);
+    std::filesystem::create_directories(path);
+    ctx.check(reload_xml_keybinds_if_changed(path, fingerprint, keybinds), "an unreadable file changes the keybinds");
+    ctx.check(!fingerprint.is_valid && keybinds.empty(), "the keybinds of the unreadable file are cleared");
+}
+} // namespace
+
+void add_file_utils_tests(TestRunnerType &runner)
+{
+    runner.add("file_utils/build_header_matches_full_parse", test_build_header_matches_full_parse);
+    runner.add("file_utils/build_header_key_order", test_build_header_key_order);
+    runner.add("file_utils/keybinds_attributes", test_keybinds_attributes);
+    runner.add("file_utils/keybinds_entities", test_keybinds_entities);
+    runner.add("file_utils/keybinds_missing_values", test_keybinds_missing_values);
+    runner.add("file_utils/keybinds_secondary_binding", test_keybinds_secondary_binding);
+    runner.add("file_utils/keybinds_reload", test_keybinds_reload);
+}
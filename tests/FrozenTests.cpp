@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Frozen.h"
+#include "SkillData.h"
+
+#include "Tests.h"
+
+namespace
+{
+constexpr auto primes = make_frozen_keys<int>({13, 2, 7, 3, 11, 5});
+constexpr auto prime_set = FrozenSet<int>{primes};
+
+constexpr auto weapon_names = make_frozen_entries<std::string_view, int>({
+    {"Sword", 1},
+    {"Axe", 2},
+    {"Staff", 3},
+});
+constexpr auto weapon_map = FrozenMap<std::string_view, int>{weapon_names};
+
+// The builders and lookups run at compile time
+static_assert(primes == std::array<int, 6>{2, 3, 5, 7, 11, 13});
+static_assert(prime_set.contains(11) && !prime_set.contains(4));
+static_assert(weapon_map.find("Axe")->second == 2);
+
+void test_frozen_set(TestContextType &ctx)
+{
+    for (auto key = -1; key <= 14; ++key)
+    {
+        const auto expected = std::find(primes.begin(), primes.end(), key) != primes.end();
+        ctx.check_equal(prime_set.contains(key), expected, "contains " + std::to_string(key));
+    }
+
+    ctx.check(prime_set.find(7) == prime_set.begin() + 3, "find returns the entry");
+    ctx.check(prime_set.find(8) == prime_set.end(), "a miss returns end");
+    ctx.check(FrozenSet<int>{}.find(1) == FrozenSet<int>{}.end() && FrozenSet<int>{}.empty(), "empty set");
+}
+
+// The branchless search has to land on every entry for every table size
+void test_lower_bound_sizes(TestContextType &ctx)
+{
+    constexpr auto keys = std::array<int, 9>{1, 3, 5, 7, 9, 11, 13, 15, 17};
+    const auto identity = [](const int &key) -> const int & { return key; };
+
+    for (auto count = size_t{0}; count <= keys.size(); ++count)
+    {
+        for (auto key = 0; key <= 18; ++key)
+        {
+            const auto *expected = std::lower_bound(keys.data(), keys.data() + count, key);
+            const auto *result = frozen_lower_bound(keys.data(), count, key, identity);
+            ctx.check(result == expected, std::to_string(count) + " entries, key " + std::to_string(key));
+        }
+    }
+}
+
+void test_frozen_map(TestContextType &ctx)
+{
+    ctx.check_equal(weapon_map.at("Staff"), 3, "at");
+    ctx.check(weapon_map.find("Mace") == weapon_map.end(), "miss");
+    ctx.check(weapon_map.begin()->first == "Axe", "sorted by key");
+
+    auto threw = false;
+    try
+    {
+        (void)weapon_map.at("Mace");
+    }
+    catch (const std::out_of_range &)
+    {
+        threw = true;
+    }
+    ctx.check(threw, "at throws on a miss");
+}
+
+void test_skill_tables(TestContextType &ctx)
+{
+    const auto is_sorted_unique = [](const auto &table, const auto &get_key) {
+        return std::adjacent_find(table.begin(), table.end(), [&](const auto &lhs, const auto &rhs) {
+                   return !(get_key(lhs) < get_key(rhs));
+               }) == table.end();
+    };
+    const auto key = [](const auto &entry) { return entry; };
+    const auto map_key = [](const auto &entry) { return entry.first; };
+
+    ctx.check(is_sorted_unique(SkillRuleData::skills_to_not_track, key), "skills_to_not_track");
+    ctx.check(is_sorted_unique(SkillRuleData::skill_cast_time_map, map_key), "skill_cast_time_map");
+    ctx.check(is_sorted_unique(SkillRuleData::special_mapping_skills, map_key), "special_mapping_skills");
+    ctx.check(is_sorted_unique(SkillRuleData::skill_rules.skills_substr_to_drop_names, key), "drop names");
+
+    for (const auto &[skill_id, cast_time] : SkillRuleData::skill_cast_time_map)
+        ctx.check(SkillRuleData::skill_cast_time_map.at(skill_id) == cast_time, "every entry is found");
+}
+} // namespace
+
+void add_frozen_tests(TestRunnerType &runner)
+{
+    runner.add("frozen/frozen_set", test_frozen_set);
+    runner.add("frozen/lower_bound_sizes", test_lower_bound_sizes);
+    runner.add("frozen/frozen_map", test_frozen_map);
+    runner.add("frozen/skill_tables", test_skill_tables);
+}
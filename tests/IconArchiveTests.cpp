@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "IconArchive.h"
+#include "PngDecoder.h"
+#include "TextureLoader.h"
+
+#include "Tests.h"
+
+namespace
+{
+std::string read_text(const std::filesystem::path &path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+void write_text(const std::filesystem::path &path, const std::string &text)
+{
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file << text;
+}
+
+bool decode_png_file(const std::filesystem::path &path, DecodedImage &image)
+{
+    const auto content = read_text(path);
+    auto scratch = PngScratch{};
+    return decode_png(reinterpret_cast<const uint8_t *>(content.data()), content.size(), scratch, image);
+}
+
+// Copies the first num_icons shipped icons the native decoder reads into img_path
+std::vector<std::filesystem::path> copy_shipped_icons(const std::filesystem::path &data_path,
+                                                      const std::filesystem::path &img_path,
+                                                      const size_t num_icons)
+{
+    auto sources = std::vector<std::filesystem::path>{};
+    auto ec = std::error_code{};
+    for (const auto &entry : std::filesystem::directory_iterator{data_path / "img", ec})
+    {
+        if (entry.path().extension() == ".png")
+            sources.push_back(entry.path());
+    }
+    std::sort(sources.begin(), sources.end());
+
+    std::filesystem::create_directories(img_path);
+
+    auto copies = std::vector<std::filesystem::path>{};
+    for (const auto &source : sources)
+    {
+        auto image = DecodedImage{};
+        if (copies.size() == num_icons || !decode_png_file(source, image))
+            continue;
+
+        copies.push_back(img_path / source.filename());
+        std::filesystem::copy_file(source, copies.back());
+    }
+
+    return copies;
+}
+
+void test_write_and_open(TestContextType &ctx)
+{
+    const auto img_path = ctx.get_temp_path() / "img";
+    const auto archive_path = ctx.get_temp_path() / "icons.pack";
+    const auto icon_paths = copy_shipped_icons(ctx.data_path, img_path, 3);
+    if (icon_paths.size() < 3)
+        return;
+
+    // Neither PNG nor an icon id, both are skipped
+    write_text(img_path / "2000000000.png", "not a png");
+    write_text(img_path / "readme.png", "not an icon");
+
+    ctx.check(write_icon_archive(img_path, archive_path, make_png_decoder_factory(nullptr), 2), "write");
+
+    auto archive = IconArchiveType{};
+    if (!ctx.check(open_current_icon_archive(archive, archive_path, img_path), "open"))
+        return;
+
+    ctx.check_equal(archive.size(), size_t{3}, "the broken PNG is left out");
+    ctx.check_equal(archive.get_source_info().num_files, uint32_t{4}, "every <icon_id>.png is fingerprinted");
+    ctx.check(!archive.contains(2000000000), "broken PNG");
+
+    for (const auto &icon_path : icon_paths)
+    {
+        const auto icon_id = std::stoi(icon_path.stem().string());
+        auto expected = DecodedImage{};
+        auto image = IconArchiveImage{};
+        ctx.check(decode_png_file(icon_path, expected), icon_path.string());
+        if (!ctx.check(archive.find(icon_id, 0, image), icon_path.string()))
+            continue;
+
+        ctx.check(image.width == expected.width && image.height == expected.height, "size");
+        ctx.check(std::equal(expected.pixels.begin(), expected.pixels.end(), image.pixels), "pixels");
+        ctx.check(reinterpret_cast<uintptr_t>(image.pixels) % 16 == 0, "aligned payload");
+    }
+}
+
+void test_stale_archive_is_rejected(TestContextType &ctx)
+{
+    const auto img_path = ctx.get_temp_path() / "img";
+    const auto archive_path = ctx.get_temp_path() / "icons.pack";
+    const auto icon_paths = copy_shipped_icons(ctx.data_path, img_path, 2);
+    if (icon_paths.size() < 2)
+        return;
+
+    const auto decoder_factory = make_png_decoder_factory(nullptr);
+    ctx.check(write_icon_archive(img_path, archive_path, decoder_factory, 1), "write");
+
+    auto archive = IconArchiveType{};
+    ctx.check(open_current_icon_archive(archive, archive_path, img_path), "fresh archive");
+    archive.close();
+
+    // An updated icon with the same size
+    const auto mtime = std::filesystem::last_write_time(icon_paths[0]);
+    std::filesystem::last_write_time(icon_paths[0], mtime + std::chrono::hours(1));
+    ctx.check(!open_current_icon_archive(archive, archive_path, img_path), "newer icon");
+    ctx.check(!archive.is_open(), "a stale archive is closed");
+
+    ctx.check(write_icon_archive(img_path, archive_path, decoder_factory, 1), "rebuild");
+    ctx.check(open_current_icon_archive(archive, archive_path, img_path), "rebuilt archive");
+    archive.close();
+
+    // A new icon, and one that went away
+    std::filesystem::copy_file(icon_paths[0], img_path / "999999999.png");
+    ctx.check(!open_current_icon_archive(archive, archive_path, img_path), "added icon");
+    std::filesystem::remove(img_path / "999999999.png");
+    std::filesystem::remove(icon_paths[1]);
+    ctx.check(!open_current_icon_archive(archive, archive_path, img_path), "removed icon");
+}
+
+void test_corrupt_archive_is_rejected(TestContextType &ctx)
+{
+    const auto img_path = ctx.get_temp_path() / "img";
+    const auto archive_path = ctx.get_temp_path() / "icons.pack";
+    if (copy_shipped_icons(ctx.data_path, img_path, 1).empty())
+        return;
+
+    ctx.check(write_icon_archive(img_path, archive_path, make_png_decoder_factory(nullptr), 1), "write");
+    const auto content = read_text(archive_path);
+
+    auto archive = IconArchiveType{};
+    write_text(archive_path, content.substr(0, content.size() - 1));
+    ctx.check(!archive.open(archive_path), "truncated payload");
+
+    write_text(archive_path, content.substr(0, 20));
+    ctx.check(!archive.open(archive_path), "truncated header");
+
+    auto old_version = content;
+    old_version[4] = 1;
+    write_text(archive_path, old_version);
+    ctx.check(!archive.open(archive_path), "version 1 archive");
+
+    ctx.check(!write_icon_archive(ctx.get_temp_path() / "missing", archive_path, make_png_decoder_factory(nullptr), 1),
+              "no icons");
+}
+} // namespace
+
+void add_icon_archive_tests(TestRunnerType &runner)
+{
+    runner.add("icon_archive/write_and_open", test_write_and_open);
+    runner.add("icon_archive/stale_archive_is_rejected", test_stale_archive_is_rejected);
+    runner.add("icon_archive/corrupt_archive_is_rejected", test_corrupt_archive_is_rejected);
+}
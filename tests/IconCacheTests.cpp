@@ -0,0 +1,196 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "IconCache.h"
+
+#include "Tests.h"
+
+namespace
+{
+// Textures are plain ids, the releaser records the order they are freed in
+using TestIconCacheType = IconCacheType<int>;
+
+void test_acquire_release(TestContextType &ctx)
+{
+    auto released = std::vector<int>{};
+    auto cache = TestIconCacheType{[&released](const int texture) { released.push_back(texture); }, 1000};
+
+    ctx.check_equal(cache.acquire(1), 0, "a miss returns an empty texture");
+    cache.insert(1, 101, 100);
+    ctx.check_equal(cache.get_stats().num_referenced, size_t{1}, "an inserted icon starts referenced");
+
+    // A second build takes a reference on the same icon
+    ctx.check_equal(cache.acquire(1), 101, "a hit returns the texture");
+    cache.release(1);
+    ctx.check_equal(cache.get_stats().num_referenced, size_t{1}, "still referenced by the first build");
+    ctx.check_equal(cache.get_stats().unreferenced_bytes, size_t{0}, "no unreferenced bytes");
+
+    cache.release(1);
+    auto stats = cache.get_stats();
+    ctx.check_equal(stats.num_referenced, size_t{0}, "the last release drops the reference");
+    ctx.check_equal(stats.num_entries, size_t{1}, "the unreferenced icon stays resident");
+    ctx.check_equal(stats.unreferenced_bytes, size_t{100}, "and counts as unreferenced");
+
+    cache.release(1);
+    cache.release(2);
+    ctx.check_equal(cache.get_stats().unreferenced_bytes, size_t{100}, "extra releases are ignored");
+
+    // Loading the build again takes the icon back out of the LRU list
+    ctx.check_equal(cache.acquire(1), 101, "a released icon is a hit");
+    stats = cache.get_stats();
+    ctx.check_equal(stats.num_referenced, size_t{1}, "referenced again");
+    ctx.check_equal(stats.unreferenced_bytes, size_t{0}, "no longer unreferenced");
+    ctx.check_equal(stats.hits, uint64_t{2}, "hits");
+    ctx.check_equal(stats.misses, uint64_t{1}, "misses");
+    ctx.check(released.empty(), "nothing was freed");
+}
+
+void test_eviction_order(TestContextType &ctx)
+{
+    auto released = std::vector<int>{};
+    auto cache = TestIconCacheType{[&released](const int texture) { released.push_back(texture); }, 250};
+
+    for (auto icon_id = 1; icon_id <= 4; ++icon_id)
+        cache.insert(icon_id, 100 + icon_id, 100);
+
+    // Referenced icons never count against the budget
+    ctx.check_equal(cache.get_stats().resident_bytes, size_t{400}, "over the budget while referenced");
+    ctx.check(released.empty(), "referenced icons are kept");
+
+    cache.release(2);
+    cache.release(1);
+    ctx.check(released.empty(), "200 unreferenced bytes fit the budget");
+
+    // A hit moves the icon out of the LRU list, 2 stays the least recently released
+    (void)cache.acquire(1);
+    cache.release(1);
+    cache.release(3);
+    ctx.check_equal(released, std::vector<int>{102}, "the least recently released icon goes first");
+
+    cache.release(4);
+    ctx.check_equal(released, std::vector<int>{102, 101}, "then the next least recently released one");
+
+    const auto stats = cache.get_stats();
+    ctx.check_equal(stats.num_entries, size_t{2}, "two icons stay resident");
+    ctx.check_equal(stats.unreferenced_bytes, size_t{200}, "within the budget");
+    ctx.check_equal(cache.acquire(3), 103, "the recently released icons are still hits");
+    ctx.check_equal(cache.acquire(1), 0, "the evicted icon is a miss");
+}
+
+void test_remove(TestContextType &ctx)
+{
+    auto released = std::vector<int>{};
+    auto cache = TestIconCacheType{[&released](const int texture) { released.push_back(texture); }, 1000};
+
+    cache.insert(1, 101, 100);
+    (void)cache.acquire(1);
+    cache.insert(2, 102, 50);
+    cache.release(2);
+
+    cache.remove(1);
+    ctx.check_equal(released, std::vector<int>{101}, "a referenced icon is freed right away");
+    cache.release(1);
+    ctx.check_equal(released.size(), size_t{1}, "a release after the remove does nothing");
+
+    cache.remove(2);
+    cache.remove(3);
+    ctx.check_equal(released, std::vector<int>{101, 102}, "an unreferenced icon is freed too");
+
+    const auto stats = cache.get_stats();
+    ctx.check_equal(stats.num_entries, size_t{0}, "no entries");
+    ctx.check_equal(stats.resident_bytes, size_t{0}, "no resident bytes");
+    ctx.check_equal(stats.unreferenced_bytes, size_t{0}, "no unreferenced bytes");
+
+    // Inserting over an existing icon frees the old texture
+    cache.insert(4, 104, 10);
+    cache.insert(4, 204, 20);
+    ctx.check_equal(released.back(), 104, "the replaced texture is freed");
+    ctx.check_equal(cache.get_stats().resident_bytes, size_t{20}, "only the new texture is resident");
+}
+
+void test_clear(TestContextType &ctx)
+{
+    auto released = std::vector<int>{};
+    {
+        auto cache = TestIconCacheType{[&released](const int texture) { released.push_back(texture); }, 1000};
+        cache.insert(1, 101, 100);
+        cache.insert(2, 102, 100);
+        cache.release(2);
+
+        cache.clear();
+        ctx.check_equal(released.size(), size_t{2}, "referenced and unreferenced icons are freed");
+
+        const auto stats = cache.get_stats();
+        ctx.check_equal(stats.num_entries, size_t{0}, "no entries");
+        ctx.check_equal(stats.resident_bytes, size_t{0}, "no resident bytes");
+        ctx.check_equal(stats.unreferenced_bytes, size_t{0}, "no unreferenced bytes");
+        ctx.check_equal(cache.acquire(1), 0, "a miss after the clear");
+
+        // The LRU list is empty as well, a release after the clear evicts nothing stale
+        cache.insert(3, 103, 2000);
+        cache.release(3);
+        ctx.check_equal(released.back(), 103, "an icon over the budget is evicted on release");
+
+        cache.insert(5, 105, 10);
+    }
+    ctx.check_equal(released.back(), 105, "the destructor frees the rest");
+}
+
+// The icon handling of a build switch: cached icons are acquired, the rest is
+// decoded and inserted, and the icons the atlas packed leave the icon map
+void test_packed_icons_survive_build_switch(TestContextType &ctx)
+{
+    auto released = std::vector<int>{};
+    auto cache = TestIconCacheType{[&released](const int texture) { released.push_back(texture); }, 1000};
+    auto icon_map = IconMapType<int>{};
+    auto num_decoded = size_t{0};
+
+    const auto load_build = [&](const std::vector<int> &icon_ids) {
+        release_icon_map(icon_map, cache);
+        for (const auto icon_id : icon_ids)
+        {
+            auto texture = cache.acquire(icon_id);
+            if (!texture)
+            {
+                ++num_decoded;
+                texture = 100 + icon_id;
+                cache.insert(icon_id, texture, 10);
+            }
+            icon_map[icon_id] = texture;
+        }
+
+        // The atlas packs everything but the last icon
+        const auto num_packed =
+            release_packed_icons(icon_map, cache, [&](const int icon_id) { return icon_id != icon_ids.back(); });
+        ctx.check_equal(num_packed, icon_ids.size() - 1, "the packed icons leave the icon map");
+    };
+
+    const auto build_a = std::vector<int>{1, 2, 3, 4};
+    const auto build_b = std::vector<int>{3, 5, 6};
+
+    load_build(build_a);
+    ctx.check_equal(num_decoded, size_t{4}, "the first load decodes every icon");
+    ctx.check_equal(icon_map.size(), size_t{1}, "only the unpacked icon keeps its single texture");
+
+    load_build(build_b);
+    ctx.check_equal(num_decoded, size_t{6}, "the second build decodes only its new icons");
+
+    load_build(build_a);
+    ctx.check_equal(num_decoded, size_t{6}, "switching back decodes nothing");
+    ctx.check(released.empty(), "no texture was freed");
+
+    const auto stats = cache.get_stats();
+    ctx.check_equal(stats.num_entries, size_t{6}, "every icon stays resident");
+    ctx.check_equal(stats.num_referenced, size_t{1}, "only the unpacked icon is referenced");
+}
+} // namespace
+
+void add_icon_cache_tests(TestRunnerType &runner)
+{
+    runner.add("icon_cache/acquire_release", test_acquire_release);
+    runner.add("icon_cache/eviction_order", test_eviction_order);
+    runner.add("icon_cache/remove", test_remove);
+    runner.add("icon_cache/clear", test_clear);
+    runner.add("icon_cache/packed_icons_survive_build_switch", test_packed_icons_survive_build_switch);
+}
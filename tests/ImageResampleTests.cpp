@@ -0,0 +1,92 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ImageResample.h"
+#include "TextureLoader.h"
+
+#include "Tests.h"
+
+namespace
+{
+DecodedImage make_noise_image(const uint32_t width, const uint32_t height, uint32_t seed)
+{
+    auto image = DecodedImage{};
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (auto &byte : image.pixels)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+
+    return image;
+}
+
+void test_simd_matches_scalar(TestContextType &ctx)
+{
+    // Odd sizes and sizes around the 8 pixel steps of the SSE2 loop
+    constexpr auto sizes = std::array<uint32_t, 16>{1, 2, 3, 5, 7, 8, 9, 15, 16, 17, 23, 31, 33, 63, 65, 129};
+
+    auto seed = uint32_t{1};
+    for (const auto width : sizes)
+    {
+        for (const auto height : sizes)
+        {
+            const auto image = make_noise_image(width, height, seed++);
+            const auto simd = downscale_half(image);
+            const auto scalar = downscale_half_scalar(image);
+
+            const auto name = std::to_string(width) + "x" + std::to_string(height);
+            ctx.check(simd.width == scalar.width && simd.height == scalar.height, name + " size");
+            ctx.check(simd.pixels == scalar.pixels, name + " pixels");
+        }
+    }
+}
+
+void test_rounded_box_filter(TestContextType &ctx)
+{
+    // 3x1 pixels, a level is size / 2, so the odd last column is dropped
+    auto image = DecodedImage{};
+    image.width = 3;
+    image.height = 1;
+    image.pixels = {0, 10, 255, 1, 1, 11, 255, 2, 200, 0, 0, 0};
+
+    const auto result = downscale_half(image);
+    ctx.check(result.width == 1 && result.height == 1, "size");
+    ctx.check_equal(result.pixels, std::vector<uint8_t>{1, 11, 255, 2}, "rounded average of the first two");
+
+    ctx.check(downscale_half(DecodedImage{}).pixels.empty(), "empty image");
+}
+
+void test_mip_chain(TestContextType &ctx)
+{
+    auto image = make_noise_image(37, 10, 3);
+    generate_mips(image, 1);
+
+    const auto expected = std::vector<std::pair<uint32_t, uint32_t>>{{18, 5}, {9, 2}, {4, 1}, {2, 1}, {1, 1}};
+    auto sizes = std::vector<std::pair<uint32_t, uint32_t>>{};
+    auto bytes = image.pixels.size();
+    for (const auto &level : image.mips)
+    {
+        sizes.emplace_back(level.width, level.height);
+        bytes += level.pixels.size();
+    }
+
+    ctx.check(sizes == expected, "levels down to 1x1");
+    ctx.check_equal(get_image_bytes(image), bytes, "bytes of all levels");
+
+    generate_mips(image, 16, 1);
+    ctx.check_equal(image.mips.size(), size_t{1}, "max_levels");
+}
+} // namespace
+
+void add_image_resample_tests(TestRunnerType &runner)
+{
+    runner.add("image_resample/simd_matches_scalar", test_simd_matches_scalar);
+    runner.add("image_resample/rounded_box_filter", test_rounded_box_filter);
+    runner.add("image_resample/mip_chain", test_mip_chain);
+}
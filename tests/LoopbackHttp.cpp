@@ -0,0 +1,456 @@
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Downloader.h"
+#include "LoopbackHttp.h"
+
+#ifndef _WIN32
+
+namespace
+{
+constexpr auto READ_BUFFER_SIZE = size_t{64 * 1024};
+
+bool send_all(const int fd, std::string_view data)
+{
+    while (!data.empty())
+    {
+        const auto num_sent = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (num_sent < 0 && errno == EINTR)
+            continue;
+        if (num_sent <= 0)
+            return false;
+
+        data.remove_prefix(static_cast<size_t>(num_sent));
+    }
+
+    return true;
+}
+
+// Appends to the buffer, false once the peer closed the connection
+bool receive_some(const int fd, std::string &buffer)
+{
+    char chunk[16 * 1024];
+    while (true)
+    {
+        const auto num_received = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (num_received < 0 && errno == EINTR)
+            continue;
+        if (num_received <= 0)
+            return false;
+
+        buffer.append(chunk, static_cast<size_t>(num_received));
+        return true;
+    }
+}
+
+void set_no_delay(const int fd)
+{
+    const auto enable = 1;
+    (void)::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+}
+
+const char *get_reason_phrase(const int status_code)
+{
+    switch (status_code)
+    {
+    case 200:
+        return "OK";
+    case 404:
+        return "Not Found";
+    case 429:
+        return "Too Many Requests";
+    case 503:
+        return "Service Unavailable";
+    default:
+        return "Error";
+    }
+}
+
+class LoopbackTransport final : public IHttpTransport
+{
+public:
+    LoopbackTransport() : read_buffer(READ_BUFFER_SIZE)
+    {
+    }
+
+    ~LoopbackTransport() override
+    {
+        for (const auto &[host, fd] : connections)
+            ::close(fd);
+    }
+
+    HttpStatus get(const std::string &url, const DataSink &on_data) override
+    {
+        static constexpr auto scheme = std::string_view{"http://"};
+        if (!url.starts_with(scheme))
+            return HttpStatus::FAILED;
+
+        const auto path_pos = url.find('/', scheme.size());
+        const auto host_port = url.substr(scheme.size(), path_pos - scheme.size());
+        const auto path = path_pos == std::string::npos ? std::string{"/"} : url.substr(path_pos);
+
+        const auto fd = get_connection(host_port);
+        if (fd < 0)
+            return HttpStatus::RETRY;
+
+        if (!send_all(fd, "GET " + path + " HTTP/1.1\r\nHost: " + host_port + "\r\n\r\n"))
+        {
+            drop_connection(host_port);
+            return HttpStatus::RETRY;
+        }
+
+        auto buffer = std::string{};
+        auto header_end = std::string::npos;
+        while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos)
+        {
+            if (!receive_some(fd, buffer))
+            {
+                drop_connection(host_port);
+                return HttpStatus::RETRY;
+            }
+        }
+
+        auto header = buffer.substr(0, header_end);
+        std::transform(header.begin(), header.end(), header.begin(), [](const unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+
+        auto status_code = 0;
+        auto content_length = size_t{0};
+        const auto status_pos = header.find(' ');
+        const auto length_pos = header.find("\r\ncontent-length:");
+        if (status_pos == std::string::npos || length_pos == std::string::npos)
+        {
+            drop_connection(host_port);
+            return HttpStatus::FAILED;
+        }
+
+        (void)std::from_chars(header.data() + status_pos + 1, header.data() + header.size(), status_code);
+        auto length_start = length_pos + 17;
+        while (length_start < header.size() && header[length_start] == ' ')
+            ++length_start;
+        (void)std::from_chars(header.data() + length_start, header.data() + header.size(), content_length);
+
+        // The body of an error response is read as well to keep the connection usable
+        const auto is_ok = status_code == 200;
+        auto num_left = content_length;
+
+        const auto num_buffered = std::min(num_left, buffer.size() - header_end - 4);
+        if (num_buffered > 0 && is_ok && !on_data(buffer.data() + header_end + 4, num_buffered))
+        {
+            drop_connection(host_port);
+            return HttpStatus::FAILED;
+        }
+        num_left -= num_buffered;
+
+        while (num_left > 0)
+        {
+            const auto num_received = ::recv(fd, read_buffer.data(), std::min(num_left, read_buffer.size()), 0);
+            if (num_received < 0 && errno == EINTR)
+                continue;
+            if (num_received <= 0)
+            {
+                drop_connection(host_port);
+                return HttpStatus::RETRY;
+            }
+
+            if (is_ok && !on_data(read_buffer.data(), static_cast<size_t>(num_received)))
+            {
+                drop_connection(host_port);
+                return HttpStatus::FAILED;
+            }
+            num_left -= static_cast<size_t>(num_received);
+        }
+
+        if (is_ok)
+            return HttpStatus::OK;
+        if (status_code == 408 || status_code == 429 || status_code >= 500)
+            return HttpStatus::RETRY;
+        return HttpStatus::FAILED;
+    }
+
+private:
+    int get_connection(const std::string &host_port)
+    {
+        const auto it = connections.find(host_port);
+        if (it != connections.end())
+            return it->second;
+
+        const auto colon_pos = host_port.find(':');
+        const auto host = host_port.substr(0, colon_pos);
+        auto port = uint16_t{80};
+        if (colon_pos != std::string::npos)
+            (void)std::from_chars(host_port.data() + colon_pos + 1, host_port.data() + host_port.size(), port);
+
+        auto address = sockaddr_in{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        if (::inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1)
+            return -1;
+
+        const auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+            return -1;
+
+        if (::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+
+        set_no_delay(fd);
+        connections[host_port] = fd;
+        return fd;
+    }
+
+    void drop_connection(const std::string &host_port)
+    {
+        const auto it = connections.find(host_port);
+        if (it == connections.end())
+            return;
+
+        ::close(it->second);
+        connections.erase(it);
+    }
+
+    std::map<std::string, int> connections;
+    std::vector<char> read_buffer;
+};
+} // namespace
+
+LoopbackHttpServerType::~LoopbackHttpServerType()
+{
+    stop();
+}
+
+bool LoopbackHttpServerType::start()
+{
+    if (listen_fd >= 0)
+        return true;
+
+    const auto fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return false;
+
+    auto address = sockaddr_in{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+
+    auto address_size = socklen_t{sizeof(address)};
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 || ::listen(fd, 128) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr *>(&address), &address_size) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    listen_fd = fd;
+    port = ntohs(address.sin_port);
+    stop_requested = false;
+    accept_thread = std::thread{&LoopbackHttpServerType::accept_loop, this};
+
+    return true;
+}
+
+void LoopbackHttpServerType::stop()
+{
+    if (listen_fd < 0)
+        return;
+
+    {
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        stop_requested = true;
+
+        // Wakes the blocked accept and recv calls, the descriptors are closed after the join
+        ::shutdown(listen_fd, SHUT_RDWR);
+        for (const auto fd : connection_fds)
+            ::shutdown(fd, SHUT_RDWR);
+    }
+
+    accept_thread.join();
+    for (auto &thread : connection_threads)
+        thread.join();
+    connection_threads.clear();
+
+    for (const auto fd : connection_fds)
+        ::close(fd);
+    connection_fds.clear();
+
+    ::close(listen_fd);
+    listen_fd = -1;
+}
+
+std::string LoopbackHttpServerType::get_url(const std::string &path) const
+{
+    return "http://127.0.0.1:" + std::to_string(port) + path;
+}
+
+void LoopbackHttpServerType::set_file(const std::string &path, std::string body)
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    files[path] = std::move(body);
+}
+
+void LoopbackHttpServerType::set_failures(const std::string &path, const uint32_t num_failures, const int status_code)
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    failures[path] = Failure{num_failures, status_code};
+}
+
+LoopbackHttpStats LoopbackHttpServerType::get_stats() const
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    return stats;
+}
+
+void LoopbackHttpServerType::accept_loop()
+{
+    while (true)
+    {
+        const auto fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0 && errno == EINTR)
+            continue;
+        if (fd < 0)
+            return;
+
+        auto lock = std::lock_guard<std::mutex>{mutex};
+        if (stop_requested)
+        {
+            ::close(fd);
+            return;
+        }
+
+        set_no_delay(fd);
+        connection_fds.push_back(fd);
+        ++stats.num_connections;
+        connection_threads.emplace_back(&LoopbackHttpServerType::serve_connection, this, fd);
+    }
+}
+
+void LoopbackHttpServerType::serve_connection(const int fd)
+{
+    auto buffer = std::string{};
+
+    while (true)
+    {
+        const auto header_end = buffer.find("\r\n\r\n");
+        if (header_end == std::string::npos)
+        {
+            if (!receive_some(fd, buffer))
+                return;
+            continue;
+        }
+
+        // "GET <path> HTTP/1.1", requests have no body
+        const auto path_start = buffer.find(' ') + 1;
+        const auto path_end = buffer.find(' ', path_start);
+        const auto path = buffer.substr(path_start, path_end - path_start);
+        buffer.erase(0, header_end + 4);
+
+        if (!send_all(fd, get_response(path)))
+            return;
+    }
+}
+
+std::string LoopbackHttpServerType::get_response(const std::string &path)
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    ++stats.num_requests;
+
+    auto status_code = 200;
+    const std::string *body = nullptr;
+
+    const auto failure_it = failures.find(path);
+    const auto file_it = files.find(path);
+    if (failure_it != failures.end() && failure_it->second.num_left > 0)
+    {
+        --failure_it->second.num_left;
+        status_code = failure_it->second.status_code;
+    }
+    else if (file_it == files.end())
+    {
+        status_code = 404;
+    }
+    else
+    {
+        body = &file_it->second;
+    }
+
+    const auto body_size = body != nullptr ? body->size() : size_t{0};
+    auto response = "HTTP/1.1 " + std::to_string(status_code) + " " + get_reason_phrase(status_code) +
+                    "\r\nContent-Length: " + std::to_string(body_size) + "\r\nConnection: keep-alive\r\n\r\n";
+    if (body != nullptr)
+        response += *body;
+
+    stats.bytes_sent += body_size;
+    return response;
+}
+
+std::unique_ptr<IHttpTransport> make_loopback_transport()
+{
+    return std::make_unique<LoopbackTransport>();
+}
+
+#else
+
+LoopbackHttpServerType::~LoopbackHttpServerType() = default;
+
+bool LoopbackHttpServerType::start()
+{
+    return false;
+}
+
+void LoopbackHttpServerType::stop()
+{
+}
+
+std::string LoopbackHttpServerType::get_url(const std::string &path) const
+{
+    return path;
+}
+
+void LoopbackHttpServerType::set_file(const std::string &path, std::string body)
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    files[path] = std::move(body);
+}
+
+void LoopbackHttpServerType::set_failures(const std::string &path, const uint32_t num_failures, const int status_code)
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    failures[path] = Failure{num_failures, status_code};
+}
+
+LoopbackHttpStats LoopbackHttpServerType::get_stats() const
+{
+    auto lock = std::lock_guard<std::mutex>{mutex};
+    return stats;
+}
+
+std::unique_ptr<IHttpTransport> make_loopback_transport()
+{
+    return nullptr;
+}
+
+#endif
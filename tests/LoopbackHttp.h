@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Downloader.h"
+
+// Plain HTTP/1.1 over loopback TCP, a stand-in for the release server in the
+// download tests and benchmarks. Only implemented with POSIX sockets, start()
+// fails and make_loopback_transport() returns nullptr on Windows.
+
+struct LoopbackHttpStats
+{
+    size_t num_requests = 0;
+    size_t num_connections = 0;
+    uintmax_t bytes_sent = 0;
+};
+
+class LoopbackHttpServerType
+{
+public:
+    LoopbackHttpServerType() = default;
+    ~LoopbackHttpServerType();
+
+    LoopbackHttpServerType(const LoopbackHttpServerType &) = delete;
+    LoopbackHttpServerType &operator=(const LoopbackHttpServerType &) = delete;
+
+    // Listens on 127.0.0.1 on a port chosen by the OS, one thread per connection
+    bool start();
+    void stop();
+
+    std::string get_url(const std::string &path) const;
+
+    void set_file(const std::string &path, std::string body);
+
+    // The next num_failures requests of the path are answered with the status code
+    void set_failures(const std::string &path, const uint32_t num_failures, const int status_code);
+
+    LoopbackHttpStats get_stats() const;
+
+private:
+    struct Failure
+    {
+        uint32_t num_left = 0;
+        int status_code = 0;
+    };
+
+    void accept_loop();
+    void serve_connection(const int fd);
+    std::string get_response(const std::string &path);
+
+    int listen_fd = -1;
+    uint16_t port = 0;
+
+    mutable std::mutex mutex;
+    std::map<std::string, std::string> files;
+    std::map<std::string, Failure> failures;
+    std::vector<int> connection_fds;
+    std::vector<std::thread> connection_threads;
+    LoopbackHttpStats stats;
+    bool stop_requested = false;
+
+    std::thread accept_thread;
+};
+
+// http:// with a numeric IPv4 host only, keeps one connection per host alive
+std::unique_ptr<IHttpTransport> make_loopback_transport();
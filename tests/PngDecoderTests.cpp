@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "PngDecoder.h"
+#include "ZipArchive.h"
+
+#include "Tests.h"
+#include "ZipWriter.h"
+
+namespace
+{
+constexpr auto COLOR_GRAY = uint8_t{0};
+constexpr auto COLOR_RGB = uint8_t{2};
+constexpr auto COLOR_PALETTE = uint8_t{3};
+constexpr auto COLOR_RGBA = uint8_t{6};
+
+void put_be32(std::string &out, const uint32_t value)
+{
+    for (auto shift = 24; shift >= 0; shift -= 8)
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+}
+
+void put_chunk(std::string &out, const std::string &type, const std::string &data)
+{
+    put_be32(out, static_cast<uint32_t>(data.size()));
+    const auto body = type + data;
+    out += body;
+    put_be32(out, update_crc32(0, reinterpret_cast<const uint8_t *>(body.data()), body.size()));
+}
+
+uint32_t get_adler32(const std::string &data)
+{
+    auto a = uint32_t{1};
+    auto b = uint32_t{0};
+    for (const auto byte : data)
+    {
+        a = (a + static_cast<uint8_t>(byte)) % 65521;
+        b = (b + a) % 65521;
+    }
+
+    return (b << 16) | a;
+}
+
+// A PNG of the given filtered rows, every row starts with its filter type
+std::string make_png(const uint32_t width,
+                     const uint32_t height,
+                     const uint8_t color_type,
+                     const std::string &filtered,
+                     const std::string &palette = "",
+                     const std::string &transparency = "")
+{
+    auto header = std::string{};
+    put_be32(header, width);
+    put_be32(header, height);
+    header += std::string{static_cast<char>(8), static_cast<char>(color_type), 0, 0, 0};
+
+    auto idat = std::string{"\x78\x01"};
+    idat += deflate_fixed(filtered);
+    put_be32(idat, get_adler32(filtered));
+
+    auto png = std::string{"\x89PNG\r\n\x1A\n"};
+    put_chunk(png, "IHDR", header);
+    if (!palette.empty())
+        put_chunk(png, "PLTE", palette);
+    if (!transparency.empty())
+        put_chunk(png, "tRNS", transparency);
+    put_chunk(png, "IDAT", idat);
+    put_chunk(png, "IEND", "");
+
+    return png;
+}
+
+bool decode(const std::string &png, DecodedImage &image)
+{
+    auto scratch = PngScratch{};
+    return decode_png(reinterpret_cast<const uint8_t *>(png.data()), png.size(), scratch, image);
+}
+
+void test_shipped_icons(TestContextType &ctx)
+{
+    auto scratch = PngScratch{};
+    auto num_decoded = 0;
+    for (const auto &entry : std::filesystem::directory_iterator{ctx.data_path / "img"})
+    {
+        if (entry.path().extension() != ".png" || num_decoded == 32)
+            continue;
+
+        auto file = std::ifstream{entry.path(), std::ios::binary};
+        const auto content = std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+        auto image = DecodedImage{};
+        const auto name = entry.path().filename().string();
+        if (ctx.check(decode_png(reinterpret_cast<const uint8_t *>(content.data()), content.size(), scratch, image),
+                      name))
+        {
+            ctx.check(image.width > 0 && image.pixels.size() == size_t{image.width} * image.height * 4,
+                      name + " size");
+        }
+        ++num_decoded;
+    }
+
+    ctx.check(num_decoded > 0, "icons found");
+}
+
+void test_color_types(TestContextType &ctx)
+{
+    auto image = DecodedImage{};
+
+    // The second RGB pixel matches the key of tRNS
+    const auto rgb = make_png(2, 1, COLOR_RGB, std::string{"\x00\x10\x20\x30\x01\x02\x03", 7}, "", {"\0\1\0\2\0\3", 6});
+    if (ctx.check(decode(rgb, image), "rgb"))
+        ctx.check_equal(image.pixels, std::vector<uint8_t>{0x10, 0x20, 0x30, 0xFF, 1, 2, 3, 0}, "rgb color key");
+
+    // A 16 bit key never matches 8 bit samples
+    const auto rgb_wide = make_png(1, 1, COLOR_RGB, std::string{"\x00\x01\x02\x03", 4}, "", {"\1\1\0\2\0\3", 6});
+    if (ctx.check(decode(rgb_wide, image), "rgb wide key"))
+        ctx.check_equal(image.pixels, std::vector<uint8_t>{1, 2, 3, 0xFF}, "wide key");
+
+    const auto gray = make_png(3, 1, COLOR_GRAY, std::string{"\x00\x05\x07\x05", 4}, "", {"\0\5", 2});
+    if (ctx.check(decode(gray, image), "gray"))
+        ctx.check_equal(image.pixels, std::vector<uint8_t>{5, 5, 5, 0, 7, 7, 7, 0xFF, 5, 5, 5, 0}, "gray color key");
+
+    // The second palette entry has no tRNS value and stays opaque
+    const auto palette = make_png(2, 1, COLOR_PALETTE, std::string{"\x00\x01\x00", 3}, "\x09\x08\x07\x01\x02\x03",
+                                  std::string{"\x40", 1});
+    if (ctx.check(decode(palette, image), "palette"))
+        ctx.check_equal(image.pixels, std::vector<uint8_t>{1, 2, 3, 0xFF, 9, 8, 7, 0x40}, "palette alpha");
+
+    // Sub filter on the first row, up filter on the second
+    const auto rgba = make_png(2, 2, COLOR_RGBA, std::string{"\x01\x01\x02\x03\x04\x01\x01\x01\x01"
+                                                             "\x02\x01\x01\x01\x01\x00\x00\x00\x00",
+                                                             18});
+    if (ctx.check(decode(rgba, image), "rgba"))
+    {
+        ctx.check_equal(image.pixels,
+                        std::vector<uint8_t>{1, 2, 3, 4, 2, 3, 4, 5, 2, 3, 4, 5, 2, 3, 4, 5},
+                        "unfiltered rows");
+    }
+}
+
+void test_rejects_bad_files(TestContextType &ctx)
+{
+    auto image = DecodedImage{};
+    const auto png = make_png(2, 1, COLOR_RGB, std::string{"\x00\x10\x20\x30\x01\x02\x03", 7});
+
+    ctx.check(decode(png, image), "valid");
+    ctx.check(!decode(png.substr(0, png.size() / 2), image), "truncated");
+    ctx.check(!decode("not a png", image), "signature");
+
+    // The last byte of the adler32 before the IDAT CRC and IEND
+    auto bad_adler = png;
+    bad_adler[bad_adler.size() - 17] ^= 0x01;
+    ctx.check(!decode(bad_adler, image), "adler32 mismatch");
+
+    // Byte 24 is the bit depth in IHDR, byte 28 the interlace method
+    auto wide = png;
+    wide[24] = 16;
+    ctx.check(!decode(wide, image), "16 bit");
+    auto interlaced = png;
+    interlaced[28] = 1;
+    ctx.check(!decode(interlaced, image), "interlaced");
+}
+} // namespace
+
+void add_png_decoder_tests(TestRunnerType &runner)
+{
+    runner.add("png_decoder/shipped_icons", test_shipped_icons);
+    runner.add("png_decoder/color_types", test_color_types);
+    runner.add("png_decoder/rejects_bad_files", test_rejects_bad_files);
+}
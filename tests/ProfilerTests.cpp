@@ -0,0 +1,103 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Profiler.h"
+
+#include "Tests.h"
+
+namespace
+{
+// The ring of a thread is not tied to an instance, a second profiler would write into the rings of the first
+static_assert(!std::is_default_constructible_v<ProfilerType> && !std::is_copy_constructible_v<ProfilerType>);
+
+// Start and duration both encode idx, so a sample mixed from two writes is detected
+void record_sample(ProfilerType &profiler, const std::chrono::steady_clock::time_point base, const int64_t idx)
+{
+    const auto start = base + std::chrono::nanoseconds(idx * 1000);
+    profiler.record(ProfileZone::RENDER, start, start + std::chrono::nanoseconds(idx));
+}
+
+void test_ring_keeps_last_samples(TestContextType &ctx)
+{
+    auto &profiler = get_profiler();
+    profiler.clear();
+
+    const auto base = std::chrono::steady_clock::now() - std::chrono::seconds(10);
+    const auto num_samples = static_cast<int64_t>(ProfilerType::RING_CAPACITY) + 100;
+    for (auto idx = int64_t{0}; idx < num_samples; ++idx)
+        record_sample(profiler, base, idx);
+
+    const auto samples = profiler.get_samples();
+    if (!ctx.check_equal(samples.size(), ProfilerType::RING_CAPACITY, "the ring is full"))
+        return;
+    ctx.check_equal(samples.front().duration_ns, int64_t{100}, "the oldest samples are dropped");
+    ctx.check_equal(samples.back().duration_ns, num_samples - 1, "newest sample");
+
+    ctx.check(profiler.get_samples(std::chrono::seconds(1)).empty(), "window");
+    profiler.clear();
+    ctx.check(profiler.get_samples().empty(), "clear");
+    record_sample(profiler, base, 1);
+    ctx.check_equal(profiler.get_samples().size(), size_t{1}, "samples after clear");
+    profiler.clear();
+}
+
+void test_new_thread_gets_new_index(TestContextType &ctx)
+{
+    auto &profiler = get_profiler();
+    profiler.clear();
+
+    // Each thread exits before the next starts, so all of them share one ring
+    const auto base = std::chrono::steady_clock::now();
+    for (auto thread_idx = 0; thread_idx < 3; ++thread_idx)
+        std::thread{[&profiler, base, thread_idx]() { record_sample(profiler, base, thread_idx); }}.join();
+
+    auto thread_indices = std::set<uint32_t>{};
+    for (const auto &sample : profiler.get_samples())
+        thread_indices.insert(sample.thread_idx);
+    ctx.check_equal(thread_indices.size(), size_t{3}, "one index per thread");
+    profiler.clear();
+}
+
+void test_snapshot_while_recording(TestContextType &ctx)
+{
+    auto &profiler = get_profiler();
+    profiler.clear();
+
+    const auto base = std::chrono::steady_clock::now() - std::chrono::seconds(10);
+    auto is_done = std::atomic<bool>{false};
+    auto writer = std::thread{[&profiler, &is_done, base]() {
+        for (auto idx = int64_t{1}; idx <= 200000; ++idx)
+            record_sample(profiler, base, idx);
+        is_done = true;
+    }};
+
+    const auto base_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(base.time_since_epoch()).count();
+    auto num_snapshots = 0;
+    auto num_torn = 0;
+    while (!is_done || num_snapshots == 0)
+    {
+        for (const auto &sample : profiler.get_samples())
+            num_torn += sample.start_ns - base_ns != sample.duration_ns * 1000;
+        ++num_snapshots;
+        std::this_thread::yield();
+    }
+    writer.join();
+
+    ctx.check_equal(num_torn, 0, "no sample mixes two writes");
+    ctx.check(num_snapshots > 0, "snapshots taken");
+    profiler.clear();
+}
+} // namespace
+
+void add_profiler_tests(TestRunnerType &runner)
+{
+    runner.add("profiler/ring_keeps_last_samples", test_ring_keeps_last_samples);
+    runner.add("profiler/new_thread_gets_new_index", test_new_thread_gets_new_index);
+    runner.add("profiler/snapshot_while_recording", test_snapshot_while_recording);
+}
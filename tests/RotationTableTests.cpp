@@ -0,0 +1,164 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "RotationTable.h"
+#include "Types.h"
+
+#include "Tests.h"
+
+namespace
+{
+SkillData make_skill(const int skill_id, const float cast_time = 0.5F)
+{
+    auto skill_data = SkillData{};
+    skill_data.skill_id = static_cast<SkillID>(skill_id);
+    skill_data.name = "Skill " + std::to_string(skill_id % 16);
+    skill_data.cast_time = cast_time;
+    return skill_data;
+}
+
+void test_intern(TestContextType &ctx)
+{
+    auto skill_table = RotationSkillTableType{};
+
+    const auto first = skill_table.intern(make_skill(100));
+    ctx.check(first == std::optional<uint16_t>{0}, "first entry");
+    ctx.check(skill_table.intern(make_skill(100)) == first, "equal skill");
+    ctx.check(skill_table.intern(make_skill(100, 1.0F)) == std::optional<uint16_t>{1}, "same id, other fields");
+    ctx.check(skill_table.intern(make_skill(101)) == std::optional<uint16_t>{2}, "other id");
+    ctx.check(skill_table.intern(make_skill(100, 1.0F)) == std::optional<uint16_t>{1}, "second entry of an id");
+    ctx.check_equal(skill_table.size(), size_t{3}, "size");
+    ctx.check(skill_table.get(1) == make_skill(100, 1.0F), "get");
+}
+
+void test_intern_overflow(TestContextType &ctx)
+{
+    auto skill_table = RotationSkillTableType{};
+    auto num_failed = size_t{0};
+    for (auto idx = size_t{0}; idx < RotationSkillTableType::MAX_SKILLS; ++idx)
+        num_failed += !skill_table.intern(make_skill(static_cast<int>(idx))).has_value();
+
+    ctx.check_equal(num_failed, size_t{0}, "a full table");
+    ctx.check(!skill_table.intern(make_skill(-1)).has_value(), "no index past the last one");
+    ctx.check(skill_table.intern(make_skill(65535)) == std::optional<uint16_t>{65535}, "known skills still resolve");
+
+    // A rotation with too many distinct skills is not loaded instead of reading wrong skills
+    auto steps = RotationSteps{};
+    for (auto idx = size_t{0}; idx <= RotationSkillTableType::MAX_SKILLS; ++idx)
+        steps.push_back(RotationStep{static_cast<float>(idx), 0.0F, make_skill(static_cast<int>(idx)), false});
+    const auto table = RotationTableType{steps, std::make_shared<RotationSkillTableType>()};
+    ctx.check(table.empty(), "overflowing rotation");
+}
+
+void test_columns(TestContextType &ctx)
+{
+    const auto steps = RotationSteps{
+        RotationStep{0.0F, 500.0F, make_skill(7), false},
+        RotationStep{0.5F, 250.0F, make_skill(8), true},
+        RotationStep{0.75F, 500.0F, make_skill(7), false},
+    };
+    const auto skill_table = std::make_shared<RotationSkillTableType>();
+    const auto table = RotationTableType{steps, skill_table};
+
+    ctx.check_equal(table.size(), steps.size(), "size");
+    ctx.check_equal(skill_table->size(), size_t{2}, "distinct skills");
+    for (auto idx = size_t{0}; idx < steps.size(); ++idx)
+    {
+        const auto step = table[idx];
+        ctx.check(step.time_of_cast == steps[idx].time_of_cast && step.duration_ms == steps[idx].duration_ms &&
+                      step.skill_data == steps[idx].skill_data && step.is_special_skill == steps[idx].is_special_skill,
+                  "step " + std::to_string(idx));
+    }
+    ctx.check(&table.get_skill_data(0) == &table.get_skill_data(2), "equal skills share an entry");
+
+    auto suffix = RotationSuffixType{table};
+    suffix.pop_front();
+    ctx.check(suffix.size() == 2 && suffix.front().skill_data.skill_id == static_cast<SkillID>(8), "suffix");
+}
+
+RotationTableType make_table(const std::vector<bool> &is_auto_attack)
+{
+    auto steps = RotationSteps{};
+    for (auto idx = size_t{0}; idx < is_auto_attack.size(); ++idx)
+    {
+        auto skill_data = make_skill(is_auto_attack[idx] ? 1 : 2 + static_cast<int>(idx % 3));
+        skill_data.is_auto_attack = is_auto_attack[idx];
+        skill_data.weapon_type = idx % 2 == 0 ? WeaponType::SWORD : WeaponType::AXE;
+        steps.push_back(RotationStep{static_cast<float>(idx), 0.0F, skill_data, false});
+    }
+
+    return RotationTableType{steps, std::make_shared<RotationSkillTableType>()};
+}
+
+bool get_is_auto_attack(const SkillData &skill_data)
+{
+    return skill_data.is_auto_attack;
+}
+
+void test_auto_attack_runs(TestContextType &ctx)
+{
+    const auto table = make_table({true, false, true, true, true, false, false, true, true});
+    const auto runs = get_auto_attack_runs(table, get_is_auto_attack);
+
+    if (!ctx.check_equal(runs.size(), size_t{3}, "runs"))
+        return;
+    ctx.check(runs[0].start == 0 && runs[0].length == 1, "single step");
+    ctx.check(runs[1].start == 2 && runs[1].length == 3, "chain of three");
+    ctx.check(runs[2].start == 7 && runs[2].length == 2, "chain at the end");
+    ctx.check(runs[1].weapon_type == WeaponType::SWORD && runs[2].weapon_type == WeaponType::AXE,
+              "weapon of the first step");
+
+    auto indices = std::vector<int>{};
+    for (auto idx = size_t{0}; idx < table.size() + 1; ++idx)
+        indices.push_back(get_auto_attack_index(runs, idx));
+    ctx.check_equal(indices, std::vector<int>{0, 0, 1, 2, 3, 0, 0, 1, 2, 0}, "indices");
+    ctx.check(get_auto_attack_runs(RotationTableType{}, get_is_auto_attack).empty(), "empty table");
+}
+
+// The counter of each step counted by walking back over the chain, as before the runs
+void test_auto_attack_index_matches_walk(TestContextType &ctx)
+{
+    auto seed = uint32_t{5};
+    auto num_mismatches = 0;
+    for (auto sequence = 0; sequence < 200; ++sequence)
+    {
+        auto is_auto_attack = std::vector<bool>{};
+        seed = seed * 1664525u + 1013904223u;
+        const auto size = (seed >> 24) % 40;
+        for (auto idx = uint32_t{0}; idx < size; ++idx)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            is_auto_attack.push_back((seed >> 16) % 3 != 0);
+        }
+
+        const auto runs = get_auto_attack_runs(make_table(is_auto_attack), get_is_auto_attack);
+        for (auto idx = size_t{0}; idx < is_auto_attack.size(); ++idx)
+        {
+            auto first = idx;
+            auto last = idx;
+            while (first > 0 && is_auto_attack[idx] && is_auto_attack[first - 1])
+                --first;
+            while (last + 1 < is_auto_attack.size() && is_auto_attack[idx] && is_auto_attack[last + 1])
+                ++last;
+
+            const auto expected = is_auto_attack[idx] && last > first ? static_cast<int>(idx - first + 1) : 0;
+            num_mismatches += get_auto_attack_index(runs, idx) != expected;
+        }
+    }
+
+    ctx.check_equal(num_mismatches, 0, "mismatches");
+}
+} // namespace
+
+void add_rotation_table_tests(TestRunnerType &runner)
+{
+    runner.add("rotation_table/intern", test_intern);
+    runner.add("rotation_table/intern_overflow", test_intern_overflow);
+    runner.add("rotation_table/columns", test_columns);
+    runner.add("rotation_table/auto_attack_runs", test_auto_attack_runs);
+    runner.add("rotation_table/auto_attack_index_matches_walk", test_auto_attack_index_matches_walk);
+}
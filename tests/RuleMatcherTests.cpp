@@ -0,0 +1,87 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "RuleMatcher.h"
+#include "SkillData.h"
+
+#include "Tests.h"
+
+namespace
+{
+void test_overlapping_patterns(TestContextType &ctx)
+{
+    auto matcher = RuleMatcherType{};
+    matcher.add_substring("he", 1u << 0);
+    matcher.add_substring("she", 1u << 1);
+    matcher.add_substring("his", 1u << 2);
+    matcher.add_substring("hers", 1u << 3);
+    matcher.build();
+
+    // "she" ends in a state whose failure link is the end of "he"
+    ctx.check_equal(matcher.match("ushers"), uint32_t{0b1011}, "ushers");
+    ctx.check_equal(matcher.match("this"), uint32_t{0b0100}, "this");
+    ctx.check_equal(matcher.match("hhhhe"), uint32_t{0b0001}, "restart after a mismatch");
+    ctx.check_equal(matcher.match("h e r s"), uint32_t{0}, "bytes outside of the patterns");
+    ctx.check_equal(matcher.match(""), uint32_t{0}, "empty text");
+}
+
+void test_exact_patterns(TestContextType &ctx)
+{
+    auto matcher = RuleMatcherType{};
+    ctx.check_equal(matcher.match("Dodge"), uint32_t{0}, "before build");
+
+    matcher.add_exact("Dodge", 1u << 0);
+    matcher.add_exact("Dodge", 1u << 1);
+    matcher.add_substring("Swap", 1u << 2);
+    matcher.add_substring("", 1u << 3);
+    matcher.build();
+
+    ctx.check_equal(matcher.match("Dodge"), uint32_t{0b1011}, "exact masks are merged");
+    ctx.check_equal(matcher.match("Dodge Roll"), uint32_t{0b1000}, "exact needs the whole text");
+    ctx.check_equal(matcher.match("Weapon Swap"), uint32_t{0b1100}, "substring");
+    ctx.check_equal(matcher.match(""), uint32_t{0b1000}, "the empty pattern matches everything");
+}
+
+// Every compiled skill rule matches its own pattern inside a longer name
+void test_skill_rules(TestContextType &ctx)
+{
+    const auto &skill_rules = SkillRuleData::skill_rules;
+    const auto &matcher = SkillRuleData::skill_rule_matcher;
+
+    const auto check_substrings = [&](const FrozenSet<std::string_view> &patterns,
+                                      const uint32_t mask,
+                                      const std::string &name) {
+        for (const auto pattern : patterns)
+        {
+            const auto text = "[" + std::string{pattern} + "]";
+            ctx.check((matcher.get_name_mask(text) & mask) != 0, name + " " + text);
+        }
+    };
+    const auto check_exacts = [&](const FrozenSet<std::string_view> &patterns,
+                                  const uint32_t mask,
+                                  const std::string &name) {
+        for (const auto pattern : patterns)
+            ctx.check((matcher.get_name_mask(pattern) & mask) != 0, name + " " + std::string{pattern});
+    };
+
+    check_substrings(skill_rules.skills_substr_to_drop_names, SkillRuleMask::DROP_NAME, "drop");
+    check_exacts(skill_rules.skills_match_to_drop_names, SkillRuleMask::DROP_NAME, "drop");
+    check_substrings(skill_rules.skills_substr_weapon_swap_like, SkillRuleMask::WEAPON_SWAP_NAME, "swap");
+    check_exacts(skill_rules.skills_match_weapon_swap_like, SkillRuleMask::WEAPON_SWAP_NAME, "swap");
+    check_substrings(skill_rules.special_substr_to_gray_out, SkillRuleMask::GRAY_OUT_NAME, "gray out");
+    check_substrings(skill_rules.easy_mode_names_drop_substr, SkillRuleMask::EASY_MODE_DROP_NAME, "easy mode");
+    ctx.check((matcher.get_name_mask("Unknown Skill 42") & SkillRuleMask::UNKNOWN_NAME) != 0, "unknown");
+
+    for (const auto skill_id : skill_rules.easy_mode_drop_match)
+        ctx.check((matcher.get_id_mask(skill_id) & SkillRuleMask::EASY_MODE_DROP_ID) != 0, "easy mode id");
+    ctx.check_equal(matcher.get_id_mask(static_cast<SkillID>(-12345)), uint32_t{0}, "unknown id");
+}
+} // namespace
+
+void add_rule_matcher_tests(TestRunnerType &runner)
+{
+    runner.add("rule_matcher/overlapping_patterns", test_overlapping_patterns);
+    runner.add("rule_matcher/exact_patterns", test_exact_patterns);
+    runner.add("rule_matcher/skill_rules", test_skill_rules);
+}
@@ -0,0 +1,165 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "AtomicFile.h"
+#include "Settings.h"
+
+#include "Tests.h"
+
+namespace
+{
+std::string read_text(const std::filesystem::path &path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+std::filesystem::path get_tmp_path(const std::filesystem::path &path)
+{
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    return tmp_path;
+}
+
+void test_atomic_write_replaces_file(TestContextType &ctx)
+{
+    const auto path = ctx.get_temp_path() / "Settings.json";
+
+    ctx.check(write_file_atomic(path, "old"), "first write");
+    ctx.check(write_file_atomic(path, "new content"), "replacing write");
+    ctx.check_equal(read_text(path), std::string{"new content"}, "the file holds the new content");
+    ctx.check(!std::filesystem::exists(get_tmp_path(path)), "no temp file is left behind");
+}
+
+void test_atomic_write_after_crash(TestContextType &ctx)
+{
+    const auto path = ctx.get_temp_path() / "Settings.json";
+    ctx.check(write_file_atomic(path, "old"), "first write");
+
+    // A crash before the rename leaves a partial temp file next to the intact file
+    {
+        auto file = std::ofstream{get_tmp_path(path), std::ios::binary};
+        file << "{\"Trunc";
+    }
+    ctx.check_equal(read_text(path), std::string{"old"}, "the target is untouched by the partial write");
+
+    ctx.check(write_file_atomic(path, "new"), "the next write replaces the stale temp file");
+    ctx.check_equal(read_text(path), std::string{"new"}, "new content");
+    ctx.check(!std::filesystem::exists(get_tmp_path(path)), "stale temp file is gone");
+}
+
+void test_atomic_write_failure_keeps_old_file(TestContextType &ctx)
+{
+    const auto path = ctx.get_temp_path() / "Settings.json";
+    ctx.check(write_file_atomic(path, "old"), "first write");
+
+    // The temp file cannot be created, the write has to fail without touching the target
+    std::filesystem::create_directories(get_tmp_path(path) / "blocker");
+
+    ctx.check(!write_file_atomic(path, "new"), "the write reports the failure");
+    ctx.check_equal(read_text(path), std::string{"old"}, "the old content survives");
+}
+
+void test_atomic_writer_chunks(TestContextType &ctx)
+{
+    const auto path = ctx.get_temp_path() / "icons.pack";
+    ctx.check(write_file_atomic(path, "old"), "first write");
+
+    {
+        auto writer = AtomicFileWriterType{};
+        ctx.check(writer.open(path), "open");
+        ctx.check(writer.write("....") && writer.write("body"), "chunks");
+        ctx.check(writer.write_at(0, "head"), "header written last");
+        ctx.check(!writer.write_at(6, "tail"), "no write past the end");
+        ctx.check_equal(read_text(path), std::string{"old"}, "the target is untouched before the commit");
+        ctx.check(writer.commit(), "commit");
+    }
+    ctx.check_equal(read_text(path), std::string{"headbody"}, "the file holds the chunks");
+    ctx.check(!std::filesystem::exists(get_tmp_path(path)), "no temp file is left behind");
+
+    // A writer that is never committed, e.g. a cancelled archive build
+    {
+        auto writer = AtomicFileWriterType{};
+        ctx.check(writer.open(path) && writer.write("partial"), "partial write");
+    }
+    ctx.check_equal(read_text(path), std::string{"headbody"}, "the old content survives");
+    ctx.check(!std::filesystem::exists(get_tmp_path(path)), "the temp file is removed");
+}
+
+void test_settings_saves_are_coalesced(TestContextType &ctx)
+{
+    const auto path = ctx.get_temp_path() / "Settings.json";
+    const auto num_writes_before = Settings::GetNumWrites();
+
+    for (auto idx = uint32_t{0}; idx < 50; ++idx)
+    {
+        Settings::WindowSizeLeft = idx;
+        Settings::Save(path);
+    }
+    Settings::Flush();
+
+    ctx.check_equal(Settings::GetNumWrites() - num_writes_before, size_t{1}, "50 saves share one write");
+
+    Settings::WindowSizeLeft = 0;
+    Settings::Load(path);
+    ctx.check_equal(Settings::WindowSizeLeft, uint32_t{49}, "the last saved state is written");
+
+    Settings::WindowSizeLeft = 7;
+    Settings::Save(path);
+    Settings::Flush();
+    ctx.check_equal(Settings::GetNumWrites() - num_writes_before, size_t{2}, "a save after a flush writes again");
+
+    Settings::WindowSizeLeft = 0;
+    Settings::Load(path);
+    ctx.check_equal(Settings::WindowSizeLeft, uint32_t{7}, "state of the second save");
+}
+
+void test_settings_save_during_flush(TestContextType &ctx)
+{
+    const auto path = ctx.get_temp_path() / "Settings.json";
+
+    // The saver keeps saving after the last flush, a writer lost in a flush loses every later save
+    auto is_flushing = std::atomic<bool>{true};
+    auto saver = std::thread{[&path, &is_flushing]() {
+        for (auto idx = uint32_t{0}; is_flushing; ++idx)
+        {
+            Settings::WindowSizeLeft = idx % 1000;
+            Settings::Save(path);
+        }
+    }};
+    for (auto idx = 0; idx < 200; ++idx)
+        Settings::Flush();
+    is_flushing = false;
+    saver.join();
+
+    const auto num_writes_before = Settings::GetNumWrites();
+    Settings::WindowSizeLeft = 4242;
+    Settings::Save(path);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (Settings::GetNumWrites() == num_writes_before && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ctx.check(Settings::GetNumWrites() > num_writes_before, "a save after the flushes is written");
+
+    Settings::Flush();
+    Settings::WindowSizeLeft = 0;
+    Settings::Load(path);
+    ctx.check_equal(Settings::WindowSizeLeft, uint32_t{4242}, "the last saved state is written");
+}
+} // namespace
+
+void add_settings_tests(TestRunnerType &runner)
+{
+    runner.add("settings/atomic_write_replaces_file", test_atomic_write_replaces_file);
+    runner.add("settings/atomic_write_after_crash", test_atomic_write_after_crash);
+    runner.add("settings/atomic_write_failure_keeps_old_file", test_atomic_write_failure_keeps_old_file);
+    runner.add("settings/atomic_writer_chunks", test_atomic_writer_chunks);
+    runner.add("settings/saves_are_coalesced", test_settings_saves_are_coalesced);
+    runner.add("settings/save_during_flush", test_settings_save_during_flush);
+}
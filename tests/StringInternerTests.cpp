@@ -0,0 +1,76 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "StringInterner.h"
+
+#include "Tests.h"
+
+namespace
+{
+void test_intern(TestContextType &ctx)
+{
+    auto interner = StringInternerType{};
+
+    const auto *sword = interner.intern("Sword");
+    ctx.check(sword != nullptr && sword->first == "Sword", "entry");
+    ctx.check(interner.intern(std::string{"Swo"} + "rd") == sword, "equal text, same entry");
+    ctx.check(interner.intern("Sword ") != sword, "other text");
+    ctx.check(interner.intern("") == nullptr, "empty string");
+    ctx.check_equal(interner.size(), size_t{2}, "size");
+
+    // Entries stay in place while the table grows
+    for (auto idx = 0; idx < 5000; ++idx)
+        (void)interner.intern("skill " + std::to_string(idx));
+    ctx.check(interner.intern("Sword") == sword && sword->first == "Sword", "stable after growth");
+    ctx.check_equal(sword->second, uint32_t{1}, "ids count from 1");
+}
+
+void test_interned_string(TestContextType &ctx)
+{
+    const auto lhs = InternedString{"Greatsword Swing"};
+    const auto rhs = InternedString{std::string{"Greatsword"} + " Swing"};
+    const auto empty = InternedString{};
+
+    ctx.check(lhs == rhs && lhs.id() == rhs.id(), "equal text compares equal");
+    ctx.check(lhs != InternedString{"Greatsword Swing 2"}, "other text");
+    ctx.check(empty.empty() && empty.id() == 0 && empty.str().empty(), "empty");
+    ctx.check(InternedString{""} == empty, "interned empty string");
+    ctx.check(lhs.view() == "Greatsword Swing" && std::string{lhs.c_str()} == "Greatsword Swing", "text");
+}
+
+void test_concurrent_intern(TestContextType &ctx)
+{
+    constexpr auto NUM_THREADS = size_t{4};
+    constexpr auto NUM_NAMES = 2000;
+
+    auto interner = StringInternerType{};
+    auto handles = std::vector<std::vector<const StringInternerType::Entry *>>(NUM_THREADS);
+    auto threads = std::vector<std::thread>{};
+    for (auto thread_idx = size_t{0}; thread_idx < NUM_THREADS; ++thread_idx)
+    {
+        threads.emplace_back([&interner, &handles, thread_idx]() {
+            for (auto idx = 0; idx < NUM_NAMES; ++idx)
+                handles[thread_idx].push_back(interner.intern("name " + std::to_string(idx)));
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    auto num_mismatches = 0;
+    for (auto thread_idx = size_t{1}; thread_idx < NUM_THREADS; ++thread_idx)
+        num_mismatches += handles[thread_idx] != handles[0];
+
+    ctx.check_equal(num_mismatches, 0, "every thread gets the same entries");
+    ctx.check_equal(interner.size(), size_t{NUM_NAMES}, "each text once");
+}
+} // namespace
+
+void add_string_interner_tests(TestRunnerType &runner)
+{
+    runner.add("string_interner/intern", test_intern);
+    runner.add("string_interner/interned_string", test_interned_string);
+    runner.add("string_interner/concurrent_intern", test_concurrent_intern);
+}
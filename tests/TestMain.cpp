@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "TestRunner.h"
+#include "Tests.h"
+
+// Unit tests of rota_core, run by ctest:
+//
+//   rota_tests [--data <data folder>] [--filter <substring>]
+//
+// Tests that read the shipped bench or skill data skip themselves if the
+// data folder is missing.
+
+int main(int argc, char **argv)
+{
+    auto data_path = std::filesystem::path{"data"};
+    auto filter = std::string{};
+
+    for (auto idx = 1; idx < argc; ++idx)
+    {
+        const auto arg = std::string_view{argv[idx]};
+        const auto has_value = idx + 1 < argc;
+
+        if (arg == "--data" && has_value)
+        {
+            data_path = argv[++idx];
+        }
+        else if (arg == "--filter" && has_value)
+        {
+            filter = argv[++idx];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: rota_tests [--data <data folder>] [--filter <substring>]\n");
+            return 1;
+        }
+    }
+
+    auto runner = TestRunnerType{};
+    add_atlas_builder_tests(runner);
+    add_bench_catalog_tests(runner);
+    add_completion_queue_tests(runner);
+    add_core_tests(runner);
+    add_data_sync_tests(runner);
+    add_downloader_tests(runner);
+    add_file_utils_tests(runner);
+    add_frozen_tests(runner);
+    add_icon_archive_tests(runner);
+    add_icon_cache_tests(runner);
+    add_image_resample_tests(runner);
+    add_png_decoder_tests(runner);
+    add_profiler_tests(runner);
+    add_rotation_table_tests(runner);
+    add_rule_matcher_tests(runner);
+    add_settings_tests(runner);
+    add_string_interner_tests(runner);
+    add_texture_loader_tests(runner);
+    add_zip_archive_tests(runner);
+
+    return runner.run(data_path, filter) == 0 ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "TestRunner.h"
+
+bool TestContextType::check(const bool condition, std::string_view message, const std::source_location location)
+{
+    if (condition)
+        return true;
+
+    ++num_failures;
+    std::fprintf(stderr,
+                 "  %s:%u: check failed: %.*s\n",
+                 std::filesystem::path{location.file_name()}.filename().string().c_str(),
+                 static_cast<unsigned>(location.line()),
+                 static_cast<int>(message.size()),
+                 message.data());
+
+    return false;
+}
+
+std::filesystem::path TestContextType::get_temp_path()
+{
+    if (temp_path.empty())
+    {
+        const auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+        temp_path = std::filesystem::temp_directory_path() / ("rota_tests_" + std::to_string(ticks));
+        std::filesystem::create_directories(temp_path);
+    }
+
+    return temp_path;
+}
+
+void TestRunnerType::add(std::string name, TestFunc func)
+{
+    tests.push_back(TestCase{std::move(name), std::move(func)});
+}
+
+size_t TestRunnerType::run(const std::filesystem::path &data_path, std::string_view filter)
+{
+    auto num_run = size_t{0};
+    auto num_failed = size_t{0};
+
+    for (const auto &test : tests)
+    {
+        if (!filter.empty() && test.name.find(filter) == std::string::npos)
+            continue;
+
+        ++num_run;
+        std::fprintf(stderr, "%s\n", test.name.c_str());
+
+        auto context = TestContextType{data_path};
+        try
+        {
+            test.func(context);
+        }
+        catch (const std::exception &e)
+        {
+            context.check(false, std::string{"unexpected exception: "} + e.what());
+        }
+
+        if (!context.temp_path.empty())
+        {
+            auto ec = std::error_code{};
+            std::filesystem::remove_all(context.temp_path, ec);
+        }
+
+        if (context.get_num_failures() > 0)
+            ++num_failed;
+    }
+
+    std::fprintf(stderr, "%zu tests, %zu failed\n", num_run, num_failed);
+
+    return num_failed;
+}
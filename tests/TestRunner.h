@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Minimal test runner of rota_tests. Tests are plain functions registered by
+// the add_*_tests functions of Tests.h, a failed check is reported with its
+// location and the test continues, so one run lists every failure.
+
+class TestContextType
+{
+public:
+    explicit TestContextType(const std::filesystem::path &data_path) : data_path(data_path)
+    {
+    }
+
+    bool check(const bool condition,
+               std::string_view message,
+               const std::source_location location = std::source_location::current());
+
+    template <typename Lhs, typename Rhs>
+    bool check_equal(const Lhs &lhs,
+                     const Rhs &rhs,
+                     std::string_view message,
+                     const std::source_location location = std::source_location::current())
+    {
+        return check(lhs == rhs, message, location);
+    }
+
+    // Fresh empty folder below the temp directory, removed after the test
+    std::filesystem::path get_temp_path();
+
+    size_t get_num_failures() const
+    {
+        return num_failures;
+    }
+
+    const std::filesystem::path &data_path;
+
+private:
+    friend class TestRunnerType;
+
+    size_t num_failures = 0;
+    std::filesystem::path temp_path;
+};
+
+class TestRunnerType
+{
+public:
+    using TestFunc = std::function<void(TestContextType &)>;
+
+    void add(std::string name, TestFunc func);
+
+    // Returns the number of failed tests
+    size_t run(const std::filesystem::path &data_path, std::string_view filter);
+
+private:
+    struct TestCase
+    {
+        std::string name;
+        TestFunc func;
+    };
+
+    std::vector<TestCase> tests;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "TestRunner.h"
+
+void add_atlas_builder_tests(TestRunnerType &runner);
+void add_bench_catalog_tests(TestRunnerType &runner);
+void add_completion_queue_tests(TestRunnerType &runner);
+void add_core_tests(TestRunnerType &runner);
+void add_data_sync_tests(TestRunnerType &runner);
+void add_downloader_tests(TestRunnerType &runner);
+void add_file_utils_tests(TestRunnerType &runner);
+void add_frozen_tests(TestRunnerType &runner);
+void add_icon_archive_tests(TestRunnerType &runner);
+void add_icon_cache_tests(TestRunnerType &runner);
+void add_image_resample_tests(TestRunnerType &runner);
+void add_png_decoder_tests(TestRunnerType &runner);
+void add_profiler_tests(TestRunnerType &runner);
+void add_rotation_table_tests(TestRunnerType &runner);
+void add_rule_matcher_tests(TestRunnerType &runner);
+void add_settings_tests(TestRunnerType &runner);
+void add_string_interner_tests(TestRunnerType &runner);
+void add_texture_loader_tests(TestRunnerType &runner);
+void add_zip_archive_tests(TestRunnerType &runner);
@@ -0,0 +1,164 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TextureLoader.h"
+
+#include "Tests.h"
+
+namespace
+{
+constexpr auto TEST_TIMEOUT = std::chrono::seconds(10);
+
+// The n-th decode waits until n decodes were released
+struct GateState
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t num_started = 0;
+    size_t num_released = 0;
+    std::atomic<size_t> num_finished = 0;
+};
+
+class GateDecoder final : public IImageDecoder
+{
+public:
+    explicit GateDecoder(GateState &state) : state(state)
+    {
+    }
+
+    bool decode(const std::filesystem::path &, DecodedImage &image) override
+    {
+        {
+            auto lock = std::unique_lock<std::mutex>{state.mutex};
+            const auto index = state.num_started++;
+            state.cv.notify_all();
+            state.cv.wait(lock, [this, index] { return state.num_released > index; });
+        }
+
+        image.width = 1;
+        image.height = 1;
+        image.pixels.assign(4, 255);
+        ++state.num_finished;
+        return true;
+    }
+
+private:
+    GateState &state;
+};
+
+bool wait_for(GateState &state, const size_t num_started)
+{
+    auto lock = std::unique_lock<std::mutex>{state.mutex};
+    return state.cv.wait_for(lock, TEST_TIMEOUT, [&state, num_started] { return state.num_started >= num_started; });
+}
+
+void release(GateState &state, const size_t num_released)
+{
+    {
+        auto lock = std::lock_guard<std::mutex>{state.mutex};
+        state.num_released = num_released;
+    }
+    state.cv.notify_all();
+}
+
+template <typename Predicate>
+bool wait_until(const Predicate &predicate)
+{
+    const auto deadline = std::chrono::steady_clock::now() + TEST_TIMEOUT;
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+void test_clear_keeps_new_generation(TestContextType &ctx)
+{
+    auto state = GateState{};
+    auto loader = TextureLoaderType{[&state]() { return std::make_unique<GateDecoder>(state); }, 2, 0};
+
+    constexpr auto icon_id = 42;
+    loader.request(icon_id, "42.png", TexturePriority::VISIBLE);
+    if (!ctx.check(wait_for(state, 1), "first decode started"))
+    {
+        release(state, 100);
+        return;
+    }
+
+    // The stale decode is still running while the icon is requested again
+    loader.clear();
+    loader.request(icon_id, "42.png", TexturePriority::VISIBLE);
+    if (!ctx.check(wait_for(state, 2), "second decode started"))
+    {
+        release(state, 100);
+        return;
+    }
+
+    release(state, 1);
+    ctx.check(wait_until([&state]() { return state.num_finished == 1; }), "stale decode finished");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // The stale worker must not have removed the decode of the new generation
+    loader.request(icon_id, "42.png", TexturePriority::VISIBLE);
+    release(state, 100);
+
+    auto uploaded = std::vector<int>{};
+    const auto uploader = [&uploaded](const int id, const DecodedImage &) {
+        uploaded.push_back(id);
+        return true;
+    };
+    ctx.check(wait_until([&]() {
+                  loader.upload(uploader, TextureUploadBudget{});
+                  return loader.is_idle();
+              }),
+              "loader is idle");
+
+    ctx.check_equal(uploaded, std::vector<int>{icon_id}, "the icon is uploaded once");
+    ctx.check_equal(state.num_finished.load(), size_t{2}, "no third decode");
+}
+
+void test_upload_budget(TestContextType &ctx)
+{
+    auto state = GateState{};
+    release(state, 100);
+    auto loader = TextureLoaderType{[&state]() { return std::make_unique<GateDecoder>(state); }, 2, 0};
+
+    for (auto icon_id = 0; icon_id < 10; ++icon_id)
+        loader.request(icon_id, std::to_string(icon_id) + ".png", TexturePriority::NORMAL);
+    ctx.check(wait_until([&state]() { return state.num_finished == 10; }), "all decoded");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto num_uploaded = size_t{0};
+    const auto uploader = [&num_uploaded](const int, const DecodedImage &) {
+        ++num_uploaded;
+        return true;
+    };
+
+    auto budget = TextureUploadBudget{};
+    budget.max_uploads = 3;
+    budget.max_time = std::chrono::seconds(10);
+    ctx.check_equal(loader.upload(uploader, budget), size_t{3}, "three uploads per frame");
+
+    while (loader.upload(uploader, budget) > 0)
+    {
+    }
+    ctx.check_equal(num_uploaded, size_t{10}, "all uploaded");
+    ctx.check(loader.is_idle(), "idle after the uploads");
+}
+} // namespace
+
+void add_texture_loader_tests(TestRunnerType &runner)
+{
+    runner.add("texture_loader/clear_keeps_new_generation", test_clear_keeps_new_generation);
+    runner.add("texture_loader/upload_budget", test_upload_budget);
+}
@@ -0,0 +1,214 @@
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Inflate.h"
+#include "ZipArchive.h"
+
+#include "Tests.h"
+#include "ZipWriter.h"
+
+namespace
+{
+// zlib level 9 output of get_cast_log(), a dynamic Huffman block
+constexpr auto DYNAMIC_BLOCK = std::array<uint8_t, 137>{
+    0x5D, 0x91, 0x4B, 0x0A, 0x80, 0x30, 0x10, 0x43, 0xAF, 0xD2, 0x23, 0x74, 0x3E, 0xB5,
+    0x8A, 0xA7, 0x11, 0x57, 0xA2, 0xAE, 0xEA, 0xFD, 0x51, 0x04, 0xCD, 0xA4, 0xBB, 0x32,
+    0x21, 0xEF, 0x11, 0xDA, 0xF6, 0xED, 0x38, 0x52, 0x4E, 0xEB, 0xD2, 0xAE, 0xB4, 0x5C,
+    0xCF, 0xEB, 0x6C, 0x73, 0x6A, 0xEF, 0xD5, 0xEA, 0x7F, 0xD6, 0x12, 0x83, 0xEA, 0x7F,
+    0x50, 0x72, 0x0C, 0x04, 0xA0, 0x4A, 0x0D, 0x07, 0x4A, 0x32, 0x55, 0x46, 0xB0, 0x84,
+    0x2D, 0x0A, 0x98, 0xB0, 0xA6, 0x04, 0x1A, 0x7B, 0x26, 0xD0, 0x94, 0x3D, 0x06, 0x9A,
+    0xB2, 0x67, 0xA0, 0x99, 0xD4, 0x41, 0xD0, 0xCD, 0x01, 0xCC, 0x58, 0x53, 0x01, 0x33,
+    0xD6, 0x08, 0x68, 0xD6, 0xCD, 0x09, 0x34, 0xF6, 0x8C, 0xA0, 0x39, 0x7B, 0x14, 0x34,
+    0xEF, 0xE6, 0x80, 0xE6, 0xEC, 0x99, 0x02, 0x8D, 0x3D, 0x66, 0xF1, 0x43, 0x69, 0x0F,
+    0x68, 0xA5, 0xF3, 0x20, 0x60, 0x8D, 0x07, 0xD8, 0xA7, 0xB9, 0x01,
+};
+
+std::string get_cast_log()
+{
+    auto text = std::string{};
+    for (auto idx = 0; idx < 24; ++idx)
+        text += "skill " + std::to_string(idx * 37 % 101) + " cast at " + std::to_string(idx * 250) + " ms; ";
+
+    return text;
+}
+
+// Text with repeats at every distance up to the window size
+std::string get_repetitive_text(const size_t size)
+{
+    auto text = std::string{};
+    auto seed = uint32_t{7};
+    while (text.size() < size)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const auto distance = 1 + (seed >> 8) % 32768;
+        if (text.size() > distance && (seed & 1))
+            text += text.substr(text.size() - distance, 3 + (seed >> 24) % 256);
+        else
+            text += static_cast<char>('a' + (seed >> 16) % 26);
+    }
+    text.resize(size);
+
+    return text;
+}
+
+InflateStatus inflate_to_string(const std::string &data, std::string &out, size_t *consumed = nullptr)
+{
+    out.clear();
+    return inflate_raw(
+        reinterpret_cast<const uint8_t *>(data.data()),
+        data.size(),
+        [&out](const uint8_t *chunk, const size_t size) {
+            out.append(reinterpret_cast<const char *>(chunk), size);
+            return true;
+        },
+        consumed);
+}
+
+std::string read_text(const std::filesystem::path &path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+void test_inflate_blocks(TestContextType &ctx)
+{
+    auto out = std::string{};
+    auto consumed = size_t{0};
+
+    const auto dynamic = std::string{DYNAMIC_BLOCK.begin(), DYNAMIC_BLOCK.end()};
+    ctx.check(inflate_to_string(dynamic, out, &consumed) == InflateStatus::OK, "dynamic block");
+    ctx.check(out == get_cast_log(), "dynamic block content");
+    ctx.check_equal(consumed, dynamic.size(), "consumed");
+
+    // The fixed encoder uses every length and distance code over 1 MB
+    const auto text = get_repetitive_text(1024 * 1024);
+    const auto fixed = deflate_fixed(text);
+    ctx.check(fixed.size() < text.size() / 2, "the fixture compresses");
+    ctx.check(inflate_to_string(fixed + "trailing", out, &consumed) == InflateStatus::OK, "fixed block");
+    ctx.check(out == text, "fixed block content");
+    ctx.check_equal(consumed, fixed.size(), "stops after the final block");
+
+    // A stored block: final, type 0, then LEN and NLEN
+    const auto stored = std::string{"\x01\x05\x00\xFA\xFFhello", 10};
+    ctx.check(inflate_to_string(stored, out) == InflateStatus::OK && out == "hello", "stored block");
+    ctx.check(inflate_to_string(deflate_fixed(""), out) == InflateStatus::OK && out.empty(), "empty");
+}
+
+void test_inflate_errors(TestContextType &ctx)
+{
+    auto out = std::string{};
+    const auto fixed = deflate_fixed(get_repetitive_text(64 * 1024));
+
+    ctx.check(inflate_to_string(fixed.substr(0, fixed.size() / 2), out) == InflateStatus::TRUNCATED, "truncated");
+    ctx.check(inflate_to_string("", out) == InflateStatus::TRUNCATED, "no data");
+    ctx.check(inflate_to_string("\x07", out) == InflateStatus::INVALID_DATA, "block type 3");
+    ctx.check(inflate_to_string(std::string{"\x01\x05\x00\x00\x00hello", 10}, out) == InflateStatus::INVALID_DATA,
+              "NLEN mismatch");
+
+    // A fixed block that starts with a match of distance 1 before any output
+    ctx.check(inflate_to_string(std::string{"\x03\x02\x00", 3}, out) == InflateStatus::INVALID_DATA, "distance");
+
+    auto num_chunks = 0;
+    const auto status = inflate_raw(reinterpret_cast<const uint8_t *>(fixed.data()),
+                                    fixed.size(),
+                                    [&num_chunks](const uint8_t *, const size_t) { return ++num_chunks < 1; });
+    ctx.check(status == InflateStatus::SINK_FAILED, "the sink aborts");
+}
+
+void test_crc32(TestContextType &ctx)
+{
+    const auto check_value = std::string{"123456789"};
+    const auto *data = reinterpret_cast<const uint8_t *>(check_value.data());
+    ctx.check_equal(update_crc32(0, data, check_value.size()), uint32_t{0xCBF43926}, "check value");
+
+    auto crc = update_crc32(0, data, 4);
+    crc = update_crc32(crc, data + 4, check_value.size() - 4);
+    ctx.check_equal(crc, uint32_t{0xCBF43926}, "in two parts");
+
+    const auto text = get_cast_log();
+    ctx.check_equal(update_crc32(0, reinterpret_cast<const uint8_t *>(text.data()), text.size()),
+                    uint32_t{628348379},
+                    "slicing by 8 matches zlib");
+}
+
+void test_extract_all(TestContextType &ctx)
+{
+    const auto zip_path = ctx.get_temp_path() / "bench.zip";
+    const auto extract_path = ctx.get_temp_path() / "out";
+
+    const auto entries = std::vector<ZipWriterEntry>{
+        {"bench/", "", false},
+        {"bench/dps/build.json", get_repetitive_text(200 * 1024), true},
+        {"bench/readme.txt", "stored", false},
+        {"bench/empty.json", "", true},
+    };
+    if (!ctx.check(write_zip(zip_path, entries), "write zip"))
+        return;
+
+    auto archive = ZipArchiveType{};
+    if (!ctx.check(archive.open(zip_path) == ZipStatus::OK, "open"))
+        return;
+
+    ctx.check_equal(archive.get_entries().size(), entries.size(), "entries");
+    ctx.check(archive.extract_all(extract_path) == ZipStatus::OK, "extract_all");
+    ctx.check(std::filesystem::is_directory(extract_path / "bench"), "directory entry");
+    for (const auto &entry : entries)
+    {
+        if (!entry.name.ends_with('/'))
+            ctx.check(read_text(extract_path / entry.name) == entry.content, entry.name);
+    }
+}
+
+void test_rejects_bad_entries(TestContextType &ctx)
+{
+    const auto extract_path = ctx.get_temp_path() / "out";
+
+    const auto unsafe_path = ctx.get_temp_path() / "unsafe.zip";
+    ctx.check(write_zip(unsafe_path, {{"../evil.txt", "evil", false}}), "write unsafe zip");
+    auto archive = ZipArchiveType{};
+    if (ctx.check(archive.open(unsafe_path) == ZipStatus::OK, "open unsafe zip"))
+        ctx.check(archive.extract_all(extract_path) == ZipStatus::UNSAFE_PATH, "path leaves the folder");
+    ctx.check(!std::filesystem::exists(ctx.get_temp_path() / "evil.txt"), "nothing outside");
+    archive.close();
+
+    // Flip a content byte of a stored entry, the CRC no longer matches
+    const auto corrupt_path = ctx.get_temp_path() / "corrupt.zip";
+    ctx.check(write_zip(corrupt_path, {{"file.txt", "content", false}}), "write zip");
+    auto content = read_text(corrupt_path);
+    content[30 + 8] ^= 0x20;
+    auto file = std::ofstream{corrupt_path, std::ios::binary | std::ios::trunc};
+    file << content;
+    file.close();
+
+    if (ctx.check(archive.open(corrupt_path) == ZipStatus::OK, "open corrupt zip"))
+        ctx.check(archive.extract_all(extract_path) == ZipStatus::CRC_MISMATCH, "crc mismatch");
+    ctx.check(!std::filesystem::exists(extract_path / "file.txt"), "no file after a mismatch");
+    ctx.check(!std::filesystem::exists(extract_path / "file.txt.part"), "no part file after a mismatch");
+    archive.close();
+
+    const auto garbage_path = ctx.get_temp_path() / "garbage.zip";
+    auto garbage = std::ofstream{garbage_path, std::ios::binary};
+    garbage << "not a zip file";
+    garbage.close();
+    ctx.check(archive.open(garbage_path) == ZipStatus::INVALID_ARCHIVE, "not a zip");
+    ctx.check(archive.open(ctx.get_temp_path() / "missing.zip") == ZipStatus::OPEN_FAILED, "missing");
+
+    ctx.check(get_zip_entry_path("out", "/etc/passwd").empty(), "absolute");
+    ctx.check(get_zip_entry_path("out", "a/../../b").empty(), "dot dot");
+    ctx.check(get_zip_entry_path("out", "a/./b.json") == std::filesystem::path{"out/a/b.json"}, "normalized");
+}
+} // namespace
+
+void add_zip_archive_tests(TestRunnerType &runner)
+{
+    runner.add("zip_archive/inflate_blocks", test_inflate_blocks);
+    runner.add("zip_archive/inflate_errors", test_inflate_errors);
+    runner.add("zip_archive/crc32", test_crc32);
+    runner.add("zip_archive/extract_all", test_extract_all);
+    runner.add("zip_archive/rejects_bad_entries", test_rejects_bad_entries);
+}
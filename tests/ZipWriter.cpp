@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ZipArchive.h"
+
+#include "ZipWriter.h"
+
+namespace
+{
+constexpr auto MIN_MATCH = size_t{3};
+constexpr auto MAX_MATCH = size_t{258};
+constexpr auto WINDOW_SIZE = size_t{32768};
+constexpr auto HASH_BITS = 15u;
+
+constexpr std::array<uint16_t, 29> LENGTH_BASES = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                                   31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<uint8_t, 29> LENGTH_EXTRA_BITS = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                                       2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<uint16_t, 30> DISTANCE_BASES = {1,    2,    3,    4,    5,    7,     9,     13,    17,    25,
+                                                     33,   49,   65,   97,   129,  193,   257,   385,   513,   769,
+                                                     1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<uint8_t, 30> DISTANCE_EXTRA_BITS = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                                         6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+class BitWriterType
+{
+public:
+    void put(const uint32_t value, const uint32_t num_bits)
+    {
+        bits |= static_cast<uint64_t>(value) << num_bits_used;
+        num_bits_used += num_bits;
+        while (num_bits_used >= 8)
+        {
+            out.push_back(static_cast<char>(bits & 0xFF));
+            bits >>= 8;
+            num_bits_used -= 8;
+        }
+    }
+
+    // Huffman codes are stored starting with their most significant bit
+    void put_code(const uint32_t code, const uint32_t length)
+    {
+        auto reversed = uint32_t{0};
+        for (auto bit = uint32_t{0}; bit < length; ++bit)
+            reversed |= ((code >> bit) & 1u) << (length - 1 - bit);
+        put(reversed, length);
+    }
+
+    std::string finish()
+    {
+        if (num_bits_used > 0)
+            out.push_back(static_cast<char>(bits & 0xFF));
+        return std::move(out);
+    }
+
+private:
+    std::string out;
+    uint64_t bits = 0;
+    uint32_t num_bits_used = 0;
+};
+
+void put_literal_length(BitWriterType &writer, const uint32_t symbol)
+{
+    if (symbol < 144)
+        writer.put_code(0x30 + symbol, 8);
+    else if (symbol < 256)
+        writer.put_code(0x190 + symbol - 144, 9);
+    else if (symbol < 280)
+        writer.put_code(symbol - 256, 7);
+    else
+        writer.put_code(0xC0 + symbol - 280, 8);
+}
+
+void put_match(BitWriterType &writer, const size_t length, const size_t distance)
+{
+    auto length_idx = LENGTH_BASES.size() - 1;
+    while (LENGTH_BASES[length_idx] > length)
+        --length_idx;
+    put_literal_length(writer, static_cast<uint32_t>(257 + length_idx));
+    writer.put(static_cast<uint32_t>(length - LENGTH_BASES[length_idx]), LENGTH_EXTRA_BITS[length_idx]);
+
+    auto distance_idx = DISTANCE_BASES.size() - 1;
+    while (DISTANCE_BASES[distance_idx] > distance)
+        --distance_idx;
+    writer.put_code(static_cast<uint32_t>(distance_idx), 5);
+    writer.put(static_cast<uint32_t>(distance - DISTANCE_BASES[distance_idx]), DISTANCE_EXTRA_BITS[distance_idx]);
+}
+
+uint32_t get_hash(const uint8_t *data)
+{
+    const auto value = uint32_t{data[0]} | (uint32_t{data[1]} << 8) | (uint32_t{data[2]} << 16);
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+template <typename T>
+void put_le(std::string &out, const T value)
+{
+    for (auto idx = size_t{0}; idx < sizeof(T); ++idx)
+        out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (idx * 8)) & 0xFF));
+}
+} // namespace
+
+std::string deflate_fixed(const std::string &data)
+{
+    const auto *bytes = reinterpret_cast<const uint8_t *>(data.data());
+    const auto size = data.size();
+
+    auto writer = BitWriterType{};
+    writer.put(1, 1); // Final block
+    writer.put(1, 2); // Fixed Huffman codes
+
+    // Greedy matching against the last position of every 3 byte hash
+    auto last_positions = std::vector<int64_t>(size_t{1} << HASH_BITS, -1);
+    auto pos = size_t{0};
+    while (pos < size)
+    {
+        auto match_length = size_t{0};
+        auto match_distance = size_t{0};
+        if (pos + MIN_MATCH <= size)
+        {
+            const auto hash = get_hash(bytes + pos);
+            const auto candidate = last_positions[hash];
+            last_positions[hash] = static_cast<int64_t>(pos);
+
+            if (candidate >= 0 && pos - static_cast<size_t>(candidate) <= WINDOW_SIZE)
+            {
+                const auto max_length = std::min(MAX_MATCH, size - pos);
+                while (match_length < max_length && bytes[candidate + match_length] == bytes[pos + match_length])
+                    ++match_length;
+                match_distance = pos - static_cast<size_t>(candidate);
+            }
+        }
+
+        if (match_length >= MIN_MATCH)
+        {
+            put_match(writer, match_length, match_distance);
+            for (auto idx = pos + 1; idx < pos + match_length && idx + MIN_MATCH <= size; ++idx)
+                last_positions[get_hash(bytes + idx)] = static_cast<int64_t>(idx);
+            pos += match_length;
+        }
+        else
+        {
+            put_literal_length(writer, bytes[pos]);
+            ++pos;
+        }
+    }
+
+    put_literal_length(writer, 256);
+    return writer.finish();
+}
+
+bool write_zip(const std::filesystem::path &path, const std::vector<ZipWriterEntry> &entries)
+{
+    constexpr auto DOS_DATE_1980 = uint16_t{0x21};
+
+    auto out = std::string{};
+    auto central_directory = std::string{};
+    for (const auto &entry : entries)
+    {
+        const auto payload = entry.is_deflated ? deflate_fixed(entry.content) : entry.content;
+        const auto method = static_cast<uint16_t>(entry.is_deflated ? 8 : 0);
+        const auto crc = update_crc32(0, reinterpret_cast<const uint8_t *>(entry.content.data()), entry.content.size());
+        const auto offset = static_cast<uint32_t>(out.size());
+
+        put_le<uint32_t>(out, 0x04034B50);
+        put_le<uint16_t>(out, 20);
+        put_le<uint16_t>(out, 0);
+        put_le<uint16_t>(out, method);
+        put_le<uint16_t>(out, 0);
+        put_le<uint16_t>(out, DOS_DATE_1980);
+        put_le<uint32_t>(out, crc);
+        put_le<uint32_t>(out, static_cast<uint32_t>(payload.size()));
+        put_le<uint32_t>(out, static_cast<uint32_t>(entry.content.size()));
+        put_le<uint16_t>(out, static_cast<uint16_t>(entry.name.size()));
+        put_le<uint16_t>(out, 0);
+        out += entry.name;
+        out += payload;
+
+        put_le<uint32_t>(central_directory, 0x02014B50);
+        put_le<uint16_t>(central_directory, 20);
+        put_le<uint16_t>(central_directory, 20);
+        put_le<uint16_t>(central_directory, 0);
+        put_le<uint16_t>(central_directory, method);
+        put_le<uint16_t>(central_directory, 0);
+        put_le<uint16_t>(central_directory, DOS_DATE_1980);
+        put_le<uint32_t>(central_directory, crc);
+        put_le<uint32_t>(central_directory, static_cast<uint32_t>(payload.size()));
+        put_le<uint32_t>(central_directory, static_cast<uint32_t>(entry.content.size()));
+        put_le<uint16_t>(central_directory, static_cast<uint16_t>(entry.name.size()));
+        put_le<uint16_t>(central_directory, 0);
+        put_le<uint16_t>(central_directory, 0);
+        put_le<uint16_t>(central_directory, 0);
+        put_le<uint16_t>(central_directory, 0);
+        put_le<uint32_t>(central_directory, 0);
+        put_le<uint32_t>(central_directory, offset);
+        central_directory += entry.name;
+    }
+
+    const auto central_directory_offset = static_cast<uint32_t>(out.size());
+    out += central_directory;
+
+    put_le<uint32_t>(out, 0x06054B50);
+    put_le<uint16_t>(out, 0);
+    put_le<uint16_t>(out, 0);
+    put_le<uint16_t>(out, static_cast<uint16_t>(entries.size()));
+    put_le<uint16_t>(out, static_cast<uint16_t>(entries.size()));
+    put_le<uint32_t>(out, static_cast<uint32_t>(central_directory.size()));
+    put_le<uint32_t>(out, central_directory_offset);
+    put_le<uint16_t>(out, 0);
+
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return file.good();
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Writes the ZIP files of the extraction tests and benchmarks. The encoder
+// only emits fixed Huffman blocks with a greedy LZ77 match search, which is
+// enough to run every length and distance code path of the inflater, but
+// compresses worse than zlib.
+
+// Raw DEFLATE data, one final fixed Huffman block
+std::string deflate_fixed(const std::string &data);
+
+struct ZipWriterEntry
+{
+    std::string name;
+    std::string content;
+    bool is_deflated = true;
+};
+
+bool write_zip(const std::filesystem::path &path, const std::vector<ZipWriterEntry> &entries);